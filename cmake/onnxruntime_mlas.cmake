@@ -13,6 +13,11 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/threading.cpp
   ${MLAS_SRC_DIR}/sgemm.cpp
   ${MLAS_SRC_DIR}/halfgemm.cpp
+  ${MLAS_SRC_DIR}/bf16gemm.cpp
+  ${MLAS_SRC_DIR}/cast.cpp
+  ${MLAS_SRC_DIR}/reduce.cpp
+  ${MLAS_SRC_DIR}/layernorm.cpp
+  ${MLAS_SRC_DIR}/flashattn.cpp
   ${MLAS_SRC_DIR}/qgemm.cpp
   ${MLAS_SRC_DIR}/qdwconv.cpp
   ${MLAS_SRC_DIR}/convolve.cpp
@@ -147,16 +152,24 @@ function(setup_mlas_source_for_windows)
       "${MLAS_SRC_DIR}/intrinsics/avx2/*.cpp"
     )
     set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+    set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+    set_source_files_properties(${MLAS_SRC_DIR}/cast_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX2")
 
     target_sources(onnxruntime_mlas PRIVATE
       ${MLAS_SRC_DIR}/dgemm.cpp
       ${mlas_platform_srcs_avx}
       ${mlas_platform_srcs_avx2}
       ${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp
+      ${MLAS_SRC_DIR}/convsym_kernel_amx.cpp
+      ${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp
+      ${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp
+      ${MLAS_SRC_DIR}/cast_kernel_avx2.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_sse.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_sse41.cpp
       ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/reduce_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/layernorm_avx512f.cpp
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAmx.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAvx2.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8U8KernelAvx2.asm
@@ -196,6 +209,8 @@ function(setup_mlas_source_for_windows)
     if (NOT onnxruntime_ORT_MINIMAL_BUILD)
       target_sources(onnxruntime_mlas PRIVATE
         ${MLAS_SRC_DIR}/q4gemm_avx512.cpp
+        ${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp
+        ${MLAS_SRC_DIR}/halfgemm_kernel_avx512fp16.cpp
       )
     endif()
 
@@ -511,6 +526,8 @@ else()
           ${MLAS_SRC_DIR}/x86_64/ErfKernelFma3.S
           ${MLAS_SRC_DIR}/intrinsics/avx2/qladd_avx2.cpp
           ${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/reduce_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/layernorm_avx2.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
 
@@ -521,6 +538,8 @@ else()
           ${MLAS_SRC_DIR}/x86_64/SpoolKernelAvx512F.S
           ${MLAS_SRC_DIR}/x86_64/TransKernelAvx512F.S
           ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/reduce_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/layernorm_avx512f.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx512f} PROPERTIES COMPILE_FLAGS "-mavx512f")
 
@@ -537,6 +556,8 @@ else()
           ${MLAS_SRC_DIR}/dwconv.cpp
           ${MLAS_SRC_DIR}/dgemm.cpp
           ${MLAS_SRC_DIR}/pooling_fp16.cpp
+          ${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp
+          ${MLAS_SRC_DIR}/cast_kernel_avx2.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
           ${mlas_platform_srcs_sse2}
           ${mlas_platform_srcs_avx}
@@ -544,13 +565,19 @@ else()
           ${mlas_platform_srcs_avx512f}
           ${mlas_platform_srcs_avx512core}
         )
+        set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mf16c")
+        set_source_files_properties(${MLAS_SRC_DIR}/cast_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mf16c")
 
         if (NOT onnxruntime_ORT_MINIMAL_BUILD)
           set(mlas_platform_srcs
             ${mlas_platform_srcs}
             ${MLAS_SRC_DIR}/q4gemm_avx512.cpp
+            ${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp
+            ${MLAS_SRC_DIR}/halfgemm_kernel_avx512fp16.cpp
           )
           set_source_files_properties(${MLAS_SRC_DIR}/q4gemm_avx512.cpp PROPERTIES COMPILE_FLAGS "-mfma -mavx512vnni -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp PROPERTIES COMPILE_FLAGS "-mavx512bf16 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_avx512fp16.cpp PROPERTIES COMPILE_FLAGS "-mavx512fp16 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
         endif()
         if(NOT APPLE)
           set(mlas_platform_srcs
@@ -558,8 +585,12 @@ else()
 	        ${MLAS_SRC_DIR}/x86_64/QgemmU8S8KernelAmxCommon.S
             ${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp
             ${MLAS_SRC_DIR}/x86_64/QgemmU8S8KernelAmx.S
+            ${MLAS_SRC_DIR}/convsym_kernel_amx.cpp
+            ${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp
             )
           set_source_files_properties(${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/convsym_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
           set_source_files_properties(${MLAS_SRC_DIR}/x86_64/QgemmU8S8KernelAmx.S PROPERTIES COMPILE_FLAGS "-mavx2 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
 	    endif()
 
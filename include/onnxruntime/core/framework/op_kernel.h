@@ -129,6 +129,24 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed weight that was persisted by an earlier session, possibly in another
+  // process. See kOrtSessionOptionsPrepackedWeightsCacheFile.
+  // Unlike UseSharedPrePackedBuffers(), this is called INSTEAD OF PrePack(), so the kernel must also restore any
+  // metadata it would otherwise capture in PrePack() (e.g. the shape of the weight) from the provided tensor.
+  // @param tensor: The initialized constant tensor the pre-packed buffers were produced from
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_buffers: The pre-packed buffers in the order PrePack() stored them in the PrePackedWeights
+  //                           instance. As with UseSharedPrePackedBuffers() the deleters are NULL.
+  // @param used_persisted_buffers: Boolean flag set by the kernel implementation indicating that the provided
+  //                                weight has been used by the kernel. If false, PrePack() is called instead.
+  virtual Status UsePersistedPrePackedBuffers(const Tensor& /*tensor*/,
+                                              int /*input_idx*/,
+                                              std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                              /*out*/ bool& used_persisted_buffers) {
+    used_persisted_buffers = false;
+    return Status::OK();
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
@@ -39,6 +39,7 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <chrono>
 #include <memory>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
@@ -78,6 +79,12 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   With adaptive spinning, each worker instead spins for a time
+//   derived from the idle gaps it observed recently: long enough to
+//   cover gaps that are shorter than the cost of blocking and waking
+//   up, and only briefly when the gaps are typically longer.  The
+//   HintBurst() and HintIdle() methods let the caller override this
+//   when it knows that work is about to arrive or that none will.
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -232,6 +239,8 @@ class ThreadPoolProfiler {
   void LogThreadId(int){};
   void LogRun(int){};
   std::string DumpChildThreadStat() { return {}; }
+  static uint64_t StartDispatchTiming() { return 0; }
+  static uint64_t StopDispatchTiming(uint64_t) { return 0; }
 };
 #else
 class ThreadPoolProfiler {
@@ -259,6 +268,12 @@ class ThreadPoolProfiler {
   void LogRun(int thread_idx);                      // called in child thread to log num of run
   std::string DumpChildThreadStat();                // return all child statitics collected so far
 
+  // Time the distribution of work and the waits of the calling thread in all thread pools, whether or not profiling
+  // is started. Returns a baseline to pass to StopDispatchTiming. Calls may nest.
+  static uint64_t StartDispatchTiming();
+  // Stop timing and return the nanoseconds spent since the matching StartDispatchTiming.
+  static uint64_t StopDispatchTiming(uint64_t baseline);
+
  private:
   static const char* GetEventName(ThreadPoolEvent);
   struct MainThreadStat {
@@ -266,15 +281,19 @@ class ThreadPoolProfiler {
     int32_t core_ = -1;
     std::vector<std::ptrdiff_t> blocks_;  // block size determined by cost model
     std::vector<onnxruntime::TimePoint> points_;
+    // nanoseconds spent in the events other than RUN while dispatch timing is on. Not cleared by Reset().
+    uint64_t dispatch_ns_ = 0;
     void LogCore();
     void LogBlockSize(std::ptrdiff_t block_size);
     void LogStart();
-    void LogEnd(ThreadPoolEvent);
-    void LogEndAndStart(ThreadPoolEvent);
+    void LogEnd(ThreadPoolEvent, bool profiling);
+    void LogEndAndStart(ThreadPoolEvent, bool profiling);
     std::string Reset();
   };
   bool enabled_ = false;
-  MainThreadStat& GetMainThreadStat();  // return thread local stat
+  // whether the calling thread has to record the Log* calls
+  bool Recording() const;
+  static MainThreadStat& GetMainThreadStat();  // return thread local stat
   int num_threads_;
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -773,6 +792,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -1332,6 +1352,34 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     spin_loop_status_ = SpinLoopStatus::kIdle;
   }
 
+  // Hint that work is about to be submitted: wake up the blocked workers and keep them spinning, whatever
+  // the spin count and the adaptive spin time, until the given duration has passed, HintIdle() is called or
+  // spinning is disabled.  Has no effect if spinning is not allowed or is currently disabled, as the workers
+  // would block again straight away.
+  void HintBurst(std::chrono::microseconds duration) {
+    if (!allow_spinning_ || spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
+      return;
+    }
+
+    const auto burst_end = std::chrono::steady_clock::now() + duration;
+    burst_end_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(burst_end.time_since_epoch()).count(),
+                        std::memory_order_relaxed);
+    for (auto& td : worker_data_) {
+      td.EnsureAwake();
+    }
+  }
+
+  // Hint that no work is expected for a while: workers that are spinning stop and block.
+  void HintIdle() {
+    burst_end_ns_.store(0, std::memory_order_relaxed);
+    idle_hint_epoch_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Number of workers that are blocked waiting for work.
+  unsigned NumBlockedThreads() const {
+    return blocked_.load(std::memory_order_relaxed);
+  }
+
  private:
   void ComputeCoprimes(int N, Eigen::MaxSizeVector<unsigned>* coprimes) {
     for (int i = 1; i <= N; i++) {
@@ -1395,6 +1443,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     std::unique_ptr<Thread> thread;
     Queue queue;
 
+    // Estimate of the time between the thread running out of work and receiving new work, for
+    // adaptive spinning.  Only accessed by the thread itself.
+    int64_t idle_gap_estimate_ns = 0;
+
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
     // purposes:
@@ -1492,6 +1544,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
@@ -1510,6 +1563,38 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // Default is no control over spinning
   std::atomic<SpinLoopStatus> spin_loop_status_{SpinLoopStatus::kBusy};
 
+  // Adaptive spinning bounds.  Blocking and waking up a thread costs in the order of tens of microseconds,
+  // so spinning pays off for gaps up to a small multiple of that.  Gaps that are longer than
+  // kAdaptiveMaxSpinNs on average only get kAdaptiveMinSpinNs to catch back-to-back parallel sections.
+  static constexpr int64_t kAdaptiveMinSpinNs = 2 * 1000;
+  static constexpr int64_t kAdaptiveMaxSpinNs = 250 * 1000;
+
+  // End of the period requested by HintBurst(), in nanoseconds of steady_clock.  0 if there is none.
+  std::atomic<int64_t> burst_end_ns_{0};
+  // Incremented by HintIdle() so that spinning workers notice it.
+  std::atomic<unsigned> idle_hint_epoch_{0};
+
+  static int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // How long a worker that ran out of work spins before blocking, unless HintBurst() requested a burst.
+  static int64_t AdaptiveSpinLimitNs(const WorkerData& td) {
+    if (td.idle_gap_estimate_ns > kAdaptiveMaxSpinNs) {
+      return kAdaptiveMinSpinNs;
+    }
+    return std::min(kAdaptiveMaxSpinNs, 2 * td.idle_gap_estimate_ns + kAdaptiveMinSpinNs);
+  }
+
+  // Update the estimate with an observed idle gap.  The gap is capped so that a single long pause does not
+  // disable spinning for many subsequent short gaps.
+  static void RecordIdleGap(WorkerData& td, int64_t gap_ns) {
+    gap_ns = std::min(gap_ns, 2 * kAdaptiveMaxSpinNs);
+    td.idle_gap_estimate_ns += (gap_ns - td.idle_gap_estimate_ns) / 4;
+  }
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1542,8 +1627,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     while (!should_exit) {
       Task t = q.PopFront();
       if (!t) {
-        // Spin waiting for work.
-        for (int i = 0; i < spin_count && !done_; i++) {
+        const int64_t burst_end_ns = burst_end_ns_.load(std::memory_order_relaxed);
+        const int64_t idle_start_ns = adaptive_spinning_ || burst_end_ns != 0 ? NowNs() : 0;
+        const int64_t spin_limit_ns = adaptive_spinning_ ? AdaptiveSpinLimitNs(td) : 0;
+        const unsigned idle_hint_epoch = idle_hint_epoch_.load(std::memory_order_relaxed);
+        bool in_burst = allow_spinning_ && idle_start_ns < burst_end_ns;
+
+        // Spin waiting for work.  During a burst the spin count and the adaptive spin time do not apply.
+        for (int64_t i = 0; (i < spin_count || in_burst) && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
           } else {
@@ -1551,9 +1642,22 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           }
           if (t) break;
 
-          if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
+          if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle ||
+              idle_hint_epoch_.load(std::memory_order_relaxed) != idle_hint_epoch) {
             break;
           }
+          // reading the clock is much more expensive than a pause, so only check it periodically.  The burst
+          // is reloaded as HintBurst() may have started or extended one since this worker ran out of work.
+          if ((i & 63) == 63) {
+            const int64_t current_burst_end_ns = burst_end_ns_.load(std::memory_order_relaxed);
+            if (adaptive_spinning_ || current_burst_end_ns != 0) {
+              const int64_t now_ns = NowNs();
+              in_burst = now_ns < current_burst_end_ns;
+              if (!in_burst && adaptive_spinning_ && now_ns - idle_start_ns >= spin_limit_ns) {
+                break;
+              }
+            }
+          }
           onnxruntime::concurrency::SpinPause();
         }
 
@@ -1621,6 +1725,11 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           if (!t) t = q.PopFront();
           if (!t) t = Steal(StealAttemptKind::TRY_ALL);
         }
+
+        // a wake-up without work (e.g. from HintBurst()) does not end the idle gap
+        if (adaptive_spinning_ && t) {
+          RecordIdleGap(td, NowNs() - idle_start_ns);
+        }
       }
 
       if (t) {
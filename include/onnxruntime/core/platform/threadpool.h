@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <chrono>
 #include <string>
 #include <vector>
 #include <functional>
@@ -221,6 +222,13 @@ class ThreadPool {
 
   void DisableSpinning();
 
+  // Hints for the spinning policy of the workers.  HintBurst wakes up blocked workers and lets them spin
+  // for the given duration in anticipation of work, unless spinning is not allowed or is disabled.
+  // HintIdle makes spinning workers block immediately.
+  void HintBurst(std::chrono::microseconds duration);
+
+  void HintIdle();
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -366,6 +374,12 @@ class ThreadPool {
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
+  // Measure the time the calling thread spends distributing work to, and waiting for, any thread pool.
+  // StartDispatchTiming returns a baseline for StopDispatchTiming, which returns the elapsed nanoseconds.
+  // Not to be consumed as public-facing API either.
+  static uint64_t StartDispatchTiming();
+  static uint64_t StopDispatchTiming(uint64_t baseline);
+
  private:
   friend class LoopCounter;
 
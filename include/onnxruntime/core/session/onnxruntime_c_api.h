@@ -300,6 +300,7 @@ ORT_RUNTIME_CLASS(Op);
 ORT_RUNTIME_CLASS(OpAttr);
 ORT_RUNTIME_CLASS(Logger);
 ORT_RUNTIME_CLASS(ShapeInferContext);
+ORT_RUNTIME_CLASS(RequestBatcher);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -341,6 +342,14 @@ typedef enum ExecutionMode {
   ORT_PARALLEL = 1,
 } ExecutionMode;
 
+/** \brief Hints about upcoming work for the thread pools of a session
+ * /see OrtApi::SessionHintThreadPoolActivity
+ */
+typedef enum OrtThreadPoolActivityHint {
+  ORT_THREAD_POOL_ACTIVITY_BURST = 0,  ///< Requests are about to arrive
+  ORT_THREAD_POOL_ACTIVITY_IDLE = 1,   ///< No requests are expected for a while
+} OrtThreadPoolActivityHint;
+
 /** \brief Language projection identifiers
  * /see OrtApi::SetLanguageProjection
  */
@@ -2768,6 +2777,10 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "thread_cache_max_bytes": Maximum number of bytes of freed memory each thread keeps in a per-thread cache in
+   *  front of the arena. Small allocations and frees by a thread are served from its cache without taking the
+   *  arena lock, which helps when many threads run inference concurrently. Not supported for stream aware arenas.
+   *  Use 0 to disable the per-thread caches. Use -1 to allow ORT to choose the default, which is 0.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -4512,6 +4525,123 @@ struct OrtApi {
    * \since Version 1.17.
    */
   ORT_API2_STATUS(ReadOpAttr, _In_ const OrtOpAttr* op_attr, _In_ OrtOpAttrType type, _Inout_ void* data, _In_ size_t len, _Out_ size_t* out);
+
+  /// \name OrtRequestBatcher
+  /// @{
+
+  /** \brief Create a batcher that combines concurrent requests against a session into batched runs
+   *
+   * Requests passed to OrtApi::RequestBatcherRun are queued and executed together once their combined batch size
+   * reaches the maximum batch size or the oldest request has waited for the maximum delay. The inputs of the
+   * requests are concatenated along the batch dim and the outputs are split back to each request.
+   *
+   * Requests can be batched together if they have the same input names, output names and element types, and their
+   * input shapes only differ in the batch dim and the padded dims. Inputs must be non-string tensors in CPU memory.
+   *
+   * Supported keys are listed below. Any other key is rejected with ORT_INVALID_ARGUMENT.
+   * "batch_dim": Name of the symbolic dim that is the batch dim. Every input and output of the model must have it.
+   *  Required.
+   * "padded_dims": Comma separated names of symbolic dims that may differ between requests that are batched
+   *  together, e.g. a sequence length. Inputs are padded with zeros to the largest value in the batch, and output
+   *  dims with the same name are sliced back to the value of each request. Default is "".
+   * "max_batch_size": Maximum combined batch size of the requests that are executed together. Default is 8.
+   * "max_delay_us": Maximum time in microseconds the oldest queued request waits for other requests. Default is 1000.
+   *
+   * \param[in] session The session must outlive the batcher.
+   * \param[in] keys Keys to configure the batcher
+   * \param[in] values Values to configure the batcher
+   * \param[in] num_keys Number of keys in `keys` and `values`
+   * \param[out] out Newly created ::OrtRequestBatcher. Must be freed with OrtApi::ReleaseRequestBatcher
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateRequestBatcher, _In_ OrtSession* session, _In_reads_(num_keys) const char* const* keys,
+                  _In_reads_(num_keys) const char* const* values, _In_ size_t num_keys,
+                  _Outptr_ OrtRequestBatcher** out);
+
+  /** \brief Run a request through a batcher
+   *
+   * Blocks until the batch containing the request has been executed. Can be called concurrently from multiple threads.
+   *
+   * \param[in] batcher
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] inputs Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names and outputs array
+   * \param[out] outputs Array of ::OrtValue%s that the outputs are stored in. The outputs are always allocated by
+   *  ORT, so the entries must be nullptr. Each ::OrtValue must be freed with OrtApi::ReleaseValue.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RequestBatcherRun, _Inout_ OrtRequestBatcher* batcher,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** outputs);
+
+  /** \brief Release an ::OrtRequestBatcher
+   *
+   * Requests that are still queued are executed before this returns.
+   *
+   * \since Version 1.17.
+   */
+  ORT_CLASS_RELEASE(RequestBatcher);
+
+  /// @}
+
+  /** \brief Hint the thread pools of a session about upcoming work
+   *
+   * With ::ORT_THREAD_POOL_ACTIVITY_BURST the worker threads are woken up and spin waiting for work for up to
+   * `burst_duration_us` microseconds, so that the parallel sections of the next requests do not pay for waking them up.
+   * With ::ORT_THREAD_POOL_ACTIVITY_IDLE spinning worker threads block immediately, and `burst_duration_us` is ignored.
+   * This is most useful together with the "session.intra_op.adaptive_spinning" session config entry.
+   * The hints affect the thread pools used by the session, which are shared with other sessions when global thread
+   * pools are used.
+   *
+   * \param[in] session
+   * \param[in] hint
+   * \param[in] burst_duration_us
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SessionHintThreadPoolActivity, _In_ OrtSession* session, _In_ OrtThreadPoolActivityHint hint,
+                  _In_ int64_t burst_duration_us);
+
+  /** \brief Get the statistics of the aggregating profiler of a session
+   *
+   * Returns a JSON document with, for each op type and execution provider that ran since the session was initialized
+   * or the profile was last reset: the number of calls, the total, min and max kernel time, the size of the outputs,
+   * the time spent distributing work to the intra-op thread pool and, if enabled, hardware counters.
+   * The session must be created with the "session.profiling.aggregate" session config entry set to "1".
+   * Can be called while runs are in progress.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out Null terminated JSON string. Free with the allocator.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SessionGetAggregateProfile, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Clear the statistics of the aggregating profiler of a session
+   *
+   * \param[in] session
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SessionResetAggregateProfile, _In_ OrtSession* session);
 };
 
 /*
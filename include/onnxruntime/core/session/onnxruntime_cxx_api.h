@@ -522,6 +522,7 @@ ORT_DEFINE_RELEASE(Status);
 ORT_DEFINE_RELEASE(OpAttr);
 ORT_DEFINE_RELEASE(Op);
 ORT_DEFINE_RELEASE(KernelInfo);
+ORT_DEFINE_RELEASE(RequestBatcher);
 
 #undef ORT_DEFINE_RELEASE
 
@@ -1027,6 +1028,15 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+
+  /** \brief Returns the statistics of the aggregating profiler as a JSON string
+   *
+   * \param allocator to allocate memory for the copy of the string returned
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetAggregateProfileAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetAggregateProfile
+
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -1096,6 +1106,17 @@ struct SessionImpl : ConstSessionImpl<T> {
    *  The OrtAllocator instances must be valid at the point of memory release.
    */
   AllocatedStringPtr EndProfilingAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionEndProfiling
+
+  /** \brief Hint the thread pools of the session about upcoming work
+   *
+   * Wraps OrtApi::SessionHintThreadPoolActivity
+   *
+   * \param hint Whether requests are about to arrive or none are expected for a while
+   * \param burst_duration_us How long the worker threads spin waiting for the requests. Ignored for idle hints.
+   */
+  void HintThreadPoolActivity(OrtThreadPoolActivityHint hint, int64_t burst_duration_us = 0);
+
+  void ResetAggregateProfile();  ///< Wraps OrtApi::SessionResetAggregateProfile
 };
 
 }  // namespace detail
@@ -1859,6 +1880,27 @@ struct IoBinding : detail::IoBindingImpl<OrtIoBinding> {
   UnownedIoBinding GetUnowned() const { return UnownedIoBinding{this->p_}; }
 };
 
+/** \brief Wrapper around ::OrtRequestBatcher
+ *
+ * Combines concurrent requests against a session into batched runs. See OrtApi::CreateRequestBatcher for the options.
+ */
+struct RequestBatcher : detail::Base<OrtRequestBatcher> {
+  explicit RequestBatcher(std::nullptr_t) {}  ///< Create an empty RequestBatcher object, must be assigned a valid one to be used
+  RequestBatcher(Session& session, const std::unordered_map<std::string, std::string>& options);  ///< Wraps OrtApi::CreateRequestBatcher
+
+  /** \brief Run a request. Blocks until the batch containing it has been executed. Wraps OrtApi::RequestBatcherRun
+   *
+   * \param[in] input_names Array of null terminated strings of length input_count that is the list of input names
+   * \param[in] input_values Array of Value objects of length input_count that is the list of input values
+   * \param[in] input_count Number of inputs (the size of the input_names & input_values arrays)
+   * \param[in] output_names Array of C style strings of length output_count that is the list of output names
+   * \param[in] output_count Number of outputs (the size of the output_names array)
+   * \return A std::vector of Value objects that directly maps to the output_names array (eg. output_name[0] is the first entry of the returned vector)
+   */
+  std::vector<Value> Run(const char* const* input_names, const Value* input_values, size_t input_count,
+                         const char* const* output_names, size_t output_count);
+};
+
 /*! \struct Ort::ArenaCfg
  * \brief it is a structure that represents the configuration of an arena based allocator
  * \details Please see docs/C_API.md for details
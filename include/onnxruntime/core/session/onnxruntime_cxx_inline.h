@@ -428,6 +428,35 @@ inline ArenaCfg::ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial
   ThrowOnError(GetApi().CreateArenaCfg(max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk, &p_));
 }
 
+inline RequestBatcher::RequestBatcher(Session& session, const std::unordered_map<std::string, std::string>& options) {
+  std::vector<const char*> keys;
+  std::vector<const char*> values;
+  keys.reserve(options.size());
+  values.reserve(options.size());
+  for (const auto& kv : options) {
+    keys.push_back(kv.first.c_str());
+    values.push_back(kv.second.c_str());
+  }
+
+  ThrowOnError(GetApi().CreateRequestBatcher(session, keys.data(), values.data(), keys.size(), &p_));
+}
+
+inline std::vector<Value> RequestBatcher::Run(const char* const* input_names, const Value* input_values,
+                                              size_t input_count, const char* const* output_names,
+                                              size_t output_count) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  std::vector<Value> output_values;
+  output_values.reserve(output_count);
+  for (size_t i = 0; i < output_count; i++)
+    output_values.emplace_back(nullptr);
+
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values.data());
+  ThrowOnError(GetApi().RequestBatcherRun(p_, input_names, ort_input_values, input_count, output_names, output_count,
+                                          ort_output_values));
+  return output_values;
+}
+
 inline ThreadingOptions::ThreadingOptions() {
   ThrowOnError(GetApi().CreateThreadingOptions(&p_));
 }
@@ -928,6 +957,13 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetAggregateProfileAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetAggregateProfile(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -998,6 +1034,16 @@ inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* al
   return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
 }
 
+template <typename T>
+inline void SessionImpl<T>::HintThreadPoolActivity(OrtThreadPoolActivityHint hint, int64_t burst_duration_us) {
+  ThrowOnError(GetApi().SessionHintThreadPoolActivity(this->p_, hint, burst_duration_us));
+}
+
+template <typename T>
+inline void SessionImpl<T>::ResetAggregateProfile() {
+  ThrowOnError(GetApi().SessionResetAggregateProfile(this->p_));
+}
+
 }  // namespace detail
 
 inline SessionOptions::SessionOptions() {
@@ -97,12 +97,30 @@ static const char* const kOrtSessionOptionsMemoryOptimizerProbeLevel = "optimiza
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Serve initializers stored in external data files and consumed on CPU directly from read-only memory mappings of
+// those files, without planning or allocating initializer memory for them. Processes that load the same model share
+// the mapped pages. Kernels can still pre-pack these initializers. The number of bytes that were mapped, or copied
+// where the file could not be mapped, is logged.
+// Option values:
+// - "0": disabled. [DEFAULT]
+// - "1": enabled.
+static const char* const kOrtSessionOptionsUseMappedExternalInitializers = "session.use_mapped_external_initializers";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure whether the inter_op/intra_op threads adapt the time they spin before blocking to the observed gaps
+// between work items, instead of spinning a fixed number of times. Threads then spin long enough to cover gaps that
+// are shorter than the cost of blocking and waking up, and only briefly when the gaps are longer, e.g. between
+// infrequent requests. Only applies if spinning is allowed for the thread pool.
+// "0": default, fixed spin count
+// "1": adaptive spinning
+static const char* const kOrtSessionOptionsConfigInterOpAdaptiveSpinning = "session.inter_op.adaptive_spinning";
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -200,6 +218,38 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// Create a separate intra-op thread pool for each NUMA node, with its threads restricted to the processors of the
+// node. Each Run() uses the pool of the node that the calling thread is running on, so callers should pin their
+// threads to a node. intra_op_num_threads is the size of each pool and defaults to the number of physical cores of
+// the node. If session.intra_op_thread_affinities is set, each thread goes to the pool of the node that contains the
+// first processor in its affinity, and intra_op_num_threads must be the number of threads per node plus one.
+// Only applies to per-session thread pools, and has no effect if the NUMA topology is unknown or has a single node.
+// "0": default, a single intra-op thread pool
+// "1": a thread pool per NUMA node
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAware = "session.intra_op.numa_aware";
+
+// With session.intra_op.numa_aware, CPU initializers of at least this many bytes are copied to memory local to each
+// NUMA node, and runs from a node use its copies. Pre-packed weights are not copied.
+// "0" disables the copies. Default is "1048576".
+static const char* const kOrtSessionOptionsConfigNumaReplicateInitializersMinBytes =
+    "session.numa.replicate_initializers_min_bytes";
+
+// Aggregate per op type statistics of the kernels run by the session: number of calls, total/min/max time, size of
+// the outputs, and the time spent distributing work to the intra-op thread pool. Unlike the profiling enabled by
+// SessionOptions::enable_profiling, no event is recorded per node, so it can be left on in production.
+// The statistics are retrieved with SessionGetAggregateProfile and cleared with SessionResetAggregateProfile.
+// "0": default, disabled
+// "1": enabled
+static const char* const kOrtSessionOptionsConfigAggregateProfiling = "session.profiling.aggregate";
+
+// With session.profiling.aggregate, also collect the CPU cycles and cache misses of the thread running each kernel.
+// Only supported on Linux, where perf_event access must be permitted. The counters are reported as 0 otherwise.
+// The "hardware_counters" field of SessionGetAggregateProfile reports whether they were collected.
+// "0": default, disabled
+// "1": enabled
+static const char* const kOrtSessionOptionsConfigAggregateProfilingHardwareCounters =
+    "session.profiling.aggregate_hardware_counters";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
@@ -235,3 +285,68 @@ static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFil
 // Use this config to control the minimum size of the initializer when externalizing it during serialization
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes =
     "session.optimized_model_external_initializers_min_size_in_bytes";
+
+// Path of a file used to persist pre-packed weights across sessions and processes.
+// When set, pre-packed weights found in the file are memory mapped and handed to kernels that support them so that
+// PrePack() is skipped. Weights that had to be pre-packed are written back to the file once the session is
+// initialized. Entries are keyed by op type, node attributes and the weight's contents, and a file written by a
+// different ORT version or for a CPU with different instruction set extensions is ignored.
+// The file is specific to the host it was written on and should not be distributed with the model.
+static const char* const kOrtSessionOptionsPrepackedWeightsCacheFile = "session.prepacked_weights_cache_file";
+
+// Comma separated list of ascending dim values used to bucket input shapes when caching memory patterns, e.g.
+// "16,32,64,128,256,512". Each input dim is rounded up to the first value that is >= the dim, so inputs whose shapes
+// fall in the same buckets share one memory pattern instead of generating a new one for every distinct shape.
+// The pattern of a bucket grows to fit the largest tensors seen in it, at the cost of tracing the allocations of the
+// runs that use it. Dims larger than the last value are used as is. Not applied in training builds.
+// Default is "" (exact input shapes are used).
+static const char* const kOrtSessionOptionsMemoryPatternDimBuckets = "session.mem_pattern_dim_buckets";
+
+// Maximum number of memory patterns cached per graph. The least recently used pattern is evicted when it is exceeded.
+// Default is "0" (unbounded).
+static const char* const kOrtSessionOptionsMemoryPatternCacheCapacity = "session.mem_pattern_cache_capacity";
+
+// Input shapes to generate memory patterns for when the session is initialized, so that the first requests for
+// those shapes do not pay for the pattern generation. Shape sets are separated by ';', the inputs of a set by ',',
+// and each input is specified as <name>:<dims separated by 'x'>. Inputs not listed are fed with their shape from
+// the model, which must then be fully specified. e.g. "input_ids:1x128,attention_mask:1x128;input_ids:1x256,..."
+// When dim buckets are used, the shapes should use the upper bound of each bucket.
+// Requires memory pattern to be enabled. Default is "" (no prewarming).
+static const char* const kOrtSessionOptionsMemoryPatternPrewarmShapes = "session.mem_pattern_prewarm_shapes";
+
+// Maximum size in bytes of a per-run region used to allocate the intermediate CPU tensors of a run.
+// When set, each Run() gets a region from which intermediate tensors that are not graph outputs are allocated by
+// bumping an offset, and which is released in one step once the run completes. Regions are reused by later runs and
+// grow to fit the demand of previous runs up to this size. Tensors that don't fit fall back to the CPU allocator.
+// As memory is not reused within a run, a region needs to fit the total size of the intermediate tensors rather than
+// the peak size, so this is intended for small models served at a high rate.
+// Tensors covered by a memory pattern are allocated from the memory pattern buffer instead.
+// Default is "0" (disabled).
+static const char* const kOrtSessionOptionsRunBumpAllocatorMaxBytes = "session.run_bump_allocator_max_bytes";
+
+// Enable TunableOp for the CPU EP. When enabled, kernels that support it (currently the float MatMul and Gemm) use
+// MLAS blocking and threading parameters found by tuning for each shape, ISA and thread count, if a tuning result
+// is available. Tuning results are loaded from "session.tuning_results_file" or the model, or produced by tuning.
+// Option values:
+// - "0": disabled. [DEFAULT]
+// - "1": enabled.
+static const char* const kOrtSessionOptionsCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+
+// Enable tuning for the CPU EP TunableOp. A shape without a tuning result is tuned on its first run by timing the
+// candidate parameters, which slows down that run. Requires "session.cpu_tunable_op_enable" to be "1".
+// Option values:
+// - "0": disabled. [DEFAULT]
+// - "1": enabled.
+static const char* const kOrtSessionOptionsCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+
+// Maximum time in milliseconds spent timing each candidate when tuning a shape for the CPU EP TunableOp.
+// Default is "0" (no limit other than the number of tuning iterations).
+static const char* const kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
+
+// Path of a JSON file with tuning results to load when the session is initialized, in the format returned by
+// InferenceSession::GetTuningResults(), i.e. a list of {"ep": ..., "validators": {...}, "results": {...}}.
+// TunableOp is enabled for each EP whose results are loaded. Results that fail validation, e.g. because they were
+// produced with a different ORT version or on a CPU with a different instruction set, are ignored with a warning.
+// Default is "" (no file).
+static const char* const kOrtSessionOptionsTuningResultsFile = "session.tuning_results_file";
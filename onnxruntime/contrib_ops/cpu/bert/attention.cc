@@ -5,6 +5,7 @@
 #include "attention_helper.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/mlas/inc/mlas_q4.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/common/safeint.h"
@@ -16,6 +17,9 @@ using onnxruntime::concurrency::ThreadPool;
 namespace onnxruntime {
 namespace contrib {
 
+// Block quantization of the prepacked weights when attention::kCpuAttentionQ4Weights is set.
+constexpr MLAS_BLK_QUANT_TYPE kQ4WeightsType = BlkQ4Sym;
+
 static void FreePackedWeights(gsl::span<IAllocatorUniquePtr<void>> array, size_t array_size) {
   for (size_t i = 0; i < array_size; i++) {
     array[i].reset();
@@ -42,9 +46,21 @@ class Attention : public OpKernel, public AttentionCPUBase {
                                size_t input_hidden_size, const T* weights_data,
                                size_t weight_matrix_col_size, PrePackedWeights* prepacked_weights);
 
+  void ComputeQkvWithQ4Weights(const T* input_data, const T* bias_data, T* const QKV[3], const int qkv_head_size[3],
+                               int batch_size, int sequence_length, int input_hidden_size, int hidden_size,
+                               AllocatorPtr allocator, ThreadPool* tp) const;
+
+  // Format of the prepacked weights.
+  enum class PackedWeightsFormat {
+    kFloat,        // packed by MlasGemmPackB
+    kQ4,           // quantized by MlasQ4GemmPackB, multiplied with the fp32 input
+    kQ4Int8Input,  // quantized by MlasQ4GemmPackB, multiplied with the input quantized to int8 blocks
+  };
+
   std::array<IAllocatorUniquePtr<void>, 3> packed_weights_;
   size_t packed_weights_size_[3] = {0, 0, 0};
   bool is_prepack_ = false;
+  PackedWeightsFormat packed_weights_format_ = PackedWeightsFormat::kFloat;
   TensorShape weight_shape_;
 };
 
@@ -61,6 +77,11 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
 
 template <typename T>
 Attention<T>::Attention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info, false) {
+  const int q4_weights = ParseEnvironmentVariableWithDefault<int>(attention::kCpuAttentionQ4Weights, 0);
+  if (q4_weights != 0 && MlasQ4GemmPackBSize(kQ4WeightsType, 1, 1) != 0) {
+    const bool int8_input = q4_weights == 2 && MlasQ80BlkQuantSize(kQ4WeightsType, 1, 1) != 0;
+    packed_weights_format_ = int8_input ? PackedWeightsFormat::kQ4Int8Input : PackedWeightsFormat::kQ4;
+  }
 }
 
 template <typename T>
@@ -71,7 +92,9 @@ bool Attention<T>::IsPackWeightsSuccessful(int qkv_index,
                                            const T* weights_data,
                                            size_t weight_matrix_col_size,
                                            /*out*/ PrePackedWeights* prepacked_weights) {
-  size_t packb_size = MlasGemmPackBSize(head_size, input_hidden_size);
+  const bool q4_weights = packed_weights_format_ != PackedWeightsFormat::kFloat;
+  size_t packb_size = q4_weights ? MlasQ4GemmPackBSize(kQ4WeightsType, head_size, input_hidden_size)
+                                 : MlasGemmPackBSize(head_size, input_hidden_size);
   if (packb_size == 0) {
     return false;
   }
@@ -87,7 +110,13 @@ bool Attention<T>::IsPackWeightsSuccessful(int qkv_index,
   memset(packed_weights_data, 0, packed_weights_data_size);
 
   for (size_t i = 0; i < loop_len; i++) {
-    MlasGemmPackB(CblasNoTrans, head_size, input_hidden_size, weights_data, weight_matrix_col_size, packed_weights_data);
+    if (q4_weights) {
+      MlasQ4GemmPackB(kQ4WeightsType, packed_weights_data, weights_data, head_size, input_hidden_size,
+                      weight_matrix_col_size);
+    } else {
+      MlasGemmPackB(CblasNoTrans, head_size, input_hidden_size, weights_data, weight_matrix_col_size,
+                    packed_weights_data);
+    }
     packed_weights_data += packb_size;
     weights_data += head_size;
   }
@@ -190,6 +219,68 @@ Status Attention<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pre
   return Status::OK();
 }
 
+template <typename T>
+void Attention<T>::ComputeQkvWithQ4Weights(const T* input_data, const T* bias_data, T* const QKV[3],
+                                           const int qkv_head_size[3], int batch_size, int sequence_length,
+                                           int input_hidden_size, int hidden_size, AllocatorPtr allocator,
+                                           ThreadPool* tp) const {
+  // The 4-bit GEMM adds the bias and writes each head of each batch directly into its S x H_t slice of
+  // QKV[qkv_index] (BxNxSxH_t), so the bias broadcast of the fp32 path is not needed.
+  const size_t M = narrow<size_t>(sequence_length);
+  const size_t K = narrow<size_t>(input_hidden_size);
+  const size_t num_heads = narrow<size_t>(num_heads_);
+  const size_t loop_len = narrow<size_t>(batch_size) * num_heads;
+
+  // The input is quantized once and shared by the GEMMs of all heads.
+  IAllocatorUniquePtr<void> quantized_input;
+  size_t quantized_input_size = 0;
+  if (packed_weights_format_ == PackedWeightsFormat::kQ4Int8Input) {
+    quantized_input_size = MlasQ80BlkQuantSize(kQ4WeightsType, M, K);
+    quantized_input = IAllocator::MakeUniquePtr<void>(allocator, SafeInt<size_t>(quantized_input_size) * batch_size);
+    MlasQ80BlkQuant(kQ4WeightsType, quantized_input.get(), input_data, M * batch_size, K, K, tp);
+  }
+
+  std::vector<MLAS_Q4_GEMM_DATA_PARAMS> gemm_params(quantized_input ? 0 : loop_len);
+  std::vector<MLAS_Q8Q4_GEMM_DATA_PARAMS> q8_gemm_params(quantized_input ? loop_len : 0);
+
+  for (int qkv_index = 0; qkv_index < 3; qkv_index++) {
+    const size_t head_size = narrow<size_t>(qkv_head_size[qkv_index]);
+    const auto* packed_weights = static_cast<const uint8_t*>(packed_weights_[qkv_index].get());
+
+    for (size_t i = 0; i < loop_len; i++) {
+      const size_t batch_index = i / num_heads;
+      const size_t head_index = i % num_heads;
+
+      const T* bias = bias_data + qkv_index * hidden_size + head_index * head_size;
+      const void* weights = packed_weights + packed_weights_size_[qkv_index] * head_index;
+      T* qkv_dest = QKV[qkv_index] + i * M * head_size;
+
+      if (quantized_input) {
+        auto& params = q8_gemm_params[i];
+        params.A = static_cast<const uint8_t*>(quantized_input.get()) + quantized_input_size * batch_index;
+        params.B = weights;
+        params.Bias = bias;
+        params.C = qkv_dest;
+        params.ldc = head_size;
+      } else {
+        auto& params = gemm_params[i];
+        params.A = input_data + batch_index * M * K;
+        params.lda = K;
+        params.B = weights;
+        params.Bias = bias;
+        params.C = qkv_dest;
+        params.ldc = head_size;
+      }
+    }
+
+    if (quantized_input) {
+      MlasQ8Q4GemmBatch(kQ4WeightsType, M, head_size, K, loop_len, q8_gemm_params.data(), tp);
+    } else {
+      MlasQ4GemmBatch(kQ4WeightsType, M, head_size, K, loop_len, gemm_params.data(), tp);
+    }
+  }
+}
+
 template <typename T>
 Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
@@ -232,7 +323,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   // Hidden dimension of input could be larger than that of Q, K and V when model is pruned.
   int qkv_hidden_size = (parameters.hidden_size + parameters.hidden_size + parameters.v_hidden_size);
   auto gemm_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * qkv_hidden_size * element_size);
-  BufferUniquePtr gemm_buffer(gemm_data, BufferDeleter(std::move(allocator)));
+  BufferUniquePtr gemm_buffer(gemm_data, BufferDeleter(allocator));
 
   auto Q = reinterpret_cast<T*>(gemm_data);
   auto K = Q + narrow<size_t>(batch_size) * sequence_length * parameters.hidden_size;
@@ -241,7 +332,10 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   T* QKV[3] = {Q, K, V};
   const int qkv_head_size[3] = {parameters.head_size, parameters.head_size, parameters.v_head_size};
 
-  {
+  if (is_prepack_ && packed_weights_format_ != PackedWeightsFormat::kFloat) {
+    ComputeQkvWithQ4Weights(input->Data<T>(), bias->Data<T>(), QKV, qkv_head_size, batch_size, sequence_length,
+                            input_hidden_size, parameters.hidden_size, allocator, tp);
+  } else {
     const int loop_len = 3 * batch_size * num_heads_;
     const auto* input_data = input->Data<T>();
     const auto* weights_data = weights ? weights->Data<T>() : nullptr;
@@ -131,6 +131,20 @@ constexpr const char* kMinSeqLenForFlashAttentionPackedQKV = "ORT_MIN_SEQ_LEN_FL
 // Default value for the above setting.
 constexpr int kDefaultMinSeqLenForFlashAttentionPackedQKV = 513;
 
+// Minimum total sequence length to use the tiled attention of MLAS in the CPU kernels. Shorter sequences use
+// one GEMM per head for the scores, which is faster when the scores fit in the cache.
+constexpr const char* kMinSeqLenForCpuFlashAttention = "ORT_MIN_SEQ_LEN_CPU_FLASH_ATTENTION";
+// Default value for the above setting.
+constexpr int kDefaultMinSeqLenForCpuFlashAttention = 256;
+
+// Environment variable to enable or disable the tiled attention of MLAS in the CPU kernels. Default is 0 (enabled).
+constexpr const char* kDisableCpuFlashAttention = "ORT_DISABLE_CPU_FLASH_ATTENTION";
+
+// Environment variable to quantize the prepacked weights of the CPU Attention QKV projection to 4-bit blocks.
+// 0 keeps fp32 weights, 1 multiplies the fp32 input with the 4-bit weights, and 2 also quantizes the input to int8
+// blocks. Default is 0. Platforms without the 4-bit GEMM of MLAS keep fp32 weights.
+constexpr const char* kCpuAttentionQ4Weights = "ORT_CPU_ATTENTION_Q4_WEIGHTS";
+
 }  // namespace attention
 
 }  // namespace contrib
@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/env_var_utils.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -16,7 +17,11 @@ namespace contrib {
 class AttentionCPUBase : public AttentionBase {
  protected:
   AttentionCPUBase(const OpKernelInfo& info, bool require_same_hidden_size)
-      : AttentionBase(info, require_same_hidden_size) {}
+      : AttentionBase(info, require_same_hidden_size) {
+    disable_flash_attention_ = ParseEnvironmentVariableWithDefault<bool>(attention::kDisableCpuFlashAttention, false);
+    min_seq_len_for_flash_attention_ = ParseEnvironmentVariableWithDefault<int>(
+        attention::kMinSeqLenForCpuFlashAttention, attention::kDefaultMinSeqLenForCpuFlashAttention);
+  }
 
   template <typename T>
   Status ApplyAttention(const T* Q,                            // Q data with shape BxNxSxH
@@ -53,13 +58,36 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
+    bool causal = (is_unidirectional_ && sequence_length > 1);
+
+    if constexpr (std::is_same_v<T, float>) {
+      // The tiled attention needs the past and new keys and values in one buffer, so the past state is only
+      // supported along with the present state. The packed present state has the V head size for both halves, so
+      // it is only used when the K head size is the same. 3D/4D masks and the relative position bias have one value
+      // per query and key, which defeats the purpose of not materializing the attention probs.
+      const bool has_present = present != nullptr || (present_key != nullptr && present_value != nullptr);
+      const bool has_partial_present = present == nullptr && (present_key != nullptr || present_value != nullptr);
+      const bool has_packed_present_of_other_head_size =
+          present != nullptr && qk_head_size != 0 && qk_head_size != v_head_size;
+      if (!disable_flash_attention_ &&
+          total_sequence_length >= min_seq_len_for_flash_attention_ &&
+          relative_position_bias == nullptr &&
+          (mask_index == nullptr || mask_index->Shape().NumDimensions() <= 2) &&
+          !has_partial_present && !has_packed_present_of_other_head_size &&
+          (past_sequence_length == 0 || has_present)) {
+        return ApplyFlashAttention(Q, K, V, mask_index, past, past_key, past_value, output, present,
+                                   present_key, present_value, causal, batch_size, sequence_length,
+                                   kv_sequence_length, past_sequence_length,
+                                   qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size,
+                                   allocator, tp);
+      }
+    }
+
     // Compute the attention score.
     size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
     auto attention_probs = allocator->Alloc(bytes);
     BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
 
-    bool causal = (is_unidirectional_ && sequence_length > 1);
-
     void* mask_data = nullptr;
     if (mask_index != nullptr || causal) {
       size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
@@ -90,13 +118,8 @@ class AttentionCPUBase : public AttentionBase {
                              qk_head_size == 0 ? v_head_size : qk_head_size, past_data, past_key_data,
                              present_data, present_key_data, tp, relative_position_bias_data);
 
-    // Compute the attentionScore * Value: out_tmp(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-    auto out_tmp_data =
-        allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * v_head_size * sizeof(T));
-    BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(std::move(allocator)));
-
-    ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(out_tmp_data),
-                            static_cast<T*>(attention_probs), V,
+    // Compute the attentionScore * Value: out(B, S, N, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
+    ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(attention_probs), V,
                             batch_size, sequence_length, kv_sequence_length, past_sequence_length,
                             v_head_size, v_hidden_size, past_data, past_value_data,
                             present_data, present_value_data, tp);
@@ -105,6 +128,99 @@ class AttentionCPUBase : public AttentionBase {
   }
 
  private:
+  bool disable_flash_attention_;
+  int min_seq_len_for_flash_attention_;
+
+  // Computes the attention with MlasFlashAttention, which processes blocks of queries and keys with an online
+  // softmax instead of materializing attention_probs(B, N, S, T). Only used for float.
+  Status ApplyFlashAttention(const float* Q,              // Q data with shape BxNxSxH
+                             const float* K,              // K data with shape BxNxLxH
+                             const float* V,              // V value with size BxNxLxH_v
+                             const Tensor* mask_index,    // 1D or 2D mask index. nullptr if no mask
+                             const Tensor* past,          // past state
+                             const Tensor* past_key,      // past K input tensor (if not using past state)
+                             const Tensor* past_value,    // past V input tensor (if not using past state)
+                             Tensor* output,              // output tensor
+                             Tensor* present,             // present state
+                             Tensor* present_key,         // present K output tensor (if separating present KV)
+                             Tensor* present_value,       // present V output tensor (if separating present KV)
+                             bool causal,                 // has causal (unidirectional) mask
+                             int batch_size,              // batch size (B)
+                             int sequence_length,         // sequence length of Q (S)
+                             int kv_sequence_length,      // sequence length of K or V (L)
+                             int past_sequence_length,    // sequence length of past state (P)
+                             int qk_head_size,            // head size of Q or K (H)
+                             int v_head_size,             // head size of V (H_v)
+                             AllocatorPtr allocator,      // allocator for the mask
+                             ThreadPool* tp) const {
+    const int total_sequence_length = past_sequence_length + kv_sequence_length;  // T = P + L
+    const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
+
+    // Concatenate past_K and K, past_V and V into the present state: (BxNx)PxH, (BxNx)LxH -> (BxNx)TxH
+    const float* k = K;
+    const float* v = V;
+    if (present != nullptr || present_key != nullptr) {
+      float* present_k = present != nullptr ? present->MutableData<float>() : present_key->MutableData<float>();
+      float* present_v = present != nullptr ? present_k + loop_len * total_sequence_length * qk_head_size
+                                            : present_value->MutableData<float>();
+      const float* past_k = nullptr;
+      const float* past_v = nullptr;
+      if (past != nullptr) {
+        past_k = past->Data<float>();
+        past_v = past_k + loop_len * past_sequence_length * qk_head_size;
+      } else if (past_key != nullptr) {
+        past_k = past_key->Data<float>();
+        past_v = past_value->Data<float>();
+      }
+
+      const size_t past_k_chunk_length = static_cast<size_t>(past_sequence_length) * qk_head_size;
+      const size_t present_k_chunk_length = static_cast<size_t>(total_sequence_length) * qk_head_size;
+      const size_t past_v_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+      const size_t present_v_chunk_length = static_cast<size_t>(total_sequence_length) * v_head_size;
+      const double cost = static_cast<double>(total_sequence_length) * (qk_head_size + v_head_size);
+
+      ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          ConcatStateChunk(past_k, K + (present_k_chunk_length - past_k_chunk_length) * i, present_k,
+                           past_k_chunk_length, present_k_chunk_length, i);
+          ConcatStateChunk(past_v, V + (present_v_chunk_length - past_v_chunk_length) * i, present_v,
+                           past_v_chunk_length, present_v_chunk_length, i);
+        }
+      });
+
+      k = present_k;
+      v = present_v;
+    }
+
+    // The mask is one value per key: (B)xT
+    void* key_mask_data = nullptr;
+    if (mask_index != nullptr) {
+      key_mask_data = allocator->Alloc(SafeInt<size_t>(batch_size) * total_sequence_length * sizeof(float));
+      PrepareKeyMask(mask_index->Data<int32_t>(), mask_index->Shape().GetDims(), static_cast<float*>(key_mask_data),
+                     batch_size, total_sequence_length, mask_filter_value_);
+    }
+    BufferUniquePtr key_mask_buffer(key_mask_data, BufferDeleter(std::move(allocator)));
+
+    MLAS_FLASH_ATTENTION_PARAMS<float> params;
+    params.Query = Q;
+    params.Key = k;
+    params.Value = v;
+    params.KeyMask = static_cast<const float*>(key_mask_data);
+    params.Output = output->MutableData<float>();
+    params.BatchSize = static_cast<size_t>(batch_size);
+    params.NumHeads = static_cast<size_t>(num_heads_);
+    params.SequenceLength = static_cast<size_t>(sequence_length);
+    params.TotalSequenceLength = static_cast<size_t>(total_sequence_length);
+    params.QkHeadSize = static_cast<size_t>(qk_head_size);
+    params.VHeadSize = static_cast<size_t>(v_head_size);
+    params.Scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(qk_head_size)) : scale_;
+    params.Causal = causal;
+
+    MlasFlashAttention(params, tp);
+
+    return Status::OK();
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
@@ -135,71 +251,84 @@ class AttentionCPUBase : public AttentionBase {
     const size_t kv_input_chunk_length = static_cast<size_t>(kv_sequence_length) * head_size;  // L x H
     const size_t present_chunk_length = past_chunk_length + kv_input_chunk_length;             // T x H
 
-    {
-      // mask_data is nullptr when mask_index is nullptr and not unidirectional, otherwise its shape is BxSxT
-      if (mask_data != nullptr) {
-        PrepareMask(mask_index, mask_index_dims, mask_data,
-                    causal, batch_size, sequence_length, past_sequence_length, mask_filter_value_);
-      } else {  // no any mask
-        const int memset_loop_len = batch_size * num_heads_;
-        const double memset_cost = static_cast<double>(sequence_length) * total_sequence_length;
-
-        ThreadPool::TryParallelFor(tp, memset_loop_len, memset_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-          for (std::ptrdiff_t i = begin; i != end; ++i) {
-            const int output_offset = static_cast<int>(i) * sequence_length * total_sequence_length;
-            T* output = attention_probs + output_offset;
-            memset(output, 0, static_cast<size_t>(sequence_length) * total_sequence_length * sizeof(T));
-          }
-        });
-      }
+    const size_t probs_chunk_length = static_cast<size_t>(sequence_length) * total_sequence_length;  // S x T
 
-      const int loop_len = batch_size * num_heads_;
-      const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    // mask_data is nullptr when mask_index is nullptr and not unidirectional, otherwise its shape is BxSxT
+    if (mask_data != nullptr) {
+      PrepareMask(mask_index, mask_index_dims, mask_data,
+                  causal, batch_size, sequence_length, past_sequence_length, mask_filter_value_);
+    }
+
+    const int loop_len = batch_size * num_heads_;
+    const bool has_addend = mask_data != nullptr || relative_position_bias_data != nullptr;
 
-      // The cost of Gemm
-      const double cost = static_cast<double>(head_size) * sequence_length * total_sequence_length;
+    // Initialize attention_probs with the mask and the relative position bias, and concatenate past_K and K, so
+    // that the GEMMs of all the heads run as one group afterwards.
+    if (has_addend || present != nullptr || present_key != nullptr) {
+      const double cost = static_cast<double>(probs_chunk_length) + static_cast<double>(present_chunk_length);
 
       ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
         for (std::ptrdiff_t i = begin; i != end; ++i) {
           const int batch_index = static_cast<int>(i) / num_heads_;
-
-          const int output_offset = static_cast<int>(i) * sequence_length * total_sequence_length;
-          const int mask_offset = batch_index * sequence_length * total_sequence_length;
-          T* output = attention_probs + output_offset;
+          T* output = attention_probs + probs_chunk_length * i;
+          const T* relative_position_bias = relative_position_bias_data != nullptr
+                                                ? relative_position_bias_data + probs_chunk_length * i
+                                                : nullptr;
 
           // Broadcast mask data: (Bx)SxT -> (BxNx)SxT
           if (mask_data != nullptr) {
-            memcpy(output,
-                   mask_data + mask_offset,
-                   static_cast<size_t>(sequence_length) * total_sequence_length * sizeof(T));
+            memcpy(output, mask_data + probs_chunk_length * batch_index, probs_chunk_length * sizeof(T));
+            if (relative_position_bias != nullptr) {
+              for (size_t j = 0; j < probs_chunk_length; j++) {
+                output[j] += relative_position_bias[j];
+              }
+            }
+          } else if (relative_position_bias != nullptr) {
+            memcpy(output, relative_position_bias, probs_chunk_length * sizeof(T));
           }
 
-          const T* k = K + kv_input_chunk_length * i;
+          // Concatenate past_K and K : (BxNx)PxH, (BxNx)LxH -> (BxNx)TxH
           if (nullptr != present) {
-            // Concatenate past_K and K : (BxNx)PxH, (BxNx)LxH -> (BxNx)TxH
-            k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
+            ConcatStateChunk(past, K + kv_input_chunk_length * i, present, past_chunk_length, present_chunk_length, i);
           } else if (nullptr != present_key) {
-            k = ConcatStateChunk(past_key, k, present_key, past_chunk_length, present_chunk_length, i);
-          }
-
-          // Compute Q*K' + AttentionMask
-          //                     original                 transposed             each iteration
-          // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
-          // B: K'               (B x N x) T x H          (B x N x) H x T        H x T
-          // C: attention_probs  (B x N x) S x T          (B x N x) S x T        S x T
-          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_sequence_length, head_size, alpha,
-                                    Q + q_input_chunk_length * i, k, 1.0,
-                                    output, nullptr);
-
-          if (relative_position_bias_data != nullptr) {
-            for (int j = 0; j < sequence_length * total_sequence_length; j++) {
-              output[j] += relative_position_bias_data[output_offset + j];
-            }
+            ConcatStateChunk(past_key, K + kv_input_chunk_length * i, present_key, past_chunk_length,
+                             present_chunk_length, i);
           }
         }
       });
     }
 
+    // Compute Q*K' + AttentionMask
+    //                     original                 transposed             each iteration
+    // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
+    // B: K'               (B x N x) T x H          (B x N x) H x T        H x T
+    // C: attention_probs  (B x N x) S x T          (B x N x) S x T        S x T
+    {
+      const bool has_present_key = present != nullptr || present_key != nullptr;
+      const T* k = present != nullptr ? present : (present_key != nullptr ? present_key : K);
+      const size_t k_chunk_length = has_present_key ? present_chunk_length : kv_input_chunk_length;
+      const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+      std::vector<MLAS_SGEMM_GROUPED_PARAMS> gemm_params(static_cast<size_t>(loop_len));
+      for (size_t i = 0; i < gemm_params.size(); i++) {
+        auto& params = gemm_params[i];
+        params.TransB = CblasTrans;
+        params.M = static_cast<size_t>(sequence_length);
+        params.N = static_cast<size_t>(total_sequence_length);
+        params.K = static_cast<size_t>(head_size);
+        params.Data.A = Q + q_input_chunk_length * i;
+        params.Data.lda = static_cast<size_t>(head_size);
+        params.Data.B = k + k_chunk_length * i;
+        params.Data.ldb = static_cast<size_t>(head_size);
+        params.Data.C = attention_probs + probs_chunk_length * i;
+        params.Data.ldc = static_cast<size_t>(total_sequence_length);
+        params.Data.alpha = alpha;
+        params.Data.beta = has_addend ? 1.0f : 0.0f;
+      }
+
+      MlasGemmGrouped(gemm_params.data(), gemm_params.size(), tp);
+    }
+
     // attention_probs(B, N, S, T) = Softmax(attention_probs)
     {
       const int N = batch_size * num_heads_ * sequence_length;
@@ -210,7 +339,6 @@ class AttentionCPUBase : public AttentionBase {
 
   template <typename T>
   void ComputeVxAttentionScore(T* output,                 // buffer for the result with size BxSxNxH_v
-                               T* tmp_buffer,             // buffer for temp use with size is BxNxSxH_v
                                const T* attention_probs,  // Attention probs with size BxNxSxT
                                const T* V,                // V value with size BxNxLxH_v
                                int batch_size,            // batch size
@@ -226,9 +354,9 @@ class AttentionCPUBase : public AttentionBase {
                                ThreadPool* tp) const {
     const int total_sequence_length = past_sequence_length + kv_sequence_length;                   // T = P + L
     const ptrdiff_t past_chunk_length = SafeInt<ptrdiff_t>(past_sequence_length) * v_head_size;    // P x H_v
-    const ptrdiff_t q_input_chunk_length = SafeInt<ptrdiff_t>(sequence_length) * v_head_size;      // S x H_v
     const ptrdiff_t kv_input_chunk_length = SafeInt<ptrdiff_t>(kv_sequence_length) * v_head_size;  // L x H_v
     const ptrdiff_t present_chunk_length = past_chunk_length + kv_input_chunk_length;              // T x H_v
+    const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
 
     // Move the pointer of past and present to start of v values.
     if (nullptr != past) {
@@ -238,39 +366,48 @@ class AttentionCPUBase : public AttentionBase {
       present += SafeInt<ptrdiff_t>(batch_size) * num_heads_ * total_sequence_length * v_head_size;
     }
 
-    const double cost =
-        static_cast<double>(sequence_length) * static_cast<double>(v_head_size) * static_cast<double>(sequence_length);
-
-    ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      for (std::ptrdiff_t i = begin; i != end; ++i) {
-        const T* v = V + kv_input_chunk_length * i;
-        if (nullptr != present) {
-          // Concatenate past_V and V: (BxNx)PxH_v, (BxNx)LxH_v -> (BxNx)TxH_v
-          v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
-        } else if (nullptr != present_value) {
-          v = ConcatStateChunk(past_value, v, present_value, past_chunk_length, present_chunk_length, i);
-        }
+    // Concatenate past_V and V: (BxNx)PxH_v, (BxNx)LxH_v -> (BxNx)TxH_v
+    const T* v = V;
+    ptrdiff_t v_chunk_length = kv_input_chunk_length;
+    if (nullptr != present || nullptr != present_value) {
+      T* present_v = nullptr != present ? present : present_value;
+      const T* past_v = nullptr != present ? past : past_value;
+      const double cost = static_cast<double>(present_chunk_length);
 
-        T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + q_input_chunk_length * i;
-        ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
-        math::MatMul<T>(sequence_length, v_head_size, total_sequence_length,
-                        attention_probs + attention_probs_offset,
-                        v, current_tmp_data, nullptr);
-
-        // Transpose: out(B, S, N, H_v) -> out_tmp(B, N, S, H_v)
-        const int batch_index = static_cast<int>(i / num_heads_);
-        const int head_index = static_cast<int>(i % num_heads_);
-        T* src = current_tmp_data;
-        ptrdiff_t dest_offset = (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
-        T* dest = output + dest_offset;
-        const auto bytes_to_copy = SafeInt<size_t>(v_head_size) * sizeof(T);
-        for (int j = 0; j < sequence_length; j++) {
-          memcpy(dest, src, bytes_to_copy);
-          src += v_head_size;
-          dest += v_hidden_size;
+      ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          ConcatStateChunk(past_v, V + kv_input_chunk_length * i, present_v, past_chunk_length, present_chunk_length, i);
         }
-      }
-    });
+      });
+
+      v = present_v;
+      v_chunk_length = present_chunk_length;
+    }
+
+    // out(B, S, N, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v). Each head writes its H_v columns of the
+    // output rows directly, so no BxNxSxH_v buffer needs to be transposed afterwards.
+    std::vector<MLAS_SGEMM_GROUPED_PARAMS> gemm_params(static_cast<size_t>(loop_len));
+    for (ptrdiff_t i = 0; i < loop_len; i++) {
+      const ptrdiff_t batch_index = i / num_heads_;
+      const ptrdiff_t head_index = i % num_heads_;
+
+      const ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
+      const ptrdiff_t output_offset =
+          (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
+
+      auto& params = gemm_params[i];
+      params.M = static_cast<size_t>(sequence_length);
+      params.N = static_cast<size_t>(v_head_size);
+      params.K = static_cast<size_t>(total_sequence_length);
+      params.Data.A = attention_probs + attention_probs_offset;
+      params.Data.lda = static_cast<size_t>(total_sequence_length);
+      params.Data.B = v + v_chunk_length * i;
+      params.Data.ldb = static_cast<size_t>(v_head_size);
+      params.Data.C = output + output_offset;
+      params.Data.ldc = static_cast<size_t>(v_hidden_size);
+    }
+
+    MlasGemmGrouped(gemm_params.data(), gemm_params.size(), tp);
   }
 };
 
@@ -153,6 +153,39 @@ void PrepareMask(const int32_t* mask_index,
   }
 }
 
+// Convert a 1D (B or 2B) or 2D (BxT) mask index to an additive mask per key with shape BxT, which is what
+// PrepareMask broadcasts to every query.
+template <typename T>
+void PrepareKeyMask(const int32_t* mask_index,
+                    gsl::span<const int64_t> mask_index_dims,
+                    T* key_mask,
+                    int batch_size,
+                    int total_sequence_length,
+                    float mask_filter_value) {
+  const bool is_raw_attention_mask = (mask_index_dims.size() == 2);
+  const bool has_mask_start_position = (mask_index_dims.size() == 1 &&
+                                        static_cast<int>(mask_index_dims[0]) == 2 * batch_size);
+
+  for (int b_i = 0; b_i < batch_size; b_i++) {
+    T* p_mask = key_mask + SafeInt<ptrdiff_t>(b_i) * total_sequence_length;
+    if (is_raw_attention_mask) {
+      const int32_t* raw_mask = mask_index + SafeInt<ptrdiff_t>(b_i) * total_sequence_length;
+      for (int m_i = 0; m_i < total_sequence_length; m_i++) {
+        p_mask[m_i] = (raw_mask[m_i] > 0) ? static_cast<T>(0.0f) : static_cast<T>(mask_filter_value);
+      }
+    } else {
+      const int end_position = std::max(mask_index[b_i], 0);
+      const int start_position = has_mask_start_position
+                                     ? std::min(mask_index[b_i + batch_size], total_sequence_length)
+                                     : 0;
+      for (int m_i = 0; m_i < total_sequence_length; m_i++) {
+        p_mask[m_i] = (m_i < start_position || m_i >= end_position) ? static_cast<T>(mask_filter_value)
+                                                                    : static_cast<T>(0.0f);
+      }
+    }
+  }
+}
+
 // Concatenate a past state chunk PxH with input state chunk LxH into present state chunk TxH
 // Returns a pointer to the start of present state chunk.
 template <typename T>
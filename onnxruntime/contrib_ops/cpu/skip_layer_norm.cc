@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -33,6 +34,114 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+template <typename T, bool simplified>
+void ComputeJob(
+    const T* input_data,
+    const T* skip_data,
+    const T* gamma_data,
+    const T* beta_data,
+    const T* bias_data,
+    ptrdiff_t task_idx,
+    int hidden_size,
+    int64_t skip_size,
+    float epsilon,
+    T* output_data,
+    T* skip_input_bias_add_output_data) {
+  auto offset = task_idx * hidden_size;
+
+  const T* p_input = input_data + offset;
+  const T* p_skip = skip_data + (offset % skip_size);
+  T* p_output = output_data + offset;
+  T* p_skip_input_bias_add_output_data = skip_input_bias_add_output_data != nullptr ? skip_input_bias_add_output_data + offset : nullptr;
+
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    T value = p_input[h] + p_skip[h];
+
+    if (nullptr != bias_data) {
+      value += bias_data[h];
+    }
+
+    if (nullptr != p_skip_input_bias_add_output_data) {
+      p_skip_input_bias_add_output_data[h] = value;
+    }
+
+    p_output[h] = value;
+    mean += value;
+    mean_square += value * value;
+  }
+
+  mean = mean / hidden_size;
+  if (simplified) {
+    mean_square = sqrt(mean_square / hidden_size + epsilon);
+  } else {
+    mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon);
+  }
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    if (simplified) {
+      p_output[h] = p_output[h] / mean_square * gamma_data[h];
+    } else if (nullptr == beta_data) {
+      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
+    } else {
+      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+    }
+  }
+}
+
+// float and fp16 rows are normalized by MLAS in fp32, with the skip and bias
+// add fused into the statistics pass.
+template <typename T, bool simplified>
+void MlasComputeJob(
+    const T* input_data,
+    const T* skip_data,
+    const float* gamma_float,
+    const float* beta_float,
+    const float* bias_float,
+    ptrdiff_t task_idx,
+    int hidden_size,
+    int64_t skip_size,
+    float epsilon,
+    T* output_data,
+    T* skip_input_bias_add_output_data) {
+  auto offset = task_idx * hidden_size;
+
+  MLAS_LAYER_NORM_PARAMS<T> params;
+  params.Input = input_data + offset;
+  params.Skip = skip_data + (offset % skip_size);
+  params.SkipBias = bias_float;
+  params.Scale = gamma_float;
+  params.Bias = beta_float;
+  params.Output = output_data + offset;
+  params.SkipOutput = skip_input_bias_add_output_data != nullptr ? skip_input_bias_add_output_data + offset : nullptr;
+  params.Epsilon = epsilon;
+  params.Simplified = simplified;
+
+  MlasLayerNormalization(params, static_cast<size_t>(hidden_size));
+}
+
+// Returns gamma, beta or bias as fp32, converting into `buffer` if needed.
+template <typename T>
+const float* ParamsAsFloat(const T* data, int hidden_size, std::vector<float>& buffer) {
+  if (data == nullptr) {
+    return nullptr;
+  }
+  if constexpr (std::is_same_v<T, float>) {
+    ORT_UNUSED_PARAMETER(hidden_size);
+    ORT_UNUSED_PARAMETER(buffer);
+    return data;
+  } else {
+    buffer.resize(static_cast<size_t>(hidden_size));
+    MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(data), buffer.data(), buffer.size());
+    return buffer.data();
+  }
+}
+}  // namespace
 
 template <typename T, bool simplified>
 SkipLayerNorm<T, simplified>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
@@ -81,53 +190,31 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
 
   const auto& skip_size = skip->Shape().Size();
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-      [&](ptrdiff_t task_idx) {
-        auto offset = task_idx * hidden_size;
-
-        const T* p_input = input_data + offset;
-        const T* p_skip = skip_data + (offset % skip_size);
-        T* p_output = output_data + offset;
-        T* p_skip_input_bias_add_output_data = skip_input_bias_add_output_data != nullptr ? skip_input_bias_add_output_data + offset : nullptr;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < hidden_size; h++) {
-          T value = p_input[h] + p_skip[h];
-
-          if (nullptr != bias_data) {
-            value += bias_data[h];
-          }
-
-          if (nullptr != p_skip_input_bias_add_output_data) {
-            p_skip_input_bias_add_output_data[h] = value;
-          }
-
-          p_output[h] = value;
-          mean += value;
-          mean_square += value * value;
-        }
-
-        mean = mean / hidden_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / hidden_size + epsilon_);
-        } else {
-          mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
-        }
-
-        for (int64_t h = 0; h < hidden_size; h++) {
-          if (simplified) {
-            p_output[h] = p_output[h] / mean_square * gamma_data[h];
-          } else if (nullptr == beta_data) {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
-          } else {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-          }
-        }
-      },
-      0);
+  if constexpr (std::is_same_v<T, double>) {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+        [&](ptrdiff_t task_idx) {
+          ComputeJob<T, simplified>(input_data, skip_data, gamma_data, beta_data, bias_data, task_idx, hidden_size,
+                                    skip_size, epsilon_, output_data, skip_input_bias_add_output_data);
+        },
+        0);
+  } else {
+    std::vector<float> gamma_buffer;
+    std::vector<float> beta_buffer;
+    std::vector<float> bias_buffer;
+    const float* gamma_float = ParamsAsFloat(gamma_data, hidden_size, gamma_buffer);
+    const float* beta_float = ParamsAsFloat(beta_data, hidden_size, beta_buffer);
+    const float* bias_float = ParamsAsFloat(bias_data, hidden_size, bias_buffer);
+
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+        [&](ptrdiff_t task_idx) {
+          MlasComputeJob<T, simplified>(input_data, skip_data, gamma_float, beta_float, bias_float, task_idx,
+                                        hidden_size, skip_size, epsilon_, output_data,
+                                        skip_input_bias_add_output_data);
+        },
+        0);
+  }
 
   return Status::OK();
 }
@@ -0,0 +1,375 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/aggregate_profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ORT_AGGREGATE_PROFILER_PERF_EVENT
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+std::atomic<uint64_t> next_instance_id{1};
+
+// ids of the profilers that haven't been destroyed, so that threads can drop the buffers of destroyed profilers from
+// their thread local state
+OrtMutex& LiveInstancesMutex() {
+  static OrtMutex mutex;
+  return mutex;
+}
+
+std::unordered_set<uint64_t>& LiveInstances() {
+  static std::unordered_set<uint64_t> instances;
+  return instances;
+}
+
+// Add to a counter that only the owning thread writes, without the cost of an atomic read-modify-write.
+inline void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+#ifdef ORT_AGGREGATE_PROFILER_PERF_EVENT
+int OpenPerfEvent(uint64_t config, int group_fd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // calling thread on any processor
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+// perf_event group counting the cycles and cache misses of the thread that opened it
+class PerfEventGroup {
+ public:
+  PerfEventGroup() {
+#ifdef ORT_AGGREGATE_PROFILER_PERF_EVENT
+    cycles_fd_ = OpenPerfEvent(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (cycles_fd_ != -1) {
+      cache_misses_fd_ = OpenPerfEvent(PERF_COUNT_HW_CACHE_MISSES, cycles_fd_);
+      ioctl(cycles_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(cycles_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  ~PerfEventGroup() {
+#ifdef ORT_AGGREGATE_PROFILER_PERF_EVENT
+    if (cache_misses_fd_ != -1) close(cache_misses_fd_);
+    if (cycles_fd_ != -1) close(cycles_fd_);
+#endif
+  }
+
+  bool IsOpen() const {
+#ifdef ORT_AGGREGATE_PROFILER_PERF_EVENT
+    return cycles_fd_ != -1;
+#else
+    return false;
+#endif
+  }
+
+  // Values that are not available are left unchanged.
+  void Read(uint64_t& cycles, uint64_t& cache_misses) const {
+#ifdef ORT_AGGREGATE_PROFILER_PERF_EVENT
+    if (cycles_fd_ == -1) {
+      return;
+    }
+    // layout of a group read: number of events followed by the value of each event
+    std::array<uint64_t, 3> values{};
+    const ssize_t bytes_read = read(cycles_fd_, values.data(), sizeof(values));
+    if (bytes_read >= static_cast<ssize_t>(2 * sizeof(uint64_t))) {
+      cycles = values[1];
+      if (values[0] > 1) {
+        cache_misses = values[2];
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(cycles);
+    ORT_UNUSED_PARAMETER(cache_misses);
+#endif
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerfEventGroup);
+
+ private:
+#ifdef ORT_AGGREGATE_PROFILER_PERF_EVENT
+  int cycles_fd_{-1};
+  int cache_misses_fd_{-1};
+#endif
+};
+
+}  // namespace
+
+struct AggregateProfiler::ThreadBuffer {
+  struct Counters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> min_ns{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> output_bytes{0};
+    std::atomic<uint64_t> threadpool_dispatch_ns{0};
+    std::atomic<uint64_t> cycles{0};
+    std::atomic<uint64_t> cache_misses{0};
+
+    void Clear() {
+      calls.store(0, std::memory_order_relaxed);
+      total_ns.store(0, std::memory_order_relaxed);
+      min_ns.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+      max_ns.store(0, std::memory_order_relaxed);
+      output_bytes.store(0, std::memory_order_relaxed);
+      threadpool_dispatch_ns.store(0, std::memory_order_relaxed);
+      cycles.store(0, std::memory_order_relaxed);
+      cache_misses.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  ThreadBuffer(size_t num_op_types, uint64_t initial_generation, const PerfEventGroup* thread_perf_event_group)
+      : perf_event_group(thread_perf_event_group), generation(initial_generation), counters(num_op_types) {
+  }
+
+  // Read the hardware counters of the owning thread. Values that are not available are left unchanged.
+  void ReadHardwareCounters(uint64_t& cycles, uint64_t& cache_misses) const {
+    if (perf_event_group != nullptr) {
+      perf_event_group->Read(cycles, cache_misses);
+    }
+  }
+
+  // counters of the owning thread, or nullptr if they are not collected. Owned by the thread local state of the
+  // owning thread and only used by that thread.
+  const PerfEventGroup* const perf_event_group;
+  // generation of the profiler the counters belong to. Only the owning thread clears the counters, when it sees
+  // that the profiler was reset, so that a reset never races with an update of the same counter.
+  std::atomic<uint64_t> generation;
+  std::vector<Counters> counters;
+};
+
+namespace {
+
+// State of a thread that records samples. It is destroyed when the thread exits, which closes its perf_event group.
+// The buffers are owned by the profilers so that the samples of the thread are kept after it exits.
+struct ThreadState {
+  struct Entry {
+    uint64_t instance_id;
+    AggregateProfiler::ThreadBuffer* buffer;
+  };
+  std::vector<Entry> buffers;
+
+  // opened the first time the thread records a sample for a profiler with hardware counters
+  std::unique_ptr<PerfEventGroup> perf_event_group;
+  bool perf_event_group_opened{false};
+
+  const PerfEventGroup* GetPerfEventGroup() {
+    if (!perf_event_group_opened) {
+      perf_event_group_opened = true;
+      auto group = std::make_unique<PerfEventGroup>();
+      if (group->IsOpen()) {
+        perf_event_group = std::move(group);
+      }
+    }
+    return perf_event_group.get();
+  }
+};
+
+thread_local ThreadState thread_state;
+
+// Whether perf_event can be used on this system.
+bool ProbeHardwareCounters() {
+  return PerfEventGroup().IsOpen();
+}
+
+}  // namespace
+
+AggregateProfiler::AggregateProfiler(bool enable_hardware_counters)
+    : enable_hardware_counters_(enable_hardware_counters && ProbeHardwareCounters()),
+      hardware_counters_available_(enable_hardware_counters_),
+      instance_id_(next_instance_id.fetch_add(1, std::memory_order_relaxed)) {
+  std::lock_guard<OrtMutex> lock(LiveInstancesMutex());
+  LiveInstances().insert(instance_id_);
+}
+
+AggregateProfiler::~AggregateProfiler() {
+  std::lock_guard<OrtMutex> lock(LiveInstancesMutex());
+  LiveInstances().erase(instance_id_);
+}
+
+size_t AggregateProfiler::RegisterOpType(const std::string& op_type, const std::string& provider) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = std::find(op_types_.cbegin(), op_types_.cend(), std::make_pair(op_type, provider));
+  if (it != op_types_.cend()) {
+    return static_cast<size_t>(it - op_types_.cbegin());
+  }
+
+  ORT_ENFORCE(!op_types_frozen_, "Op type ", op_type, " was registered after the profiler started recording.");
+  op_types_.emplace_back(op_type, provider);
+  return op_types_.size() - 1;
+}
+
+AggregateProfiler::ThreadBuffer& AggregateProfiler::GetThreadBuffer() {
+  // A thread usually runs the nodes of a few sessions at most.
+  for (const auto& entry : thread_state.buffers) {
+    if (entry.instance_id == instance_id_) {
+      return *entry.buffer;
+    }
+  }
+
+  // first sample of the calling thread. drop the buffers of the profilers that were destroyed.
+  {
+    std::lock_guard<OrtMutex> lock(LiveInstancesMutex());
+    const auto& live_instances = LiveInstances();
+    auto& buffers = thread_state.buffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [&live_instances](const ThreadState::Entry& entry) {
+                                   return live_instances.count(entry.instance_id) == 0;
+                                 }),
+                  buffers.end());
+  }
+
+  const PerfEventGroup* perf_event_group = nullptr;
+  if (enable_hardware_counters_) {
+    perf_event_group = thread_state.GetPerfEventGroup();
+    if (perf_event_group == nullptr) {
+      // the counters of this thread are missing from the statistics
+      hardware_counters_available_.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  ThreadBuffer* buffer = nullptr;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    op_types_frozen_ = true;
+    thread_buffers_.push_back(std::make_unique<ThreadBuffer>(op_types_.size(),
+                                                             generation_.load(std::memory_order_relaxed),
+                                                             perf_event_group));
+    buffer = thread_buffers_.back().get();
+  }
+
+  thread_state.buffers.push_back(ThreadState::Entry{instance_id_, buffer});
+  return *buffer;
+}
+
+AggregateProfiler::Sample AggregateProfiler::Begin() {
+  Sample sample;
+  sample.buffer = &GetThreadBuffer();
+  sample.buffer->ReadHardwareCounters(sample.cycles, sample.cache_misses);
+  sample.start = std::chrono::steady_clock::now();
+  return sample;
+}
+
+void AggregateProfiler::End(const Sample& sample, size_t op_type_id, uint64_t output_bytes,
+                            uint64_t threadpool_dispatch_ns) {
+  const auto end = std::chrono::steady_clock::now();
+  ThreadBuffer& buffer = *sample.buffer;
+
+  uint64_t cycles = sample.cycles;
+  uint64_t cache_misses = sample.cache_misses;
+  buffer.ReadHardwareCounters(cycles, cache_misses);
+
+  const uint64_t generation = generation_.load(std::memory_order_acquire);
+  if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+    for (auto& counters : buffer.counters) {
+      counters.Clear();
+    }
+    buffer.generation.store(generation, std::memory_order_release);
+  }
+
+  const auto elapsed_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - sample.start).count());
+
+  auto& counters = buffer.counters[op_type_id];
+  Add(counters.calls, 1);
+  Add(counters.total_ns, elapsed_ns);
+  if (elapsed_ns < counters.min_ns.load(std::memory_order_relaxed)) {
+    counters.min_ns.store(elapsed_ns, std::memory_order_relaxed);
+  }
+  if (elapsed_ns > counters.max_ns.load(std::memory_order_relaxed)) {
+    counters.max_ns.store(elapsed_ns, std::memory_order_relaxed);
+  }
+  Add(counters.output_bytes, output_bytes);
+  Add(counters.threadpool_dispatch_ns, threadpool_dispatch_ns);
+  Add(counters.cycles, cycles - sample.cycles);
+  Add(counters.cache_misses, cache_misses - sample.cache_misses);
+}
+
+std::vector<OpTypeStats> AggregateProfiler::Snapshot() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  const uint64_t generation = generation_.load(std::memory_order_acquire);
+
+  std::vector<OpTypeStats> stats(op_types_.size());
+  for (size_t i = 0; i < op_types_.size(); ++i) {
+    stats[i].op_type = op_types_[i].first;
+    stats[i].provider = op_types_[i].second;
+    stats[i].min_ns = std::numeric_limits<uint64_t>::max();
+  }
+
+  for (const auto& buffer : thread_buffers_) {
+    // a buffer with an older generation hasn't recorded anything since the last reset
+    if (buffer->generation.load(std::memory_order_acquire) != generation) {
+      continue;
+    }
+
+    for (size_t i = 0; i < stats.size(); ++i) {
+      const auto& counters = buffer->counters[i];
+      auto& op_stats = stats[i];
+      op_stats.calls += counters.calls.load(std::memory_order_relaxed);
+      op_stats.total_ns += counters.total_ns.load(std::memory_order_relaxed);
+      op_stats.min_ns = std::min(op_stats.min_ns, counters.min_ns.load(std::memory_order_relaxed));
+      op_stats.max_ns = std::max(op_stats.max_ns, counters.max_ns.load(std::memory_order_relaxed));
+      op_stats.output_bytes += counters.output_bytes.load(std::memory_order_relaxed);
+      op_stats.threadpool_dispatch_ns += counters.threadpool_dispatch_ns.load(std::memory_order_relaxed);
+      op_stats.cycles += counters.cycles.load(std::memory_order_relaxed);
+      op_stats.cache_misses += counters.cache_misses.load(std::memory_order_relaxed);
+    }
+  }
+
+  stats.erase(std::remove_if(stats.begin(), stats.end(),
+                             [](const OpTypeStats& op_stats) { return op_stats.calls == 0; }),
+              stats.end());
+  return stats;
+}
+
+std::string AggregateProfiler::SnapshotJson() const {
+  const auto stats = Snapshot();
+
+  std::ostringstream ss;
+  ss << "{\"hardware_counters\": " << (HardwareCountersAvailable() ? "true" : "false") << ", \"op_types\": [";
+  for (size_t i = 0; i < stats.size(); ++i) {
+    const auto& op_stats = stats[i];
+    ss << (i == 0 ? "" : ", ")
+       << "{\"op_type\": \"" << op_stats.op_type << "\", "
+       << "\"provider\": \"" << op_stats.provider << "\", "
+       << "\"calls\": " << op_stats.calls << ", "
+       << "\"total_ns\": " << op_stats.total_ns << ", "
+       << "\"min_ns\": " << op_stats.min_ns << ", "
+       << "\"max_ns\": " << op_stats.max_ns << ", "
+       << "\"output_bytes\": " << op_stats.output_bytes << ", "
+       << "\"threadpool_dispatch_ns\": " << op_stats.threadpool_dispatch_ns << ", "
+       << "\"cycles\": " << op_stats.cycles << ", "
+       << "\"cache_misses\": " << op_stats.cache_misses << "}";
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+void AggregateProfiler::Reset() {
+  generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+// Statistics of the nodes of one op type and execution provider, aggregated over all the runs of a session.
+struct OpTypeStats {
+  std::string op_type;
+  std::string provider;
+  uint64_t calls = 0;
+  uint64_t total_ns = 0;
+  uint64_t min_ns = 0;
+  uint64_t max_ns = 0;
+  // size of the output tensors of the nodes
+  uint64_t output_bytes = 0;
+  // time the thread running a node spent distributing work to, and waiting for, the intra-op thread pool
+  uint64_t threadpool_dispatch_ns = 0;
+  // hardware counters of the thread running a node. 0 if they are not available.
+  uint64_t cycles = 0;
+  uint64_t cache_misses = 0;
+};
+
+/**
+ * Profiler that aggregates statistics per op type instead of recording an event for each node, so that it can be
+ * left enabled in production.
+ *
+ * Op types are registered before the first run. Each thread that runs nodes records into its own buffer with relaxed
+ * atomic stores, so there is no locking, allocation or formatting on the hot path. Snapshot() sums the buffers of all
+ * the threads and may be called while runs are in progress. Reset() starts a new aggregation period. Samples that are
+ * recorded concurrently with a Reset() may be counted in either period.
+ *
+ * On Linux, the CPU cycles and cache misses of the thread running each node can be collected with perf_event. Work
+ * done by the other threads of the intra-op thread pool is not included in them. Each thread opens its counters the
+ * first time it records a sample and closes them when it exits.
+ */
+class AggregateProfiler {
+ public:
+  explicit AggregateProfiler(bool enable_hardware_counters);
+  ~AggregateProfiler();
+
+  /*
+  Get the id used to record the nodes of an op type. All op types must be registered before the first sample is
+  recorded.
+  */
+  size_t RegisterOpType(const std::string& op_type, const std::string& provider);
+
+  struct ThreadBuffer;
+
+  // Start of the measurement of a node.
+  struct Sample {
+    ThreadBuffer* buffer = nullptr;
+    std::chrono::steady_clock::time_point start;
+    uint64_t cycles = 0;
+    uint64_t cache_misses = 0;
+  };
+
+  // Start measuring a node on the calling thread.
+  Sample Begin();
+
+  // Finish measuring a node on the thread that called Begin() and add it to the statistics of its op type.
+  void End(const Sample& sample, size_t op_type_id, uint64_t output_bytes, uint64_t threadpool_dispatch_ns);
+
+  // Statistics of the op types that were run since the last reset.
+  std::vector<OpTypeStats> Snapshot() const;
+
+  // Snapshot() as a JSON document.
+  std::string SnapshotJson() const;
+
+  void Reset();
+
+  // Whether the hardware counters were requested and collected for every thread that recorded samples.
+  bool HardwareCountersAvailable() const {
+    return hardware_counters_available_.load(std::memory_order_relaxed);
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AggregateProfiler);
+
+ private:
+  ThreadBuffer& GetThreadBuffer();
+
+  // hardware counters were requested and perf_event is usable
+  const bool enable_hardware_counters_;
+  // cleared if a thread could not open its hardware counters
+  std::atomic<bool> hardware_counters_available_;
+  // distinguishes instances in the thread local state, as an address may be reused by a later instance
+  const uint64_t instance_id_;
+
+  std::atomic<uint64_t> generation_{1};
+
+  mutable OrtMutex mutex_;
+  std::vector<std::pair<std::string, std::string>> op_types_;
+  // set once the first buffer is created, after which no more op types can be registered
+  bool op_types_frozen_{false};
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
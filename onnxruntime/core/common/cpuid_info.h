@@ -16,10 +16,12 @@ class CPUIDInfo {
   }
 
   bool HasAMX_BF16() const { return has_amx_bf16_; }
+  bool HasAMX_INT8() const { return has_amx_int8_; }
   bool HasAVX() const { return has_avx_; }
   bool HasAVX2() const { return has_avx2_; }
   bool HasAVX512f() const { return has_avx512f_; }
   bool HasAVX512_BF16() const { return has_avx512_bf16_; }
+  bool HasAVX512_FP16() const { return has_avx512_fp16_; }
   bool HasAVX512Skylake() const { return has_avx512_skylake_; }
   bool HasF16C() const { return has_f16c_; } /*fp16 conversion inst*/
   bool HasSSE3() const { return has_sse3_; }
@@ -104,10 +106,12 @@ class CPUIDInfo {
 #endif
   }
   bool has_amx_bf16_{false};
+  bool has_amx_int8_{false};
   bool has_avx_{false};
   bool has_avx2_{false};
   bool has_avx512f_{false};
   bool has_avx512_bf16_{false};
+  bool has_avx512_fp16_{false};
   bool has_avx512_skylake_{false};
   bool has_f16c_{false};
   bool has_sse3_{false};
@@ -46,6 +46,11 @@ namespace onnxruntime {
 namespace concurrency {
 
 #if !defined(ORT_MINIMAL_BUILD)
+namespace {
+// number of nested StartDispatchTiming calls of the current thread
+thread_local int dispatch_timing_depth = 0;
+}  // namespace
+
 ThreadPoolProfiler::ThreadPoolProfiler(int num_threads, const CHAR_TYPE* thread_pool_name) : num_threads_(num_threads) {
   child_thread_stats_.assign(num_threads, {});
   if (thread_pool_name) {
@@ -88,12 +93,29 @@ std::string ThreadPoolProfiler::Stop() {
   return ss.str();
 }
 
+uint64_t ThreadPoolProfiler::StartDispatchTiming() {
+  ++dispatch_timing_depth;
+  return GetMainThreadStat().dispatch_ns_;
+}
+
+uint64_t ThreadPoolProfiler::StopDispatchTiming(uint64_t baseline) {
+  ORT_ENFORCE(dispatch_timing_depth > 0, "StartDispatchTiming must pair with StopDispatchTiming");
+  --dispatch_timing_depth;
+  return GetMainThreadStat().dispatch_ns_ - baseline;
+}
+
+bool ThreadPoolProfiler::Recording() const {
+  return enabled_ || dispatch_timing_depth > 0;
+}
+
 void ThreadPoolProfiler::LogStartAndCoreAndBlock(std::ptrdiff_t block_size) {
   if (enabled_) {
     MainThreadStat& stat = GetMainThreadStat();
     stat.LogCore();
     stat.LogBlockSize(block_size);
     stat.LogStart();
+  } else if (dispatch_timing_depth > 0) {
+    GetMainThreadStat().LogStart();
   }
 }
 
@@ -106,20 +128,20 @@ void ThreadPoolProfiler::LogCoreAndBlock(std::ptrdiff_t block_size) {
 }
 
 void ThreadPoolProfiler::LogStart() {
-  if (enabled_) {
+  if (Recording()) {
     GetMainThreadStat().LogStart();
   }
 }
 
 void ThreadPoolProfiler::LogEnd(ThreadPoolEvent evt) {
-  if (enabled_) {
-    GetMainThreadStat().LogEnd(evt);
+  if (Recording()) {
+    GetMainThreadStat().LogEnd(evt, enabled_);
   }
 }
 
 void ThreadPoolProfiler::LogEndAndStart(ThreadPoolEvent evt) {
-  if (enabled_) {
-    GetMainThreadStat().LogEndAndStart(evt);
+  if (Recording()) {
+    GetMainThreadStat().LogEndAndStart(evt, enabled_);
   }
 }
 
@@ -151,16 +173,28 @@ void ThreadPoolProfiler::MainThreadStat::LogStart() {
   points_.emplace_back(Clock::now());
 }
 
-void ThreadPoolProfiler::MainThreadStat::LogEnd(ThreadPoolEvent evt) {
+void ThreadPoolProfiler::MainThreadStat::LogEnd(ThreadPoolEvent evt, bool profiling) {
   ORT_ENFORCE(!points_.empty(), "LogStart must pair with LogEnd");
-  events_[evt] += TimeDiffMicroSeconds(points_.back(), Clock::now());
+  const auto now = Clock::now();
+  if (profiling) {
+    events_[evt] += TimeDiffMicroSeconds(points_.back(), now);
+  }
+  if (evt != RUN && dispatch_timing_depth > 0) {
+    dispatch_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(now - points_.back()).count();
+  }
   points_.pop_back();
 }
 
-void ThreadPoolProfiler::MainThreadStat::LogEndAndStart(ThreadPoolEvent evt) {
+void ThreadPoolProfiler::MainThreadStat::LogEndAndStart(ThreadPoolEvent evt, bool profiling) {
   ORT_ENFORCE(!points_.empty(), "LogStart must pair with LogEnd");
-  events_[evt] += TimeDiffMicroSeconds(points_.back(), Clock::now());
-  points_.back() = Clock::now();
+  const auto now = Clock::now();
+  if (profiling) {
+    events_[evt] += TimeDiffMicroSeconds(points_.back(), now);
+  }
+  if (evt != RUN && dispatch_timing_depth > 0) {
+    dispatch_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(now - points_.back()).count();
+  }
+  points_.back() = now;
 }
 
 std::string ThreadPoolProfiler::MainThreadStat::Reset() {
@@ -663,6 +697,14 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+uint64_t ThreadPool::StartDispatchTiming() {
+  return ThreadPoolProfiler::StartDispatchTiming();
+}
+
+uint64_t ThreadPool::StopDispatchTiming(uint64_t baseline) {
+  return ThreadPoolProfiler::StopDispatchTiming(baseline);
+}
+
 void ThreadPool::EnableSpinning() {
   if (extended_eigen_threadpool_) {
     extended_eigen_threadpool_->EnableSpinning();
@@ -675,6 +717,18 @@ void ThreadPool::DisableSpinning() {
   }
 }
 
+void ThreadPool::HintBurst(std::chrono::microseconds duration) {
+  if (extended_eigen_threadpool_) {
+    extended_eigen_threadpool_->HintBurst(duration);
+  }
+}
+
+void ThreadPool::HintIdle() {
+  if (extended_eigen_threadpool_) {
+    extended_eigen_threadpool_->HintIdle();
+  }
+}
+
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
   if (underlying_threadpool_) {
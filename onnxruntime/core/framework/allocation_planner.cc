@@ -5,6 +5,8 @@
 #include <list>
 #include <algorithm>
 #include <deque>
+#include <limits>
+#include <queue>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
@@ -1784,7 +1786,8 @@ class PlannerImpl {
   void
   PartitionIntoStreams(const logging::Logger& logger, const ExecutionProviders& execution_providers,
                        const PathString& partition_config_file) {
-    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file);
+    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file,
+                                                                 context_->GetMaxCpuStreams());
     auto status = partitioner->PartitionGraph(graph_viewer_, execution_providers, stream_nodes_, context_->GetExecutionOrder());
     ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
     node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
@@ -1844,25 +1847,118 @@ class PlannerImpl {
       return producer_topoindex < yieldOp_index_in_toposort && yieldOp_index_in_toposort < consumer_topoindex;
     };
 #endif
+    // A node waits with a barrier for the producers of its inputs in other streams. The barrier is skipped if its
+    // stream is already known to have passed the producer, i.e. an earlier barrier in the stream waited for the
+    // producer, a later node in the producer's stream, or a node in a third stream that itself waited for them.
+    // This is tracked with a vector clock per node: the position in each stream up to which all nodes have completed
+    // when the node is launched.
+    InlinedVector<int> node_position(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1, -1);
+    for (size_t i = 0; i < num_logic_streams_; ++i) {
+      for (size_t j = 0; j < stream_nodes_[i].size(); ++j) {
+        node_position[stream_nodes_[i][j]] = static_cast<int>(j);
+      }
+    }
+    std::vector<InlinedVector<int>> node_clock(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
+    InlinedHashMap<NodeIndex, InlinedVector<NodeIndex>> node_to_barriers;
+    InlinedHashSet<NodeIndex> trigger_nodes;
+    {
+      // the clock of a producer after it completed
+      auto clock_after = [&](NodeIndex producer) {
+        auto clock = node_clock[producer];
+        clock[node_stream_map_[producer]] = node_position[producer];
+        return clock;
+      };
+      // visit the nodes in an order that respects both the stream order and the data dependencies
+      InlinedVector<size_t> next_in_stream(num_logic_streams_, 0);
+      InlinedVector<bool> visited(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1, false);
+      size_t num_visited = 0;
+      bool progress = true;
+      while (progress) {
+        progress = false;
+        for (size_t i = 0; i < num_logic_streams_; ++i) {
+          while (next_in_stream[i] < stream_nodes_[i].size()) {
+            const size_t j = next_in_stream[i];
+            auto node_index = stream_nodes_[i][j];
+            auto* node = graph_viewer_.GetNode(node_index);
+            bool inputs_visited = true;
+            for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+              if (!visited[it->Index()]) {
+                inputs_visited = false;
+                break;
+              }
+            }
+            if (!inputs_visited) {
+              break;
+            }
+
+            InlinedVector<int> clock = j > 0 ? clock_after(stream_nodes_[i][j - 1])
+                                             : InlinedVector<int>(num_logic_streams_, -1);
+            // the last producer in each other stream that is not already covered by the clock
+            InlinedVector<int> candidates(num_logic_streams_, -1);
+            for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+              const size_t producer_stream = node_stream_map_[it->Index()];
+              const int producer_position = node_position[it->Index()];
+              if (producer_stream == i || clock[producer_stream] >= producer_position
+#ifdef ENABLE_TRAINING
+                  // Do not insert Barrier/TriggerDownStream step if the producer and consumer are in different sides of yieldOp
+                  // As in this case producer will surely be ready before the consumer is running.
+                  || AreNodesSeparatedByYield(it->Index(), node_index)
+#endif
+              ) {
+                continue;
+              }
+              candidates[producer_stream] = std::max(candidates[producer_stream], producer_position);
+            }
+            // drop the candidates that another candidate already waited for
+            InlinedVector<InlinedVector<int>> candidate_clocks(num_logic_streams_);
+            for (size_t k = 0; k < num_logic_streams_; ++k) {
+              if (candidates[k] >= 0) {
+                candidate_clocks[k] = clock_after(stream_nodes_[k][candidates[k]]);
+              }
+            }
+            for (size_t k = 0; k < num_logic_streams_; ++k) {
+              if (candidates[k] < 0) {
+                continue;
+              }
+              bool covered = false;
+              for (size_t l = 0; l < num_logic_streams_ && !covered; ++l) {
+                covered = l != k && candidates[l] >= 0 && candidate_clocks[l][k] >= candidates[k];
+              }
+              if (covered) {
+                continue;
+              }
+              auto producer = stream_nodes_[k][candidates[k]];
+              node_to_barriers[node_index].push_back(producer);
+              trigger_nodes.insert(producer);
+              for (size_t l = 0; l < num_logic_streams_; ++l) {
+                clock[l] = std::max(clock[l], candidate_clocks[k][l]);
+              }
+            }
+
+            node_clock[node_index] = std::move(clock);
+            visited[node_index] = true;
+            ++num_visited;
+            ++next_in_stream[i];
+            progress = true;
+          }
+        }
+      }
+      size_t num_stream_nodes = 0;
+      for (size_t i = 0; i < num_logic_streams_; ++i) {
+        num_stream_nodes += stream_nodes_[i].size();
+      }
+      ORT_ENFORCE(num_visited == num_stream_nodes, "The order of the nodes in the logic streams causes a deadlock");
+    }
+
     size_t num_trigger_points = 0;
     InlinedHashMap<NodeIndex, size_t> node_to_trigger_points;
     InlinedHashMap<NodeIndex, NotificationIndex> node_to_notification;
     std::map<NodeIndex, std::map<NodeIndex, WaitNotificationFn>> node_to_wait;
     for (size_t i = 0; i < num_logic_streams_; ++i) {
       for (auto node_index : stream_nodes_[i]) {
-        auto* node = graph_viewer_.GetNode(node_index);
-        for (auto it = node->OutputNodesBegin(); it != node->OutputNodesEnd(); ++it) {
-          // if the output node is not in the same stream, generate a trigger point
-          if (node_stream_map_[it->Index()] != i
-#ifdef ENABLE_TRAINING
-              // Do not insert Barrier/TriggerDownStream step if the producer and consumer are in different sides of yieldOp
-              // As in this case producer will surely be ready before the consumer is running.
-              && !AreNodesSeparatedByYield(node_index, it->Index())
-#endif
-          ) {
-            node_to_trigger_points[node_index] = num_trigger_points++;
-            break;
-          }
+        // generate a trigger point if any node in another stream waits for the node
+        if (trigger_nodes.count(node_index) > 0) {
+          node_to_trigger_points[node_index] = num_trigger_points++;
         }
       }
     }
@@ -1939,20 +2035,11 @@ class PlannerImpl {
           dependence_graph_[node_index].insert(stream_nodes_[i][j - 1]);
         }
         auto* node = graph_viewer_.GetNode(node_index);
-        std::unordered_set<NodeIndex> visited;  // TODO(leca): See the bug description in PlannerTest.MultiStreamMultiOutput. Can remove this variable once this bug is fixed
-        for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
-          if (visited.find(it->Index()) != visited.end()) {
-            continue;
-          }
-          visited.insert(it->Index());
-          //  check whether we need to add barrier
-          if (std::find(stream_nodes_[i].begin(), stream_nodes_[i].end(), it->Index()) == stream_nodes_[i].end()
-#ifdef ENABLE_TRAINING
-              && !AreNodesSeparatedByYield(it->Index(), node_index)
-#endif
-          ) {
+        auto barriers_it = node_to_barriers.find(node_index);
+        if (barriers_it != node_to_barriers.end()) {
+          for (auto producer_index : barriers_it->second) {
             // find the trigger_point_id
-            auto trigger_point_it = node_to_trigger_points.find(it->Index());
+            auto trigger_point_it = node_to_trigger_points.find(producer_index);
             ORT_ENFORCE(trigger_point_it != node_to_trigger_points.end());
             size_t trigger_point_index = trigger_point_it->second;
             // push a barrier
@@ -2403,11 +2490,293 @@ void DeviceBasedPartitioner::SaveConfig() const {
   }
 }
 
+/*
+CriticalPathPartitioner keeps the nodes of each non-CPU device in one stream like DeviceBasedPartitioner, and splits
+the CPU nodes into up to max_cpu_streams streams so that independent branches of the graph run concurrently.
+
+The CPU nodes are list scheduled: nodes become ready once all their producers are scheduled, and the ready node with
+the longest remaining path to the end of the graph (its bottom level) is placed on the stream where it can start the
+earliest. A node that consumes the output of a node in another stream can only start after a barrier, which costs
+cross_stream_cost, so chains of dependent nodes stay on one stream and new streams are only used for branches that are
+expensive enough to pay for the synchronization.
+
+The cost of a node is taken from the optional config, e.g. converted from a profiling run, and estimated from the
+static output shapes of the node otherwise. Costs are in microseconds.
+------------------------------------------------------
+{
+"type":"CriticalPathPartitioner",
+"max_cpu_streams":4,
+"cross_stream_cost":5.0,
+"node_costs":{"node_1":120.0,"node_2":35.5}
+}
+------------------------------------------------------
+All fields other than "type" are optional. max_cpu_streams defaults to the number of inter-op threads.
+*/
+class CriticalPathPartitioner : public IGraphPartitioner {
+ public:
+  CriticalPathPartitioner(const logging::Logger& logger,
+                          const PathString& config_file,
+                          size_t max_cpu_streams) : IGraphPartitioner(logger, config_file),
+                                                    max_cpu_streams_(std::max<size_t>(max_cpu_streams, 1)) {
+    Initialize();
+  }
+
+  Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                        const ExecutionProviders& execution_providers,
+                        std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                        ExecutionOrder execution_order) override;
+
+  const char* Type() const override { return "CriticalPathPartitioner"; }
+  size_t Streams() const override { return num_streams_; }
+
+ private:
+  void Initialize();
+  double NodeCost(const Node& node) const;
+
+  // fixed cost of executing a node, and cost per output element, for estimated costs
+  static constexpr double kNodeOverhead = 0.5;
+  static constexpr double kElementCost = 0.001;
+  // output elements assumed for an output whose shape is not known statically
+  static constexpr double kDefaultElements = 4096;
+
+  size_t max_cpu_streams_;
+  double cross_stream_cost_ = 5.0;
+  InlinedHashMap<std::string, double> node_costs_;
+  size_t num_streams_ = 0;
+};
+
+void CriticalPathPartitioner::Initialize() {
+  if (config_file_.empty()) {
+    return;
+  }
+  std::ifstream if_stream(config_file_);
+  if (!if_stream.is_open()) {
+    return;
+  }
+  try {
+    json json_config = json::parse(if_stream);
+    if (json_config.contains("max_cpu_streams")) {
+      max_cpu_streams_ = std::max<size_t>(json_config["max_cpu_streams"].get<size_t>(), 1);
+    }
+    if (json_config.contains("cross_stream_cost")) {
+      cross_stream_cost_ = json_config["cross_stream_cost"].get<double>();
+    }
+    if (json_config.contains("node_costs")) {
+      for (const auto& item : json_config["node_costs"].items()) {
+        node_costs_[item.key()] = item.value().get<double>();
+      }
+    }
+  } catch (const std::exception& ex) {
+    LOGS(logger_, WARNING) << "Caught exception when reading CriticalPathPartitioner config: " << ex.what();
+  }
+}
+
+double CriticalPathPartitioner::NodeCost(const Node& node) const {
+  auto cost_it = node_costs_.find(node.Name());
+  if (cost_it != node_costs_.end()) {
+    return cost_it->second;
+  }
+
+  // nodes that only produce metadata or alias their input
+  static const InlinedHashSet<std::string_view> view_ops = {
+      "Shape", "Size", "Reshape", "Squeeze", "Unsqueeze", "Flatten", "Identity", "Constant"};
+  // nodes that do much more work per output element than elementwise ops
+  static const InlinedHashSet<std::string_view> compute_bound_ops = {
+      "Conv", "ConvTranspose", "FusedConv", "NhwcFusedConv", "QLinearConv", "ConvInteger",
+      "MatMul", "FusedMatMul", "MatMulInteger", "MatMulIntegerToFloat", "QLinearMatMul", "DynamicQuantizeMatMul",
+      "MatMulNBits", "Gemm", "FusedGemm", "QGemm", "Einsum",
+      "Attention", "QAttention", "MultiHeadAttention", "LSTM", "GRU", "RNN", "DynamicQuantizeLSTM"};
+  constexpr double kComputeBoundFactor = 32;
+
+  if (view_ops.count(node.OpType()) > 0) {
+    return kNodeOverhead;
+  }
+
+  double elements = 0;
+  for (const auto* output : node.OutputDefs()) {
+    if (!output->Exists()) {
+      continue;
+    }
+    const auto* shape = output->Shape();
+    double output_elements = shape != nullptr ? 1 : kDefaultElements;
+    if (shape != nullptr) {
+      for (const auto& dim : shape->dim()) {
+        if (!utils::HasDimValue(dim)) {
+          output_elements = kDefaultElements;
+          break;
+        }
+        output_elements *= static_cast<double>(dim.dim_value());
+      }
+    }
+    elements += output_elements;
+  }
+
+  if (compute_bound_ops.count(node.OpType()) > 0) {
+    elements *= kComputeBoundFactor;
+  }
+
+  return kNodeOverhead + elements * kElementCost;
+}
+
+Status CriticalPathPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                                               const ExecutionProviders& execution_providers,
+                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                                               ExecutionOrder execution_order) {
+  const auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  const size_t max_node_index = graph_viewer.MaxNodeIndex();
+
+  InlinedVector<size_t> topo_position(max_node_index, 0);
+  InlinedVector<double> cost(max_node_index, 0);
+  InlinedVector<OrtDevice::DeviceType> device_types(max_node_index, OrtDevice::CPU);
+  for (size_t i = 0; i < p_graph_nodes.size(); ++i) {
+    const auto* node = graph_viewer.GetNode(p_graph_nodes[i]);
+    topo_position[node->Index()] = i;
+    cost[node->Index()] = NodeCost(*node);
+    auto* ep = execution_providers.Get(*node);
+    ORT_RETURN_IF(ep == nullptr, "Failed to find execution provider for node ", node->Name());
+    device_types[node->Index()] = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+  }
+
+  // longest path from each node to the end of the graph, including the node itself
+  InlinedVector<double> bottom_level(max_node_index, 0);
+  for (auto it = p_graph_nodes.rbegin(); it != p_graph_nodes.rend(); ++it) {
+    const auto* node = graph_viewer.GetNode(*it);
+    double longest_successor = 0;
+    for (auto out_it = node->OutputNodesBegin(); out_it != node->OutputNodesEnd(); ++out_it) {
+      longest_successor = std::max(longest_successor, bottom_level[out_it->Index()]);
+    }
+    bottom_level[*it] = cost[*it] + longest_successor;
+  }
+
+  // ready nodes, highest bottom level first. ties are broken by the topological order to keep the result stable.
+  auto lower_priority = [&](NodeIndex a, NodeIndex b) {
+    if (bottom_level[a] != bottom_level[b]) {
+      return bottom_level[a] < bottom_level[b];
+    }
+    return topo_position[a] > topo_position[b];
+  };
+  std::priority_queue<NodeIndex, std::vector<NodeIndex>, decltype(lower_priority)> ready(lower_priority);
+
+  InlinedVector<size_t> pending_inputs(max_node_index, 0);
+  for (auto node_index : p_graph_nodes) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    InlinedHashSet<NodeIndex> input_nodes;
+    for (auto in_it = node->InputNodesBegin(); in_it != node->InputNodesEnd(); ++in_it) {
+      input_nodes.insert(in_it->Index());
+    }
+    pending_inputs[node_index] = input_nodes.size();
+    if (input_nodes.empty()) {
+      ready.push(node_index);
+    }
+  }
+
+  // CPU streams come first, followed by one stream per other device type
+  InlinedVector<double> cpu_stream_end;
+  InlinedHashMap<OrtDevice::DeviceType, size_t> device_to_stream;
+  InlinedVector<InlinedVector<NodeIndex>> cpu_streams;
+  InlinedVector<InlinedVector<NodeIndex>> device_streams;
+  InlinedVector<size_t> node_stream(max_node_index, 0);
+  InlinedVector<bool> on_cpu_stream(max_node_index, false);
+  InlinedVector<double> finish_time(max_node_index, 0);
+
+  while (!ready.empty()) {
+    const NodeIndex node_index = ready.top();
+    ready.pop();
+    const auto* node = graph_viewer.GetNode(node_index);
+
+    InlinedHashSet<NodeIndex> input_nodes;
+    for (auto in_it = node->InputNodesBegin(); in_it != node->InputNodesEnd(); ++in_it) {
+      input_nodes.insert(in_it->Index());
+    }
+
+    if (device_types[node_index] != OrtDevice::CPU) {
+      // nodes of other devices are kept in one stream per device. their finish time is only a rough estimate.
+      auto it = device_to_stream.find(device_types[node_index]);
+      if (it == device_to_stream.end()) {
+        it = device_to_stream.emplace(device_types[node_index], device_streams.size()).first;
+        device_streams.emplace_back();
+      }
+      double start = 0;
+      for (auto input_index : input_nodes) {
+        start = std::max(start, finish_time[input_index] + cross_stream_cost_);
+      }
+      node_stream[node_index] = it->second;
+      device_streams[it->second].push_back(node_index);
+      finish_time[node_index] = start + cost[node_index];
+    } else {
+      // the earliest time the node can start on the given CPU stream
+      auto earliest_start = [&](size_t stream) {
+        double start = stream < cpu_stream_end.size() ? cpu_stream_end[stream] : 0;
+        for (auto input_index : input_nodes) {
+          const bool same_stream = on_cpu_stream[input_index] && node_stream[input_index] == stream;
+          start = std::max(start, finish_time[input_index] + (same_stream ? 0 : cross_stream_cost_));
+        }
+        return start;
+      };
+
+      // consider the existing streams, and one new stream if the limit is not reached. prefer existing streams
+      // with lower index on ties so that new streams are only opened when it helps.
+      size_t best_stream = 0;
+      double best_start = std::numeric_limits<double>::max();
+      const size_t candidates = std::min(cpu_stream_end.size() + 1, max_cpu_streams_);
+      for (size_t stream = 0; stream < candidates; ++stream) {
+        double start = earliest_start(stream);
+        if (start < best_start) {
+          best_start = start;
+          best_stream = stream;
+        }
+      }
+
+      if (best_stream == cpu_streams.size()) {
+        cpu_streams.emplace_back();
+        cpu_stream_end.push_back(0);
+      }
+      node_stream[node_index] = best_stream;
+      on_cpu_stream[node_index] = true;
+      cpu_streams[best_stream].push_back(node_index);
+      finish_time[node_index] = best_start + cost[node_index];
+      cpu_stream_end[best_stream] = finish_time[node_index];
+    }
+
+    // the scheduling order is a topological order, and each stream is a subsequence of it, so waiting on
+    // the producers in other streams can never deadlock.
+    InlinedHashSet<NodeIndex> output_nodes;
+    for (auto out_it = node->OutputNodesBegin(); out_it != node->OutputNodesEnd(); ++out_it) {
+      if (output_nodes.insert(out_it->Index()).second && --pending_inputs[out_it->Index()] == 0) {
+        ready.push(out_it->Index());
+      }
+    }
+  }
+
+  stream_nodes.clear();
+  stream_nodes.reserve(cpu_streams.size() + device_streams.size());
+  for (auto& nodes : cpu_streams) {
+    stream_nodes.push_back(std::move(nodes));
+  }
+  for (auto& nodes : device_streams) {
+    stream_nodes.push_back(std::move(nodes));
+  }
+  num_streams_ = stream_nodes.size();
+
+  size_t num_scheduled = 0;
+  for (const auto& nodes : stream_nodes) {
+    num_scheduled += nodes.size();
+  }
+  ORT_RETURN_IF_NOT(num_scheduled == p_graph_nodes.size(), "CriticalPathPartitioner failed to schedule all nodes");
+
+  LOGS(logger_, INFO) << "CriticalPathPartitioner partitioned " << num_scheduled << " nodes into "
+                      << cpu_streams.size() << " CPU streams and " << device_streams.size() << " other streams";
+  return Status::OK();
+}
+
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
-                                                                             const PathString& config_file) {
-  // use device based partitioner by default
+                                                                             const PathString& config_file,
+                                                                             size_t max_cpu_streams) {
+  // use device based partitioner by default, and critical path based partitioner if multiple CPU streams are allowed
   IGraphPartitioner::GraphPartitioningStrategy partitioner_type =
-      IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+      config_file.empty() && max_cpu_streams > 1
+          ? IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition
+          : IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
   if (!config_file.empty()) {
     std::ifstream f(config_file);
     if (f.is_open()) {
@@ -2417,6 +2786,8 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
           auto type = json_config["type"];
           if (type == "DeviceBasedPartitioner") {
             partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+          } else if (type == "CriticalPathPartitioner") {
+            partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition;
           }
         }
       } catch (const std::exception& ex) {
@@ -2428,6 +2799,9 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
     return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+  } else if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition) {
+    LOGS(logger, INFO) << "Use CriticalPathPartition with up to " << max_cpu_streams << " CPU streams";
+    return std::make_unique<CriticalPathPartitioner>(logger, config_file, max_cpu_streams);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
@@ -46,15 +46,20 @@ class ISequentialPlannerContext {
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
+
+  // Maximum number of logic streams the CPU nodes of the main graph may be partitioned into.
+  virtual size_t GetMaxCpuStreams() const { return 1; }
   virtual ~ISequentialPlannerContext() = default;
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           size_t max_cpu_streams = 1)
       : execution_mode_(execution_mode),
         exection_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        max_cpu_streams_(max_cpu_streams) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -67,10 +72,13 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
 
+  size_t GetMaxCpuStreams() const override { return max_cpu_streams_; }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder exection_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  size_t max_cpu_streams_ = 1;
 };
 
 #ifdef ORT_ENABLE_STREAM
@@ -82,16 +90,21 @@ class IGraphPartitioner {
   // DeviceBasedPartitioner is the default, who partitions a graph based off device information.
   // i.e., given a graph which has CPU EP nodes, Cuda EP nodes and TRT EP nodes,
   // it will be partitioned as two sequences, one is for CPU EP nodes, another is for TRT and Cuda nodes.
-  // We will add more optimized partitioner later.
+  // CriticalPathPartitioner additionally splits the CPU EP nodes into multiple sequences based on the
+  // estimated or profiled cost of each node, so that independent branches of the graph run concurrently
+  // on the inter-op thread pool.
   enum GraphPartitioningStrategy {
     DeviceBasedPartition = 0,
+    CriticalPathPartition,
     Unknown,
   };
   virtual ~IGraphPartitioner() = default;
   // create the partition based on the partition type.
   // perform partition based on the user input when provided.
+  // if the config file does not specify the type, CriticalPathPartitioner is used when max_cpu_streams > 1.
   static std::unique_ptr<IGraphPartitioner> CreateGraphPartitioner(const logging::Logger& logger,
-                                                                   const PathString& config_file);
+                                                                   const PathString& config_file,
+                                                                   size_t max_cpu_streams = 1);
   virtual Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                 const ExecutionProviders& execution_providers,
                                 std::vector<InlinedVector<NodeIndex>>& stream_nodes,
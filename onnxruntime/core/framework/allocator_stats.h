@@ -22,6 +22,10 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  // Allocations served from and missed by the per-thread caches of an arena. Hits are not included in num_allocs.
+  int64_t num_thread_cache_hits;
+  int64_t num_thread_cache_misses;
+  int64_t thread_cache_bytes;  // Bytes held in per-thread caches. These are included in bytes_in_use.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +39,9 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_thread_cache_misses = 0;
+    this->thread_cache_bytes = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +54,10 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumThreadCacheHits:       " << this->num_thread_cache_hits << "\n"
+       << "NumThreadCacheMisses:     " << this->num_thread_cache_misses << "\n"
+       << "ThreadCacheBytes:         " << this->thread_cache_bytes << "\n";
     return ss.str();
   }
 };
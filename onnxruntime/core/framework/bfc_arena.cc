@@ -3,16 +3,56 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
+#include <atomic>
 #include <type_traits>
 
+#include "core/common/inlined_containers.h"
+
 namespace onnxruntime {
+
+struct BFCArena::ThreadCache {
+  static constexpr size_t kNumSizeClasses = kMaxThreadCacheChunkSize >> kMinAllocationBits;
+
+  // Only accessed by the owning thread.
+  // Maps each chunk owned by the cache, whether free or handed out, to its size class.
+  InlinedHashMap<void*, uint16_t> owned_chunks;
+  // Free chunks for each multiple of kMinAllocationSize
+  std::array<std::vector<void*>, kNumSizeClasses> free_lists;
+
+  // Chunks owned by this cache that were freed by other threads. Protected by the arena's lock_.
+  std::vector<void*> remote_frees;
+
+  // Only written by the owning thread. Atomic so GetStats() can read them.
+  std::atomic<int64_t> cached_bytes{0};
+  std::atomic<int64_t> hits{0};
+  std::atomic<int64_t> misses{0};
+};
+
+struct BFCArena::ThreadCacheRegistry {
+  OrtMutex mutex;
+  // nullptr once the arena is destroyed
+  BFCArena* arena = nullptr;
+  std::vector<std::shared_ptr<ThreadCache>> caches;
+};
+
+namespace {
+// Update a value that has a single writer without a locked read-modify-write instruction
+inline void AddFromOwner(std::atomic<int64_t>& value, int64_t delta) {
+  value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+std::atomic<uint64_t> next_thread_cache_arena_id{0};
+}  // namespace
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   int64_t thread_cache_max_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -25,12 +65,15 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
-      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes),
+      thread_cache_max_bytes_(thread_cache_max_bytes),
+      thread_cache_arena_id_(next_thread_cache_arena_id++) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
+                     << " thread_cache_max_bytes: " << thread_cache_max_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -75,9 +118,22 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  if (thread_cache_max_bytes_ > 0) {
+    thread_cache_registry_ = std::make_shared<ThreadCacheRegistry>();
+    thread_cache_registry_->arena = this;
+  }
 }
 
 BFCArena::~BFCArena() {
+  if (thread_cache_registry_) {
+    // threads that still have a cache for this arena drop it when they exit. the chunks it holds are freed with the
+    // regions below.
+    std::lock_guard<OrtMutex> lock(thread_cache_registry_->mutex);
+    thread_cache_registry_->arena = nullptr;
+    thread_cache_registry_->caches.clear();
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -269,9 +325,191 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (thread_cache_registry_) {
+    return ThreadCacheAlloc(*GetThreadCache(), size);
+  }
+
   return AllocateRawInternal(size, false, nullptr, false, nullptr);
 }
 
+BFCArena::ThreadCache* BFCArena::GetThreadCache() {
+  // The caches of the current thread for each arena it used. Caches are returned to their arena when the thread exits.
+  struct ThreadCaches {
+    struct Entry {
+      uint64_t arena_id;
+      std::shared_ptr<ThreadCacheRegistry> registry;
+      std::shared_ptr<ThreadCache> cache;
+    };
+
+    ~ThreadCaches() {
+      for (auto& entry : entries) {
+        std::lock_guard<OrtMutex> lock(entry.registry->mutex);
+        if (entry.registry->arena != nullptr) {
+          entry.registry->arena->ReleaseThreadCache(*entry.cache);
+          auto& caches = entry.registry->caches;
+          caches.erase(std::remove(caches.begin(), caches.end(), entry.cache), caches.end());
+        }
+      }
+    }
+
+    std::vector<Entry> entries;
+  };
+
+  thread_local ThreadCaches thread_caches;
+
+  auto& entries = thread_caches.entries;
+  for (const auto& entry : entries) {
+    if (entry.arena_id == thread_cache_arena_id_) {
+      return entry.cache.get();
+    }
+  }
+
+  // drop the caches of arenas that no longer exist
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [](const ThreadCaches::Entry& entry) {
+                                 std::lock_guard<OrtMutex> lock(entry.registry->mutex);
+                                 return entry.registry->arena == nullptr;
+                               }),
+                entries.end());
+
+  auto cache = std::make_shared<ThreadCache>();
+  {
+    std::lock_guard<OrtMutex> lock(thread_cache_registry_->mutex);
+    thread_cache_registry_->caches.push_back(cache);
+  }
+
+  entries.push_back({thread_cache_arena_id_, thread_cache_registry_, cache});
+  return cache.get();
+}
+
+void* BFCArena::ThreadCacheAlloc(ThreadCache& cache, size_t num_bytes) {
+  if (num_bytes == 0 || num_bytes > kMaxThreadCacheChunkSize) {
+    return AllocateRawInternal(num_bytes, false, nullptr, false, nullptr);
+  }
+
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  const size_t size_class = (rounded_bytes >> kMinAllocationBits) - 1;
+  auto& free_list = cache.free_lists[size_class];
+
+  auto pop_free_chunk = [&]() {
+    void* p = free_list.back();
+    free_list.pop_back();
+    AddFromOwner(cache.cached_bytes, -static_cast<int64_t>(rounded_bytes));
+    return p;
+  };
+
+  if (!free_list.empty()) {
+    AddFromOwner(cache.hits, 1);
+    return pop_free_chunk();
+  }
+
+  AddFromOwner(cache.misses, 1);
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  DrainRemoteFrees(cache);
+  if (cache.cached_bytes.load(std::memory_order_relaxed) > thread_cache_max_bytes_) {
+    FlushThreadCache(cache, static_cast<size_t>(thread_cache_max_bytes_ / 2));
+  }
+
+  if (!free_list.empty()) {
+    return pop_free_chunk();
+  }
+
+  auto take_ownership = [&](Chunk* chunk) {
+    chunk->thread_cache = &cache;
+    cache.owned_chunks[chunk->ptr] = static_cast<uint16_t>(size_class);
+  };
+
+  const BinNum bin_num = BinNumForSize(rounded_bytes);
+  Chunk* chunk = FindChunkOrExtend(bin_num, rounded_bytes, num_bytes, false, nullptr, false, nullptr);
+  take_ownership(chunk);
+  // chunk may be invalidated by the allocations below as they can grow chunks_
+  void* ptr = chunk->ptr;
+
+  // allocate a few more chunks of the same size while we hold the lock so the next allocations don't need it.
+  // don't extend the arena for these.
+  for (size_t i = 1; i < kThreadCacheRefillBatch &&
+                     cache.cached_bytes.load(std::memory_order_relaxed) +
+                             static_cast<int64_t>(rounded_bytes) <=
+                         thread_cache_max_bytes_;
+       ++i) {
+    Chunk* extra_chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, nullptr, false);
+    if (extra_chunk == nullptr) {
+      break;
+    }
+
+    take_ownership(extra_chunk);
+    free_list.push_back(extra_chunk->ptr);
+    AddFromOwner(cache.cached_bytes, static_cast<int64_t>(rounded_bytes));
+  }
+
+  return ptr;
+}
+
+bool BFCArena::ThreadCacheFree(ThreadCache& cache, void* p) {
+  auto it = cache.owned_chunks.find(p);
+  if (it == cache.owned_chunks.end()) {
+    return false;
+  }
+
+  const size_t size_class = it->second;
+  cache.free_lists[size_class].push_back(p);
+  AddFromOwner(cache.cached_bytes, static_cast<int64_t>((size_class + 1) << kMinAllocationBits));
+
+  if (cache.cached_bytes.load(std::memory_order_relaxed) > thread_cache_max_bytes_) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    FlushThreadCache(cache, static_cast<size_t>(thread_cache_max_bytes_ / 2));
+  }
+
+  return true;
+}
+
+void BFCArena::DrainRemoteFrees(ThreadCache& cache) {
+  for (void* p : cache.remote_frees) {
+    auto it = cache.owned_chunks.find(p);
+    ORT_ENFORCE(it != cache.owned_chunks.end(), "Chunk freed by another thread is not owned by the thread cache.");
+    const size_t size_class = it->second;
+    cache.free_lists[size_class].push_back(p);
+    AddFromOwner(cache.cached_bytes, static_cast<int64_t>((size_class + 1) << kMinAllocationBits));
+  }
+
+  cache.remote_frees.clear();
+}
+
+void BFCArena::FlushThreadCache(ThreadCache& cache, size_t target_bytes) {
+  // return the largest chunks first
+  for (size_t size_class = ThreadCache::kNumSizeClasses; size_class-- > 0;) {
+    auto& free_list = cache.free_lists[size_class];
+    const int64_t chunk_bytes = static_cast<int64_t>((size_class + 1) << kMinAllocationBits);
+    while (!free_list.empty() &&
+           cache.cached_bytes.load(std::memory_order_relaxed) > static_cast<int64_t>(target_bytes)) {
+      void* p = free_list.back();
+      free_list.pop_back();
+      AddFromOwner(cache.cached_bytes, -chunk_bytes);
+
+      cache.owned_chunks.erase(p);
+      ChunkFromHandle(region_manager_.get_handle(p))->thread_cache = nullptr;
+      DeallocateRawInternal(p);
+    }
+  }
+}
+
+void BFCArena::ReleaseThreadCache(ThreadCache& cache) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  DrainRemoteFrees(cache);
+  FlushThreadCache(cache, 0);
+
+  // the remaining chunks are in use. they are freed directly to the arena from now on.
+  for (const auto& owned_chunk : cache.owned_chunks) {
+    ChunkFromHandle(region_manager_.get_handle(owned_chunk.first))->thread_cache = nullptr;
+  }
+
+  cache.owned_chunks.clear();
+
+  stats_.num_thread_cache_hits += cache.hits.load(std::memory_order_relaxed);
+  stats_.num_thread_cache_misses += cache.misses.load(std::memory_order_relaxed);
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -326,6 +564,18 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+  return FindChunkOrExtend(bin_num, rounded_bytes, num_bytes, dump_log_on_failure, stream,
+                           enable_cross_stream_reusing, wait_fn)
+      ->ptr;
+}
+
+BFCArena::Chunk* BFCArena::FindChunkOrExtend(BinNum bin_num,
+                                             size_t rounded_bytes,
+                                             size_t num_bytes,
+                                             bool dump_log_on_failure,
+                                             Stream* stream,
+                                             bool enable_cross_stream_reusing,
+                                             WaitNotificationFn wait_fn) {
   // search for a valid chunk
   auto* chunk = FindChunkPtr(bin_num,
                              rounded_bytes,
@@ -341,7 +591,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (stream)
         chunk->stream_timestamp = stream->GetCurrentTimestamp();
     }
-    return chunk->ptr;
+    return chunk;
   }
 
   LOGS_DEFAULT(INFO) << "Extending BFCArena for " << device_allocator_->Info().name
@@ -356,7 +606,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (chunk->stream == nullptr && stream) {
         chunk->stream = stream;
       }
-      return chunk->ptr;
+      return chunk;
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                                "Failed to find a free memory block despite calling Extend. rounded_bytes=",
@@ -377,8 +627,24 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 }
 
 void BFCArena::GetStats(AllocatorStats* stats) {
+  int64_t thread_cache_hits = 0;
+  int64_t thread_cache_misses = 0;
+  int64_t thread_cache_bytes = 0;
+  if (thread_cache_registry_) {
+    std::lock_guard<OrtMutex> lock(thread_cache_registry_->mutex);
+    for (const auto& cache : thread_cache_registry_->caches) {
+      thread_cache_hits += cache->hits.load(std::memory_order_relaxed);
+      thread_cache_misses += cache->misses.load(std::memory_order_relaxed);
+      thread_cache_bytes += cache->cached_bytes.load(std::memory_order_relaxed);
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  // stats_ holds the hits and misses of caches whose threads have exited
+  stats->num_thread_cache_hits += thread_cache_hits;
+  stats->num_thread_cache_misses += thread_cache_misses;
+  stats->thread_cache_bytes = thread_cache_bytes;
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -496,6 +762,11 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (thread_cache_registry_ && ThreadCacheFree(*GetThreadCache(), p)) {
+    return;
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -504,12 +775,31 @@ void BFCArena::Free(void* p) {
     stats_.total_allocated_bytes -= it->second;
     reserved_chunks_.erase(it);
   } else {
+    if (thread_cache_registry_) {
+      // hand chunks owned by another thread's cache back to it
+      BFCArena::ChunkHandle h = region_manager_.get_handle(p);
+      ORT_ENFORCE(h != kInvalidChunkHandle);
+      Chunk* c = ChunkFromHandle(h);
+      if (c->thread_cache != nullptr) {
+        c->thread_cache->remote_frees.push_back(p);
+        return;
+      }
+    }
+
     DeallocateRawInternal(p);
   }
 }
 
 Status BFCArena::Shrink() {
+  // the caller's thread cache must be looked up before taking lock_
+  ThreadCache* thread_cache = thread_cache_registry_ ? GetThreadCache() : nullptr;
+
   std::lock_guard<OrtMutex> lock(lock_);
+  if (thread_cache) {
+    DrainRemoteFrees(*thread_cache);
+    FlushThreadCache(*thread_cache, 0);
+  }
+
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
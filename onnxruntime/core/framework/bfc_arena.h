@@ -61,6 +61,7 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const int64_t DEFAULT_THREAD_CACHE_MAX_BYTES = 0;  // per-thread caching disabled
 
   enum ArenaType {
     BaseArena,
@@ -73,7 +74,8 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int64_t thread_cache_max_bytes = DEFAULT_THREAD_CACHE_MAX_BYTES);
 
   ~BFCArena() override;
 
@@ -86,7 +88,7 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
-  // Does not free any reserved chunks.
+  // Does not free any reserved chunks, or chunks held in the per-thread caches of threads other than the caller.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
   // future allocation sizes are determined by the arena growth strategy
@@ -97,6 +99,8 @@ class BFCArena : public IAllocator {
 
   void GetStats(AllocatorStats* stats) override;
 
+  // Not updated when an allocation is served from a per-thread cache, in which case the size requested when the
+  // chunk was first allocated from the arena is returned.
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
@@ -132,6 +136,10 @@ class BFCArena : public IAllocator {
   static const int kInvalidBinNum = -1;
   static const int kNumBins = 21;
 
+  // See the description of the per-thread caches below.
+  struct ThreadCache;
+  struct ThreadCacheRegistry;
+
   // Chunks point to memory.  Their prev/next pointers form a
   // doubly-linked list of addresses sorted by base address that
   // must be contiguous.  Chunks contain information about whether
@@ -170,6 +178,9 @@ class BFCArena : public IAllocator {
 
     uint64_t stream_timestamp = 0;
 
+    // The per-thread cache that owns this chunk, if any. Only set while the chunk is in use.
+    ThreadCache* thread_cache = nullptr;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -417,6 +428,40 @@ class BFCArena : public IAllocator {
 
   Chunk* ChunkFromHandle(ChunkHandle h);
 
+  // Per-thread front end to the arena, similar to the thread caches in tcmalloc.
+  //
+  // When enabled, chunks of up to kMaxThreadCacheChunkSize bytes allocated by a thread are owned by that thread's
+  // cache. Freeing an owned chunk puts it on a free list for its size class without taking lock_, and allocations of
+  // the same size class are served from that list. Misses take lock_ and allocate a small batch of chunks at once.
+  // When the cached bytes exceed thread_cache_max_bytes_, the cache returns chunks to the arena until it is half full.
+  //
+  // Chunks owned by a cache are in use from the arena's point of view. A chunk freed by a thread other than its
+  // owner is handed back to the owner under lock_ and picked up on the owner's next miss. All chunks are returned to
+  // the arena when the owning thread exits.
+  static const size_t kMaxThreadCacheChunkSize = 64 * 1024;
+  static const size_t kThreadCacheRefillBatch = 4;
+
+  ThreadCache* GetThreadCache();
+  void* ThreadCacheAlloc(ThreadCache& cache, size_t num_bytes);
+  // Returns false if `p` is not owned by `cache`
+  bool ThreadCacheFree(ThreadCache& cache, void* p);
+  // Moves chunks freed by other threads to the free lists of `cache`. Requires lock_ to be held.
+  void DrainRemoteFrees(ThreadCache& cache);
+  // Returns cached chunks to the arena until at most `target_bytes` are cached. Requires lock_ to be held.
+  void FlushThreadCache(ThreadCache& cache, size_t target_bytes);
+  // Returns all chunks owned by `cache` to the arena when its thread exits.
+  void ReleaseThreadCache(ThreadCache& cache);
+
+  // Finds a chunk for the allocation, extending the arena if needed. Throws if the allocation fails.
+  // Requires lock_ to be held.
+  BFCArena::Chunk* FindChunkOrExtend(BinNum bin_num,
+                                     size_t rounded_bytes,
+                                     size_t num_bytes,
+                                     bool dump_log_on_failure,
+                                     Stream* stream,
+                                     bool enable_cross_stream_reusing,
+                                     WaitNotificationFn wait_fn);
+
   // Information about a Bin that is useful for debugging.
   struct BinDebugInfo {
     size_t total_bytes_in_use = 0;
@@ -509,6 +554,12 @@ class BFCArena : public IAllocator {
   const int initial_growth_chunk_size_bytes_;
   const int64_t max_power_of_two_extend_bytes_;
 
+  // Maximum number of bytes kept in each thread's cache. 0 disables the per-thread caches.
+  const int64_t thread_cache_max_bytes_;
+  // Unique id of this arena used to look up the per-thread caches
+  const uint64_t thread_cache_arena_id_;
+  std::shared_ptr<ThreadCacheRegistry> thread_cache_registry_;
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/bump_allocator.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+BumpAllocator::BumpAllocator(AllocatorPtr backing_allocator, size_t max_region_bytes)
+    : IAllocator(backing_allocator->Info()),
+      backing_allocator_(std::move(backing_allocator)),
+      max_region_bytes_(max_region_bytes) {
+}
+
+void* BumpAllocator::Alloc(size_t size) {
+  // requests that can never fit are not counted towards the demand
+  if (size == 0 || size > max_region_bytes_) {
+    return nullptr;
+  }
+
+  const size_t aligned_size = (size + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment;
+  const size_t offset = offset_.fetch_add(aligned_size, std::memory_order_relaxed);
+  if (offset + aligned_size > region_size_) {
+    return nullptr;
+  }
+
+  num_allocs_.fetch_add(1, std::memory_order_relaxed);
+  total_allocated_bytes_.fetch_add(static_cast<int64_t>(aligned_size), std::memory_order_relaxed);
+  return static_cast<char*>(region_.get()) + offset;
+}
+
+void BumpAllocator::Free(void* /*p*/) {
+  // released by Reset()
+}
+
+void BumpAllocator::GetStats(AllocatorStats* stats) {
+  stats->Clear();
+  stats->num_allocs = num_allocs_.load(std::memory_order_relaxed);
+  stats->num_reserves = num_reserves_;
+  stats->bytes_in_use = static_cast<int64_t>(std::min(offset_.load(std::memory_order_relaxed), region_size_));
+  stats->total_allocated_bytes = total_allocated_bytes_.load(std::memory_order_relaxed);
+  stats->bytes_limit = static_cast<int64_t>(max_region_bytes_);
+}
+
+void BumpAllocator::Reserve() {
+  ORT_ENFORCE(offset_.load(std::memory_order_relaxed) == 0, "Reserve() must be called after Reset().");
+
+  const size_t required_size = std::min(last_demand_, max_region_bytes_);
+  if (required_size <= region_size_) {
+    return;
+  }
+
+  // free the current region first so the backing allocator can reuse its memory for the new one
+  region_.reset();
+  region_size_ = 0;
+
+  void* buffer = nullptr;
+  ORT_TRY {
+    buffer = backing_allocator_->Alloc(required_size);
+  }
+  ORT_CATCH(const std::exception&) {
+    // run without a region. allocations fall back to the caller's allocator.
+  }
+
+  if (buffer != nullptr) {
+    region_ = BufferUniquePtr(buffer, BufferDeleter(backing_allocator_));
+    region_size_ = required_size;
+    ++num_reserves_;
+  }
+}
+
+void BumpAllocator::Reset() noexcept {
+  last_demand_ = offset_.exchange(0, std::memory_order_relaxed);
+}
+
+BumpAllocatorPool::BumpAllocatorPool(AllocatorPtr backing_allocator, size_t max_region_bytes)
+    : backing_allocator_(std::move(backing_allocator)),
+      max_region_bytes_(max_region_bytes),
+      free_list_(std::make_shared<FreeList>()) {
+}
+
+std::shared_ptr<BumpAllocator> BumpAllocatorPool::Acquire() {
+  std::unique_ptr<BumpAllocator> allocator;
+  {
+    std::lock_guard<OrtMutex> lock(free_list_->mutex);
+    if (!free_list_->allocators.empty()) {
+      allocator = std::move(free_list_->allocators.back());
+      free_list_->allocators.pop_back();
+    }
+  }
+
+  if (!allocator) {
+    allocator = std::make_unique<BumpAllocator>(backing_allocator_, max_region_bytes_);
+  }
+
+  allocator->Reserve();
+
+  return std::shared_ptr<BumpAllocator>(allocator.release(),
+                                        [free_list = free_list_](BumpAllocator* released) {
+                                          std::unique_ptr<BumpAllocator> owned(released);
+                                          owned->Reset();
+                                          std::lock_guard<OrtMutex> lock(free_list->mutex);
+                                          free_list->allocators.push_back(std::move(owned));
+                                        });
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "core/framework/allocator.h"
+#include "core/framework/buffer_deleter.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+Allocator that serves allocations from a single contiguous region by bumping an offset.
+
+Free() is a no-op. All allocations are released at once by Reset(), so it is only suitable for buffers that have a
+bounded and common lifetime such as the intermediate tensors of a single run.
+Alloc() returns nullptr once the region is exhausted, and the caller is expected to fall back to another allocator.
+The total size requested between resets is recorded, and the next Reserve() grows the region to fit it, up to the
+maximum size, so after the first few uses of an allocator all allocations are usually served from the region.
+
+Alloc() is thread-safe. Reserve() and Reset() must not be called concurrently with other methods.
+*/
+class BumpAllocator : public IAllocator {
+ public:
+  // backing_allocator provides the region. allocations report the backing allocator's OrtMemoryInfo.
+  BumpAllocator(AllocatorPtr backing_allocator, size_t max_region_bytes);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+  // num_allocs and total_allocated_bytes count the allocations served from the region over the lifetime of the
+  // allocator. bytes_in_use is the part of the region in use since the last reset.
+  void GetStats(AllocatorStats* stats) override;
+
+  // Grow the region if the demand since the last reset exceeded it.
+  void Reserve();
+
+  // Release all allocations. Never throws.
+  void Reset() noexcept;
+
+  size_t RegionSize() const { return region_size_; }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BumpAllocator);
+
+ private:
+  AllocatorPtr backing_allocator_;
+  const size_t max_region_bytes_;
+
+  BufferUniquePtr region_;
+  size_t region_size_{0};
+
+  // bytes requested since the last reset, including any that did not fit in the region
+  std::atomic<size_t> offset_{0};
+  // value of offset_ at the last reset
+  size_t last_demand_{0};
+
+  std::atomic<int64_t> num_allocs_{0};
+  std::atomic<int64_t> total_allocated_bytes_{0};
+  int64_t num_reserves_{0};
+};
+
+/**
+Pool of BumpAllocator instances so that concurrent runs each get their own allocator, and the regions are reused
+across runs instead of being allocated each time.
+*/
+class BumpAllocatorPool {
+ public:
+  BumpAllocatorPool(AllocatorPtr backing_allocator, size_t max_region_bytes);
+
+  /**
+  Get an allocator for exclusive use by the caller.
+  The allocator is reset and returned to the pool when the last reference to it is released, so buffers allocated
+  from it remain valid as long as they hold a reference (e.g. as the deleter of a Tensor).
+  The most recently returned allocator is handed out first as its region is the most likely to be in cache.
+  */
+  std::shared_ptr<BumpAllocator> Acquire();
+
+ private:
+  struct FreeList {
+    OrtMutex mutex;
+    std::vector<std::unique_ptr<BumpAllocator>> allocators;
+  };
+
+  AllocatorPtr backing_allocator_;
+  const size_t max_region_bytes_;
+  // shared with the deleters of the allocators that are in use so the pool can be destroyed before them
+  std::shared_ptr<FreeList> free_list_;
+};
+
+}  // namespace onnxruntime
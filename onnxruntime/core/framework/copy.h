@@ -8,6 +8,8 @@
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 
+#include <array>
+#include <utility>
 #include <vector>
 
 namespace onnxruntime {
@@ -45,6 +47,9 @@ void Copy1D(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::p
   } else {
     if (dst_stride == 1 && src_stride == 1) {
       Copy1DContiguous(dst, src, count);
+    } else if (dst_stride == 1 && src_stride == 0) {
+      // broadcasting a single value
+      std::fill_n(dst, count, src[0]);
     } else {
       Copy1DNonContiguous(dst, dst_stride, src, src_stride, count);
     }
@@ -102,8 +107,79 @@ struct NdCounter {
   TensorShapeVector current_index;
   const TensorShapeVector& shape;
 };
+
+template <size_t N, size_t... I>
+void CoalesceDimensions(std::array<TensorShapeVector, N>& tensors_strides, TensorShapeVector& shape,
+                        std::index_sequence<I...>) {
+  ::onnxruntime::CoalesceDimensions({std::ref(tensors_strides[I])...}, shape);
+}
 }  // namespace strided_copy_detail
 
+/*
+    Iterate over `shape_in` in spans along the innermost dimension, with the spans split across the thread pool.
+
+    `strides_in` holds the strides, in elements, of N tensors that are indexed by `shape_in`. A stride of 0 broadcasts
+    the tensor along the dimension. The dimensions are coalesced first, so that the spans are as long as possible.
+
+    fn(offsets, inner_strides, count) is called for each span, where offsets[i] is the offset of the span in tensor i
+    and the span advances by inner_strides[i] per element in tensor i. Spans may be split between threads.
+*/
+template <size_t N, typename Fn>
+void StridedForEachSpan(concurrency::ThreadPool* thread_pool,
+                        const TensorShape& shape_in,
+                        const std::array<TensorShapeVector, N>& strides_in,
+                        const TensorOpCost& cost_per_element,
+                        const Fn& fn) {
+  using Offsets = std::array<std::ptrdiff_t, N>;
+
+  const int64_t total_num_elements = shape_in.Size();
+  ORT_ENFORCE(total_num_elements >= 0, "shape must have non-negative size");
+  if (total_num_elements == 0) {
+    return;
+  }
+
+  if (shape_in.NumDimensions() == 0) {
+    Offsets offsets{};
+    Offsets inner_strides{};
+    fn(offsets, inner_strides, std::ptrdiff_t{1});
+    return;
+  }
+
+  std::array<TensorShapeVector, N> strides(strides_in);
+  TensorShapeVector shape = shape_in.AsShapeVector();
+  for (const auto& tensor_strides : strides) {
+    ORT_ENFORCE(tensor_strides.size() == shape.size(), "strides must have the same rank as the shape.");
+  }
+  strided_copy_detail::CoalesceDimensions(strides, shape, std::make_index_sequence<N>{});
+
+  const std::size_t dims = shape.size();
+  Offsets inner_strides;
+  for (size_t i = 0; i < N; i++) {
+    inner_strides[i] = static_cast<std::ptrdiff_t>(strides[i][dims - 1]);
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(total_num_elements), cost_per_element,
+      [&shape, &strides, &inner_strides, &fn, dims](std::ptrdiff_t first, std::ptrdiff_t last) {
+        strided_copy_detail::NdCounter counter(shape, first, last);
+
+        auto span_size = counter.NextStepSize();
+        while (span_size > 0) {
+          Offsets offsets{};
+          for (std::size_t dim = 0; dim < dims; dim++) {
+            for (size_t i = 0; i < N; i++) {
+              offsets[i] += static_cast<std::ptrdiff_t>(counter.current_index[dim] * strides[i][dim]);
+            }
+          }
+          fn(offsets, inner_strides, span_size);
+
+          counter.Step(span_size);
+          span_size = counter.NextStepSize();
+        }
+        ORT_ENFORCE(counter.current_offset == last);
+      });
+}
+
 template <typename T>
 void StridedCopy(concurrency::ThreadPool* thread_pool,
                  T* dst,
@@ -194,37 +270,12 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
           strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, last_span_size);
         });
   } else {
-    // enforce that the lambda doesn't change anything
-    const TensorShapeVector& const_dst_strides = dst_strides;
-    const TensorShapeVector& const_src_strides = src_strides;
-    const TensorShapeVector& const_copy_shape = copy_shape;
-
-    concurrency::ThreadPool::TryParallelFor(
-        thread_pool, static_cast<std::ptrdiff_t>(total_num_elements_to_copy),
+    StridedForEachSpan<2>(
+        thread_pool, TensorShape(copy_shape), {dst_strides, src_strides},
         {static_cast<float>(sizeof(T)), static_cast<float>(sizeof(T)), 1.0F},
-        [&const_copy_shape, &const_dst_strides, dst, src, &const_src_strides, dims](std::ptrdiff_t first,
-                                                                                    std::ptrdiff_t last) {
-          strided_copy_detail::NdCounter counter(const_copy_shape, first, last);
-
-          auto last_dst_stride = const_dst_strides[dims - 1];
-          auto last_src_stride = const_src_strides[dims - 1];
-
-          auto iter_size = counter.NextStepSize();
-          while (iter_size > 0) {
-            // Compute the src and dst addresses
-            std::ptrdiff_t dst_idx = 0;
-            std::ptrdiff_t src_idx = 0;
-            for (std::size_t dim = 0; dim < dims; dim++) {
-              dst_idx += static_cast<std::ptrdiff_t>(counter.current_index[dim] * const_dst_strides[dim]);
-              src_idx += static_cast<std::ptrdiff_t>(counter.current_index[dim] * const_src_strides[dim]);
-            }
-            // we can copy until the current dimension is done (or until we hit the last element we are trying to copy)
-            strided_copy_detail::Copy1D<T>(dst + dst_idx, last_dst_stride, src + src_idx, last_src_stride, iter_size);
-
-            counter.Step(iter_size);
-            iter_size = counter.NextStepSize();
-          }
-          ORT_ENFORCE(counter.current_offset == last);
+        [dst, src](const std::array<std::ptrdiff_t, 2>& offsets, const std::array<std::ptrdiff_t, 2>& inner_strides,
+                   std::ptrdiff_t count) {
+          strided_copy_detail::Copy1D<T>(dst + offsets[0], inner_strides[0], src + offsets[1], inner_strides[1], count);
         });
   }
 }
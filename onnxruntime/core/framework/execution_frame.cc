@@ -3,6 +3,7 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
@@ -348,9 +349,10 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       device_streams_(device_streams),
 #endif
       session_state_(session_state),
+      numa_node_(session_state.GetCurrentNumaNode()),
       mem_patterns_(nullptr) {
   Init(
-      feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
+      feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(numa_node_),
 #if !defined(DISABLE_SPARSE_TENSORS)
       [&session_state](const std::string& name) -> bool {
         int idx = -1;
@@ -382,6 +384,8 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
     }
   }
 
+  run_allocator_ = session_state.AcquireRunBumpAllocator();
+
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
@@ -397,11 +401,18 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+      mem_pattern_entry_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs);
       // if no existing patterns, generate one in this execution frame
-      if (!mem_patterns_) {
+      if (!mem_pattern_entry_) {
         planner_.emplace(*session_state.GetExecutionPlan());
       } else {
+        mem_patterns_ = &mem_pattern_entry_->mem_patterns;
+        inferred_shapes_ = &mem_pattern_entry_->inferred_shapes;
+        // with bucketed input shapes the run may need larger blocks than the patterns have. trace it so that the
+        // patterns can be grown to cover it. see ShouldUpdateMemoryPatterns().
+        if (session_state.IsMemoryPatternBucketed()) {
+          planner_.emplace(*session_state.GetExecutionPlan());
+        }
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         buffers_.reserve(mem_patterns_->locations.size());
@@ -539,6 +550,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   // try to allocate on pre-allocated big chunk.
   const auto& per_alloc_plan = GetAllocationPlan(ort_value_index);
 
+  // size to trace the allocation with. when tracing a run that uses bucketed patterns this is the larger of the
+  // block and the tensor, so that the traced patterns cover both.
+  size_t trace_size = size;
+
   if (mem_patterns_ && per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput &&
       per_alloc_plan.alloc_kind != AllocKind::kAllocatedExternally) {
     auto pattern = mem_patterns_->GetPatterns(location);
@@ -546,16 +561,26 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       auto block = pattern->GetBlock(ort_value_index);
       // if block not found, fall back to default behavior
       if (block) {
+        trace_size = std::max(size, block->size_);
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // with bucketed input shapes the pattern may be for a larger shape in the same bucket, in which case any
+          // block that is large enough can be used.
+          if (block->size_ == size || (size < block->size_ && session_state_.IsMemoryPatternBucketed())) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+            if (status.IsOK()) {
+              TraceAllocate(ort_value_index, trace_size);
+            }
             return status;
           } else {
+            if (size > block->size_ && session_state_.IsMemoryPatternBucketed()) {
+              mem_patterns_outgrown_ = true;
+            }
+
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
             // fed in, so use VERBOSE as the log level as it's expected.
             // TODO: Should we reuse the block if the size is large enough? Would probably need to allow it
@@ -571,6 +596,20 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     }
   }
 
+  // allocate intermediate tensors from the per-run region if there's space left. string tensors are excluded as
+  // their destructor accesses the buffer, which may already be in use by another run at that point.
+  if (run_allocator_ && location == run_allocator_->Info().device &&
+      per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput &&
+      per_alloc_plan.alloc_kind != AllocKind::kAllocatedExternally &&
+      !utils::IsDataTypeString(element_type)) {
+    void* buffer = run_allocator_->Alloc(size);
+    if (buffer != nullptr) {
+      Tensor::InitOrtValue(element_type, shape, buffer, run_allocator_, ort_value);
+      TraceAllocate(ort_value_index, trace_size);
+      return Status::OK();
+    }
+  }
+
   // no memory pattern, or the pattern is not correct.
   if (!alloc) alloc = GetAllocator(location);
   ORT_ENFORCE(alloc && alloc.get() != nullptr, "Failed to get allocator for ", location.ToString());
@@ -600,7 +639,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   // don't trace the memory allocation on string tensors, as it need
   // placement new, we don't support it in memory pattern optimization.
   if (!utils::IsDataTypeString(element_type)) {
-    TraceAllocate(ort_value_index, size);
+    TraceAllocate(ort_value_index, trace_size);
   }
 
   {
@@ -3,13 +3,16 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
+#include "core/framework/bump_allocator.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/memory_pattern_cache.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -164,6 +167,15 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_.has_value();
   }
 
+  // Whether the memory patterns traced by this run should be added to the cache: either there were none for the
+  // input shapes, or the bucketed patterns that were used had blocks that were too small for some tensors.
+  bool ShouldUpdateMemoryPatterns() const {
+    return planner_.has_value() && (mem_patterns_ == nullptr || mem_patterns_outgrown_);
+  }
+
+  // NUMA node the frame was created on. Selects the intra-op thread pool and initializer copies used by the run.
+  size_t GetNumaNode() const noexcept { return numa_node_; }
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrival is sucessful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
@@ -223,21 +235,34 @@ class ExecutionFrame final : public IExecutionFrame {
 
   const SessionState& session_state_;
 
+  const size_t numa_node_;
+
   // map of index to custom allocator
   InlinedHashMap<int, IExecutor::CustomAllocator> custom_allocators_;
 
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
+  // mem_patterns_ and inferred_shapes_ point into it.
+  std::shared_ptr<const MemoryPatternCache::Entry> mem_pattern_entry_;
   const MemoryPatternGroup* mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
+  // Also used with bucketed patterns, to grow them if they are too small for this run.
   std::optional<OrtValuePatternPlanner> planner_;
 
+  // Set if a bucketed pattern had a block that was too small for a tensor of this run.
+  std::atomic<bool> mem_patterns_outgrown_{false};
+
   // Big chunks on different locations that will be used by mem_pattern.
   InlinedHashMap<OrtDevice, BufferUniquePtr> buffers_;
 
+  // Allocator for the intermediate CPU tensors that are not covered by a memory pattern. nullptr if not enabled.
+  // Tensors allocated from it hold a reference to it, so its region is released once the frame and all those tensors
+  // are destroyed.
+  std::shared_ptr<BumpAllocator> run_allocator_;
+
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
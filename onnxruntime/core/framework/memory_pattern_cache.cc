@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_pattern_cache.h"
+
+#include <algorithm>
+
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// whether the blocks of `patterns` are at least as large as those of `existing`, and at least one is larger
+bool GrowsPatterns(const MemoryPatternGroup& patterns, const MemoryPatternGroup& existing) {
+  bool grows = false;
+  for (size_t i = 0; i < existing.locations.size(); ++i) {
+    const MemoryPattern* pattern = patterns.GetPatterns(existing.locations[i]);
+    if (pattern == nullptr) {
+      return false;
+    }
+
+    for (const auto& [ort_value_idx, existing_block] : existing.patterns[i].GetPatternsMap()) {
+      const MemoryBlock* block = pattern->GetBlock(ort_value_idx);
+      if (block == nullptr || block->size_ < existing_block.size_) {
+        return false;
+      }
+
+      grows = grows || block->size_ > existing_block.size_;
+    }
+  }
+
+  return grows;
+}
+
+}  // namespace
+
+void MemoryPatternCache::Configure(InlinedVector<int64_t> dim_buckets, size_t capacity) {
+  ORT_ENFORCE(std::is_sorted(dim_buckets.begin(), dim_buckets.end()),
+              "Memory pattern dim buckets must be in ascending order.");
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ORT_ENFORCE(entries_.empty(), "Memory pattern cache must be configured before it is used.");
+  dim_buckets_ = std::move(dim_buckets);
+  capacity_ = capacity;
+}
+
+int64_t MemoryPatternCache::RoundUpToBucket(int64_t dim) const {
+  auto it = std::lower_bound(dim_buckets_.begin(), dim_buckets_.end(), dim);
+  return it != dim_buckets_.end() ? *it : dim;
+}
+
+int64_t MemoryPatternCache::CalculateKey(gsl::span<const OrtValue> tensor_inputs) const {
+  // include the rank of each input so that e.g. {2, 3} and {2}, {3} produce different keys
+  uint64_t key = 0;
+  auto combine = [&key](int64_t value) {
+    key ^= static_cast<uint64_t>(value) + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+  };
+
+  for (const auto& input : tensor_inputs) {
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    combine(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) {
+      combine(dim_buckets_.empty() ? dim : RoundUpToBucket(dim));
+    }
+  }
+
+  return static_cast<int64_t>(key);
+}
+
+std::shared_ptr<const MemoryPatternCache::Entry> MemoryPatternCache::Find(int64_t key) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+
+  ++hits_;
+  lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+  return it->second->second;
+}
+
+std::shared_ptr<const MemoryPatternCache::Entry> MemoryPatternCache::Insert(int64_t key, Entry&& entry,
+                                                                            bool overwrite) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    if (overwrite) {
+      it->second->second = std::make_shared<const Entry>(std::move(entry));
+    }
+
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+    return it->second->second;
+  }
+
+  lru_list_.emplace_front(key, std::make_shared<const Entry>(std::move(entry)));
+  entries_.emplace(key, lru_list_.begin());
+
+  if (capacity_ > 0 && entries_.size() > capacity_) {
+    entries_.erase(lru_list_.back().first);
+    lru_list_.pop_back();
+    ++evictions_;
+  }
+
+  return lru_list_.front().second;
+}
+
+std::shared_ptr<const MemoryPatternCache::Entry> MemoryPatternCache::InsertOrGrow(int64_t key, Entry&& entry) {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      if (GrowsPatterns(entry.mem_patterns, it->second->second->mem_patterns)) {
+        it->second->second = std::make_shared<const Entry>(std::move(entry));
+      }
+
+      lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+      return it->second->second;
+    }
+  }
+
+  return Insert(key, std::move(entry));
+}
+
+MemoryPatternCacheStats MemoryPatternCache::GetStats() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  MemoryPatternCacheStats stats;
+  stats.num_entries = entries_.size();
+  stats.capacity = capacity_;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  return stats;
+}
+
+}  // namespace onnxruntime
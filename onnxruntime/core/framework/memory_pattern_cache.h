@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+struct MemoryPatternCacheStats {
+  size_t num_entries{0};
+  // maximum number of entries. 0 if the cache is unbounded.
+  size_t capacity{0};
+  uint64_t hits{0};
+  uint64_t misses{0};
+  uint64_t evictions{0};
+};
+
+/**
+Thread-safe cache of the memory patterns generated for a graph, keyed by the shapes of the graph inputs.
+
+By default every distinct set of input shapes gets its own entry, which for variable length inputs means the cache
+rarely hits and grows without bound. Two options address that:
+  - dim buckets: each input dim is rounded up to the smallest bucket boundary that is >= the dim before computing the
+    key, so all input shapes in the same buckets share a pattern. A pattern generated for the largest shapes in a
+    bucket covers all smaller ones, which is what PrewarmMemoryPatterns() on the session is intended for. A run that
+    needs larger blocks than the pattern of its bucket has grows the pattern with InsertOrGrow().
+    Dims larger than the last boundary are used as is.
+  - capacity: the maximum number of entries. The least recently used entry is evicted when it is exceeded.
+
+Entries are handed out as shared pointers so an entry that is evicted stays valid for runs that are using it.
+*/
+class MemoryPatternCache {
+ public:
+  struct Entry {
+    MemoryPatternGroup mem_patterns;
+    // shapes inferred for the values in the graph when the patterns were generated.
+    // only populated in training builds. see SessionState::GeneratePatternGroupCache.
+    InlinedHashMap<int, TensorShape> inferred_shapes;
+  };
+
+  MemoryPatternCache() = default;
+
+  // dim_buckets must be in ascending order. empty to use the exact input shapes. capacity of 0 means unbounded.
+  void Configure(InlinedVector<int64_t> dim_buckets, size_t capacity);
+
+  bool IsBucketed() const { return !dim_buckets_.empty(); }
+
+  int64_t CalculateKey(gsl::span<const OrtValue> tensor_inputs) const;
+
+  // Returns the entry for the key or nullptr if there is none. Marks the entry as most recently used.
+  std::shared_ptr<const Entry> Find(int64_t key);
+
+  // Adds an entry for the key. An existing entry is only replaced if overwrite is true.
+  // Returns the entry stored for the key.
+  std::shared_ptr<const Entry> Insert(int64_t key, Entry&& entry, bool overwrite = false);
+
+  // Adds an entry for the key, or replaces the existing one if the new patterns grow it: every block of the existing
+  // patterns has a block at least as large in the new ones, and at least one of them is larger.
+  // Returns the entry stored for the key.
+  std::shared_ptr<const Entry> InsertOrGrow(int64_t key, Entry&& entry);
+
+  MemoryPatternCacheStats GetStats() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryPatternCache);
+
+ private:
+  int64_t RoundUpToBucket(int64_t dim) const;
+
+  InlinedVector<int64_t> dim_buckets_;
+  size_t capacity_{0};
+
+  mutable OrtMutex mutex_;
+  // most recently used entry at the front
+  using LruList = std::list<std::pair<int64_t, std::shared_ptr<const Entry>>>;
+  LruList lru_list_;
+  InlinedHashMap<int64_t, LruList::iterator> entries_;
+
+  uint64_t hits_{0};
+  uint64_t misses_{0};
+  uint64_t evictions_{0};
+};
+
+}  // namespace onnxruntime
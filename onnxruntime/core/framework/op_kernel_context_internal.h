@@ -17,13 +17,15 @@ class ExecutionFrame;
 
 class OpKernelContextInternal : public OpKernelContext {
  public:
+  // threadpool is the intra-op thread pool of the run
   explicit OpKernelContextInternal(const SessionState& session_state,
                                    IExecutionFrame& frame,
                                    const OpKernel& kernel,
+                                   concurrency::ThreadPool* threadpool,
                                    const logging::Logger& logger,
                                    const bool& terminate_flag,
                                    Stream* stream)
-      : OpKernelContext(&frame, &kernel, stream, session_state.GetThreadPool(), logger),
+      : OpKernelContext(&frame, &kernel, stream, threadpool, logger),
         session_state_(session_state),
         terminate_flag_(terminate_flag) {
     const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
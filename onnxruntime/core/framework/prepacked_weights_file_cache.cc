@@ -0,0 +1,386 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', 'C', '2'};
+
+// pre-packed buffers are stored at this alignment in the file. the file is mapped at a page boundary so this matches
+// the alignment the kernels get from the allocators used in PrePack().
+constexpr size_t kBufferAlignment = 64;
+
+// MLAS selects its packing format based on the architecture and the instruction set extensions of the CPU,
+// and the format may change between releases.
+std::string GetPlatformSignature() {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  std::ostringstream ss;
+  ss << "ort:" << ORT_VERSION
+     << ";ptr:" << sizeof(void*)
+     << ";avx:" << cpuid_info.HasAVX()
+     << ";avx2:" << cpuid_info.HasAVX2()
+     << ";avx512f:" << cpuid_info.HasAVX512f()
+     << ";avx512skx:" << cpuid_info.HasAVX512Skylake()
+     << ";avx512bf16:" << cpuid_info.HasAVX512_BF16()
+     << ";avx512fp16:" << cpuid_info.HasAVX512_FP16()
+     << ";amxbf16:" << cpuid_info.HasAMX_BF16()
+     << ";amxint8:" << cpuid_info.HasAMX_INT8()
+     << ";f16c:" << cpuid_info.HasF16C()
+     << ";sse41:" << cpuid_info.HasSSE4_1()
+     << ";neondot:" << cpuid_info.HasArmNeonDot()
+     << ";neoni8mm:" << cpuid_info.HasArmNeon_I8MM()
+     << ";svei8mm:" << cpuid_info.HasArmSVE_I8MM()
+     << ";fp16:" << cpuid_info.HasFp16VectorAcceleration();
+  return ss.str();
+}
+
+// 128-bit MurmurHash3 of a buffer that may be larger than what a single call can handle
+void HashBuffer(const void* data, size_t len, uint32_t (&hash)[4]) {
+  constexpr size_t kMaxChunkSize = size_t{1} << 30;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  do {
+    const size_t chunk_size = std::min(len, kMaxChunkSize);
+    MurmurHash3::x86_128(bytes, static_cast<int>(chunk_size), hash[0], &hash);
+    bytes += chunk_size;
+    len -= chunk_size;
+  } while (len > 0);
+}
+
+// checksum of the contents of the buffers of an entry, so that a corrupted entry is detected when the file is loaded
+void HashWeights(const PrePackedWeights& weights, uint32_t (&hash)[4]) {
+  for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+    if (weights.buffers_[i] != nullptr && weights.buffer_sizes_[i] > 0) {
+      HashBuffer(weights.buffers_[i].get(), weights.buffer_sizes_[i], hash);
+    }
+  }
+}
+
+int RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  return _wremove(path.c_str());
+#else
+  return std::remove(path.c_str());
+#endif
+}
+
+size_t AlignUp(size_t value) {
+  return (value + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+template <typename T>
+void AppendPod(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Bounds checked reader over the mapped file
+class FileReader {
+ public:
+  FileReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool ReadPod(T& value) {
+    if (size_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    uint32_t length = 0;
+    if (!ReadPod(length) || size_ - offset_ < length) {
+      return false;
+    }
+    value.assign(data_ + offset_, length);
+    offset_ += length;
+    return true;
+  }
+
+  bool IsValidRange(uint64_t offset, uint64_t length) const {
+    return offset <= size_ && length <= size_ - offset;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+}  // namespace
+
+Status PrepackedWeightsFileCache::Load(const Env& env, const logging::Logger& logger) {
+  size_t file_length = 0;
+  if (!env.GetFileLength(file_path_.c_str(), file_length).IsOK() || file_length == 0) {
+    LOGS(logger, INFO) << "Pre-packed weights cache file " << ToUTF8String(file_path_)
+                       << " does not exist yet. It will be created.";
+    return Status::OK();
+  }
+
+  Env::MappedMemoryPtr mapped_file;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path_.c_str(), 0, file_length, mapped_file));
+
+  FileReader reader(mapped_file.get(), file_length);
+  auto ignore_file = [&logger, this](const char* reason) {
+    LOGS(logger, WARNING) << "Ignoring pre-packed weights cache file " << ToUTF8String(file_path_) << ": " << reason;
+    prepacked_weights_map_.clear();
+    return Status::OK();
+  };
+
+  char magic[sizeof(kFileMagic)];
+  for (auto& c : magic) {
+    if (!reader.ReadPod(c)) {
+      return ignore_file("file is truncated");
+    }
+  }
+  if (memcmp(magic, kFileMagic, sizeof(kFileMagic)) != 0) {
+    return ignore_file("not a pre-packed weights cache file");
+  }
+
+  std::string platform_signature;
+  if (!reader.ReadString(platform_signature)) {
+    return ignore_file("file is truncated");
+  }
+  if (platform_signature != GetPlatformSignature()) {
+    return ignore_file("file was written by a different ORT version or for a different CPU");
+  }
+
+  uint64_t number_of_weights = 0;
+  if (!reader.ReadPod(number_of_weights)) {
+    return ignore_file("file is truncated");
+  }
+
+  for (uint64_t i = 0; i < number_of_weights; ++i) {
+    std::string key;
+    uint32_t number_of_buffers = 0;
+    if (!reader.ReadString(key) || !reader.ReadPod(number_of_buffers)) {
+      return ignore_file("file is truncated");
+    }
+
+    PrePackedWeights weights;
+    for (uint32_t j = 0; j < number_of_buffers; ++j) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      if (!reader.ReadPod(offset) || !reader.ReadPod(size)) {
+        return ignore_file("file is truncated");
+      }
+
+      // an offset of 0 denotes a place-holder buffer that was null when the weights were persisted
+      void* buffer = nullptr;
+      if (offset != 0) {
+        if (!reader.IsValidRange(offset, size)) {
+          return ignore_file("buffer is out of bounds");
+        }
+        buffer = mapped_file.get() + offset;
+      }
+
+      // the buffers are owned by the mapping so nothing needs to be freed
+      weights.buffers_.push_back(IAllocatorUniquePtr<void>(buffer, [](void*) {}));
+      weights.buffer_sizes_.push_back(static_cast<size_t>(size));
+    }
+
+    uint32_t checksum[4];
+    for (auto& value : checksum) {
+      if (!reader.ReadPod(value)) {
+        return ignore_file("file is truncated");
+      }
+    }
+
+    // a corrupted entry is dropped so that the weights are pre-packed again and the file is rewritten
+    uint32_t hash[4] = {0, 0, 0, 0};
+    HashWeights(weights, hash);
+    if (memcmp(hash, checksum, sizeof(hash)) != 0) {
+      LOGS(logger, WARNING) << "Ignoring corrupted entry " << key << " of pre-packed weights cache file "
+                            << ToUTF8String(file_path_);
+      continue;
+    }
+
+    prepacked_weights_map_.insert(std::make_pair(std::move(key), std::move(weights)));
+  }
+
+  mapped_file_ = std::move(mapped_file);
+
+  LOGS(logger, INFO) << "Loaded " << prepacked_weights_map_.size() << " pre-packed weights from "
+                     << ToUTF8String(file_path_);
+  return Status::OK();
+}
+
+Status PrepackedWeightsFileCache::Save(const Env& env) const {
+  if (number_of_new_weights_ == 0) {
+    return Status::OK();
+  }
+
+  // sort by key so the file contents don't depend on the order the weights were packed in
+  std::vector<const std::pair<const std::string, PrePackedWeights>*> entries;
+  entries.reserve(prepacked_weights_map_.size());
+  for (const auto& entry : prepacked_weights_map_) {
+    entries.push_back(&entry);
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+
+  // the header size is needed to compute the buffer offsets, so compute the layout before serializing
+  const std::string platform_signature = GetPlatformSignature();
+  size_t header_size = sizeof(kFileMagic) + sizeof(uint32_t) + platform_signature.size() + sizeof(uint64_t);
+  for (const auto* entry : entries) {
+    header_size += sizeof(uint32_t) + entry->first.size() + sizeof(uint32_t) +
+                   entry->second.buffers_.size() * 2 * sizeof(uint64_t) + 4 * sizeof(uint32_t);
+  }
+
+  std::string header;
+  header.reserve(header_size);
+  header.append(kFileMagic, sizeof(kFileMagic));
+  AppendPod(header, static_cast<uint32_t>(platform_signature.size()));
+  header.append(platform_signature);
+  AppendPod(header, static_cast<uint64_t>(entries.size()));
+
+  size_t data_offset = AlignUp(header_size);
+  for (const auto* entry : entries) {
+    const auto& weights = entry->second;
+    AppendPod(header, static_cast<uint32_t>(entry->first.size()));
+    header.append(entry->first);
+    AppendPod(header, static_cast<uint32_t>(weights.buffers_.size()));
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      const bool is_placeholder = weights.buffers_[i] == nullptr;
+      AppendPod(header, static_cast<uint64_t>(is_placeholder ? 0 : data_offset));
+      AppendPod(header, static_cast<uint64_t>(weights.buffer_sizes_[i]));
+      if (!is_placeholder) {
+        data_offset = AlignUp(data_offset + weights.buffer_sizes_[i]);
+      }
+    }
+
+    uint32_t checksum[4] = {0, 0, 0, 0};
+    HashWeights(weights, checksum);
+    for (uint32_t value : checksum) {
+      AppendPod(header, value);
+    }
+  }
+  ORT_ENFORCE(header.size() == header_size, "Pre-packed weights cache header size mismatch.");
+
+  // write to a temporary file and rename it so that other processes never see a partially written cache.
+  // the existing file may be mapped by this process, which is fine as the mapping keeps the old contents alive.
+  // the temporary file name is unique so that sessions saving the same cache concurrently don't write to one file.
+  std::ostringstream temp_file_suffix;
+  temp_file_suffix << "." << env.GetSelfPid() << "." << std::hex << std::random_device{}() << ".tmp";
+  const PathString temp_file_path = file_path_ + ToPathString(temp_file_suffix.str());
+  {
+    std::ofstream file(temp_file_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(file.good(), "Failed to open ", ToUTF8String(temp_file_path), " for writing.");
+
+    const char padding[kBufferAlignment] = {};
+    size_t written = 0;
+    auto write = [&file, &written](const void* data, size_t size) {
+      file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+      written += size;
+    };
+
+    write(header.data(), header.size());
+    for (const auto* entry : entries) {
+      const auto& weights = entry->second;
+      for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+        if (weights.buffers_[i] == nullptr) {
+          continue;
+        }
+        write(padding, AlignUp(written) - written);
+        write(weights.buffers_[i].get(), weights.buffer_sizes_[i]);
+      }
+    }
+
+    file.flush();
+    if (!file.good()) {
+      file.close();
+      RemoveFile(temp_file_path);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write pre-packed weights to ",
+                             ToUTF8String(temp_file_path));
+    }
+  }
+
+#ifdef _WIN32
+  const int rename_result = _wrename(temp_file_path.c_str(), file_path_.c_str());
+#else
+  const int rename_result = std::rename(temp_file_path.c_str(), file_path_.c_str());
+#endif
+  if (rename_result != 0) {
+    RemoveFile(temp_file_path);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ", ToUTF8String(temp_file_path), " to ",
+                           ToUTF8String(file_path_));
+  }
+
+  return Status::OK();
+}
+
+std::string PrepackedWeightsFileCache::GenerateKey(const Node& node, int input_idx, const Tensor& weight) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  // node attributes can affect the packed format (e.g. transB) so they are part of the key.
+  // sort by name as NodeAttributes is an unordered map.
+  const auto& attributes = node.GetAttributes();
+  std::vector<const std::string*> attribute_names;
+  attribute_names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(&attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end(),
+            [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+  for (const auto* name : attribute_names) {
+    const std::string serialized_attribute = attributes.at(*name).SerializeAsString();
+    HashBuffer(serialized_attribute.data(), serialized_attribute.size(), hash);
+  }
+
+  // the types of the other inputs can affect the packed format too (e.g. signedness of A for quantized GEMMs)
+  for (const auto* input_def : node.InputDefs()) {
+    const std::string* type = input_def->Exists() ? input_def->Type() : nullptr;
+    if (type != nullptr) {
+      HashBuffer(type->data(), type->size(), hash);
+    }
+  }
+
+  const auto dims = weight.Shape().GetDims();
+  if (!dims.empty()) {
+    HashBuffer(dims.data(), dims.size_bytes(), hash);
+  }
+  if (weight.SizeInBytes() > 0) {
+    HashBuffer(weight.DataRaw(), weight.SizeInBytes(), hash);
+  }
+
+  std::ostringstream ss;
+  ss << node.Domain() << ":" << node.OpType() << ":" << node.SinceVersion() << ":" << input_idx << ":"
+     << DataTypeImpl::ToString(weight.DataType()) << ":" << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    ss << std::setw(8) << h;
+  }
+  return ss.str();
+}
+
+const PrePackedWeights* PrepackedWeightsFileCache::GetWeight(const std::string& key) const {
+  auto it = prepacked_weights_map_.find(key);
+  return it != prepacked_weights_map_.end() ? &it->second : nullptr;
+}
+
+bool PrepackedWeightsFileCache::WriteWeight(const std::string& key, PrePackedWeights&& packed_weight) {
+  auto ret = prepacked_weights_map_.insert(std::make_pair(key, std::move(packed_weight)));
+  if (ret.second) {
+    ++number_of_new_weights_;
+  }
+  return ret.second;
+}
+
+}  // namespace onnxruntime
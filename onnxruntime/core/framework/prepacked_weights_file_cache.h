@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+class Node;
+class Tensor;
+
+namespace logging {
+class Logger;
+}
+
+// On-disk cache of the buffers produced by OpKernel::PrePack().
+//
+// Unlike PrepackedWeightsContainer, which shares pre-packed weights between sessions in the same process and is
+// keyed by a hash of the pre-packed output, entries in this cache are keyed by the inputs of the packing step
+// (op type, node attributes, input index and weight contents) so that a hit allows PrePack() to be skipped entirely.
+//
+// Weights loaded from the file are served directly from a memory mapping of it. The file records the ORT version and
+// the instruction set extensions of the CPU it was written on, as MLAS packing formats depend on both; a file that
+// does not match the current host is ignored and rewritten. Each entry records a checksum of its buffers, and an entry
+// whose buffers do not match it is dropped so that the weights are pre-packed again.
+class PrepackedWeightsFileCache final {
+ public:
+  explicit PrepackedWeightsFileCache(PathString file_path) : file_path_(std::move(file_path)) {}
+
+  // Loads the persisted pre-packed weights. A missing, stale or malformed file is not an error - the cache
+  // starts empty and the file is rewritten by Save().
+  Status Load(const Env& env, const logging::Logger& logger);
+
+  // Writes all cached weights to the file if any weights were added since it was loaded.
+  Status Save(const Env& env) const;
+
+  // Generates the key for the pre-packed version of `weight` when used as input `input_idx` of `node`.
+  static std::string GenerateKey(const Node& node, int input_idx, const Tensor& weight);
+
+  // Returns the pre-packed weights for the key, or nullptr if there is no entry for it.
+  const PrePackedWeights* GetWeight(const std::string& key) const;
+
+  // Adds pre-packed weights that will be persisted by the next call to Save().
+  // Returns a boolean indicating if the insertion took place.
+  bool WriteWeight(const std::string& key, PrePackedWeights&& packed_weight);
+
+  // Returns the number of weights added since the file was loaded
+  size_t GetNumberOfNewWeights() const { return number_of_new_weights_; }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsFileCache);
+
+ private:
+  const PathString file_path_;
+
+  // The mapped file must outlive the entries pointing into it
+  Env::MappedMemoryPtr mapped_file_;
+
+  std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+
+  size_t number_of_new_weights_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -56,6 +56,19 @@ LARGE_INTEGER perf_freq = OrtGetPerformanceFrequency();
 
 namespace onnxruntime {
 
+// Total size of the output tensors of a kernel.
+static size_t CalculateOutputBytes(OpKernelContextInternal* op_kernel_context) {
+  size_t output_bytes = 0;
+  const int output_count = op_kernel_context->OutputCount();
+  for (int i = 0; i < output_count; i++) {
+    const OrtValue* p_output = op_kernel_context->GetOutputMLValue(i);
+    if (p_output != nullptr && p_output->IsTensor()) {
+      output_bytes += p_output->Get<Tensor>().SizeInBytes();
+    }
+  }
+  return output_bytes;
+}
+
 static void CalculateTotalOutputSizes(OpKernelContextInternal* op_kernel_context,
                                       size_t& total_output_sizes, const std::string& node_name,
                                       std::string& output_type_shape) {
@@ -343,13 +356,19 @@ class KernelScope {
                                      node_name_ + "_fence_before",
                                      sync_time_begin,
                                      {{"op_name", kernel_.KernelDef().OpName()}});
-      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      concurrency::ThreadPool::StartProfiling(kernel_context.GetOperatorThreadPool());
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
     }
+
+    auto* aggregate_profiler = session_state_.GetAggregateProfiler();
+    if (aggregate_profiler != nullptr) {
+      aggregate_sample_ = aggregate_profiler->Begin();
+      dispatch_timing_baseline_ = concurrency::ThreadPool::StartDispatchTiming();
+    }
   }
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelScope);
@@ -359,6 +378,13 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
+    auto* aggregate_profiler = session_state_.GetAggregateProfiler();
+    if (aggregate_profiler != nullptr) {
+      const uint64_t dispatch_ns = concurrency::ThreadPool::StopDispatchTiming(dispatch_timing_baseline_);
+      aggregate_profiler->End(aggregate_sample_, session_state_.GetAggregateOpTypeId(kernel_.Node().Index()),
+                              CalculateOutputBytes(&kernel_context_), dispatch_ns);
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
       std::string output_type_shape_;
@@ -377,7 +403,8 @@ class KernelScope {
                                          {"input_type_shape", input_type_shape_},
                                          {"output_type_shape", output_type_shape_},
                                          {"thread_scheduling_stats",
-                                          concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
+                                          concurrency::ThreadPool::StopProfiling(
+                                              kernel_context_.GetOperatorThreadPool())},
                                      });
       auto sync_time_begin = profiler.Start();
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
@@ -418,6 +445,9 @@ class KernelScope {
   size_t total_output_sizes_{};
   std::string input_type_shape_;
 
+  profiling::AggregateProfiler::Sample aggregate_sample_;
+  uint64_t dispatch_timing_baseline_{};
+
 #ifdef CONCURRENCY_VISUALIZER
   diagnostic::span span_;
 #endif
@@ -450,6 +480,7 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
                                      *p_kernel,
+                                     ctx.GetIntraOpThreadPool(),
                                      ctx.GetLogger(),
                                      terminate_flag,
                                      ctx.GetDeviceStream(stream_idx));
@@ -592,7 +623,7 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
   ctx.WaitAll();
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
-  if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
+  if (ctx.GetExecutionFrame().ShouldUpdateMemoryPatterns()) {
     bool all_tensors = true;
     for (const auto& feed : feeds) {
       if (!(feed.IsTensor())) {
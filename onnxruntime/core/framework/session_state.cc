@@ -3,11 +3,14 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
 #include "core/framework/node_index_info.h"
@@ -15,6 +18,7 @@
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/session_state_utils.h"
 #include "core/framework/utils.h"
+#include "core/platform/Barrier.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
@@ -87,6 +91,14 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  if (enable_mem_pattern_) {
+    ConfigureMemoryPatternCache();
+  }
+
+  const std::string run_bump_allocator_max_bytes_str =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsRunBumpAllocatorMaxBytes, "0");
+  ORT_THROW_IF_ERROR(ParseStringWithClassicLocale(run_bump_allocator_max_bytes_str, run_bump_allocator_max_bytes_));
+
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -114,6 +126,22 @@ AllocatorPtr SessionState::GetAllocator(const OrtDevice& device) const noexcept
   return nullptr;
 }
 
+std::shared_ptr<BumpAllocator> SessionState::AcquireRunBumpAllocator() const {
+  if (run_bump_allocator_max_bytes_ == 0) {
+    return nullptr;
+  }
+
+  std::call_once(run_bump_allocator_pool_init_, [this]() {
+    AllocatorPtr cpu_allocator = GetAllocator(OrtDevice());
+    if (cpu_allocator) {
+      run_bump_allocator_pool_ = std::make_unique<BumpAllocatorPool>(std::move(cpu_allocator),
+                                                                     run_bump_allocator_max_bytes_);
+    }
+  });
+
+  return run_bump_allocator_pool_ ? run_bump_allocator_pool_->Acquire() : nullptr;
+}
+
 void SessionState::UpdateAllocatorsWithEnvAllocators(const std::vector<AllocatorPtr>& env_allocators) {
   for (const auto& env_alloc : env_allocators) {
     (*allocators_)[env_alloc->Info().device] = env_alloc;
@@ -306,6 +334,143 @@ Status SessionState::AddInitializedTensor(int ort_value_index, const OrtValue& o
 
 const std::unordered_map<int, OrtValue>& SessionState::GetInitializedTensors() const { return initialized_tensors_; }
 
+const std::unordered_map<int, OrtValue>& SessionState::GetInitializedTensors(size_t numa_node) const {
+  if (numa_node < numa_initialized_tensors_.size() && !numa_initialized_tensors_[numa_node].empty()) {
+    return numa_initialized_tensors_[numa_node];
+  }
+  return initialized_tensors_;
+}
+
+void SessionState::SetNumaThreadPools(gsl::span<const LogicalProcessors> node_processors,
+                                      gsl::span<concurrency::ThreadPool* const> thread_pools) {
+  ORT_ENFORCE(node_processors.size() == thread_pools.size(), "Expected a thread pool for each NUMA node.");
+  ORT_ENFORCE(subgraph_session_states_.empty(), "NUMA thread pools must be set before subgraphs are created.");
+
+  auto numa_nodes = std::make_shared<NumaNodes>();
+  for (size_t node = 0; node < node_processors.size(); ++node) {
+    for (int processor : node_processors[node]) {
+      if (processor < 0) {
+        continue;
+      }
+      if (static_cast<size_t>(processor) >= numa_nodes->processor_to_node.size()) {
+        numa_nodes->processor_to_node.resize(static_cast<size_t>(processor) + 1, -1);
+      }
+      numa_nodes->processor_to_node[processor] = static_cast<int>(node);
+    }
+  }
+  numa_nodes->thread_pools.assign(thread_pools.begin(), thread_pools.end());
+  numa_nodes_ = std::move(numa_nodes);
+}
+
+size_t SessionState::GetCurrentNumaNode() const {
+  if (!numa_nodes_) {
+    return 0;
+  }
+
+  const int processor = Env::Default().GetCurrentProcessorId();
+  if (processor < 0 || static_cast<size_t>(processor) >= numa_nodes_->processor_to_node.size()) {
+    return 0;
+  }
+
+  const int node = numa_nodes_->processor_to_node[processor];
+  return node < 0 ? 0 : static_cast<size_t>(node);
+}
+
+Status SessionState::ReplicateInitializedTensorsPerNumaNode(size_t min_bytes) {
+  if (!numa_nodes_ || min_bytes == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<std::pair<int, const Tensor*>> to_replicate;
+  for (const auto& [ort_value_index, ort_value] : initialized_tensors_) {
+    if (!ort_value.IsTensor()) {
+      continue;
+    }
+    const auto& tensor = ort_value.Get<Tensor>();
+    if (tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString() &&
+        tensor.SizeInBytes() >= min_bytes) {
+      to_replicate.emplace_back(ort_value_index, &tensor);
+    }
+  }
+
+  if (to_replicate.empty()) {
+    return Status::OK();
+  }
+
+  // The copies are allocated directly rather than from the arena. Large allocations get fresh pages from the OS that
+  // are placed on the node of the first thread that writes them.
+  auto allocator = std::make_shared<CPUAllocator>();
+  const size_t home_node = GetCurrentNumaNode();
+  const size_t num_nodes = numa_nodes_->thread_pools.size();
+  numa_initialized_tensors_.resize(num_nodes);
+
+  size_t total_bytes = 0;
+  size_t num_replicated_nodes = 0;
+  for (size_t node = 0; node < num_nodes; ++node) {
+    if (node == home_node) {
+      continue;
+    }
+
+    // the copies must be written by a thread of the node to be placed on it. without one, runs from the node keep
+    // using the initializers of the home node.
+    if (numa_nodes_->thread_pools[node] == nullptr) {
+      LOGS(logger_, WARNING) << "NUMA node " << node
+                             << " has no intra-op thread pool. Its runs will use the initializers of NUMA node "
+                             << home_node << ".";
+      continue;
+    }
+
+    auto& node_tensors = numa_initialized_tensors_[node];
+    node_tensors = initialized_tensors_;
+
+    // allocate all the copies before scheduling any work so a failed allocation can't leave tasks running
+    InlinedVector<std::pair<const Tensor*, void*>> copies;
+    copies.reserve(to_replicate.size());
+    for (const auto& entry : to_replicate) {
+      const Tensor* source = entry.second;
+      OrtValue& copy = node_tensors[entry.first];
+      Tensor::InitOrtValue(source->DataType(), source->Shape(), allocator, copy);
+      copies.emplace_back(source, copy.GetMutable<Tensor>()->MutableDataRaw());
+      total_bytes += source->SizeInBytes();
+    }
+
+    Barrier barrier(static_cast<unsigned int>(copies.size()));
+    for (const auto& copy : copies) {
+      concurrency::ThreadPool::Schedule(numa_nodes_->thread_pools[node], [copy, &barrier]() {
+        memcpy(copy.second, copy.first->DataRaw(), copy.first->SizeInBytes());
+        barrier.Notify();
+      });
+    }
+    barrier.Wait();
+    ++num_replicated_nodes;
+  }
+
+  LOGS(logger_, INFO) << "Replicated " << to_replicate.size() << " initializers to " << num_replicated_nodes
+                      << " NUMA nodes, " << total_bytes << " bytes in total.";
+
+  return Status::OK();
+}
+
+void SessionState::SetAggregateProfiler(profiling::AggregateProfiler* aggregate_profiler) {
+  aggregate_profiler_ = aggregate_profiler;
+  aggregate_op_type_ids_.clear();
+  if (aggregate_profiler_ == nullptr) {
+    return;
+  }
+
+  aggregate_op_type_ids_.resize(graph_viewer_->MaxNodeIndex(), 0);
+  for (const auto& node : graph_viewer_->Nodes()) {
+    aggregate_op_type_ids_[node.Index()] = aggregate_profiler_->RegisterOpType(node.OpType(),
+                                                                               node.GetExecutionProviderType());
+  }
+
+  for (const auto& entry : subgraph_session_states_) {
+    for (const auto& name_to_subgraph_session_state : entry.second) {
+      name_to_subgraph_session_state.second->SetAggregateProfiler(aggregate_profiler);
+    }
+  }
+}
+
 const std::unordered_map<int, OrtValue>& SessionState::GetConstantInitializedTensors() const {
   return constant_initialized_tensors_;
 }
@@ -380,6 +545,20 @@ static Status KernelUseSharedPrePackedBuffers(OpKernel& kernel, int input_idx,
   return Status::OK();
 }
 
+static Status KernelUsePersistedPrePackedBuffers(OpKernel& kernel, int input_idx, const Tensor& tensor,
+                                                 const PrePackedWeights& prepacked_weights,
+                                                 /*out*/ bool& used_persisted_buffers) {
+  std::vector<BufferUniquePtr> persisted_prepacked_buffers;
+  persisted_prepacked_buffers.reserve(prepacked_weights.buffers_.size());
+
+  for (const auto& prepacked_buffer : prepacked_weights.buffers_) {
+    // BufferDeleter is nullptr because the buffers are owned by the PrepackedWeightsFileCache
+    persisted_prepacked_buffers.emplace_back(prepacked_buffer.get(), BufferDeleter(nullptr));
+  }
+
+  return kernel.UsePersistedPrePackedBuffers(tensor, input_idx, persisted_prepacked_buffers, used_persisted_buffers);
+}
+
 static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
                                                      const PrePackedWeights& pre_packed_weights) {
   std::ostringstream ss_1;
@@ -392,7 +571,15 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
 
 Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                                        const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+  // the on-disk cache is owned by the root session state
+  SessionState* root_session_state = this;
+  while (root_session_state->parent_ != nullptr) {
+    root_session_state = root_session_state->parent_;
+  }
+  PrepackedWeightsFileCache* prepacked_weights_file_cache = root_session_state->prepacked_weights_file_cache_.get();
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                     prepacked_weights_file_cache](
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
     for (auto& node : GetGraphViewer().Nodes()) {
       auto kernel = GetMutableKernel(node.Index());
@@ -472,6 +659,49 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                     }
                   }
 
+                } else if (prepacked_weights_file_cache != nullptr &&
+                           node.GetExecutionProviderType() == kCpuExecutionProvider) {  // on-disk caching turned ON
+                  const std::string prepacked_weights_file_cache_key =
+                      PrepackedWeightsFileCache::GenerateKey(node, input_idx, const_initialized_tensor);
+                  const PrePackedWeights* persisted_weights =
+                      prepacked_weights_file_cache->GetWeight(prepacked_weights_file_cache_key);
+
+                  if (persisted_weights != nullptr) {
+                    ORT_RETURN_IF_ERROR(KernelUsePersistedPrePackedBuffers(*kernel, input_idx, const_initialized_tensor,
+                                                                           *persisted_weights, is_packed));
+                    if (is_packed) {
+                      VLOGS(logger_, 1) << "Using persisted pre-packed weight for constant initializer: " << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: "
+                                        << node.OpType();
+                      ++used_persisted_pre_packed_weights_counter_;
+                    }
+                  }
+
+                  if (!is_packed) {
+                    AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                    // only ask for the pre-packed weights if they can be persisted. if there is an entry for the key
+                    // the kernel doesn't support using persisted weights so it keeps ownership of its buffers.
+                    PrePackedWeights weights_to_be_filled_in;
+                    ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                                        session_cpu_alloc,  // use allocator tied to this session
+                                                        is_packed,
+                                                        persisted_weights == nullptr ? &weights_to_be_filled_in : nullptr));
+
+                    // kernels that support sharing hand over their pre-packed buffers. keep them in the cache so
+                    // they can be persisted, and give the kernel a non-owning reference back.
+                    if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                      if (!prepacked_weights_file_cache->WriteWeight(prepacked_weights_file_cache_key,
+                                                                     std::move(weights_to_be_filled_in))) {
+                        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                                               "Unable to write the provided PrePackedWeights instance into the "
+                                               "pre-packed weights file cache");
+                      }
+
+                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(
+                          *kernel, input_idx, *prepacked_weights_file_cache->GetWeight(prepacked_weights_file_cache_key),
+                          node.Name()));
+                    }
+                  }
                 } else {  // caching of pre-packed weights' turned OFF
                   AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
                   ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
@@ -519,14 +749,6 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
-  for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
-  }
-  return key;
-}
-
 #ifdef ENABLE_TRAINING
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
@@ -761,38 +983,27 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+// Entries are only inserted upon creation and are not updated if already present, other than in training
+// scenarios where they are regenerated on a cache miss.
+std::shared_ptr<const MemoryPatternCache::Entry> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
-    gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
-  out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+    gsl::span<const int> feed_mlvalue_idxs) const {
+  int64_t key = mem_pattern_cache_.CalculateKey(tensor_inputs);
+  auto entry = mem_pattern_cache_.Find(key);
+  if (!entry) {
 #ifdef ENABLE_TRAINING
-    MemoryPatternGroup mem_patterns;
-    InlinedHashMap<int, TensorShape> inferred_shapes;
-    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+    MemoryPatternCache::Entry new_entry;
+    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, new_entry.mem_patterns,
+                                  new_entry.inferred_shapes)
+            .IsOK()) {
+      return mem_pattern_cache_.Insert(key, std::move(new_entry), /*overwrite*/ true);
     }
 #else
     ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
 #endif
-    return nullptr;
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
-  }
-  return &it->second;
+  return entry;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -843,14 +1054,38 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  int64_t key = mem_pattern_cache_.CalculateKey(tensor_inputs);
 
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  // Only replace an existing entry if the new patterns grow it. A concurrent run may have generated the entry first,
+  // and with bucketed input shapes the entry is regenerated by runs that needed larger blocks than it has.
+  MemoryPatternCache::Entry entry;
+  entry.mem_patterns = std::move(mem_patterns);
+  mem_pattern_cache_.InsertOrGrow(key, std::move(entry));
   return Status::OK();
 }
 
+void SessionState::ConfigureMemoryPatternCache() {
+  InlinedVector<int64_t> dim_buckets;
+#ifndef ENABLE_TRAINING
+  // in training the cached inferred shapes must match the inputs exactly so bucketing is not supported
+  const std::string dim_buckets_str =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternDimBuckets, "");
+  for (const auto& bucket_str : utils::SplitString(dim_buckets_str, ",")) {
+    int64_t bucket = 0;
+    ORT_THROW_IF_ERROR(ParseStringWithClassicLocale(bucket_str, bucket));
+    ORT_ENFORCE(bucket > 0, "Invalid memory pattern dim bucket: ", bucket_str);
+    dim_buckets.push_back(bucket);
+  }
+#endif
+
+  size_t capacity = 0;
+  const std::string capacity_str =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternCacheCapacity, "0");
+  ORT_THROW_IF_ERROR(ParseStringWithClassicLocale(capacity_str, capacity));
+
+  mem_pattern_cache_.Configure(std::move(dim_buckets), capacity);
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -1048,6 +1283,9 @@ Status SessionState::CreateSubgraphSessionState() {
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
 
+      // subgraphs run on the intra-op thread pool of the run that executes them
+      subgraph_session_state->numa_nodes_ = numa_nodes_;
+
       // recurse
       ORT_RETURN_IF_ERROR(subgraph_session_state->CreateSubgraphSessionState());
 
@@ -1182,8 +1420,30 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
 
   InlinedHashMap<std::string, size_t> constant_initializers_use_count;
   ComputeConstantInitializerUseCount(graph_, constant_initializers_use_count);
-  return FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
-                                  remove_initializers, constant_initializers_use_count);
+
+  const std::string prepacked_weights_cache_file =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPrepackedWeightsCacheFile, "");
+  if (!prepacked_weights_cache_file.empty()) {
+    prepacked_weights_file_cache_ =
+        std::make_unique<PrepackedWeightsFileCache>(ToPathString(prepacked_weights_cache_file));
+    ORT_RETURN_IF_ERROR(prepacked_weights_file_cache_->Load(Env::Default(), logger_));
+  }
+
+  ORT_RETURN_IF_ERROR(FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
+                                               remove_initializers, constant_initializers_use_count));
+
+  if (prepacked_weights_file_cache_ != nullptr && prepacked_weights_file_cache_->GetNumberOfNewWeights() > 0) {
+    // failing to update the cache only costs the next session the time to pre-pack again
+    auto status = prepacked_weights_file_cache_->Save(Env::Default());
+    if (status.IsOK()) {
+      LOGS(logger_, INFO) << "Saved " << prepacked_weights_file_cache_->GetNumberOfNewWeights()
+                          << " new pre-packed weights to " << prepacked_weights_cache_file;
+    } else {
+      LOGS(logger_, WARNING) << "Failed to save pre-packed weights: " << status.ErrorMessage();
+    }
+  }
+
+  return Status::OK();
 }
 
 static Status Index(const OrtValueNameIdxMap& ort_value_name_idx_map,
@@ -1372,9 +1632,18 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
+  // in parallel execution mode the logic streams run on the inter-op thread pool, so the CPU nodes of the main graph
+  // can be partitioned into as many streams as there are threads in it. subgraphs are always executed sequentially.
+  size_t max_cpu_streams = 1;
+  if (session_options.execution_mode == ExecutionMode::ORT_PARALLEL && parent_node == nullptr &&
+      inter_op_thread_pool_ != nullptr) {
+    max_cpu_streams = static_cast<size_t>(std::max(inter_op_thread_pool_->NumThreads(), 1));
+  }
+
   SequentialPlannerContext context(session_options.execution_mode,
                                    session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+                                   session_options.enable_mem_reuse,
+                                   max_cpu_streams);
 
 #ifdef _WIN32
 
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -15,8 +16,10 @@
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
+#include "core/common/aggregate_profiler.h"
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/bump_allocator.h"
 #include "core/framework/callback.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_providers.h"
@@ -24,9 +27,11 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file_cache.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/memory_pattern_cache.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
@@ -154,6 +159,9 @@ class SessionState {
    */
   const std::unordered_map<int, OrtValue>& GetInitializedTensors() const;
 
+  // Initialized tensors for runs from the given NUMA node. See ReplicateInitializedTensorsPerNumaNode.
+  const std::unordered_map<int, OrtValue>& GetInitializedTensors(size_t numa_node) const;
+
   /**
    * Gets the map of ort_value_index to initialized tensors (e.g. weights) that are constant
    * and cannot be overridden at runtime.
@@ -203,6 +211,18 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
+  /**
+  Record the kernels of this graph and its subgraphs in an aggregating profiler, which must outlive the session state.
+  Must be called after the session state is finalized and before the first run.
+  */
+  void SetAggregateProfiler(profiling::AggregateProfiler* aggregate_profiler);
+
+  // nullptr if aggregate profiling is not enabled
+  profiling::AggregateProfiler* GetAggregateProfiler() const noexcept { return aggregate_profiler_; }
+
+  // Op type id of a node in the aggregating profiler.
+  size_t GetAggregateOpTypeId(NodeIndex node_index) const { return aggregate_op_type_ids_[node_index]; }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* GetMemoryProfiler() const noexcept { return memory_profiler_; }
 
@@ -214,25 +234,37 @@ class SessionState {
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
-  In training scenarios, the cache may be updated so
-  the callers would receive a copy of inferred shapes
-  made under mutex being held. In inference scenarios,
-  it is not mutable, we do not obtain a lock and simply get a pointer
-  w/o copying a hashtable
+  In training scenarios, the patterns and inferred shapes are generated on a cache miss.
+  The returned entry is shared so it remains valid if it is evicted from the cache while in use.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternCache::Entry> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
-      gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      gsl::span<const int> feed_mlvalue_idxs) const;
 
   /**
   Set generated memory pattern with a given input shapes.
+  An existing pattern is only replaced if the new one has larger blocks, see MemoryPatternCache::InsertOrGrow().
   Const as it's an internal cache update only.
   All inputs must represent Tensors
   */
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Whether input shapes are bucketed when looking up memory patterns, in which case a pattern may have been
+  generated for larger tensors than the ones being allocated.
+  */
+  bool IsMemoryPatternBucketed() const { return mem_pattern_cache_.IsBucketed(); }
+
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const { return mem_pattern_cache_.GetStats(); }
+
+  /**
+  Get an allocator for the intermediate CPU tensors of a single run. All its allocations are released at once when
+  the last reference to it is dropped.
+  Returns nullptr if kOrtSessionOptionsRunBumpAllocatorMaxBytes is not set. Thread-safe.
+  */
+  std::shared_ptr<BumpAllocator> AcquireRunBumpAllocator() const;
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -289,6 +321,31 @@ class SessionState {
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
+  /**
+  Use a separate intra-op thread pool for each NUMA node. A run uses the pool of the node that its calling thread is
+  running on when the run starts. thread_pools[i] is the pool of the node with the processors in node_processors[i],
+  and may be nullptr. Must be called before the subgraph session states are created.
+  */
+  void SetNumaThreadPools(gsl::span<const LogicalProcessors> node_processors,
+                          gsl::span<concurrency::ThreadPool* const> thread_pools);
+
+  // NUMA node of the calling thread. 0 if NUMA-aware execution is not enabled or the node is unknown.
+  size_t GetCurrentNumaNode() const;
+
+  // Intra-op thread pool for runs from the given NUMA node.
+  concurrency::ThreadPool* GetThreadPool(size_t numa_node) const noexcept {
+    return numa_nodes_ && numa_node < numa_nodes_->thread_pools.size() ? numa_nodes_->thread_pools[numa_node]
+                                                                       : thread_pool_;
+  }
+
+  /**
+  Copy the CPU initialized tensors of at least min_bytes to memory that is local to each NUMA node other than the one
+  of the calling thread, which is where the existing tensors were loaded. Each copy is written by a thread of the
+  node's thread pool, so the OS places its pages on that node on first touch. Nodes without a thread pool are skipped.
+  Kernels that pre-packed a tensor keep using their packed copy. No-op if NUMA-aware execution is not enabled.
+  */
+  Status ReplicateInitializedTensorsPerNumaNode(size_t min_bytes);
+
   const FuncManager& GetFuncMgr() const noexcept { return fused_funcs_mgr_; }
   FuncManager& GetMutableFuncMgr() noexcept { return fused_funcs_mgr_; }
 
@@ -325,6 +382,10 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedPersistedPrePackedWeightCounter() const {
+    return used_persisted_pre_packed_weights_counter_;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -395,6 +456,9 @@ class SessionState {
                                   const InlinedHashMap<OrtValueName, OrtDevice>& outer_scope_node_arg_to_location_map = {},
                                   bool graph_info_already_created = false);
 
+  // Set up the memory pattern cache from the session config options.
+  void ConfigureMemoryPatternCache();
+
 #ifdef ENABLE_TRAINING
   Status GeneratePatternGroupCache(
       gsl::span<const OrtValue> inputs,
@@ -478,6 +542,10 @@ class SessionState {
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
 
+  profiling::AggregateProfiler* aggregate_profiler_{nullptr};
+  // op type id of each node, indexed by NodeIndex
+  InlinedVector<size_t> aggregate_op_type_ids_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* memory_profiler_;
 #endif
@@ -485,18 +553,14 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
-  // lock for the mem_patterns_
-  mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  mutable MemoryPatternCache mem_pattern_cache_;
+
+  // allocators for the intermediate CPU tensors of each run. the pool is created on first use as the CPU allocator
+  // may be replaced by a shared environment allocator after the SessionState is constructed.
+  size_t run_bump_allocator_max_bytes_{0};
+  mutable std::once_flag run_bump_allocator_pool_init_;
+  mutable std::unique_ptr<BumpAllocatorPool> run_bump_allocator_pool_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -507,6 +571,20 @@ class SessionState {
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
 
+  struct NumaNodes {
+    // node of each logical processor id. -1 if the processor is not on any of the nodes.
+    InlinedVector<int> processor_to_node;
+    // intra-op thread pool of each node
+    InlinedVector<concurrency::ThreadPool*> thread_pools;
+  };
+
+  // nullptr if NUMA-aware execution is not enabled. shared with the subgraph session states.
+  std::shared_ptr<const NumaNodes> numa_nodes_;
+
+  // initialized_tensors_ with the large tensors replaced by node-local copies, for each NUMA node.
+  // empty for the nodes that use initialized_tensors_.
+  std::vector<std::unordered_map<int, OrtValue>> numa_initialized_tensors_;
+
   const DataTransferManager& data_transfer_mgr_;
 
   const SessionOptions& sess_options_;
@@ -519,6 +597,10 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // On-disk cache of pre-packed weights. Only set on the root session state if
+  // kOrtSessionOptionsPrepackedWeightsCacheFile is specified. Subgraphs use the one from the root.
+  std::unique_ptr<PrepackedWeightsFileCache> prepacked_weights_file_cache_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -549,6 +631,9 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight loaded from the on-disk cache was used by the session state
+  size_t used_persisted_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
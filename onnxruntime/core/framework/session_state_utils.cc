@@ -75,13 +75,15 @@ struct ExtDataValueDeleter {
 static inline common::Status ExtDataTensorProtoToTensor(const Env& env,
                                                         const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                                         const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                                        Tensor& tensor, OrtCallback& ext_data_deleter) {
+                                                        Tensor& tensor, OrtCallback& ext_data_deleter,
+                                                        bool* ext_data_is_mapped = nullptr) {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
 
   void* ext_data_buf = nullptr;
   SafeInt<size_t> ext_data_len = 0;
   ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path.c_str(), tensor_proto,
-                                                       ext_data_buf, ext_data_len, ext_data_deleter));
+                                                       ext_data_buf, ext_data_len, ext_data_deleter,
+                                                       ext_data_is_mapped));
 
   // NB: creating a do-nothing allocator per tensor is wasteful; can perhaps be
   // avoided if the Tensor class implements the do-nothing behavior when given a
@@ -93,6 +95,25 @@ static inline common::Status ExtDataTensorProtoToTensor(const Env& env,
   return common::Status::OK();
 }
 
+// given a tensor proto with external data that will be consumed on CPU, return an OrtValue whose tensor points
+// directly at the external data. the data is served from a memory mapping of the external data file where the
+// platform supports it, so no initializer buffer needs to be planned or allocated for it.
+static common::Status ExtDataTensorProtoToOrtValue(const Env& env,
+                                                   const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                                   const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                   OrtValue& ort_value, bool& ext_data_is_mapped) {
+  auto p_tensor = std::make_unique<Tensor>();
+  OrtCallback ext_data_deleter;
+  ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter,
+                                                 &ext_data_is_mapped));
+
+  ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
+
+  MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+  ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
+  return common::Status::OK();
+}
+
 static common::Status DeserializeTensorProto(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                              const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer* m,
                                              const AllocatorPtr& alloc, const AllocatorPtr& default_cpu_alloc,
@@ -247,16 +268,27 @@ common::Status SaveInitializedTensors(
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
 
+  // only skip tracing and planning memory when data is external (i.e mmap) and on CPU.
+  // when data is external and on GPU, need to copy first to cpu memory, then to gpu memory.
+  auto uses_ext_data_in_place = [&exec_plan](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    return utils::HasExternalData(tensor_proto) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU;
+  };
+  // outside of initializer_allocation_order, such tensors are only served from the mapping without a planned buffer
+  // if the session opted in
+  const bool use_mapped_external_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseMappedExternalInitializers, "0") == "1";
+  auto uses_mapped_ext_data = [&](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    return use_mapped_external_initializers && uses_ext_data_in_place(ort_value_index, tensor_proto);
+  };
+
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
-  // NB1: vector with init allocation order may contain a subset of all tensors (or none at all)
-  // NB2: only skip tracing and planning memory when data is external (i.e mmap) and on CPU.
-  //    when data is external and on GPU, need to copy first to cpu memory, then to gpu memory.
+  // NB: vector with init allocation order may contain a subset of all tensors (or none at all)
   auto initialized_tensors_to_allocate = id_to_initialized_tensor;
   for (int ort_value_index : initializer_allocation_order) {
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
+    if (!uses_ext_data_in_place(ort_value_index, *entry->second)) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
       ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
@@ -273,6 +305,10 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    if (uses_mapped_ext_data(entry.first, *entry.second)) {
+      // the tensor will point directly at the external data so don't reserve space for it
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
   // 2. allocate weight buffer on different locations
@@ -292,6 +328,10 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
+  // bytes of external initializer data served from a memory mapping vs. read into a buffer
+  size_t ext_data_mapped_bytes = 0;
+  size_t ext_data_copied_bytes = 0;
+
   // 3. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
@@ -307,6 +347,19 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (uses_mapped_ext_data(ort_value_index, *(entry.second))) {
+      bool ext_data_is_mapped = false;
+      Status st = ExtDataTensorProtoToOrtValue(env, graph_loc, *(entry.second), ort_value, ext_data_is_mapped);
+      if (!st.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
+      }
+
+      const size_t size_in_bytes = ort_value.Get<Tensor>().SizeInBytes();
+      (ext_data_is_mapped ? ext_data_mapped_bytes : ext_data_copied_bytes) += size_in_bytes;
+      VLOGS(logger, 1) << "External data for initializer " << name << " was "
+                       << (ext_data_is_mapped ? "memory mapped" : "copied") << " (" << size_in_bytes << " bytes)";
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
@@ -342,6 +395,12 @@ common::Status SaveInitializedTensors(
 #endif
   }
 
+  if (ext_data_mapped_bytes > 0 || ext_data_copied_bytes > 0) {
+    LOGS(logger, INFO) << "[Memory] SessionStateInitializer memory mapped " << ext_data_mapped_bytes
+                       << " bytes and copied " << ext_data_copied_bytes
+                       << " bytes of external initializer data for CPU";
+  }
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
@@ -29,6 +29,7 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
              fetch_allocators,
              device_stream_map,
              sess_state),
+      intra_op_thread_pool_(sess_state.GetThreadPool(frame_.GetNumaNode())),
       logger_(&sess_logger),
       single_thread_mode_(single_thread_mode),
       device_stream_map_(device_stream_map),
@@ -96,6 +97,7 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
              fetches,
              fetch_allocators,
              sess_state),
+      intra_op_thread_pool_(sess_state.GetThreadPool(frame_.GetNumaNode())),
       logger_(&sess_logger),
       single_thread_mode_(single_thread_mode) {
 #ifdef _WIN32
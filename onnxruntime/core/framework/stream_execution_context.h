@@ -78,6 +78,9 @@ class StreamExecutionContext {
 
   ExecutionFrame& GetExecutionFrame();
 
+  // Intra-op thread pool for the kernels of this execution.
+  concurrency::ThreadPool* GetIntraOpThreadPool() const { return intra_op_thread_pool_; }
+
   synchronize::Notification* GetNotification(size_t idx);
 
   void SetLogger(const logging::Logger& current_logger) {
@@ -152,6 +155,8 @@ class StreamExecutionContext {
 
   ExecutionFrame frame_;
 
+  concurrency::ThreadPool* const intra_op_thread_pool_;
+
   const logging::Logger* logger_;
 
   std::unique_ptr<std::atomic_int[]> release_plan_;
@@ -771,7 +771,7 @@ static void DeleteCharArray(void* param) noexcept {
 
 static Status GetFileContent(
     const Env& env, const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
-    void*& raw_buffer, OrtCallback& deleter) {
+    void*& raw_buffer, OrtCallback& deleter, bool* is_mapped) {
   // query length if it is 0
   if (length == 0) {
     ORT_RETURN_IF_ERROR(env.GetFileLength(file_path, length));
@@ -784,6 +784,9 @@ static Status GetFileContent(
     if (status.IsOK()) {
       deleter = mapped_memory.get_deleter().callback;
       raw_buffer = mapped_memory.release();
+      if (is_mapped != nullptr) {
+        *is_mapped = true;
+      }
       return Status::OK();
     }
   }
@@ -795,13 +798,20 @@ static Status GetFileContent(
 
   deleter = OrtCallback{DeleteCharArray, buffer.get()};
   raw_buffer = buffer.release();
+  if (is_mapped != nullptr) {
+    *is_mapped = false;
+  }
   return Status::OK();
 }
 
 Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path,
                                  const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                 void*& ext_data_buf, SafeInt<size_t>& ext_data_len, OrtCallback& ext_data_deleter) {
+                                 void*& ext_data_buf, SafeInt<size_t>& ext_data_len, OrtCallback& ext_data_deleter,
+                                 bool* ext_data_is_mapped) {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
+  if (ext_data_is_mapped != nullptr) {
+    *ext_data_is_mapped = false;
+  }
   std::basic_string<ORTCHAR_T> tensor_proto_dir;
   if (model_path != nullptr) {
     ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_path, tensor_proto_dir));
@@ -834,7 +844,7 @@ Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path,
                   " offset: ", file_offset, " size to read: ", static_cast<size_t>(raw_data_safe_len),
                   " given file_length: ", file_length, " are out of bounds or can not be read in full.");
     ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len,
-                                       ext_data_buf, ext_data_deleter));
+                                       ext_data_buf, ext_data_deleter, ext_data_is_mapped));
     ext_data_len = raw_data_safe_len;
   }
 
@@ -309,4 +309,257 @@ bool IsTransposeMovingSingleAxis(gsl::span<const size_t> permutations, size_t& f
   return single_axis_moved;
 }
 
-}  // namespace onnxruntime
\ No newline at end of file
+namespace {
+
+// The input and output of a tile of the 2D transposes in GeneralTranspose should fit in the L1 cache together.
+constexpr size_t kTransposeTileBytes = 16 * 1024;
+
+// Returns the tile edge in elements: the largest multiple of 8 for which a square tile is within kTransposeTileBytes.
+size_t TransposeTileEdge(size_t element_size) {
+  size_t edge = 8;
+  while ((edge + 8) * (edge + 8) * element_size <= kTransposeTileBytes) {
+    edge += 8;
+  }
+  return edge;
+}
+
+// Transposes the input matrix (m rows by n columns, ld_input elements apart) to the output matrix (n rows by m
+// columns, ld_output elements apart).
+template <typename T>
+void TransposeTile(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output, size_t m, size_t n) {
+  const T* s = reinterpret_cast<const T*>(input);
+  T* d = reinterpret_cast<T*>(output);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      d[i * ld_output + j] = s[j * ld_input + i];
+    }
+  }
+}
+
+template <>
+void TransposeTile<uint8_t>(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output,
+                            size_t m, size_t n) {
+  MlasTranspose(input, ld_input, output, ld_output, m, n);
+}
+
+template <>
+void TransposeTile<uint16_t>(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output,
+                             size_t m, size_t n) {
+  MlasTranspose(reinterpret_cast<const uint16_t*>(input), ld_input, reinterpret_cast<uint16_t*>(output), ld_output,
+                m, n);
+}
+
+template <>
+void TransposeTile<uint32_t>(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output,
+                             size_t m, size_t n) {
+  MlasTranspose(reinterpret_cast<const uint32_t*>(input), ld_input, reinterpret_cast<uint32_t*>(output), ld_output,
+                m, n);
+}
+
+void TransposeTileBytes(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output,
+                        size_t m, size_t n, size_t element_size) {
+  switch (element_size) {
+    case sizeof(uint8_t):
+      TransposeTile<uint8_t>(input, ld_input, output, ld_output, m, n);
+      break;
+    case sizeof(uint16_t):
+      TransposeTile<uint16_t>(input, ld_input, output, ld_output, m, n);
+      break;
+    case sizeof(uint32_t):
+      TransposeTile<uint32_t>(input, ld_input, output, ld_output, m, n);
+      break;
+    case sizeof(uint64_t):
+      TransposeTile<uint64_t>(input, ld_input, output, ld_output, m, n);
+      break;
+    default:
+      for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+          memcpy(output + (i * ld_output + j) * element_size, input + (j * ld_input + i) * element_size,
+                 element_size);
+        }
+      }
+      break;
+  }
+}
+
+}  // namespace
+
+//  `input_shape_override` overrides the shape of `input` for compute purposes.
+void GeneralTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
+                      const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
+  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
+  const auto input_dims = input_shape.GetDims();
+  const size_t rank = input_dims.size();
+  ORT_ENFORCE(permutations.size() == rank, "Transpose permutation size ", permutations.size(),
+              " does not match the input rank ", rank);
+
+  size_t element_size = input.DataType()->Size();
+  const auto* input_data = static_cast<const uint8_t*>(input.DataRaw());
+  auto* output_data = static_cast<uint8_t*>(output.MutableDataRaw());
+
+  const size_t num_elements = onnxruntime::narrow<size_t>(input_shape.Size());
+  if (num_elements == 0) {
+    return;
+  }
+
+  // Axes of size 1 do not affect the memory order, so number the remaining input axes contiguously.
+  constexpr size_t kDroppedAxis = std::numeric_limits<size_t>::max();
+  InlinedVector<size_t> compact_axis(rank, kDroppedAxis);
+  size_t num_compact_axes = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[i] != 1) {
+      compact_axis[i] = num_compact_axes++;
+    }
+  }
+
+  // Coalesce the runs of output axes that are also consecutive in the input into single axes. `group_of` maps the
+  // first input axis of each run to the run, which is numbered in output order.
+  InlinedVector<size_t> group_of(num_compact_axes, kDroppedAxis);
+  InlinedVector<size_t> group_size;
+  size_t previous_axis = kDroppedAxis;
+  for (size_t i = 0; i < rank; ++i) {
+    const size_t axis = compact_axis[permutations[i]];
+    if (axis == kDroppedAxis) {
+      continue;
+    }
+    const auto dim = onnxruntime::narrow<size_t>(input_dims[permutations[i]]);
+    if (previous_axis != kDroppedAxis && axis == previous_axis + 1) {
+      group_size.back() *= dim;
+    } else {
+      group_of[axis] = group_size.size();
+      group_size.push_back(dim);
+    }
+    previous_axis = axis;
+  }
+
+  const size_t num_axes = group_size.size();
+  if (num_axes <= 1) {
+    // the transpose is a reshape
+    memcpy(output_data, input_data, num_elements * element_size);
+    return;
+  }
+
+  // For each output axis, the size, and the byte distance between consecutive entries in the input and the output.
+  InlinedVector<size_t> dims(num_axes);
+  InlinedVector<size_t> input_pitches(num_axes);
+  InlinedVector<size_t> output_pitches(num_axes);
+  size_t pitch = element_size;
+  for (size_t axis = num_compact_axes; axis-- > 0;) {
+    if (group_of[axis] != kDroppedAxis) {
+      input_pitches[group_of[axis]] = pitch;
+      pitch *= group_size[group_of[axis]];
+    }
+  }
+  pitch = element_size;
+  for (size_t i = num_axes; i-- > 0;) {
+    dims[i] = group_size[i];
+    output_pitches[i] = pitch;
+    pitch *= dims[i];
+  }
+
+  size_t last = num_axes - 1;
+  if (input_pitches[last] == element_size) {
+    // The innermost axis stays innermost, so the transpose moves blocks of it. Small blocks are moved as the elements
+    // of a tiled transpose of the remaining axes, which have a moved innermost axis as the runs are coalesced.
+    const size_t block_bytes = dims[last] * element_size;
+    if (block_bytes <= sizeof(uint64_t) && (block_bytes & (block_bytes - 1)) == 0) {
+      element_size = block_bytes;
+      --last;
+    } else {
+      size_t num_blocks = 1;
+      for (size_t i = 0; i < last; ++i) {
+        num_blocks *= dims[i];
+      }
+
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(num_blocks),
+          TensorOpCost{static_cast<double>(block_bytes), static_cast<double>(block_bytes),
+                       static_cast<double>(block_bytes) / 16},
+          [&](std::ptrdiff_t first, std::ptrdiff_t end) {
+            InlinedVector<size_t> index(last);
+            size_t input_offset = 0;
+            for (size_t i = last, rest = static_cast<size_t>(first); i-- > 0;) {
+              index[i] = rest % dims[i];
+              rest /= dims[i];
+              input_offset += index[i] * input_pitches[i];
+            }
+
+            uint8_t* target = output_data + static_cast<size_t>(first) * block_bytes;
+            for (std::ptrdiff_t b = first; b < end; ++b) {
+              memcpy(target, input_data + input_offset, block_bytes);
+              target += block_bytes;
+
+              // increment the index of the blocks, last axis first
+              for (size_t i = last; i-- > 0;) {
+                input_offset += input_pitches[i];
+                if (++index[i] < dims[i]) {
+                  break;
+                }
+                input_offset -= index[i] * input_pitches[i];
+                index[i] = 0;
+              }
+            }
+          });
+      return;
+    }
+  }
+
+  // The innermost input axis moved to output axis `moved`. For every index of the other outer axes, transpose the
+  // 2D slice of the input with rows along output axis `last` and columns along output axis `moved`, tile by tile.
+  size_t moved = 0;
+  while (input_pitches[moved] != element_size) {
+    ++moved;
+  }
+
+  const size_t rows = dims[last];
+  const size_t cols = dims[moved];
+  const size_t ld_input = input_pitches[last] / element_size;
+  const size_t ld_output = output_pitches[moved] / element_size;
+
+  const size_t tile = TransposeTileEdge(element_size);
+  const size_t row_tiles = (rows + tile - 1) / tile;
+  const size_t col_tiles = (cols + tile - 1) / tile;
+
+  InlinedVector<size_t> outer_axes;
+  size_t num_outer = 1;
+  for (size_t i = 0; i < last; ++i) {
+    if (i != moved) {
+      outer_axes.push_back(i);
+      num_outer *= dims[i];
+    }
+  }
+
+  const double tile_bytes = static_cast<double>(std::min(rows, tile) * std::min(cols, tile) * element_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_outer * row_tiles * col_tiles),
+      TensorOpCost{tile_bytes, tile_bytes, tile_bytes / element_size},
+      [&](std::ptrdiff_t first, std::ptrdiff_t end) {
+        for (std::ptrdiff_t work = first; work < end; ++work) {
+          size_t rest = static_cast<size_t>(work);
+          const size_t col_tile = rest % col_tiles;
+          rest /= col_tiles;
+          const size_t row_tile = rest % row_tiles;
+          rest /= row_tiles;
+
+          size_t input_offset = 0;
+          size_t output_offset = 0;
+          for (size_t i = outer_axes.size(); i-- > 0;) {
+            const size_t axis = outer_axes[i];
+            const size_t index = rest % dims[axis];
+            rest /= dims[axis];
+            input_offset += index * input_pitches[axis];
+            output_offset += index * output_pitches[axis];
+          }
+
+          const size_t row = row_tile * tile;
+          const size_t col = col_tile * tile;
+          input_offset += row * input_pitches[last] + col * element_size;
+          output_offset += col * output_pitches[moved] + row * element_size;
+
+          TransposeTileBytes(input_data + input_offset, ld_input, output_data + output_offset, ld_output,
+                             std::min(tile, rows - row), std::min(tile, cols - col), element_size);
+        }
+      });
+}
+
+}  // namespace onnxruntime
@@ -27,6 +27,11 @@ We use simple pointer arithmetic if the size of each read/write is a power of 2
 We use memcpy if the block size is larger.
 
 We fall back to the default implementation in all other cases, and if the input is std::string.
+
+GeneralTranspose handles any permutation of a tensor that is not std::string. It drops axes of size 1 and coalesces
+the axes that stay next to each other into single axes, so e.g. a {0, 2, 1, 3} permutation of {B, S, N, H} moves blocks
+of H elements. If the innermost axis moves, the two axes involved are transposed in cache sized tiles with
+MlasTranspose, and the tiles of all the other axes are split across the thread pool.
 */
 
 #include <sstream>
@@ -44,4 +49,6 @@ bool IsTransposeMovingSingleAxis(gsl::span<const size_t> permutations, size_t& f
 void SingleAxisTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output, size_t from,
                          size_t to, const TensorShape* input_shape_override = nullptr,
                          concurrency::ThreadPool* tp = nullptr);
+void GeneralTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
+                      const TensorShape* input_shape_override = nullptr, concurrency::ThreadPool* tp = nullptr);
 }  // namespace onnxruntime
@@ -91,6 +91,17 @@ Abstract:
 #endif // ARM64
 #endif // Visual Studio 16 or earlier does not support fp16 intrinsic
 
+//
+// The half precision GEMM and depthwise convolution routines have vectorized
+// kernels for ARM64 with fp16 vector intrinsics and for x64 (F16C and
+// AVX512-FP16). MlasFp16AccelerationSupported() reports whether the current
+// CPU has one of these kernels.
+//
+
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) || defined(MLAS_TARGET_AMD64)
+#define MLAS_F16_GEMM_SUPPORTED
+#endif
+
 //
 // Basic Linear Algebra Subprograms (BLAS) types.
 //
@@ -115,6 +126,7 @@ namespace onnxruntime {
         class ThreadPool;
     };
     struct MLFloat16;
+    struct BFloat16;
 };  // namespace onnxruntime
 
 using MLAS_THREADPOOL = onnxruntime::concurrency::ThreadPool;
@@ -211,6 +223,21 @@ struct MLAS_SGEMM_DATA_PARAMS {
     bool BIsPacked = false;   /**< Whether B is pre-packed */
 };
 
+/**
+ * @brief Supply blocking and threading parameters found by tuning a single
+ *        precision gemm operation for a particular shape. A zero value keeps
+ *        the built-in choice for that parameter.
+ *
+ *        StrideN must be a multiple of 16 and StrideN * StrideK must not
+ *        exceed the size of the internal B panel, else the built-in strides
+ *        are used. Strides do not apply when B is pre-packed.
+ */
+struct MLAS_SGEMM_TUNING_PARAMS {
+    size_t StrideN = 0;          /**< Supplies the number of columns of B packed per pass */
+    size_t StrideK = 0;          /**< Supplies the number of rows of B packed per pass */
+    size_t ThreadComplexity = 0; /**< Supplies the target number of multiplies per thread */
+};
+
 /**
  * @brief  Batched single precision matrix/matrix multiply operation (SGEMM)
  *
@@ -224,6 +251,8 @@ struct MLAS_SGEMM_DATA_PARAMS {
  * @param BatchSize  Supplies number of multiplications in this batch
  * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
                      base library threading support should be used.
+ * @param Tuning     Optionally supplies tuned parameters for this shape, else
+                     nullptr to use the built-in heuristics.
  */
 void
 MLASCALL
@@ -235,6 +264,41 @@ MlasGemmBatch(
     size_t K,
     const MLAS_SGEMM_DATA_PARAMS* Data,
     size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning = nullptr
+    );
+
+/**
+ * @brief Supply the shape and matrices of one multiplication in a group of
+ *        single precision gemm operations
+ */
+struct MLAS_SGEMM_GROUPED_PARAMS {
+    CBLAS_TRANSPOSE TransA = CblasNoTrans; /**< Supplies the transpose operation for matrix A. */
+    CBLAS_TRANSPOSE TransB = CblasNoTrans; /**< Supplies the transpose operation for matrix B. */
+    size_t M = 0;                          /**< Supplies the number of rows of matrix A and matrix C. */
+    size_t N = 0;                          /**< Supplies the number of columns of matrix B and matrix C. */
+    size_t K = 0;                          /**< Supplies the number of columns of matrix A and rows of matrix B. */
+    MLAS_SGEMM_DATA_PARAMS Data;           /**< Supplies the matrices data parameters */
+};
+
+/**
+ * @brief  Grouped single precision matrix/matrix multiply operation (SGEMM)
+ *
+ *         Unlike MlasGemmBatch, the multiplications may have different shapes.
+ *         The work of the whole group is partitioned across the thread pool
+ *         in one pass, so many small multiplications share one parallel
+ *         section and a large one is still split across threads.
+ *
+ * @param Params     An array of the multiplications
+ * @param GroupSize  Supplies the number of multiplications in the group
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUPED_PARAMS* Params,
+    size_t GroupSize,
     MLAS_THREADPOOL* ThreadPool
     );
 
@@ -1034,6 +1098,206 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// Brain floating-point routines.
+//
+// Conversions to bfloat16 round to nearest even and preserve NaN.
+//
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// Integer/floating-point conversion routines.
+//
+// InputType/OutputType is one of int8_t, uint8_t, int32_t or int64_t paired
+// with float. Conversions to integer truncate toward zero like static_cast.
+//
+
+template<typename InputType, typename OutputType>
+void
+MLASCALL
+MlasConvertBuffer(
+    const InputType* Source,
+    OutputType* Destination,
+    size_t Count
+    );
+
+//
+// Reduction routines.
+//
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceMaximum,
+    MlasReduceMinimum,
+};
+
+/**
+ * @brief Reduce each row of a row major matrix to one value:
+ *        Output[m] = Reduce(Input[m * ldInput + 0 .. CountN))
+ *
+ * @param Kind      Reduction to apply
+ * @param Input     Input matrix, CountM rows of CountN values (CountN >= 1)
+ * @param Output    CountM output values
+ * @param CountM    Number of rows
+ * @param CountN    Number of columns
+ * @param ldInput   Leading dimension of the input matrix
+ */
+void
+MLASCALL
+MlasReduceRows(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    );
+
+/**
+ * @brief Reduce each column of a row major matrix to one value:
+ *        Output[n] = Reduce(Input[m * ldInput + n] for m in 0 .. CountM)
+ *
+ * @param Kind      Reduction to apply
+ * @param Input     Input matrix, CountM rows (CountM >= 1) of CountN values
+ * @param Output    CountN output values
+ * @param CountM    Number of rows
+ * @param CountN    Number of columns
+ * @param ldInput   Leading dimension of the input matrix
+ */
+void
+MLASCALL
+MlasReduceColumns(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    );
+
+//
+// Layer normalization routines.
+//
+
+/**
+ * @brief Supply the data of one row for the layer normalization routine.
+ *
+ * The row is computed as
+ *     X = Input + Skip + SkipBias
+ *     Output = (X - mean(X)) / sqrt(variance(X) + Epsilon) * Scale + Bias
+ * or, when Simplified is set (RMS normalization),
+ *     Output = X / sqrt(mean(X * X) + Epsilon) * Scale
+ *
+ * T is float, MLAS_FP16 or MLAS_BF16. The statistics and the parameters are
+ * always fp32, so the caller converts Scale, Bias and SkipBias once per tensor.
+ */
+template<typename T>
+struct MLAS_LAYER_NORM_PARAMS {
+    const T* Input = nullptr;           /**< Supplies the input row */
+    const T* Skip = nullptr;            /**< Optionally supplies a row added to the input */
+    const float* SkipBias = nullptr;    /**< Optionally supplies a bias added to the input */
+    const float* Scale = nullptr;       /**< Supplies the scale (gamma) */
+    const float* Bias = nullptr;        /**< Optionally supplies the bias (beta), unused when Simplified */
+    T* Output = nullptr;                /**< Supplies the output row */
+    T* SkipOutput = nullptr;            /**< Optionally receives Input + Skip + SkipBias */
+    float* Mean = nullptr;              /**< Optionally receives the mean, unused when Simplified */
+    float* InvStdDev = nullptr;         /**< Optionally receives the reciprocal of the standard deviation */
+    float Epsilon = 0.0f;
+    bool Simplified = false;
+};
+
+/**
+ * @brief Normalize one row of N values
+ *
+ * The statistics are computed in a single pass over shifted values, which
+ * avoids the cancellation of the textbook mean of squares formula when the
+ * mean is large relative to the standard deviation.
+ *
+ * @param Params    Supplies the row data
+ * @param N         Supplies the number of values in the row
+ */
+template<typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    size_t N
+    );
+
+//
+// Attention routines.
+//
+
+/**
+ * @brief Supply the data for the tiled attention routine.
+ *
+ * For each batch b and head n the routine computes
+ *     Output = Softmax(Scale * Query x Key' + KeyMask) x Value
+ * without materializing the S x T matrix of probabilities: blocks of queries
+ * are multiplied with blocks of keys and the softmax is accumulated with a
+ * running maximum and sum per query.
+ *
+ * T is float, MLAS_FP16 or MLAS_BF16 for the keys and values. The queries,
+ * the mask and the output are always fp32.
+ */
+template<typename T>
+struct MLAS_FLASH_ATTENTION_PARAMS {
+    const float* Query = nullptr;       /**< Supplies the queries, B x N x S x H */
+    const T* Key = nullptr;             /**< Supplies the keys, B x N x T x H */
+    const T* Value = nullptr;           /**< Supplies the values, B x N x T x Hv */
+    const float* KeyMask = nullptr;     /**< Optionally supplies a mask added per key, B x T */
+    float* Output = nullptr;            /**< Receives the output, B x S x N x Hv */
+    size_t BatchSize = 0;               /**< B */
+    size_t NumHeads = 0;                /**< N */
+    size_t SequenceLength = 0;          /**< S, the number of queries */
+    size_t TotalSequenceLength = 0;     /**< T, the number of keys including any past keys */
+    size_t QkHeadSize = 0;              /**< H */
+    size_t VHeadSize = 0;               /**< Hv */
+    float Scale = 1.0f;
+    bool Causal = false;                /**< Query s only attends to keys t <= s + T - S */
+};
+
+/**
+ * @brief Compute multi-head attention in blocks of queries and keys
+ *
+ * The working memory is a few blocks per thread regardless of the sequence
+ * lengths.
+ *
+ * @param Params        Supplies the attention data
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if
+ *                      the base library threading support should be used.
+ */
+template<typename T>
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS<T>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Transpose routines.
 //
@@ -1083,6 +1347,39 @@ MlasTranspose(
     size_t N
     );
 
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    size_t ldInput,
+    uint16_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -1404,11 +1701,22 @@ using MLAS_FP16 = onnxruntime::MLFloat16;
 constexpr size_t FP16_SIZE = sizeof(uint16_t);
 
 /**
- * @brief Whether current CPU supports FP16 acceleration.
+ * @brief Whether current CPU supports FP16 acceleration, i.e. MLAS has a
+ *        vectorized half precision GEMM kernel for it (ARM64 fp16 vector
+ *        instructions, or F16C/AVX512-FP16 on x64).
 */
 bool MLASCALL
 MlasFp16AccelerationSupported();
 
+/**
+ * @brief Whether the half precision GEMM kernel of the current CPU
+ *        accumulates in fp32 instead of fp16, as the x64 F16C kernel does.
+ *        Its results then differ from those of a kernel that accumulates in
+ *        fp16 by more than the rounding of the output.
+*/
+bool MLASCALL
+MlasHalfGemmAccumulatesInFloat();
+
 /**
  * @brief Interface for half gemm post processors.
  *
@@ -1689,3 +1997,98 @@ MlasNhwcAvgPool(
     );
 
 #endif
+
+//
+// Bfloat16 routines
+//
+
+using MLAS_BF16 = onnxruntime::BFloat16;
+
+/**
+ * @brief Whether the current CPU has a bfloat16 GEMM kernel (AVX512-BF16 or AMX-BF16).
+ *        Other CPUs compute bfloat16 GEMMs by converting the inputs to fp32.
+*/
+bool MLASCALL
+MlasBf16AccelerationSupported();
+
+/**
+ * @brief Supply matrices data information to bfloat16 gemm functions.
+ *
+ * Products are accumulated in fp32 and C is rounded to bfloat16 once, after
+ * alpha and beta are applied.
+ */
+struct MLAS_BF16_GEMM_DATA_PARAMS {
+    const MLAS_BF16* A = nullptr; /**< Supplies the address of matrix A */
+    size_t lda = 0;               /**< Supplies the first dimension of matrix A. */
+    const void* B = nullptr;      /**< Supplies the address of matrix B, either bfloat16 or packed */
+    size_t ldb = 0;               /**< Supplies the first dimension of matrix B. */
+    MLAS_BF16* C = nullptr;       /**< Supplies the address of matrix C */
+    size_t ldc = 0;               /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;           /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
+    float beta = 0.0f;            /**< Supplies the scalar beta multiplier (see SGEMM definition) */
+    bool BIsPacked = false;       /**< Whether B is pre-packed with MlasBf16GemmPackB */
+};
+
+/**
+ * @brief  Batched bfloat16 matrix/matrix multiply operation
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param TransB     Supplies the transpose operation for matrix B. Ignored
+ *                   for packed B.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+ *                   of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasBf16GemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_BF16_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief For bfloat16 GEMM, returns size of the packing buffer needed for
+ *        right hand side
+ * @param N   Number of columns
+ * @param K   Number of rows
+ * @return    size of the packing buffer in bytes. The packed layout depends on
+ *            the kernel selected for the current CPU.
+*/
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief For bfloat16 GEMM, pack the right hand side matrix B
+ *
+ * @param TransB  Supplies the transpose operation for matrix B.
+ * @param N       Number of columns
+ * @param K       Number of rows
+ * @param B       Address of matrix B
+ * @param ldb     leading dimension of input matrix B
+ * @param PackedB Address of the packed matrix, sized by MlasBf16GemmPackBSize
+*/
+void
+MLASCALL
+MlasBf16GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    );
@@ -0,0 +1,489 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply operation.
+
+    CPUs with AVX512-BF16 or AMX-BF16 multiply bfloat16 values directly and
+    accumulate in fp32. Other CPUs convert the operands to fp32 and run the
+    single precision GEMM.
+
+--*/
+
+#include "bf16gemm.h"
+
+#include <memory>
+
+bool
+MLASCALL
+MlasBf16AccelerationSupported()
+{
+    return GetMlasPlatform().Bf16GemmDispatch != nullptr;
+}
+
+static
+void
+MlasBf16GemmCopyPackB(
+    uint16_t* D,
+    const uint16_t* B,
+    size_t ldb,
+    bool TransB,
+    size_t CountN,
+    size_t CountK,
+    size_t AlignedK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer, as panels of MLAS_BF16_GEMM_PANEL_N columns with pairs of
+    rows interleaved. Columns and rows past the end of the source matrix are
+    filled with zeros.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    TransB - Supplies whether the source matrix is transposed (N x K).
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    AlignedK - Supplies the number of rows of each destination panel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < CountN; n += MLAS_BF16_GEMM_PANEL_N) {
+
+        const size_t PanelN = std::min(CountN - n, MLAS_BF16_GEMM_PANEL_N);
+
+        for (size_t k = 0; k < AlignedK; k += 2) {
+
+            uint16_t* d = D + k * MLAS_BF16_GEMM_PANEL_N;
+
+            for (size_t j = 0; j < MLAS_BF16_GEMM_PANEL_N; j++) {
+
+                uint16_t v0 = 0;
+                uint16_t v1 = 0;
+
+                if (j < PanelN) {
+                    if (TransB) {
+                        const uint16_t* b = B + (n + j) * ldb + k;
+                        v0 = (k < CountK) ? b[0] : 0;
+                        v1 = (k + 1 < CountK) ? b[1] : 0;
+                    } else {
+                        const uint16_t* b = B + k * ldb + n + j;
+                        v0 = (k < CountK) ? b[0] : 0;
+                        v1 = (k + 1 < CountK) ? b[ldb] : 0;
+                    }
+                }
+
+                d[j * 2] = v0;
+                d[j * 2 + 1] = v1;
+            }
+        }
+
+        D += AlignedK * MLAS_BF16_GEMM_PANEL_N;
+    }
+}
+
+static
+void
+MlasBf16GemmCopyPackA(
+    uint16_t* D,
+    const uint16_t* A,
+    size_t lda,
+    bool TransA,
+    size_t CountM,
+    size_t CountK,
+    size_t AlignedM,
+    size_t AlignedK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a block of the source matrix to a row major buffer of
+    AlignedM x AlignedK elements, padded with zeros.
+
+--*/
+{
+    for (size_t m = 0; m < AlignedM; m++) {
+
+        uint16_t* d = D + m * AlignedK;
+        size_t k = 0;
+
+        if (m < CountM) {
+            if (TransA) {
+                for (; k < CountK; k++) {
+                    d[k] = A[k * lda + m];
+                }
+            } else {
+                std::memcpy(d, A + m * lda, CountK * sizeof(uint16_t));
+                k = CountK;
+            }
+        }
+
+        std::fill(d + k, d + AlignedK, uint16_t(0));
+    }
+}
+
+static
+void
+MlasBf16GemmOperation(
+    const MLAS_BF16_GEMM_DISPATCH* Dispatch,
+    bool TransA,
+    bool TransB,
+    size_t K,
+    const MLAS_BF16_GEMM_DATA_PARAMS* Data,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a range of rows and columns of C with a bfloat16
+    kernel. RangeCountM must not exceed MLAS_BF16_GEMM_STRIDEM.
+
+--*/
+{
+    constexpr size_t StrideM = MLAS_BF16_GEMM_STRIDEM;
+    constexpr size_t StrideN = MLAS_BF16_GEMM_STRIDEN;
+    constexpr size_t StrideK = MLAS_BF16_GEMM_STRIDEK;
+
+    constexpr size_t PanelASize = UpAlignSize(StrideM * StrideK * sizeof(uint16_t));
+    constexpr size_t PanelBSize = UpAlignSize(StrideN * StrideK * sizeof(uint16_t));
+    constexpr size_t AccumulatorSize = UpAlignSize(StrideM * StrideN * sizeof(float));
+
+    MlasThreadedBufAlloc(PanelASize + PanelBSize + AccumulatorSize);
+
+    uint8_t* p = ThreadedBufHolder.get();
+    auto* PanelA = reinterpret_cast<uint16_t*>(p);
+    p += PanelASize;
+    auto* PanelB = reinterpret_cast<uint16_t*>(p);
+    p += PanelBSize;
+    auto* Accumulator = reinterpret_cast<float*>(p);
+
+    const size_t PackedK = Dispatch->PackedK;
+    const size_t AlignedM = (RangeCountM + Dispatch->AlignM - 1) / Dispatch->AlignM * Dispatch->AlignM;
+
+    const auto* A = reinterpret_cast<const uint16_t*>(Data->A);
+    const size_t lda = Data->lda;
+    const size_t ldb = Data->ldb;
+    auto* C = reinterpret_cast<uint16_t*>(Data->C);
+    const size_t ldc = Data->ldc;
+
+    for (size_t n = 0; n < RangeCountN; n += StrideN) {
+
+        const size_t CountN = std::min(RangeCountN - n, StrideN);
+        const size_t StartN = RangeStartN + n;
+
+        for (size_t k = 0; k < K; k += StrideK) {
+
+            const size_t CountK = std::min(K - k, StrideK);
+            const size_t AlignedCountK = (CountK + PackedK - 1) / PackedK * PackedK;
+
+            const uint16_t* b;
+            size_t PanelStride;
+
+            if (Data->BIsPacked) {
+
+                //
+                // StartN is a multiple of the panel width and k a multiple of
+                // StrideK, which is a multiple of PackedK.
+                //
+
+                const size_t AlignedK = (K + PackedK - 1) / PackedK * PackedK;
+                PanelStride = AlignedK * MLAS_BF16_GEMM_PANEL_N;
+                b = reinterpret_cast<const uint16_t*>(Data->B) +
+                    (StartN / MLAS_BF16_GEMM_PANEL_N) * PanelStride + k * MLAS_BF16_GEMM_PANEL_N;
+
+            } else {
+
+                const uint16_t* B = reinterpret_cast<const uint16_t*>(Data->B);
+                B += TransB ? (StartN * ldb + k) : (k * ldb + StartN);
+                MlasBf16GemmCopyPackB(PanelB, B, ldb, TransB, CountN, CountK, AlignedCountK);
+                PanelStride = AlignedCountK * MLAS_BF16_GEMM_PANEL_N;
+                b = PanelB;
+            }
+
+            const uint16_t* a = A + (TransA ? (k * lda + RangeStartM) : (RangeStartM * lda + k));
+            MlasBf16GemmCopyPackA(PanelA, a, lda, TransA, RangeCountM, CountK, AlignedM, AlignedCountK);
+
+            Dispatch->Kernel(PanelA, b, Accumulator, RangeCountM, CountN, AlignedCountK,
+                             AlignedCountK, PanelStride, StrideN, k == 0);
+        }
+
+        if (K == 0) {
+            std::fill_n(Accumulator, StrideM * StrideN, 0.0f);
+        }
+
+        //
+        // Apply alpha and beta and round the accumulators to bfloat16.
+        //
+
+        const float alpha = Data->alpha;
+        const float beta = Data->beta;
+
+        for (size_t m = 0; m < RangeCountM; m++) {
+
+            const float* acc = Accumulator + m * StrideN;
+            uint16_t* c = C + (RangeStartM + m) * ldc + StartN;
+
+            if (beta == 0.0f) {
+                for (size_t j = 0; j < CountN; j++) {
+                    c[j] = MlasFloatToBf16(alpha * acc[j]);
+                }
+            } else {
+                for (size_t j = 0; j < CountN; j++) {
+                    c[j] = MlasFloatToBf16(alpha * acc[j] + beta * MlasBf16ToFloat(c[j]));
+                }
+            }
+        }
+    }
+}
+
+static
+void
+MlasBf16GemmConvertToFloat(
+    float* D,
+    const uint16_t* S,
+    size_t Rows,
+    size_t Columns,
+    size_t lds
+    )
+{
+    for (size_t r = 0; r < Rows; r++) {
+        for (size_t c = 0; c < Columns; c++) {
+            D[r * Columns + c] = MlasBf16ToFloat(S[r * lds + c]);
+        }
+    }
+}
+
+static
+void
+MlasBf16GemmBatchFallback(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_BF16_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the bfloat16 GEMM with the single precision GEMM,
+    for CPUs without a bfloat16 kernel. Packed B holds the matrix packed by
+    MlasGemmPackB.
+
+--*/
+{
+    const size_t ARows = (TransA == CblasNoTrans) ? M : K;
+    const size_t AColumns = (TransA == CblasNoTrans) ? K : M;
+    const size_t BRows = (TransB == CblasNoTrans) ? K : N;
+    const size_t BColumns = (TransB == CblasNoTrans) ? N : K;
+
+    for (size_t i = 0; i < BatchSize; i++) {
+
+        const auto& Params = Data[i];
+
+        std::unique_ptr<float[]> A(new float[ARows * AColumns]);
+        MlasBf16GemmConvertToFloat(A.get(), reinterpret_cast<const uint16_t*>(Params.A),
+                                   ARows, AColumns, Params.lda);
+
+        std::unique_ptr<float[]> B;
+        if (!Params.BIsPacked) {
+            B.reset(new float[BRows * BColumns]);
+            MlasBf16GemmConvertToFloat(B.get(), reinterpret_cast<const uint16_t*>(Params.B),
+                                       BRows, BColumns, Params.ldb);
+        }
+
+        auto* C = reinterpret_cast<uint16_t*>(Params.C);
+        std::unique_ptr<float[]> CFloat(new float[M * N]);
+        if (Params.beta != 0.0f) {
+            MlasBf16GemmConvertToFloat(CFloat.get(), C, M, N, Params.ldc);
+        }
+
+        MLAS_SGEMM_DATA_PARAMS SgemmParams;
+        SgemmParams.A = A.get();
+        SgemmParams.lda = AColumns;
+        SgemmParams.B = Params.BIsPacked ? static_cast<const float*>(Params.B) : B.get();
+        SgemmParams.ldb = BColumns;
+        SgemmParams.C = CFloat.get();
+        SgemmParams.ldc = N;
+        SgemmParams.alpha = Params.alpha;
+        SgemmParams.beta = Params.beta;
+        SgemmParams.BIsPacked = Params.BIsPacked;
+
+        MlasGemmBatch(TransA, TransB, M, N, K, &SgemmParams, 1, ThreadPool);
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                C[m * Params.ldc + n] = MlasFloatToBf16(CFloat[m * N + n]);
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasBf16GemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_BF16_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const MLAS_BF16_GEMM_DISPATCH* Dispatch = GetMlasPlatform().Bf16GemmDispatch;
+
+    if (Dispatch == nullptr) {
+        MlasBf16GemmBatchFallback(TransA, TransB, M, N, K, Data, BatchSize, ThreadPool);
+        return;
+    }
+
+    const bool TransAFlag = (TransA != CblasNoTrans);
+    const bool TransBFlag = (TransB != CblasNoTrans);
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchSize;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    constexpr size_t StrideM = MLAS_BF16_GEMM_STRIDEM;
+
+    //
+    // Each work item computes at most StrideM rows. Split the columns when
+    // there are not enough row blocks to keep the threads busy.
+    //
+
+    size_t nc = N;
+    const size_t BlockedM = MlasDivRoundup(M, StrideM);
+    if (size_t(ThreadsPerGemm) > BlockedM) {
+        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
+        if (max_nc < nc) {
+            nc = std::min(nc, MlasDivRoundup(max_nc, MLAS_QGEMM_STRIDEN_THREAD_ALIGN) *
+                                  MLAS_QGEMM_STRIDEN_THREAD_ALIGN);
+        }
+    }
+    const size_t StrideN = nc;
+
+    const size_t ThreadCountM = BlockedM;
+    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
+    const size_t WorkPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(WorkPerGemm * BatchSize), [&](ptrdiff_t tid) {
+        const size_t gemm_i = size_t(tid) / WorkPerGemm;
+        const size_t blk_i = size_t(tid) % WorkPerGemm;
+
+        const size_t ThreadIdN = blk_i / ThreadCountM;
+        const size_t ThreadIdM = blk_i % ThreadCountM;
+
+        const size_t RangeStartM = ThreadIdM * StrideM;
+        const size_t RangeCountM = std::min(M - RangeStartM, StrideM);
+
+        const size_t RangeStartN = ThreadIdN * StrideN;
+        const size_t RangeCountN = std::min(N - RangeStartN, StrideN);
+
+        MlasBf16GemmOperation(Dispatch, TransAFlag, TransBFlag, K, &Data[gemm_i],
+                              RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+    });
+}
+
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+    const MLAS_BF16_GEMM_DISPATCH* Dispatch = GetMlasPlatform().Bf16GemmDispatch;
+
+    if (Dispatch == nullptr) {
+        return MlasGemmPackBSize(N, K);
+    }
+
+    const size_t PackedK = Dispatch->PackedK;
+    const size_t AlignedK = (K + PackedK - 1) / PackedK * PackedK;
+    const size_t AlignedN = MlasDivRoundup(N, MLAS_BF16_GEMM_PANEL_N) * MLAS_BF16_GEMM_PANEL_N;
+
+    const size_t BytesRequired = AlignedN * AlignedK * sizeof(uint16_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired =
+        (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasBf16GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    const MLAS_BF16_GEMM_DISPATCH* Dispatch = GetMlasPlatform().Bf16GemmDispatch;
+    const auto* b = reinterpret_cast<const uint16_t*>(B);
+
+    if (Dispatch == nullptr) {
+        const size_t BRows = (TransB == CblasNoTrans) ? K : N;
+        const size_t BColumns = (TransB == CblasNoTrans) ? N : K;
+        std::unique_ptr<float[]> BFloat(new float[BRows * BColumns]);
+        MlasBf16GemmConvertToFloat(BFloat.get(), b, BRows, BColumns, ldb);
+        MlasGemmPackB(TransB, N, K, BFloat.get(), BColumns, PackedB);
+        return;
+    }
+
+    const size_t PackedK = Dispatch->PackedK;
+    const size_t AlignedK = (K + PackedK - 1) / PackedK * PackedK;
+
+    MlasBf16GemmCopyPackB(reinterpret_cast<uint16_t*>(PackedB), b, ldb, TransB != CblasNoTrans,
+                          N, K, AlignedK);
+}
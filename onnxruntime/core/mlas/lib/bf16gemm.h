@@ -0,0 +1,112 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.h
+
+Abstract:
+
+    This module defines the kernel dispatch structure and the shared helpers
+    of the bfloat16 matrix/matrix multiply operation.
+
+    The kernels multiply a packed panel of A with a packed panel of B and
+    accumulate into an fp32 tile. The packed B layout pairs consecutive rows
+    of K so that both VDPBF16PS and TDPBF16PS can consume it directly: for
+    each group of 16 columns (a "panel") and each pair of rows k, k + 1, the
+    panel stores 16 x 2 bfloat16 values, column major within the pair.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+#include <cstring>
+
+//
+// Blocking of the bfloat16 GEMM driver. The fp32 accumulation tile holds
+// StrideM x StrideN values, the packed B block StrideK x StrideN values.
+//
+
+constexpr size_t MLAS_BF16_GEMM_STRIDEM = 32;
+constexpr size_t MLAS_BF16_GEMM_STRIDEN = 128;
+constexpr size_t MLAS_BF16_GEMM_STRIDEK = 256;
+
+//
+// Number of columns of a packed B panel.
+//
+
+constexpr size_t MLAS_BF16_GEMM_PANEL_N = 16;
+
+/**
+ * @brief Multiply a packed A block with a packed B block.
+ *
+ * @param A           Packed A, CountM rows of CountK values with stride lda.
+ *                    Rows are padded with zeros to a multiple of the AlignM
+ *                    of the dispatch.
+ * @param B           Packed B, the first panel of the block.
+ * @param C           fp32 accumulators, with room for whole panels.
+ * @param CountM      Number of rows of A and C.
+ * @param CountN      Number of columns of B and C.
+ * @param CountK      Number of columns of A and rows of B, a multiple of the
+ *                    PackedK of the dispatch.
+ * @param lda         Leading dimension of packed A.
+ * @param PanelStride Number of elements between consecutive panels of B.
+ * @param ldc         Leading dimension of C.
+ * @param ZeroMode    Whether to overwrite C instead of accumulating into it.
+ */
+typedef
+void
+(MLAS_BF16_GEMM_KERNEL)(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    bool ZeroMode
+    );
+
+struct MLAS_BF16_GEMM_DISPATCH {
+    MLAS_BF16_GEMM_KERNEL* Kernel;
+    size_t PackedK;  // K of the packed panels is padded to a multiple of this
+    size_t AlignM;   // rows of packed A are padded to a multiple of this
+};
+
+MLAS_FORCEINLINE
+float
+MlasBf16ToFloat(
+    uint16_t Value
+    )
+{
+    const uint32_t Bits = uint32_t(Value) << 16;
+    float f;
+    std::memcpy(&f, &Bits, sizeof(f));
+    return f;
+}
+
+//
+// Round to nearest even, as onnxruntime::BFloat16 does.
+//
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBf16(
+    float Value
+    )
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    if ((Bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return 0x7FC1;
+    }
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+    return uint16_t(Bits >> 16);
+}
@@ -0,0 +1,155 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the bfloat16 GEMM kernel for processors with
+    AMX-BF16, using TDPBF16PS.
+
+    All tiles are 16 rows of 64 bytes: 16 x 32 bfloat16 values of A, 16 pairs
+    of rows of a B panel, or 16 x 16 fp32 values of C. Tiles 0-3 hold C, 4-5
+    hold A and 6-7 hold B.
+
+--*/
+
+#include "bf16gemm.h"
+#include "amx_common.h"
+
+static
+void
+MlasBf16GemmAmxInitTileConfig()
+{
+    struct tileconfig_t tc;
+    tc.palette_id = 1;
+    for (int t = 0; t < 8; t++) {
+        tc.rows[t] = 16;
+        tc.colb[t] = 64;
+    }
+
+    struct tileconfig_t current_tc;
+    tile_storeconfig(&current_tc);
+
+    if (current_tc.palette_id != tc.palette_id ||
+        std::memcmp(&current_tc.colb, &tc.colb, sizeof(tc.colb)) != 0 ||
+        std::memcmp(&current_tc.rows, &tc.rows, sizeof(tc.rows)) != 0) {
+        tile_loadconfig(&tc);
+    }
+}
+
+template <bool TwoRowTiles, bool TwoPanels>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmKernelAmxBlock(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    const size_t StrideA = lda * sizeof(uint16_t);
+    const size_t StrideC = ldc * sizeof(float);
+    constexpr size_t StrideB = MLAS_BF16_GEMM_PANEL_N * 2 * sizeof(uint16_t);
+
+    float* c0 = C;
+    float* c1 = C + MLAS_BF16_GEMM_PANEL_N;
+    float* c2 = C + 16 * ldc;
+    float* c3 = C + 16 * ldc + MLAS_BF16_GEMM_PANEL_N;
+
+    if (ZeroMode) {
+        tile_zero(0);
+        if (TwoPanels) tile_zero(1);
+        if (TwoRowTiles) tile_zero(2);
+        if (TwoRowTiles && TwoPanels) tile_zero(3);
+    } else {
+        tile_loadd(0, c0, StrideC);
+        if (TwoPanels) tile_loadd(1, c1, StrideC);
+        if (TwoRowTiles) tile_loadd(2, c2, StrideC);
+        if (TwoRowTiles && TwoPanels) tile_loadd(3, c3, StrideC);
+    }
+
+    for (size_t k = 0; k < CountK; k += 32) {
+
+        tile_loadd(4, A + k, StrideA);
+        if (TwoRowTiles) tile_loadd(5, A + 16 * lda + k, StrideA);
+
+        tile_loadd(6, B + k * MLAS_BF16_GEMM_PANEL_N, StrideB);
+        if (TwoPanels) tile_loadd(7, B + PanelStride + k * MLAS_BF16_GEMM_PANEL_N, StrideB);
+
+        tile_dpbf16ps(0, 4, 6);
+        if (TwoPanels) tile_dpbf16ps(1, 4, 7);
+        if (TwoRowTiles) tile_dpbf16ps(2, 5, 6);
+        if (TwoRowTiles && TwoPanels) tile_dpbf16ps(3, 5, 7);
+    }
+
+    tile_stored(0, c0, StrideC);
+    if (TwoPanels) tile_stored(1, c1, StrideC);
+    if (TwoRowTiles) tile_stored(2, c2, StrideC);
+    if (TwoRowTiles && TwoPanels) tile_stored(3, c3, StrideC);
+}
+
+static
+void
+MlasBf16GemmKernelAmx(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    MlasBf16GemmAmxInitTileConfig();
+
+    //
+    // Rows of packed A are padded to a multiple of 16 and the accumulators
+    // are stored as whole tiles, so blocks are computed without masking.
+    //
+
+    for (size_t m = 0; m < CountM; m += 32) {
+
+        const bool TwoRowTiles = CountM - m > 16;
+        const uint16_t* a = A + m * lda;
+        float* c = C + m * ldc;
+
+        for (size_t n = 0; n < CountN; n += 2 * MLAS_BF16_GEMM_PANEL_N) {
+
+            const bool TwoPanels = CountN - n > MLAS_BF16_GEMM_PANEL_N;
+            const uint16_t* b = B + (n / MLAS_BF16_GEMM_PANEL_N) * PanelStride;
+
+            if (TwoRowTiles) {
+                if (TwoPanels) {
+                    MlasBf16GemmKernelAmxBlock<true, true>(a, b, c + n, CountK, lda, PanelStride, ldc, ZeroMode);
+                } else {
+                    MlasBf16GemmKernelAmxBlock<true, false>(a, b, c + n, CountK, lda, PanelStride, ldc, ZeroMode);
+                }
+            } else {
+                if (TwoPanels) {
+                    MlasBf16GemmKernelAmxBlock<false, true>(a, b, c + n, CountK, lda, PanelStride, ldc, ZeroMode);
+                } else {
+                    MlasBf16GemmKernelAmxBlock<false, false>(a, b, c + n, CountK, lda, PanelStride, ldc, ZeroMode);
+                }
+            }
+        }
+    }
+}
+
+const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAmx = {
+    MlasBf16GemmKernelAmx,
+    32,
+    16,
+};
@@ -0,0 +1,155 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 GEMM kernel for processors with
+    AVX512-BF16, using VDPBF16PS.
+
+--*/
+
+#include "bf16gemm.h"
+
+template <size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmKernelAvx512Bf16Block(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        __m512bh BElements[PanelCount];
+        for (size_t p = 0; p < PanelCount; p++) {
+            BElements[p] = (__m512bh)_mm512_loadu_si512(B + p * PanelStride + k * MLAS_BF16_GEMM_PANEL_N);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            int32_t APair;
+            std::memcpy(&APair, A + r * lda + k, sizeof(APair));
+            const __m512bh ABroadcast = (__m512bh)_mm512_set1_epi32(APair);
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(Accumulators[r][p], ABroadcast, BElements[p]);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            float* c = C + r * ldc + p * MLAS_BF16_GEMM_PANEL_N;
+            if (!ZeroMode) {
+                Accumulators[r][p] = _mm512_add_ps(Accumulators[r][p], _mm512_loadu_ps(c));
+            }
+            _mm512_storeu_ps(c, Accumulators[r][p]);
+        }
+    }
+}
+
+template <size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmKernelAvx512Bf16Panels(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    while (CountM >= 8) {
+        MlasBf16GemmKernelAvx512Bf16Block<8, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+        A += 8 * lda;
+        C += 8 * ldc;
+        CountM -= 8;
+    }
+
+    switch (CountM) {
+        case 7:
+            MlasBf16GemmKernelAvx512Bf16Block<7, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+            break;
+        case 6:
+            MlasBf16GemmKernelAvx512Bf16Block<6, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+            break;
+        case 5:
+            MlasBf16GemmKernelAvx512Bf16Block<5, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+            break;
+        case 4:
+            MlasBf16GemmKernelAvx512Bf16Block<4, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+            break;
+        case 3:
+            MlasBf16GemmKernelAvx512Bf16Block<3, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+            break;
+        case 2:
+            MlasBf16GemmKernelAvx512Bf16Block<2, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+            break;
+        case 1:
+            MlasBf16GemmKernelAvx512Bf16Block<1, PanelCount>(A, B, C, CountK, lda, PanelStride, ldc, ZeroMode);
+            break;
+        default:
+            break;
+    }
+}
+
+static
+void
+MlasBf16GemmKernelAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    //
+    // Process two panels (32 columns) at a time. The accumulators are stored
+    // as whole panels, the columns past CountN are ignored by the caller.
+    //
+
+    for (size_t n = 0; n < CountN; n += 2 * MLAS_BF16_GEMM_PANEL_N) {
+
+        const uint16_t* b = B + (n / MLAS_BF16_GEMM_PANEL_N) * PanelStride;
+
+        if (CountN - n > MLAS_BF16_GEMM_PANEL_N) {
+            MlasBf16GemmKernelAvx512Bf16Panels<2>(A, b, C + n, CountM, CountK, lda, PanelStride, ldc, ZeroMode);
+        } else {
+            MlasBf16GemmKernelAvx512Bf16Panels<1>(A, b, C + n, CountM, CountK, lda, PanelStride, ldc, ZeroMode);
+        }
+    }
+}
+
+const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16 = {
+    MlasBf16GemmKernelAvx512Bf16,
+    2,
+    1,
+};
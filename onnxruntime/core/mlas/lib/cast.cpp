@@ -0,0 +1,234 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements the conversion routines between the floating point
+    and integer element types.
+
+--*/
+
+#include "mlasi.h"
+#include "mlas_float16.h"
+
+#include <cstring>
+
+//
+// The portable kernels are written as simple loops over the elements so that
+// the compiler is free to vectorize them for the target architecture.
+//
+
+void
+MLASCALL
+MlasCastF16ToF32Kernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_ARM64)
+    while (Count >= 4) {
+        vst1q_f32(Destination, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(Source))));
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Half2Float(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16Kernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_ARM64)
+    while (Count >= 4) {
+        vst1_u16(Destination, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(Source))));
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Float2Half(Source[i]);
+    }
+}
+
+//
+// Windows x64 uses the assembly version of this routine (cvtfp16a.asm).
+//
+
+#if !(defined(_WIN32) && defined(MLAS_TARGET_AMD64))
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF16ToF32Kernel(Source, Destination, Count);
+#else
+    MlasCastF16ToF32Kernel(Source, Destination, Count);
+#endif
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToF16Kernel(Source, Destination, Count);
+#else
+    MlasCastF32ToF16Kernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        const uint32_t Bits = uint32_t(Source[i]) << 16;
+        std::memcpy(&Destination[i], &Bits, sizeof(float));
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        uint32_t Bits;
+        std::memcpy(&Bits, &Source[i], sizeof(float));
+
+        //
+        // Round to nearest even by adding 0x7FFF plus the lowest retained bit.
+        // NaN is mapped to a quiet NaN of the same sign, as the rounding bias
+        // could otherwise carry a NaN with a small payload into infinity.
+        //
+
+        const uint32_t RoundingBias = 0x7FFF + ((Bits >> 16) & 1);
+        const uint16_t Rounded = uint16_t((Bits + RoundingBias) >> 16);
+        const uint16_t QuietNaN = uint16_t(((Bits >> 16) & 0x8000) | 0x7FC0);
+
+        Destination[i] = ((Bits & 0x7FFFFFFF) > 0x7F800000) ? QuietNaN : Rounded;
+    }
+}
+
+template<typename InputType, typename OutputType>
+void
+MLASCALL
+MlasConvertBuffer(
+    const InputType* Source,
+    OutputType* Destination,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = static_cast<OutputType>(Source[i]);
+    }
+}
+
+template
+void
+MLASCALL
+MlasConvertBuffer<int8_t, float>(
+    const int8_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+template
+void
+MLASCALL
+MlasConvertBuffer<uint8_t, float>(
+    const uint8_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+template
+void
+MLASCALL
+MlasConvertBuffer<int32_t, float>(
+    const int32_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+template
+void
+MLASCALL
+MlasConvertBuffer<int64_t, float>(
+    const int64_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+template
+void
+MLASCALL
+MlasConvertBuffer<float, int8_t>(
+    const float* Source,
+    int8_t* Destination,
+    size_t Count
+    );
+
+template
+void
+MLASCALL
+MlasConvertBuffer<float, uint8_t>(
+    const float* Source,
+    uint8_t* Destination,
+    size_t Count
+    );
+
+template
+void
+MLASCALL
+MlasConvertBuffer<float, int32_t>(
+    const float* Source,
+    int32_t* Destination,
+    size_t Count
+    );
+
+template
+void
+MLASCALL
+MlasConvertBuffer<float, int64_t>(
+    const float* Source,
+    int64_t* Destination,
+    size_t Count
+    );
@@ -0,0 +1,81 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the half precision conversion kernels for
+    processors with F16C.
+
+--*/
+
+#include "mlasi.h"
+#include "mlas_float16.h"
+
+void
+MLASCALL
+MlasCastF16ToF32KernelAvx2(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        const __m128i Half0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+        const __m128i Half1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + 8));
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(Half0));
+        _mm256_storeu_ps(Destination + 8, _mm256_cvtph_ps(Half1));
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+        const __m128i Half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(Half));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Half2Float(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx2(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        const __m128i Half0 = _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        const __m128i Half1 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + 8), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Half0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + 8), Half1);
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+        const __m128i Half = _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Half);
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Float2Half(Source[i]);
+    }
+}
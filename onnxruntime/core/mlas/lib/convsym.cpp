@@ -78,6 +78,7 @@ extern "C" {
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseKernelAvx512Core;
     MLAS_CONV_SYM_KERNEL MlasConvSymKernelAvx512Vnni;
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseKernelAvx512Vnni;
+    MLAS_CONV_SYM_KERNEL MlasConvSymKernelAmx;
 #elif defined(MLAS_TARGET_ARM64)
     MLAS_CONV_SYM_KERNEL MlasConvSymS8KernelNeon;
     MLAS_CONV_SYM_KERNEL MlasConvSymU8KernelNeon;
@@ -229,6 +230,31 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni = {
     false,                                  // FixupInputZeroPoint
 };
 
+#if !defined(__APPLE__)
+
+//
+// The AMX kernel consumes the filter packed for the AVX512VNNI kernel. AMX
+// has no use for depthwise convolution, which stays on AVX512VNNI.
+//
+
+const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx = {
+    MlasConvSymKernelAmx,
+    MlasConvSymDepthwiseKernelAvx512Vnni,
+    nullptr,
+    nullptr,
+    4,                                      // FilterInputChannelPackCount
+    16,                                     // FilterOutputChannelPackCount
+    64,                                     // KernelChannelCount
+    16,                                     // KernelOutputCount
+    4,                                      // KernelInputChannelAlignment
+    4,                                      // KernelOutputChannelAlignment
+    64,                                     // KernelDepthwiseChannelCount
+    6,                                      // KernelDepthwiseOutputCount
+    false,                                  // FixupInputZeroPoint
+};
+
+#endif // __APPLE__
+
 #endif // ORT_MINIMAL_BUILD
 
 #elif defined(MLAS_TARGET_ARM64)
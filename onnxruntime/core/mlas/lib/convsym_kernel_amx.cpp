@@ -0,0 +1,382 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convsym_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the symmetric quantized integer convolution kernel
+    for AMX.
+
+    The kernel consumes the filter in the format packed for the AVX512 kernels:
+    blocks of 16 output channels, each holding groups of 4 input channels for
+    every kernel position. 64 consecutive input channels of a block form one
+    16x64 byte B tile. A tile of 16 outputs by 64 input channels is loaded in
+    place from the input image for pointwise convolutions, and gathered
+    through the indirection buffer otherwise.
+
+--*/
+
+#include "mlasi.h"
+#include "amx_common.h"
+
+#include <cstring>
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+constexpr size_t MLAS_CONV_SYM_AMX_TILE_M = 16;
+constexpr size_t MLAS_CONV_SYM_AMX_TILE_N = 16;
+constexpr size_t MLAS_CONV_SYM_AMX_TILE_K = 64;
+
+//
+// Shallow convolutions waste most of each tile multiply, so they are passed
+// to the AVX512VNNI kernel, which consumes the same packed filter.
+//
+
+constexpr size_t MLAS_CONV_SYM_AMX_MINIMUM_INPUT_CHANNELS = 32;
+constexpr unsigned MLAS_CONV_SYM_AVX512VNNI_OUTPUT_COUNT = 6;
+
+extern "C" {
+
+    void
+    MLASCALL
+    MlasConvSymKernelAvx512Vnni(
+        const void* Input,
+        const void* Filter,
+        void* Output,
+        size_t KernelSize,
+        size_t InputChannels,
+        size_t OutputChannels,
+        unsigned ChannelCount,
+        unsigned OutputCount,
+        const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+        unsigned KernelFlags
+        );
+
+}
+
+static
+void
+MlasConvSymAmxLoadTileConfig(
+    void
+    )
+{
+    //
+    // All tiles are configured as 16 rows of 64 bytes, which is the
+    // configuration used by the QGEMM kernels, so the two can be interleaved
+    // on a thread without reloading.
+    //
+
+    static thread_local struct tileconfig_t tc = {};
+    struct tileconfig_t current_tc = {};
+    tile_storeconfig(&current_tc);
+
+    if (tc.palette_id == 0 || std::memcmp(&current_tc, &tc, sizeof(tileconfig_t)) != 0) {
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = 16;
+            tc.colb[t] = 64;
+        }
+        tile_loadconfig(&tc);
+    }
+}
+
+template<size_t BlockCount>
+void
+MlasConvSymKernelAmxAccumulate(
+    const void* Input,
+    const int8_t* Filter,
+    int32_t* Accumulators,
+    size_t KernelSize,
+    size_t InputChannels,
+    unsigned OutputCount,
+    bool InputDirect,
+    uint8_t* ABuffer,
+    int8_t* BBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates a 16 x (16 * BlockCount) block of outputs.
+
+Arguments:
+
+    Input - Supplies the input image for a pointwise convolution, else the
+        indirection buffer.
+
+    Filter - Supplies the packed filter of the first output channel.
+
+    Accumulators - Supplies the buffer that receives the 16x16 accumulator
+        tiles.
+
+    KernelSize - Supplies the number of kernel positions.
+
+    InputChannels - Supplies the number of input channels.
+
+    OutputCount - Supplies the number of outputs to produce.
+
+    InputDirect - Supplies true if Input is the input image.
+
+    ABuffer - Supplies a 16x64 byte buffer for a gathered input tile. The rows
+        from OutputCount onwards are zero.
+
+    BBuffer - Supplies BlockCount 16x64 byte buffers for filter tiles that
+        are shorter than 64 input channels.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterBlockStride = MLAS_CONV_SYM_AMX_TILE_N * InputChannels * KernelSize;
+    const bool LoadInPlace = InputDirect && OutputCount == MLAS_CONV_SYM_AMX_TILE_M;
+
+    tile_zero(TMM0);
+    if constexpr (BlockCount > 1) {
+        tile_zero(TMM1);
+    }
+    if constexpr (BlockCount > 2) {
+        tile_zero(TMM2);
+    }
+    if constexpr (BlockCount > 3) {
+        tile_zero(TMM3);
+    }
+
+    for (size_t k = 0; k < KernelSize; k++) {
+
+        for (size_t ic = 0; ic < InputChannels; ic += MLAS_CONV_SYM_AMX_TILE_K) {
+
+            const size_t CountK = std::min(InputChannels - ic, MLAS_CONV_SYM_AMX_TILE_K);
+
+            //
+            // Load the input tile in place when all 16 rows and 64 columns
+            // are present, else gather it with the missing columns zeroed.
+            //
+
+            if (LoadInPlace && CountK == MLAS_CONV_SYM_AMX_TILE_K) {
+                tile_loadd(TMM4, static_cast<const uint8_t*>(Input) + ic, InputChannels);
+            } else {
+                const __mmask64 MaskK = (CountK == 64) ? ~__mmask64(0) : ((__mmask64(1) << CountK) - 1);
+
+                for (size_t m = 0; m < OutputCount; m++) {
+                    const uint8_t* row;
+                    if (InputDirect) {
+                        row = static_cast<const uint8_t*>(Input) + m * InputChannels;
+                    } else {
+                        row = static_cast<const uint8_t* const*>(Input)[m * KernelSize + k];
+                    }
+                    _mm512_storeu_si512(ABuffer + m * MLAS_CONV_SYM_AMX_TILE_K,
+                                        _mm512_maskz_loadu_epi8(MaskK, row + ic));
+                }
+
+                tile_loadd(TMM4, ABuffer, MLAS_CONV_SYM_AMX_TILE_K);
+            }
+
+            //
+            // The filter tiles of the 64 input channels are contiguous. A
+            // shorter tile is copied so that no load runs past the filter.
+            //
+
+            const int8_t* b = Filter + (k * InputChannels + ic) * MLAS_CONV_SYM_AMX_TILE_N;
+            const size_t ldb = MLAS_CONV_SYM_AMX_TILE_K;
+            size_t BlockStride = FilterBlockStride;
+
+            if (CountK != MLAS_CONV_SYM_AMX_TILE_K) {
+                const size_t TileSize = MLAS_CONV_SYM_AMX_TILE_K * MLAS_CONV_SYM_AMX_TILE_N;
+                for (size_t n = 0; n < BlockCount; n++) {
+                    std::memcpy(BBuffer + n * TileSize, b + n * FilterBlockStride, CountK * MLAS_CONV_SYM_AMX_TILE_N);
+                    std::memset(BBuffer + n * TileSize + CountK * MLAS_CONV_SYM_AMX_TILE_N, 0,
+                                (MLAS_CONV_SYM_AMX_TILE_K - CountK) * MLAS_CONV_SYM_AMX_TILE_N);
+                }
+                b = BBuffer;
+                BlockStride = TileSize;
+            }
+
+            tile_loadd(TMM5, b, ldb);
+            tile_dpbusd(TMM0, TMM4, TMM5);
+            if constexpr (BlockCount > 1) {
+                tile_loadd(TMM6, b + BlockStride, ldb);
+                tile_dpbusd(TMM1, TMM4, TMM6);
+            }
+            if constexpr (BlockCount > 2) {
+                tile_loadd(TMM7, b + 2 * BlockStride, ldb);
+                tile_dpbusd(TMM2, TMM4, TMM7);
+            }
+            if constexpr (BlockCount > 3) {
+                tile_loadd(TMM5, b + 3 * BlockStride, ldb);
+                tile_dpbusd(TMM3, TMM4, TMM5);
+            }
+        }
+    }
+
+    const size_t AccumulatorTileSize = MLAS_CONV_SYM_AMX_TILE_M * MLAS_CONV_SYM_AMX_TILE_N;
+
+    tile_stored(TMM0, Accumulators, MLAS_CONV_SYM_AMX_TILE_N * sizeof(int32_t));
+    if constexpr (BlockCount > 1) {
+        tile_stored(TMM1, Accumulators + AccumulatorTileSize, MLAS_CONV_SYM_AMX_TILE_N * sizeof(int32_t));
+    }
+    if constexpr (BlockCount > 2) {
+        tile_stored(TMM2, Accumulators + 2 * AccumulatorTileSize, MLAS_CONV_SYM_AMX_TILE_N * sizeof(int32_t));
+    }
+    if constexpr (BlockCount > 3) {
+        tile_stored(TMM3, Accumulators + 3 * AccumulatorTileSize, MLAS_CONV_SYM_AMX_TILE_N * sizeof(int32_t));
+    }
+}
+
+extern "C"
+void
+MLASCALL
+MlasConvSymKernelAmx(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 16 outputs of up to 64 output channels of a
+    symmetric quantized convolution with unsigned input.
+
+Arguments:
+
+    Input - Supplies the indirection buffer, or the input image if
+        MLAS_CONV_SYM_FLAG_INPUT_DIRECT is set.
+
+    Filter - Supplies the packed filter of the first output channel.
+
+    Output - Supplies the output of the first output channel of the first
+        output.
+
+    KernelSize - Supplies the number of kernel positions.
+
+    InputChannels - Supplies the number of input channels.
+
+    OutputChannels - Supplies the number of output channels, which is the
+        stride between outputs.
+
+    ChannelCount - Supplies the number of output channels to produce.
+
+    OutputCount - Supplies the number of outputs to produce.
+
+    PostProcessParams - Supplies the requantization parameters.
+
+    KernelFlags - Supplies the MLAS_CONV_SYM_FLAG flags.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const bool InputDirect = (KernelFlags & MLAS_CONV_SYM_FLAG_INPUT_DIRECT) != 0;
+
+    if (InputChannels < MLAS_CONV_SYM_AMX_MINIMUM_INPUT_CHANNELS) {
+
+        while (OutputCount > 0) {
+
+            const unsigned Count = std::min(OutputCount, MLAS_CONV_SYM_AVX512VNNI_OUTPUT_COUNT);
+
+            MlasConvSymKernelAvx512Vnni(Input, Filter, Output, KernelSize, InputChannels,
+                OutputChannels, ChannelCount, Count, PostProcessParams, KernelFlags);
+
+            if (InputDirect) {
+                Input = static_cast<const uint8_t*>(Input) + Count * InputChannels;
+            } else {
+                Input = static_cast<const void* const*>(Input) + Count * KernelSize;
+            }
+            Output = static_cast<uint8_t*>(Output) + Count * OutputChannels;
+            OutputCount -= Count;
+        }
+
+        return;
+    }
+
+    MlasConvSymAmxLoadTileConfig();
+
+    MLAS_DECLSPEC_ALIGN(uint8_t ABuffer[MLAS_CONV_SYM_AMX_TILE_M * MLAS_CONV_SYM_AMX_TILE_K], 64);
+    MLAS_DECLSPEC_ALIGN(int8_t BBuffer[4 * MLAS_CONV_SYM_AMX_TILE_K * MLAS_CONV_SYM_AMX_TILE_N], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t Accumulators[4 * MLAS_CONV_SYM_AMX_TILE_M * MLAS_CONV_SYM_AMX_TILE_N], 64);
+
+    std::memset(ABuffer + OutputCount * MLAS_CONV_SYM_AMX_TILE_K, 0,
+                (MLAS_CONV_SYM_AMX_TILE_M - OutputCount) * MLAS_CONV_SYM_AMX_TILE_K);
+
+    const size_t BlockCount = MlasDivRoundup(ChannelCount, MLAS_CONV_SYM_AMX_TILE_N);
+    const int8_t* PackedFilter = static_cast<const int8_t*>(Filter);
+
+    switch (BlockCount) {
+        case 1:
+            MlasConvSymKernelAmxAccumulate<1>(Input, PackedFilter, Accumulators, KernelSize,
+                InputChannels, OutputCount, InputDirect, ABuffer, BBuffer);
+            break;
+        case 2:
+            MlasConvSymKernelAmxAccumulate<2>(Input, PackedFilter, Accumulators, KernelSize,
+                InputChannels, OutputCount, InputDirect, ABuffer, BBuffer);
+            break;
+        case 3:
+            MlasConvSymKernelAmxAccumulate<3>(Input, PackedFilter, Accumulators, KernelSize,
+                InputChannels, OutputCount, InputDirect, ABuffer, BBuffer);
+            break;
+        default:
+            MlasConvSymKernelAmxAccumulate<4>(Input, PackedFilter, Accumulators, KernelSize,
+                InputChannels, OutputCount, InputDirect, ABuffer, BBuffer);
+            break;
+    }
+
+    //
+    // Apply the bias and the scale, clip to the output range and add the
+    // output zero point.
+    //
+
+    const bool PerChannelScale = (KernelFlags & MLAS_CONV_SYM_FLAG_PER_CHANNEL_SCALE) != 0;
+    const __m512 MinimumValue = _mm512_set1_ps(PostProcessParams->MinimumValue);
+    const __m512 MaximumValue = _mm512_set1_ps(PostProcessParams->MaximumValue);
+    const __m512i OutputZeroPoint = _mm512_set1_epi32(PostProcessParams->OutputZeroPoint);
+
+    for (size_t n = 0; n < BlockCount; n++) {
+
+        const size_t Channel = n * MLAS_CONV_SYM_AMX_TILE_N;
+        const size_t CountN = std::min<size_t>(ChannelCount - Channel, MLAS_CONV_SYM_AMX_TILE_N);
+        const __mmask16 MaskN = __mmask16((1u << CountN) - 1);
+
+        const __m512i Bias = _mm512_maskz_loadu_epi32(MaskN, PostProcessParams->Bias + Channel);
+        const __m512 Scale = PerChannelScale
+            ? _mm512_maskz_loadu_ps(MaskN, PostProcessParams->Scale + Channel)
+            : _mm512_set1_ps(PostProcessParams->Scale[0]);
+
+        const int32_t* acc = Accumulators + n * MLAS_CONV_SYM_AMX_TILE_M * MLAS_CONV_SYM_AMX_TILE_N;
+        uint8_t* out = static_cast<uint8_t*>(Output) + Channel;
+
+        for (size_t m = 0; m < OutputCount; m++) {
+            __m512 Value = _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_load_si512(acc), Bias));
+            Value = _mm512_mul_ps(Value, Scale);
+            Value = _mm512_min_ps(_mm512_max_ps(Value, MinimumValue), MaximumValue);
+            const __m512i Integer = _mm512_add_epi32(_mm512_cvtps_epi32(Value), OutputZeroPoint);
+            _mm512_mask_cvtepi32_storeu_epi8(out, MaskN, Integer);
+
+            acc += MLAS_CONV_SYM_AMX_TILE_N;
+            out += OutputChannels;
+        }
+    }
+}
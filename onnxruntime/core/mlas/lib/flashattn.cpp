@@ -0,0 +1,298 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements multi-head attention in blocks of queries and keys
+    with an online softmax.
+
+    Each work item owns one block of queries of one head. The scores of the
+    block against a block of keys are computed with SGEMM, exponentiated
+    relative to the running maximum of each query, and multiplied with the
+    block of values into an fp32 accumulator. The accumulator is rescaled
+    whenever the running maximum grows. fp16 and bfloat16 keys and values are
+    converted to fp32 one block at a time.
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+#include <limits>
+
+//
+// Number of queries and keys in a block. A block of scores and the
+// accumulator stay in the L2 cache for the usual head sizes.
+//
+
+constexpr size_t MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q = 64;
+constexpr size_t MLAS_FLASH_ATTENTION_BLOCK_SIZE_KV = 256;
+
+//
+// Element types of the keys and values. Load returns a block as fp32. fp32
+// blocks are used in place. fp16 and bfloat16 blocks are accessed as their
+// bits so that this module does not depend on the complete MLAS_FP16 and
+// MLAS_BF16 types.
+//
+
+struct MLAS_FLASH_ATTENTION_ELEMENT_FP32 {
+    using Storage = float;
+    static constexpr bool NeedsBuffer = false;
+
+    static MLAS_FORCEINLINE const float* Load(const float* Source, float*, size_t) { return Source; }
+};
+
+struct MLAS_FLASH_ATTENTION_ELEMENT_FP16 {
+    using Storage = unsigned short;
+    static constexpr bool NeedsBuffer = true;
+
+    static MLAS_FORCEINLINE const float* Load(const unsigned short* Source, float* Buffer, size_t N)
+    {
+        MlasConvertHalfToFloatBuffer(Source, Buffer, N);
+        return Buffer;
+    }
+};
+
+struct MLAS_FLASH_ATTENTION_ELEMENT_BF16 {
+    using Storage = unsigned short;
+    static constexpr bool NeedsBuffer = true;
+
+    static MLAS_FORCEINLINE const float* Load(const unsigned short* Source, float* Buffer, size_t N)
+    {
+        MlasConvertBFloat16ToFloatBuffer(Source, Buffer, N);
+        return Buffer;
+    }
+};
+
+template<typename T>
+struct MLAS_FLASH_ATTENTION_ELEMENT;
+
+template<>
+struct MLAS_FLASH_ATTENTION_ELEMENT<float> : MLAS_FLASH_ATTENTION_ELEMENT_FP32 {};
+
+template<>
+struct MLAS_FLASH_ATTENTION_ELEMENT<MLAS_FP16> : MLAS_FLASH_ATTENTION_ELEMENT_FP16 {};
+
+template<>
+struct MLAS_FLASH_ATTENTION_ELEMENT<MLAS_BF16> : MLAS_FLASH_ATTENTION_ELEMENT_BF16 {};
+
+template<typename KvType>
+void
+MlasFlashAttentionBlock(
+    const MLAS_FLASH_ATTENTION_PARAMS<KvType>& Params,
+    size_t WorkIndex
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output of one block of queries of one head.
+
+Arguments:
+
+    Params - Supplies the attention data.
+
+    WorkIndex - Supplies the index of the block of queries, ordered by batch,
+        head and block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using E = MLAS_FLASH_ATTENTION_ELEMENT<KvType>;
+    using Storage = typename E::Storage;
+
+    const size_t N = Params.NumHeads;
+    const size_t S = Params.SequenceLength;
+    const size_t T = Params.TotalSequenceLength;
+    const size_t H = Params.QkHeadSize;
+    const size_t Hv = Params.VHeadSize;
+
+    const size_t QueryBlockCount = MlasDivRoundup(S, MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q);
+    const size_t bn = WorkIndex / QueryBlockCount;
+    const size_t b = bn / N;
+    const size_t n = bn % N;
+    const size_t q0 = (WorkIndex % QueryBlockCount) * MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q;
+    const size_t Rows = std::min(S - q0, MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q);
+
+    const float* Query = Params.Query + (bn * S + q0) * H;
+    const Storage* Key = reinterpret_cast<const Storage*>(Params.Key) + bn * T * H;
+    const Storage* Value = reinterpret_cast<const Storage*>(Params.Value) + bn * T * Hv;
+    const float* KeyMask = (Params.KeyMask != nullptr) ? Params.KeyMask + b * T : nullptr;
+
+    //
+    // Query s attends to the keys before CausalOffset + s + 1. Blocks of keys
+    // after the last query of the block are skipped.
+    //
+
+    const ptrdiff_t CausalOffset = ptrdiff_t(T) - ptrdiff_t(S);
+    size_t KeyCount = T;
+
+    if (Params.Causal) {
+        KeyCount = size_t(std::clamp<ptrdiff_t>(CausalOffset + ptrdiff_t(q0 + Rows), 0, ptrdiff_t(T)));
+    }
+
+    //
+    // Carve the working buffers from the thread local buffer.
+    //
+
+    const size_t ScoresSize = UpAlignSize(MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q * MLAS_FLASH_ATTENTION_BLOCK_SIZE_KV * sizeof(float));
+    const size_t AccumulatorSize = UpAlignSize(MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q * Hv * sizeof(float));
+    const size_t RowSize = UpAlignSize(MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q * sizeof(float));
+    const size_t KeyBufferSize = E::NeedsBuffer ? UpAlignSize(MLAS_FLASH_ATTENTION_BLOCK_SIZE_KV * H * sizeof(float)) : 0;
+    const size_t ValueBufferSize = E::NeedsBuffer ? UpAlignSize(MLAS_FLASH_ATTENTION_BLOCK_SIZE_KV * Hv * sizeof(float)) : 0;
+
+    MlasThreadedBufAlloc(ScoresSize + AccumulatorSize + 2 * RowSize + KeyBufferSize + ValueBufferSize);
+
+    uint8_t* p = ThreadedBufHolder.get();
+    float* Scores = reinterpret_cast<float*>(p);
+    p += ScoresSize;
+    float* Accumulator = reinterpret_cast<float*>(p);
+    p += AccumulatorSize;
+    float* RowMaximum = reinterpret_cast<float*>(p);
+    p += RowSize;
+    float* RowSum = reinterpret_cast<float*>(p);
+    p += RowSize;
+    float* KeyBuffer = reinterpret_cast<float*>(p);
+    p += KeyBufferSize;
+    float* ValueBuffer = reinterpret_cast<float*>(p);
+
+    std::fill_n(Accumulator, Rows * Hv, 0.0f);
+    std::fill_n(RowMaximum, Rows, -std::numeric_limits<float>::infinity());
+    std::fill_n(RowSum, Rows, 0.0f);
+
+    for (size_t k0 = 0; k0 < KeyCount; k0 += MLAS_FLASH_ATTENTION_BLOCK_SIZE_KV) {
+
+        const size_t Columns = std::min(KeyCount - k0, MLAS_FLASH_ATTENTION_BLOCK_SIZE_KV);
+
+        const float* KeyBlock = E::Load(Key + k0 * H, KeyBuffer, Columns * H);
+
+        MlasGemm(CblasNoTrans, CblasTrans, Rows, Columns, H, Params.Scale, Query, H,
+            KeyBlock, H, 0.0f, Scores, Columns, nullptr);
+
+        for (size_t r = 0; r < Rows; r++) {
+
+            float* s = Scores + r * Columns;
+
+            size_t Valid = Columns;
+
+            if (Params.Causal) {
+                const ptrdiff_t Limit = CausalOffset + ptrdiff_t(q0 + r) + 1 - ptrdiff_t(k0);
+                Valid = size_t(std::clamp<ptrdiff_t>(Limit, 0, ptrdiff_t(Columns)));
+            }
+
+            if (Valid == 0) {
+                std::fill_n(s, Columns, 0.0f);
+                continue;
+            }
+
+            if (KeyMask != nullptr) {
+                for (size_t c = 0; c < Valid; c++) {
+                    s[c] += KeyMask[k0 + c];
+                }
+            }
+
+            //
+            // Exponentiate the scores relative to the new maximum and rescale
+            // the sum and the accumulator of the previous blocks.
+            //
+
+#if defined(MLAS_TARGET_AMD64)
+            const float BlockMaximum = GetMlasPlatform().ReduceMaximumF32Kernel(s, Valid);
+#else
+            const float BlockMaximum = MlasReduceMaximumF32Kernel(s, Valid);
+#endif
+            const float Maximum = std::max(RowMaximum[r], BlockMaximum);
+            const float NegativeMaximum = -Maximum;
+
+#if defined(MLAS_TARGET_AMD64)
+            const float BlockSum = GetMlasPlatform().ComputeSumExpF32Kernel(s, s, Valid, &NegativeMaximum);
+#else
+            const float BlockSum = MlasComputeSumExpF32Kernel(s, s, Valid, &NegativeMaximum);
+#endif
+            std::fill(s + Valid, s + Columns, 0.0f);
+
+            if (Maximum != RowMaximum[r]) {
+                const float Correction = std::exp(RowMaximum[r] - Maximum);
+                float* a = Accumulator + r * Hv;
+                for (size_t i = 0; i < Hv; i++) {
+                    a[i] *= Correction;
+                }
+                RowSum[r] *= Correction;
+                RowMaximum[r] = Maximum;
+            }
+
+            RowSum[r] += BlockSum;
+        }
+
+        const float* ValueBlock = E::Load(Value + k0 * Hv, ValueBuffer, Columns * Hv);
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, Rows, Hv, Columns, 1.0f, Scores, Columns,
+            ValueBlock, Hv, 1.0f, Accumulator, Hv, nullptr);
+    }
+
+    //
+    // Normalize the accumulator into the B x S x N x Hv output. A query
+    // without any visible key produces zeros.
+    //
+
+    for (size_t r = 0; r < Rows; r++) {
+
+        const float* a = Accumulator + r * Hv;
+        float* Output = Params.Output + ((b * S + q0 + r) * N + n) * Hv;
+        const float InverseSum = (RowSum[r] > 0.0f) ? 1.0f / RowSum[r] : 0.0f;
+
+        for (size_t i = 0; i < Hv; i++) {
+            Output[i] = a[i] * InverseSum;
+        }
+    }
+}
+
+template<typename T>
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS<T>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const size_t WorkCount = Params.BatchSize * Params.NumHeads *
+        MlasDivRoundup(Params.SequenceLength, MLAS_FLASH_ATTENTION_BLOCK_SIZE_Q);
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(WorkCount), [&](ptrdiff_t WorkIndex) {
+        MlasFlashAttentionBlock(Params, size_t(WorkIndex));
+    });
+}
+
+template
+void
+MLASCALL
+MlasFlashAttention<float>(
+    const MLAS_FLASH_ATTENTION_PARAMS<float>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasFlashAttention<MLAS_FP16>(
+    const MLAS_FLASH_ATTENTION_PARAMS<MLAS_FP16>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasFlashAttention<MLAS_BF16>(
+    const MLAS_FLASH_ATTENTION_PARAMS<MLAS_BF16>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -27,6 +27,16 @@ MlasFp16AccelerationSupported()
 {
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
     return MLAS_CPUIDINFO::GetCPUIDInfo().HasFp16VectorAcceleration();
+#else
+    return GetMlasPlatform().HalfGemmDispatch != &MlasHalfGemmDispatchDefault;
+#endif
+}
+
+bool MLASCALL
+MlasHalfGemmAccumulatesInFloat()
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().HalfGemmDispatch == &MlasHalfGemmDispatchAvx2;
 #else
     return false;
 #endif
@@ -497,8 +497,6 @@ struct MLAS_HALFGEMM_DISPATCH {
     size_t BufOverRead;
 };
 
-extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault;
-
 #if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
 extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchNeon;
 #endif
@@ -510,6 +508,6 @@ MlasHalfGemmGetDispatch()
 #if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
     return &MlasHalfGemmDispatchNeon;
 #else
-    return &MlasHalfGemmDispatchDefault;
+    return GetMlasPlatform().HalfGemmDispatch;
 #endif
 }
@@ -0,0 +1,283 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for processors with
+    AVX2, FMA3 and F16C.
+
+    The fp16 values of A, B and bias are converted to fp32 as they are loaded
+    and the products are accumulated in fp32, so the result is rounded to
+    fp16 once per K stride instead of once per multiply-add.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#include <cstring>
+
+struct MLAS_HALF_GEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+MLAS_FORCEINLINE
+__m256
+MlasLoadHalf8Avx2(
+    const _mlas_fp16_* Source
+    )
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Source)));
+}
+
+MLAS_FORCEINLINE
+__m256
+MlasLoadPartialHalf8Avx2(
+    const _mlas_fp16_* Source,
+    size_t Count
+    )
+{
+    _mlas_fp16_ Buffer[8] = {};
+    std::memcpy(Buffer, Source, Count * sizeof(_mlas_fp16_));
+    return MlasLoadHalf8Avx2(Buffer);
+}
+
+MLAS_FORCEINLINE
+void
+MlasStorePartialHalf8Avx2(
+    _mlas_fp16_* Destination,
+    __m256 Vector,
+    size_t Count
+    )
+{
+    const __m128i Half8 = _mm256_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT);
+
+    if (Count == 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Half8);
+    } else {
+        _mlas_fp16_ Buffer[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Buffer), Half8);
+        std::memcpy(Destination, Buffer, Count * sizeof(_mlas_fp16_));
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+static
+void
+MlasCvtFloat2Half2DAvx2(
+    _mlas_fp16_* Destination,
+    const float* Source,
+    size_t ld,
+    size_t CountRow,
+    size_t CountCol
+    )
+{
+    while (CountRow-- > 0) {
+
+        size_t c = 0;
+
+        for (; c + 8 <= CountCol; c += 8) {
+            const __m128i Half8 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + c), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + c), Half8);
+        }
+
+        for (; c < CountCol; c++) {
+            Destination[c] = MLAS_Float2Half(Source[c]);
+        }
+
+        Source += ld;
+        Destination += CountCol;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    MlasCvtFloat2Half2DAvx2(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    MlasCvtFloat2Half2DAvx2(D, B, ldb, CountK, CountN);
+}
+
+/**
+ * @brief Compute RowCount rows and 16 columns of C
+ *
+ * @tparam RowCount  Number of rows of A and C, 1 to 6
+ * @tparam Partial   Whether fewer than 16 columns remain, in which case B,
+ *                   bias and C are accessed through bounce buffers
+ */
+template<size_t RowCount, bool Partial>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx2Block(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    const size_t Count0 = Partial ? std::min(CountN, size_t(8)) : 8;
+    const size_t Count1 = Partial ? CountN - Count0 : 8;
+
+    const auto LoadB = [&](const _mlas_fp16_* b, size_t Offset, size_t Count) {
+        if (!Partial) {
+            return MlasLoadHalf8Avx2(b + Offset);
+        }
+        return Count == 0 ? _mm256_setzero_ps() : MlasLoadPartialHalf8Avx2(b + Offset, Count);
+    };
+
+    __m256 Accumulators[RowCount][2];
+
+    const __m256 Bias0 = (Bias == nullptr) ? _mm256_setzero_ps() : LoadB(Bias, 0, Count0);
+    const __m256 Bias1 = (Bias == nullptr) ? _mm256_setzero_ps() : LoadB(Bias, 8, Count1);
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = Bias0;
+        Accumulators[r][1] = Bias1;
+        if (!ZeroMode) {
+            Accumulators[r][0] = _mm256_add_ps(Accumulators[r][0], LoadB(C + r * ldc, 0, Count0));
+            Accumulators[r][1] = _mm256_add_ps(Accumulators[r][1], LoadB(C + r * ldc, 8, Count1));
+        }
+    }
+
+    const _mlas_fp16_* b = B;
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        const __m256 BElements0 = LoadB(b, 0, Count0);
+        const __m256 BElements1 = LoadB(b, 8, Count1);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m256 ABroadcast = _mm256_cvtph_ps(_mm_set1_epi16(short(A[r * lda + k])));
+            Accumulators[r][0] = _mm256_fmadd_ps(ABroadcast, BElements0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(ABroadcast, BElements1, Accumulators[r][1]);
+        }
+
+        b += ldb;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        MlasStorePartialHalf8Avx2(C + r * ldc, Accumulators[r][0], Count0);
+        if (Count1 > 0) {
+            MlasStorePartialHalf8Avx2(C + r * ldc + 8, Accumulators[r][1], Count1);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasHalfGemmKernelAvx2Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN >= 16) {
+        MlasHalfGemmKernelAvx2Block<RowCount, false>(16, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+        C += 16;
+        B += 16;
+        if (Bias != nullptr) {
+            Bias += 16;
+        }
+        CountN -= 16;
+    }
+
+    if (CountN > 0) {
+        MlasHalfGemmKernelAvx2Block<RowCount, true>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM)) {
+        case 6:
+            MlasHalfGemmKernelAvx2Rows<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmKernelAvx2Rows<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmKernelAvx2Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx2Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx2Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 1:
+            MlasHalfGemmKernelAvx2Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    MLAS_HALF_GEMM_KERNEL_AVX2::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
@@ -0,0 +1,230 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for processors with
+    AVX512-FP16.
+
+    Like the ARM64 kernel, the products are accumulated in fp16 with the
+    native VFMADD231PH instruction.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512FP16 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+static
+void
+MlasCvtFloat2Half2DAvx512(
+    _mlas_fp16_* Destination,
+    const float* Source,
+    size_t ld,
+    size_t CountRow,
+    size_t CountCol
+    )
+{
+    while (CountRow-- > 0) {
+
+        size_t c = 0;
+
+        for (; c + 16 <= CountCol; c += 16) {
+            const __m256i Half16 = _mm512_cvtps_ph(_mm512_loadu_ps(Source + c), _MM_FROUND_TO_NEAREST_INT);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(Destination + c), Half16);
+        }
+
+        if (c < CountCol) {
+            const __mmask16 Mask = __mmask16((1u << (CountCol - c)) - 1);
+            const __m256i Half16 = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(Mask, Source + c), _MM_FROUND_TO_NEAREST_INT);
+            _mm256_mask_storeu_epi16(Destination + c, Mask, Half16);
+        }
+
+        Source += ld;
+        Destination += CountCol;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    MlasCvtFloat2Half2DAvx512(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    MlasCvtFloat2Half2DAvx512(D, B, ldb, CountK, CountN);
+}
+
+/**
+ * @brief Compute RowCount rows and up to 64 columns of C
+ *
+ * @tparam RowCount  Number of rows of A and C, 1 to 6
+ */
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx512Fp16Block(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    __mmask32 Masks[2];
+    Masks[0] = (CountN >= 32) ? __mmask32(~0u) : __mmask32((1u << CountN) - 1);
+    Masks[1] = (CountN >= 64) ? __mmask32(~0u) :
+               (CountN <= 32) ? __mmask32(0) : __mmask32((1u << (CountN - 32)) - 1);
+
+    __m512h Accumulators[RowCount][2];
+
+    for (size_t i = 0; i < 2; i++) {
+        const __m512h BiasElements = (Bias == nullptr) ? _mm512_setzero_ph() :
+            _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Masks[i], Bias + i * 32));
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][i] = BiasElements;
+            if (!ZeroMode) {
+                const __m512h CElements = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Masks[i], C + r * ldc + i * 32));
+                Accumulators[r][i] = _mm512_add_ph(Accumulators[r][i], CElements);
+            }
+        }
+    }
+
+    const _mlas_fp16_* b = B;
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        const __m512h BElements0 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Masks[0], b));
+        const __m512h BElements1 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Masks[1], b + 32));
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512h ABroadcast = _mm512_castsi512_ph(_mm512_set1_epi16(short(A[r * lda + k])));
+            Accumulators[r][0] = _mm512_fmadd_ph(ABroadcast, BElements0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm512_fmadd_ph(ABroadcast, BElements1, Accumulators[r][1]);
+        }
+
+        b += ldb;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        _mm512_mask_storeu_epi16(C + r * ldc, Masks[0], _mm512_castph_si512(Accumulators[r][0]));
+        _mm512_mask_storeu_epi16(C + r * ldc + 32, Masks[1], _mm512_castph_si512(Accumulators[r][1]));
+    }
+}
+
+template<size_t RowCount>
+void
+MlasHalfGemmKernelAvx512Fp16Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN > 0) {
+        const size_t CountNBlock = std::min(CountN, size_t(64));
+        MlasHalfGemmKernelAvx512Fp16Block<RowCount>(CountNBlock, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+        C += CountNBlock;
+        B += CountNBlock;
+        if (Bias != nullptr) {
+            Bias += CountNBlock;
+        }
+        CountN -= CountNBlock;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM)) {
+        case 6:
+            MlasHalfGemmKernelAvx512Fp16Rows<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmKernelAvx512Fp16Rows<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmKernelAvx512Fp16Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx512Fp16Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx512Fp16Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 1:
+            MlasHalfGemmKernelAvx512Fp16Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM,
+    0
+};
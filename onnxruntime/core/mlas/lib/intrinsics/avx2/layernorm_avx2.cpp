@@ -0,0 +1,46 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels with AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "../../layernorm.h"
+
+struct MLAS_LAYER_NORM_VECTOR_AVX2 {
+    using Vector = __m256;
+    static constexpr size_t Width = 8;
+
+    static MLAS_FORCEINLINE Vector Load(const float* p) { return _mm256_loadu_ps(p); }
+    static MLAS_FORCEINLINE void Store(float* p, Vector v) { _mm256_storeu_ps(p, v); }
+    static MLAS_FORCEINLINE Vector Zero() { return _mm256_setzero_ps(); }
+    static MLAS_FORCEINLINE Vector Broadcast(float f) { return _mm256_set1_ps(f); }
+    static MLAS_FORCEINLINE Vector Add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Subtract(Vector a, Vector b) { return _mm256_sub_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Multiply(Vector a, Vector b) { return _mm256_mul_ps(a, b); }
+    static MLAS_FORCEINLINE Vector MultiplyAdd(Vector a, Vector b, Vector c) { return _mm256_fmadd_ps(a, b, c); }
+
+    static MLAS_FORCEINLINE float ReduceAdd(Vector v)
+    {
+        __m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_add_ss(x, _mm_movehdup_ps(x));
+        return _mm_cvtss_f32(x);
+    }
+};
+
+const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx2 = {
+    MlasLayerNormAddKernel<MLAS_LAYER_NORM_VECTOR_AVX2>,
+    MlasLayerNormAccumulateKernel<MLAS_LAYER_NORM_VECTOR_AVX2>,
+    MlasLayerNormOutputKernel<MLAS_LAYER_NORM_VECTOR_AVX2>,
+};
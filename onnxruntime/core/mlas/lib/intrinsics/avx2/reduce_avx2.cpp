@@ -0,0 +1,82 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_avx2.cpp
+
+Abstract:
+
+    This module implements the row and column reduction kernels with AVX2
+    instructions.
+
+--*/
+
+#include "../../reduce.h"
+
+struct MLAS_REDUCE_VECTOR_AVX2 {
+    using Vector = __m256;
+    static constexpr size_t Width = 8;
+
+    static MLAS_FORCEINLINE Vector Load(const float* p) { return _mm256_loadu_ps(p); }
+    static MLAS_FORCEINLINE void Store(float* p, Vector v) { _mm256_storeu_ps(p, v); }
+    static MLAS_FORCEINLINE Vector Zero() { return _mm256_setzero_ps(); }
+    static MLAS_FORCEINLINE Vector Add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Maximum(Vector a, Vector b) { return _mm256_max_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Minimum(Vector a, Vector b) { return _mm256_min_ps(a, b); }
+
+    static MLAS_FORCEINLINE float ReduceAdd(Vector v)
+    {
+        __m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_add_ss(x, _mm_movehdup_ps(x));
+        return _mm_cvtss_f32(x);
+    }
+
+    static MLAS_FORCEINLINE float ReduceMaximum(Vector v)
+    {
+        __m128 x = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_max_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_max_ss(x, _mm_movehdup_ps(x));
+        return _mm_cvtss_f32(x);
+    }
+
+    static MLAS_FORCEINLINE float ReduceMinimum(Vector v)
+    {
+        __m128 x = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_min_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_min_ss(x, _mm_movehdup_ps(x));
+        return _mm_cvtss_f32(x);
+    }
+};
+
+void
+MLASCALL
+MlasReduceRowsF32KernelAvx2(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    MLAS_REDUCE_KERNEL<MLAS_REDUCE_VECTOR_AVX2>::Rows(Kind, Input, Output, CountM, CountN, ldInput);
+}
+
+void
+MLASCALL
+MlasReduceColumnsF32KernelAvx2(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    MLAS_REDUCE_KERNEL<MLAS_REDUCE_VECTOR_AVX2>::Columns(Kind, Input, Output, CountM, CountN, ldInput);
+}
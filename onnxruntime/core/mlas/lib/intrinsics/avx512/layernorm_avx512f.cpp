@@ -0,0 +1,49 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels with AVX512F
+    instructions.
+
+--*/
+
+#include "../../layernorm.h"
+
+struct MLAS_LAYER_NORM_VECTOR_AVX512F {
+    using Vector = __m512;
+    static constexpr size_t Width = 16;
+
+    static MLAS_FORCEINLINE Vector Load(const float* p) { return _mm512_loadu_ps(p); }
+    static MLAS_FORCEINLINE void Store(float* p, Vector v) { _mm512_storeu_ps(p, v); }
+    static MLAS_FORCEINLINE Vector Zero() { return _mm512_setzero_ps(); }
+    static MLAS_FORCEINLINE Vector Broadcast(float f) { return _mm512_set1_ps(f); }
+    static MLAS_FORCEINLINE Vector Add(Vector a, Vector b) { return _mm512_add_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Subtract(Vector a, Vector b) { return _mm512_sub_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Multiply(Vector a, Vector b) { return _mm512_mul_ps(a, b); }
+    static MLAS_FORCEINLINE Vector MultiplyAdd(Vector a, Vector b, Vector c) { return _mm512_fmadd_ps(a, b, c); }
+
+    // The unmasked shuffles, including those of _mm512_reduce_add_ps, pass an undefined source to the builtins that
+    // trips -Werror=uninitialized in the GCC 12 headers, so the zero masked forms are used with a full mask.
+    static MLAS_FORCEINLINE float ReduceAdd(Vector v)
+    {
+        v = _mm512_add_ps(v, _mm512_maskz_shuffle_f32x4(0xFFFF, v, v, 0x4E));
+        v = _mm512_add_ps(v, _mm512_maskz_shuffle_f32x4(0xFFFF, v, v, 0xB1));
+        v = _mm512_add_ps(v, _mm512_maskz_permute_ps(0xFFFF, v, 0x4E));
+        v = _mm512_add_ps(v, _mm512_maskz_permute_ps(0xFFFF, v, 0xB1));
+        return _mm512_cvtss_f32(v);
+    }
+};
+
+const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx512F = {
+    MlasLayerNormAddKernel<MLAS_LAYER_NORM_VECTOR_AVX512F>,
+    MlasLayerNormAccumulateKernel<MLAS_LAYER_NORM_VECTOR_AVX512F>,
+    MlasLayerNormOutputKernel<MLAS_LAYER_NORM_VECTOR_AVX512F>,
+};
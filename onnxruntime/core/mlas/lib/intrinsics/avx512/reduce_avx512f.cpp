@@ -0,0 +1,61 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_avx512f.cpp
+
+Abstract:
+
+    This module implements the row and column reduction kernels with AVX512F
+    instructions.
+
+--*/
+
+#include "../../reduce.h"
+
+struct MLAS_REDUCE_VECTOR_AVX512F {
+    using Vector = __m512;
+    static constexpr size_t Width = 16;
+
+    static MLAS_FORCEINLINE Vector Load(const float* p) { return _mm512_loadu_ps(p); }
+    static MLAS_FORCEINLINE void Store(float* p, Vector v) { _mm512_storeu_ps(p, v); }
+    static MLAS_FORCEINLINE Vector Zero() { return _mm512_setzero_ps(); }
+    static MLAS_FORCEINLINE Vector Add(Vector a, Vector b) { return _mm512_add_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Maximum(Vector a, Vector b) { return _mm512_max_ps(a, b); }
+    static MLAS_FORCEINLINE Vector Minimum(Vector a, Vector b) { return _mm512_min_ps(a, b); }
+    static MLAS_FORCEINLINE float ReduceAdd(Vector v) { return _mm512_reduce_add_ps(v); }
+    static MLAS_FORCEINLINE float ReduceMaximum(Vector v) { return _mm512_reduce_max_ps(v); }
+    static MLAS_FORCEINLINE float ReduceMinimum(Vector v) { return _mm512_reduce_min_ps(v); }
+};
+
+void
+MLASCALL
+MlasReduceRowsF32KernelAvx512F(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    MLAS_REDUCE_KERNEL<MLAS_REDUCE_VECTOR_AVX512F>::Rows(Kind, Input, Output, CountM, CountN, ldInput);
+}
+
+void
+MLASCALL
+MlasReduceColumnsF32KernelAvx512F(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    MLAS_REDUCE_KERNEL<MLAS_REDUCE_VECTOR_AVX512F>::Columns(Kind, Input, Output, CountM, CountN, ldInput);
+}
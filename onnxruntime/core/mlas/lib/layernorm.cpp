@@ -0,0 +1,259 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements the layer normalization routine, with the fused
+    skip connection of SkipLayerNormalization and the RMS variant of
+    SimplifiedLayerNormalization.
+
+    The row is read twice: once to accumulate the statistics and once to
+    write the output. fp16 and bfloat16 rows are converted to fp32 in chunks
+    that stay in the L1 cache between the conversion and the kernel.
+
+--*/
+
+#include "layernorm.h"
+
+#include <cmath>
+#include <cstring>
+
+struct MLAS_LAYER_NORM_VECTOR_FLOAT32X4 {
+    using Vector = MLAS_FLOAT32X4;
+    static constexpr size_t Width = 4;
+
+    static MLAS_FORCEINLINE Vector Load(const float* p) { return MlasLoadFloat32x4(p); }
+    static MLAS_FORCEINLINE void Store(float* p, Vector v) { MlasStoreFloat32x4(p, v); }
+    static MLAS_FORCEINLINE Vector Zero() { return MlasZeroFloat32x4(); }
+    static MLAS_FORCEINLINE Vector Broadcast(float f) { return MlasBroadcastFloat32x4(f); }
+    static MLAS_FORCEINLINE Vector Add(Vector a, Vector b) { return MlasAddFloat32x4(a, b); }
+    static MLAS_FORCEINLINE Vector Subtract(Vector a, Vector b) { return MlasSubtractFloat32x4(a, b); }
+    static MLAS_FORCEINLINE Vector Multiply(Vector a, Vector b) { return MlasMultiplyFloat32x4(a, b); }
+    static MLAS_FORCEINLINE Vector MultiplyAdd(Vector a, Vector b, Vector c) { return MlasMultiplyAddFloat32x4(a, b, c); }
+    static MLAS_FORCEINLINE float ReduceAdd(Vector v) { return MlasReduceAddFloat32x4(v); }
+};
+
+const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchDefault = {
+    MlasLayerNormAddKernel<MLAS_LAYER_NORM_VECTOR_FLOAT32X4>,
+    MlasLayerNormAccumulateKernel<MLAS_LAYER_NORM_VECTOR_FLOAT32X4>,
+    MlasLayerNormOutputKernel<MLAS_LAYER_NORM_VECTOR_FLOAT32X4>,
+};
+
+//
+// Number of elements converted to fp32 at a time.
+//
+
+constexpr size_t MLAS_LAYER_NORM_CHUNK = 256;
+
+//
+// Element types of the rows. Load returns a chunk of the row as fp32 and
+// OutputBuffer returns where the kernel writes a chunk before Store. fp32
+// rows are used in place. fp16 and bfloat16 rows are accessed as their bits
+// so that this module does not depend on the complete MLAS_FP16 and MLAS_BF16
+// types.
+//
+
+struct MLAS_LAYER_NORM_ELEMENT_FP32 {
+    using Storage = float;
+
+    static MLAS_FORCEINLINE const float* Load(const float* Source, float*, size_t) { return Source; }
+    static MLAS_FORCEINLINE float* OutputBuffer(float* Destination, float*) { return Destination; }
+
+    static MLAS_FORCEINLINE void Store(const float* Source, float* Destination, size_t N)
+    {
+        if (Source != Destination) {
+            std::memcpy(Destination, Source, N * sizeof(float));
+        }
+    }
+};
+
+struct MLAS_LAYER_NORM_ELEMENT_FP16 {
+    using Storage = unsigned short;
+
+    static MLAS_FORCEINLINE const float* Load(const unsigned short* Source, float* Buffer, size_t N)
+    {
+        MlasConvertHalfToFloatBuffer(Source, Buffer, N);
+        return Buffer;
+    }
+
+    static MLAS_FORCEINLINE float* OutputBuffer(unsigned short*, float* Buffer) { return Buffer; }
+
+    static MLAS_FORCEINLINE void Store(const float* Source, unsigned short* Destination, size_t N)
+    {
+        MlasConvertFloatToHalfBuffer(Source, Destination, N);
+    }
+};
+
+struct MLAS_LAYER_NORM_ELEMENT_BF16 {
+    using Storage = unsigned short;
+
+    static MLAS_FORCEINLINE const float* Load(const unsigned short* Source, float* Buffer, size_t N)
+    {
+        MlasConvertBFloat16ToFloatBuffer(Source, Buffer, N);
+        return Buffer;
+    }
+
+    static MLAS_FORCEINLINE float* OutputBuffer(unsigned short*, float* Buffer) { return Buffer; }
+
+    static MLAS_FORCEINLINE void Store(const float* Source, unsigned short* Destination, size_t N)
+    {
+        MlasConvertFloatToBFloat16Buffer(Source, Destination, N);
+    }
+};
+
+template<typename T>
+struct MLAS_LAYER_NORM_ELEMENT;
+
+template<>
+struct MLAS_LAYER_NORM_ELEMENT<float> : MLAS_LAYER_NORM_ELEMENT_FP32 {};
+
+template<>
+struct MLAS_LAYER_NORM_ELEMENT<MLAS_FP16> : MLAS_LAYER_NORM_ELEMENT_FP16 {};
+
+template<>
+struct MLAS_LAYER_NORM_ELEMENT<MLAS_BF16> : MLAS_LAYER_NORM_ELEMENT_BF16 {};
+
+/**
+ * @brief Load a chunk of Input + Skip + SkipBias as fp32
+ */
+template<typename E>
+MLAS_FORCEINLINE
+const float*
+MlasLayerNormLoadInput(
+    const MLAS_LAYER_NORM_DISPATCH* Dispatch,
+    const typename E::Storage* Input,
+    const typename E::Storage* Skip,
+    const float* SkipBias,
+    size_t Count,
+    float* InputBuffer,
+    float* SkipBuffer
+    )
+{
+    const float* InputFloat = E::Load(Input, InputBuffer, Count);
+
+    if (Skip == nullptr && SkipBias == nullptr) {
+        return InputFloat;
+    }
+
+    const float* SkipFloat = (Skip != nullptr) ? E::Load(Skip, SkipBuffer, Count) : nullptr;
+
+    Dispatch->Add(InputFloat, SkipFloat, SkipBias, InputBuffer, Count);
+
+    return InputBuffer;
+}
+
+template<typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    size_t N
+    )
+{
+    using E = MLAS_LAYER_NORM_ELEMENT<T>;
+    using Storage = typename E::Storage;
+
+    const MLAS_LAYER_NORM_DISPATCH* Dispatch = GetMlasPlatform().LayerNormDispatch;
+
+    const Storage* Input = reinterpret_cast<const Storage*>(Params.Input);
+    const Storage* Skip = reinterpret_cast<const Storage*>(Params.Skip);
+    Storage* Output = reinterpret_cast<Storage*>(Params.Output);
+    Storage* SkipOutput = reinterpret_cast<Storage*>(Params.SkipOutput);
+
+    MLAS_DECLSPEC_ALIGN(float InputBuffer[MLAS_LAYER_NORM_CHUNK], 64);
+    MLAS_DECLSPEC_ALIGN(float SkipBuffer[MLAS_LAYER_NORM_CHUNK], 64);
+
+    //
+    // Accumulate the statistics relative to the first element, which keeps
+    // the sum of squares small when the values share a large offset. The RMS
+    // variant needs the raw sum of squares.
+    //
+
+    float Shift = 0.0f;
+    float Sum = 0.0f;
+    float SumSquares = 0.0f;
+
+    for (size_t n = 0; n < N; n += MLAS_LAYER_NORM_CHUNK) {
+
+        const size_t Count = std::min(N - n, MLAS_LAYER_NORM_CHUNK);
+        const float* x = MlasLayerNormLoadInput<E>(Dispatch, Input + n, (Skip != nullptr) ? Skip + n : nullptr,
+            (Params.SkipBias != nullptr) ? Params.SkipBias + n : nullptr, Count, InputBuffer, SkipBuffer);
+
+        if (n == 0 && !Params.Simplified) {
+            Shift = x[0];
+        }
+
+        Dispatch->Accumulate(x, Count, Shift, &Sum, &SumSquares);
+
+        if (SkipOutput != nullptr) {
+            E::Store(x, SkipOutput + n, Count);
+        }
+    }
+
+    float Mean;
+    float Variance;
+
+    if (Params.Simplified) {
+        Mean = 0.0f;
+        Variance = SumSquares / N;
+    } else {
+        const float ShiftedMean = Sum / N;
+        Mean = Shift + ShiftedMean;
+        Variance = std::max(SumSquares / N - ShiftedMean * ShiftedMean, 0.0f);
+    }
+
+    const float InvStdDev = 1.0f / std::sqrt(Variance + Params.Epsilon);
+
+    if (Params.Mean != nullptr) {
+        *Params.Mean = Mean;
+    }
+
+    if (Params.InvStdDev != nullptr) {
+        *Params.InvStdDev = InvStdDev;
+    }
+
+    const float* Bias = Params.Simplified ? nullptr : Params.Bias;
+
+    for (size_t n = 0; n < N; n += MLAS_LAYER_NORM_CHUNK) {
+
+        const size_t Count = std::min(N - n, MLAS_LAYER_NORM_CHUNK);
+        const float* x = MlasLayerNormLoadInput<E>(Dispatch, Input + n, (Skip != nullptr) ? Skip + n : nullptr,
+            (Params.SkipBias != nullptr) ? Params.SkipBias + n : nullptr, Count, InputBuffer, SkipBuffer);
+        float* y = E::OutputBuffer(Output + n, SkipBuffer);
+
+        Dispatch->Output(x, Params.Scale + n, (Bias != nullptr) ? Bias + n : nullptr, y, Count, Mean, InvStdDev);
+
+        E::Store(y, Output + n, Count);
+    }
+}
+
+template
+void
+MLASCALL
+MlasLayerNormalization<float>(
+    const MLAS_LAYER_NORM_PARAMS<float>& Params,
+    size_t N
+    );
+
+template
+void
+MLASCALL
+MlasLayerNormalization<MLAS_FP16>(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_FP16>& Params,
+    size_t N
+    );
+
+template
+void
+MLASCALL
+MlasLayerNormalization<MLAS_BF16>(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_BF16>& Params,
+    size_t N
+    );
@@ -0,0 +1,206 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.h
+
+Abstract:
+
+    This module defines the kernels used by the layer normalization routine
+    and the dispatch structure that selects them for the current processor.
+
+    The kernels operate on fp32 vectors. The routine converts fp16 and
+    bfloat16 rows to fp32 in short chunks before calling them.
+
+    A vector type should define the following members:
+        Vector;                  The SIMD register type
+        size_t Width;            Number of floats in a Vector
+        Load/Store/Zero/Broadcast;
+                                 Memory access and initialization
+        Add/Subtract/Multiply/MultiplyAdd;
+                                 Element-wise operations
+        ReduceAdd;               Horizontal sum returning a float
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+#include <algorithm>
+
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_ADD_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N
+    );
+
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_ACCUMULATE_KERNEL)(
+    const float* Input,
+    size_t N,
+    float Shift,
+    float* Sum,
+    float* SumSquares
+    );
+
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_OUTPUT_KERNEL)(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev
+    );
+
+struct MLAS_LAYER_NORM_DISPATCH {
+    MLAS_LAYER_NORM_ADD_KERNEL* Add;                /**< Output = Input + Skip + Bias, Skip or Bias may be null */
+    MLAS_LAYER_NORM_ACCUMULATE_KERNEL* Accumulate;  /**< Sum += sum(Input - Shift), SumSquares += sum((Input - Shift)^2) */
+    MLAS_LAYER_NORM_OUTPUT_KERNEL* Output;          /**< Output = (Input - Mean) * InvStdDev * Scale + Bias, Bias may be null */
+};
+
+template<typename V>
+void
+MLASCALL
+MlasLayerNormAddKernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N
+    )
+{
+    constexpr size_t W = V::Width;
+    size_t n = 0;
+
+    if (Skip != nullptr && Bias != nullptr) {
+        for (; n + W <= N; n += W) {
+            V::Store(Output + n, V::Add(V::Add(V::Load(Input + n), V::Load(Skip + n)), V::Load(Bias + n)));
+        }
+        for (; n < N; n++) {
+            Output[n] = Input[n] + Skip[n] + Bias[n];
+        }
+        return;
+    }
+
+    const float* Addend = (Skip != nullptr) ? Skip : Bias;
+
+    if (Addend == nullptr) {
+        if (Output != Input) {
+            std::copy_n(Input, N, Output);
+        }
+        return;
+    }
+
+    for (; n + W <= N; n += W) {
+        V::Store(Output + n, V::Add(V::Load(Input + n), V::Load(Addend + n)));
+    }
+    for (; n < N; n++) {
+        Output[n] = Input[n] + Addend[n];
+    }
+}
+
+/**
+ * @brief Accumulate the sum and the sum of squares of the shifted input
+ *
+ * Two sets of accumulators hide the latency of the vector additions.
+ */
+template<typename V>
+void
+MLASCALL
+MlasLayerNormAccumulateKernel(
+    const float* Input,
+    size_t N,
+    float Shift,
+    float* Sum,
+    float* SumSquares
+    )
+{
+    constexpr size_t W = V::Width;
+
+    const typename V::Vector ShiftVector = V::Broadcast(Shift);
+    typename V::Vector Sum0 = V::Zero();
+    typename V::Vector Sum1 = V::Zero();
+    typename V::Vector SumSquares0 = V::Zero();
+    typename V::Vector SumSquares1 = V::Zero();
+
+    size_t n = 0;
+
+    for (; n + 2 * W <= N; n += 2 * W) {
+        typename V::Vector x0 = V::Subtract(V::Load(Input + n), ShiftVector);
+        typename V::Vector x1 = V::Subtract(V::Load(Input + n + W), ShiftVector);
+        Sum0 = V::Add(Sum0, x0);
+        Sum1 = V::Add(Sum1, x1);
+        SumSquares0 = V::MultiplyAdd(x0, x0, SumSquares0);
+        SumSquares1 = V::MultiplyAdd(x1, x1, SumSquares1);
+    }
+
+    for (; n + W <= N; n += W) {
+        typename V::Vector x0 = V::Subtract(V::Load(Input + n), ShiftVector);
+        Sum0 = V::Add(Sum0, x0);
+        SumSquares0 = V::MultiplyAdd(x0, x0, SumSquares0);
+    }
+
+    float s = V::ReduceAdd(V::Add(Sum0, Sum1));
+    float ss = V::ReduceAdd(V::Add(SumSquares0, SumSquares1));
+
+    for (; n < N; n++) {
+        const float x = Input[n] - Shift;
+        s += x;
+        ss += x * x;
+    }
+
+    *Sum += s;
+    *SumSquares += ss;
+}
+
+template<typename V>
+void
+MLASCALL
+MlasLayerNormOutputKernel(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev
+    )
+{
+    constexpr size_t W = V::Width;
+
+    const typename V::Vector MeanVector = V::Broadcast(Mean);
+    const typename V::Vector InvStdDevVector = V::Broadcast(InvStdDev);
+
+    size_t n = 0;
+
+    if (Bias != nullptr) {
+        for (; n + W <= N; n += W) {
+            typename V::Vector x = V::Multiply(V::Subtract(V::Load(Input + n), MeanVector), InvStdDevVector);
+            V::Store(Output + n, V::MultiplyAdd(x, V::Load(Scale + n), V::Load(Bias + n)));
+        }
+        for (; n < N; n++) {
+            Output[n] = (Input[n] - Mean) * InvStdDev * Scale[n] + Bias[n];
+        }
+    } else {
+        for (; n + W <= N; n += W) {
+            typename V::Vector x = V::Multiply(V::Subtract(V::Load(Input + n), MeanVector), InvStdDevVector);
+            V::Store(Output + n, V::Multiply(x, V::Load(Scale + n)));
+        }
+        for (; n < N; n++) {
+            Output[n] = (Input[n] - Mean) * InvStdDev * Scale[n];
+        }
+    }
+}
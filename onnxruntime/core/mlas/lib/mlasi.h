@@ -587,6 +587,33 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_REDUCE_FLOAT_KERNEL)(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F16_TO_F32_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_F16_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -798,6 +825,22 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_REDUCE_FLOAT_KERNEL MlasReduceRowsF32Kernel;
+    MLAS_REDUCE_FLOAT_KERNEL MlasReduceColumnsF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_REDUCE_FLOAT_KERNEL MlasReduceRowsF32KernelAvx2;
+    MLAS_REDUCE_FLOAT_KERNEL MlasReduceColumnsF32KernelAvx2;
+    MLAS_REDUCE_FLOAT_KERNEL MlasReduceRowsF32KernelAvx512F;
+    MLAS_REDUCE_FLOAT_KERNEL MlasReduceColumnsF32KernelAvx512F;
+#endif
+
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32KernelAvx2;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16KernelAvx2;
+#endif
+
 }
 
 //
@@ -844,7 +887,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning = nullptr
     );
 
 //
@@ -885,6 +929,7 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx2;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvxVnni;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Core;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni;
+extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot;
@@ -898,6 +943,23 @@ struct MLAS_FPQ4GEMM_DISPATCH;
 
 extern const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchAvx512;
 
+struct MLAS_BF16_GEMM_DISPATCH;
+
+extern const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16;
+extern const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAmx;
+
+struct MLAS_HALFGEMM_DISPATCH;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+
+struct MLAS_LAYER_NORM_DISPATCH;
+
+extern const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchDefault;
+extern const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx2;
+extern const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx512F;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -1018,6 +1080,10 @@ struct MLAS_PLATFORM {
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     MLAS_QUANTIZE_LINEAR_S16_KERNEL* QuantizeLinearS16Kernel;
     MLAS_QUANTIZE_LINEAR_U16_KERNEL* QuantizeLinearU16Kernel;
+    MLAS_REDUCE_FLOAT_KERNEL* ReduceRowsF32Kernel;
+    MLAS_REDUCE_FLOAT_KERNEL* ReduceColumnsF32Kernel;
+    MLAS_CAST_F16_TO_F32_KERNEL* CastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
@@ -1029,6 +1095,9 @@ struct MLAS_PLATFORM {
 
     const MLAS_FPQ4GEMM_DISPATCH* FpQ4GemmDispatch{nullptr};
     const MLAS_Q8Q4GEMM_DISPATCH* Q8Q4GemmDispatch{nullptr};
+    const MLAS_BF16_GEMM_DISPATCH* Bf16GemmDispatch{nullptr};
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{&MlasHalfGemmDispatchDefault};
+    const MLAS_LAYER_NORM_DISPATCH* LayerNormDispatch{&MlasLayerNormDispatchDefault};
 };
 
 inline
@@ -246,6 +246,10 @@ Return Value:
     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8Kernel;
     this->QuantizeLinearS16Kernel = MlasQuantizeLinearS16Kernel;
     this->QuantizeLinearU16Kernel = MlasQuantizeLinearU16Kernel;
+    this->ReduceRowsF32Kernel = MlasReduceRowsF32Kernel;
+    this->ReduceColumnsF32Kernel = MlasReduceColumnsF32Kernel;
+    this->CastF16ToF32Kernel = MlasCastF16ToF32Kernel;
+    this->CastF32ToF16Kernel = MlasCastF32ToF16Kernel;
 
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
@@ -345,6 +349,9 @@ Return Value:
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->ReduceRowsF32Kernel = MlasReduceRowsF32KernelAvx2;
+                this->ReduceColumnsF32Kernel = MlasReduceColumnsF32KernelAvx2;
+                this->LayerNormDispatch = &MlasLayerNormDispatchAvx2;
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -373,6 +380,17 @@ Return Value:
                     this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvxVnni;
                 }
 
+                //
+                // Check if the processor supports F16C.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+
+                    this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx2;
+                    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelAvx2;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx2;
+                }
+
 #if !defined(ORT_MINIMAL_BUILD)
 
                 //
@@ -395,6 +413,9 @@ Return Value:
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->ReduceRowsF32Kernel = MlasReduceRowsF32KernelAvx512F;
+                    this->ReduceColumnsF32Kernel = MlasReduceColumnsF32KernelAvx512F;
+                    this->LayerNormDispatch = &MlasLayerNormDispatchAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -423,20 +444,44 @@ Return Value:
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                         }
+
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->Bf16GemmDispatch = &MlasBf16GemmDispatchAvx512Bf16;
+                        }
+
+                        //
+                        // Check if the processor supports AVX512_FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0) {
+
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                        }
                     }
                 }
 
 #ifndef __APPLE__
                 //
-                // Check if the processor supports AMX-TILE and AMX-INT8
-                // features.
+                // Check if the processor supports AMX-TILE and the AMX-INT8
+                // or AMX-BF16 features.
                 //
                 if ((Cpuid7[3] & 0b1 << 24) != 0 &&
-                    (Cpuid7[3] & 0b1 << 25) != 0 &&
+                    (Cpuid7[3] & (0b1 << 25 | 0b1 << 22)) != 0 &&
                     (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE) {
                     if (MlasInitAMX()) {
-                        this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
-                        this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                        if ((Cpuid7[3] & 0b1 << 25) != 0) {
+                            this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
+                            this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                            this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAmx;
+                        }
+                        if ((Cpuid7[3] & 0b1 << 22) != 0) {
+                            this->Bf16GemmDispatch = &MlasBf16GemmDispatchAmx;
+                        }
                     }
                 }
 #endif // __APPLE__
@@ -0,0 +1,100 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements the row and column reduction routines.
+
+    The kernels in this module use the portable four element vector type,
+    which maps to SSE2, NEON, VSX or WebAssembly SIMD instructions. Wider
+    kernels are selected at runtime on processors with AVX2 or AVX512F.
+
+--*/
+
+#include "reduce.h"
+
+struct MLAS_REDUCE_VECTOR_FLOAT32X4 {
+    using Vector = MLAS_FLOAT32X4;
+    static constexpr size_t Width = 4;
+
+    static MLAS_FORCEINLINE Vector Load(const float* p) { return MlasLoadFloat32x4(p); }
+    static MLAS_FORCEINLINE void Store(float* p, Vector v) { MlasStoreFloat32x4(p, v); }
+    static MLAS_FORCEINLINE Vector Zero() { return MlasZeroFloat32x4(); }
+    static MLAS_FORCEINLINE Vector Add(Vector a, Vector b) { return MlasAddFloat32x4(a, b); }
+    static MLAS_FORCEINLINE Vector Maximum(Vector a, Vector b) { return MlasMaximumFloat32x4(a, b); }
+    static MLAS_FORCEINLINE Vector Minimum(Vector a, Vector b) { return MlasMinimumFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float ReduceAdd(Vector v) { return MlasReduceAddFloat32x4(v); }
+    static MLAS_FORCEINLINE float ReduceMaximum(Vector v) { return MlasReduceMaximumFloat32x4(v); }
+    static MLAS_FORCEINLINE float ReduceMinimum(Vector v) { return MlasReduceMinimumFloat32x4(v); }
+};
+
+void
+MLASCALL
+MlasReduceRowsF32Kernel(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    MLAS_REDUCE_KERNEL<MLAS_REDUCE_VECTOR_FLOAT32X4>::Rows(Kind, Input, Output, CountM, CountN, ldInput);
+}
+
+void
+MLASCALL
+MlasReduceColumnsF32Kernel(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    MLAS_REDUCE_KERNEL<MLAS_REDUCE_VECTOR_FLOAT32X4>::Columns(Kind, Input, Output, CountM, CountN, ldInput);
+}
+
+void
+MLASCALL
+MlasReduceRows(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().ReduceRowsF32Kernel(Kind, Input, Output, CountM, CountN, ldInput);
+#else
+    MlasReduceRowsF32Kernel(Kind, Input, Output, CountM, CountN, ldInput);
+#endif
+}
+
+void
+MLASCALL
+MlasReduceColumns(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().ReduceColumnsF32Kernel(Kind, Input, Output, CountM, CountN, ldInput);
+#else
+    MlasReduceColumnsF32Kernel(Kind, Input, Output, CountM, CountN, ldInput);
+#endif
+}
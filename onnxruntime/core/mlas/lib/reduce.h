@@ -0,0 +1,275 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.h
+
+Abstract:
+
+    This module defines the set of template functions to implement the row
+    and column reduction kernels.
+
+    A vector type should define the following members:
+        Vector;                  The SIMD register type
+        size_t Width;            Number of floats in a Vector
+        Load/Store/Zero;         Memory access and initialization
+        Add/Maximum/Minimum;     Element-wise operations
+        ReduceAdd/ReduceMaximum/ReduceMinimum;
+                                 Horizontal operations returning a float
+
+    The kernels are instantiated once per vector type, in a translation unit
+    compiled for the matching instruction set.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+#include <algorithm>
+
+//
+// Reduction operators.
+//
+// Fill returns the initial value of the secondary accumulators given the
+// first input vector. Addition needs zero to avoid counting the first vector
+// twice, while maximum and minimum are idempotent.
+//
+
+struct MLAS_REDUCE_OP_SUM {
+    template<typename V>
+    static MLAS_FORCEINLINE typename V::Vector Fill(typename V::Vector) { return V::Zero(); }
+
+    template<typename V>
+    static MLAS_FORCEINLINE typename V::Vector Apply(typename V::Vector a, typename V::Vector b) { return V::Add(a, b); }
+
+    template<typename V>
+    static MLAS_FORCEINLINE float Reduce(typename V::Vector a) { return V::ReduceAdd(a); }
+
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return a + b; }
+};
+
+struct MLAS_REDUCE_OP_MAXIMUM {
+    template<typename V>
+    static MLAS_FORCEINLINE typename V::Vector Fill(typename V::Vector a) { return a; }
+
+    template<typename V>
+    static MLAS_FORCEINLINE typename V::Vector Apply(typename V::Vector a, typename V::Vector b) { return V::Maximum(a, b); }
+
+    template<typename V>
+    static MLAS_FORCEINLINE float Reduce(typename V::Vector a) { return V::ReduceMaximum(a); }
+
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return std::max(a, b); }
+};
+
+struct MLAS_REDUCE_OP_MINIMUM {
+    template<typename V>
+    static MLAS_FORCEINLINE typename V::Vector Fill(typename V::Vector a) { return a; }
+
+    template<typename V>
+    static MLAS_FORCEINLINE typename V::Vector Apply(typename V::Vector a, typename V::Vector b) { return V::Minimum(a, b); }
+
+    template<typename V>
+    static MLAS_FORCEINLINE float Reduce(typename V::Vector a) { return V::ReduceMinimum(a); }
+
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return std::min(a, b); }
+};
+
+/**
+ * @brief Reduce each row of a matrix to a single value
+ *
+ * Four independent accumulators hide the latency of the vector operation.
+ */
+template<typename V, typename Op>
+void
+MlasReduceRowsKernel(
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    constexpr size_t W = V::Width;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        const float* row = Input + m * ldInput;
+        float Value = row[0];
+        size_t n = 1;
+
+        if (CountN >= W) {
+
+            typename V::Vector Acc0 = V::Load(row);
+            typename V::Vector Acc1 = Op::template Fill<V>(Acc0);
+            typename V::Vector Acc2 = Acc1;
+            typename V::Vector Acc3 = Acc1;
+
+            for (n = W; n + 4 * W <= CountN; n += 4 * W) {
+                Acc0 = Op::template Apply<V>(Acc0, V::Load(row + n));
+                Acc1 = Op::template Apply<V>(Acc1, V::Load(row + n + W));
+                Acc2 = Op::template Apply<V>(Acc2, V::Load(row + n + 2 * W));
+                Acc3 = Op::template Apply<V>(Acc3, V::Load(row + n + 3 * W));
+            }
+
+            for (; n + W <= CountN; n += W) {
+                Acc0 = Op::template Apply<V>(Acc0, V::Load(row + n));
+            }
+
+            Acc0 = Op::template Apply<V>(Acc0, Acc1);
+            Acc2 = Op::template Apply<V>(Acc2, Acc3);
+            Value = Op::template Reduce<V>(Op::template Apply<V>(Acc0, Acc2));
+        }
+
+        for (; n < CountN; n++) {
+            Value = Op::Apply(Value, row[n]);
+        }
+
+        Output[m] = Value;
+    }
+}
+
+/**
+ * @brief Reduce each column of a matrix to a single value
+ *
+ * The columns are processed in strips of four vectors that stay in registers
+ * while a block of rows is accumulated, so every input element is loaded
+ * once and the output strip is stored once per block instead of once per
+ * row. The row blocks bound the set of rows walked by a strip so that the
+ * adjacent strip finds them in cache.
+ */
+template<typename V, typename Op>
+void
+MlasReduceColumnsKernel(
+    const float* Input,
+    float* Output,
+    size_t CountM,
+    size_t CountN,
+    size_t ldInput
+    )
+{
+    constexpr size_t W = V::Width;
+    constexpr size_t RowBlock = 256;
+
+    for (size_t m = 0; m < CountM; m += RowBlock) {
+
+        const size_t RowCount = std::min(RowBlock, CountM - m);
+        const float* rows = Input + m * ldInput;
+
+        //
+        // The first block starts from its first row, later blocks from the
+        // partial result in the output.
+        //
+
+        const bool Accumulate = (m != 0);
+        const size_t FirstRow = Accumulate ? 0 : 1;
+
+        size_t n = 0;
+
+        for (; n + 4 * W <= CountN; n += 4 * W) {
+
+            const float* init = Accumulate ? Output + n : rows + n;
+            typename V::Vector Acc0 = V::Load(init);
+            typename V::Vector Acc1 = V::Load(init + W);
+            typename V::Vector Acc2 = V::Load(init + 2 * W);
+            typename V::Vector Acc3 = V::Load(init + 3 * W);
+
+            const float* row = rows + FirstRow * ldInput + n;
+
+            for (size_t r = FirstRow; r < RowCount; r++) {
+                Acc0 = Op::template Apply<V>(Acc0, V::Load(row));
+                Acc1 = Op::template Apply<V>(Acc1, V::Load(row + W));
+                Acc2 = Op::template Apply<V>(Acc2, V::Load(row + 2 * W));
+                Acc3 = Op::template Apply<V>(Acc3, V::Load(row + 3 * W));
+                row += ldInput;
+            }
+
+            V::Store(Output + n, Acc0);
+            V::Store(Output + n + W, Acc1);
+            V::Store(Output + n + 2 * W, Acc2);
+            V::Store(Output + n + 3 * W, Acc3);
+        }
+
+        for (; n + W <= CountN; n += W) {
+
+            typename V::Vector Acc0 = V::Load(Accumulate ? Output + n : rows + n);
+
+            const float* row = rows + FirstRow * ldInput + n;
+
+            for (size_t r = FirstRow; r < RowCount; r++) {
+                Acc0 = Op::template Apply<V>(Acc0, V::Load(row));
+                row += ldInput;
+            }
+
+            V::Store(Output + n, Acc0);
+        }
+
+        for (; n < CountN; n++) {
+
+            float Value = Accumulate ? Output[n] : rows[n];
+
+            const float* row = rows + FirstRow * ldInput + n;
+
+            for (size_t r = FirstRow; r < RowCount; r++) {
+                Value = Op::Apply(Value, *row);
+                row += ldInput;
+            }
+
+            Output[n] = Value;
+        }
+    }
+}
+
+/**
+ * @brief Instantiate the row and column kernels of a vector type for the
+ *        requested reduction kind
+ */
+template<typename V>
+struct MLAS_REDUCE_KERNEL {
+
+    template<typename Op>
+    static void Rows(const float* Input, float* Output, size_t CountM, size_t CountN, size_t ldInput)
+    {
+        MlasReduceRowsKernel<V, Op>(Input, Output, CountM, CountN, ldInput);
+    }
+
+    template<typename Op>
+    static void Columns(const float* Input, float* Output, size_t CountM, size_t CountN, size_t ldInput)
+    {
+        MlasReduceColumnsKernel<V, Op>(Input, Output, CountM, CountN, ldInput);
+    }
+
+    static void Rows(MLAS_REDUCE_KIND Kind, const float* Input, float* Output, size_t CountM, size_t CountN, size_t ldInput)
+    {
+        switch (Kind) {
+            case MlasReduceSum:
+                Rows<MLAS_REDUCE_OP_SUM>(Input, Output, CountM, CountN, ldInput);
+                break;
+            case MlasReduceMaximum:
+                Rows<MLAS_REDUCE_OP_MAXIMUM>(Input, Output, CountM, CountN, ldInput);
+                break;
+            case MlasReduceMinimum:
+                Rows<MLAS_REDUCE_OP_MINIMUM>(Input, Output, CountM, CountN, ldInput);
+                break;
+        }
+    }
+
+    static void Columns(MLAS_REDUCE_KIND Kind, const float* Input, float* Output, size_t CountM, size_t CountN, size_t ldInput)
+    {
+        switch (Kind) {
+            case MlasReduceSum:
+                Columns<MLAS_REDUCE_OP_SUM>(Input, Output, CountM, CountN, ldInput);
+                break;
+            case MlasReduceMaximum:
+                Columns<MLAS_REDUCE_OP_MAXIMUM>(Input, Output, CountM, CountN, ldInput);
+                break;
+            case MlasReduceMinimum:
+                Columns<MLAS_REDUCE_OP_MINIMUM>(Input, Output, CountM, CountN, ldInput);
+                break;
+        }
+    }
+};
@@ -1093,7 +1093,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning
     )
 /*++
 
@@ -1131,6 +1132,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Tuning - Optionally supplies tuned strides for this shape, else nullptr
+        to use the built-in heuristics.
+
 Return Value:
 
     None.
@@ -1219,11 +1223,21 @@ Return Value:
     // for better utilization of the B panel. Avoid changing the K stride if
     // the A panel needs to be used for transposing.
     //
+    // Tuned strides replace the heuristic if they fit the local panels.
+    //
 
     size_t StrideN = MLAS_SGEMM_STRIDEN;
     size_t StrideK = MLAS_SGEMM_STRIDEK;
 
-    if (N >= K) {
+    if (Tuning != nullptr && Tuning->StrideN != 0 && Tuning->StrideK != 0 &&
+        Tuning->StrideN % MLAS_SGEMM_STRIDEN_THREAD_ALIGN == 0 &&
+        Tuning->StrideK <= (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK) / Tuning->StrideN &&
+        (TransA == CblasNoTrans || Tuning->StrideK <= MLAS_SGEMM_STRIDEK)) {
+
+        StrideN = Tuning->StrideN;
+        StrideK = Tuning->StrideK;
+
+    } else if (N >= K) {
 
         while (StrideK / 2 >= K) {
             StrideN *= 2;
@@ -1464,7 +1478,8 @@ MlasSgemmThreaded(
     const size_t K,
 
     const MLAS_SGEMM_DATA_PARAMS* DataParams,
-    ptrdiff_t ThreadId
+    ptrdiff_t ThreadId,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning
     )
 /*++
 
@@ -1489,6 +1504,9 @@ Arguments:
 
     ThreadId - Supplies the current index of the threaded operation.
 
+    Tuning - Optionally supplies tuned parameters for this shape, else nullptr
+        to use the built-in heuristics.
+
 Return Value:
 
     None.
@@ -1549,7 +1567,7 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc, Tuning);
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1567,7 +1585,8 @@ MlasGemmBatch(
     size_t K,
     const MLAS_SGEMM_DATA_PARAMS* Data,
     size_t BatchSize,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning
     )
 {
 
@@ -1578,10 +1597,13 @@ MlasGemmBatch(
 
     const double Complexity = double(M) * double(N) * double(K);
 
+    const size_t ThreadComplexity = (Tuning != nullptr && Tuning->ThreadComplexity != 0) ?
+        Tuning->ThreadComplexity : MLAS_SGEMM_THREAD_COMPLEXITY;
+
     ptrdiff_t TargetThreadCount;
 
-    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
-        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    if (Complexity < double(ThreadComplexity) * double(GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(ThreadComplexity)) + 1;
     } else {
         TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
     }
@@ -1632,13 +1654,186 @@ MlasGemmBatch(
         ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
         ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
         MlasSgemmThreaded(ThreadCountM, ThreadCountN,
-            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
+            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx, Tuning);
     });
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
 #endif
 
+void
+MlasSgemmGroupedPartition(
+    const MLAS_SGEMM_GROUPED_PARAMS& Params,
+    ptrdiff_t MaximumThreadCount,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the segments of one multiplication of a group in
+    the same way that MlasGemmBatch segments a single multiplication.
+
+Arguments:
+
+    Params - Supplies the multiplication.
+
+    MaximumThreadCount - Supplies the maximum number of segments.
+
+    ThreadCountM - Receives the number of segments along the M dimension.
+
+    ThreadCountN - Receives the number of segments along the N dimension.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const double Complexity = double(Params.M) * double(Params.N) * double(Params.K);
+
+    ptrdiff_t ThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY) * double(MaximumThreadCount)) {
+        ThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        ThreadCount = MaximumThreadCount;
+    }
+
+    if (Params.N > Params.M) {
+
+        const size_t BlockedN = (Params.N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+            MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+        *ThreadCountM = 1;
+        *ThreadCountN = std::min(ThreadCount, ptrdiff_t(BlockedN));
+
+    } else {
+
+        *ThreadCountM = std::min(ThreadCount, ptrdiff_t(Params.M));
+        *ThreadCountN = 1;
+    }
+}
+
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUPED_PARAMS* Params,
+    size_t GroupSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a group of single precision matrix/matrix
+    multiply operations with individual shapes.
+
+    The group is viewed as a sequence of work units, where each multiplication
+    covers a length equal to its complexity. Each thread executes the segments
+    of the multiplications that start within its share of the sequence, so
+    consecutive small multiplications run on the same thread and a large
+    multiplication is split across the threads that its length overlaps.
+
+Arguments:
+
+    Params - Supplies the array of multiplications.
+
+    GroupSize - Supplies the number of multiplications.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // An empty multiplication has no work. A multiplication with K == 0 still
+    // scales matrix C by beta.
+    //
+
+    auto GemmComplexity = [](const MLAS_SGEMM_GROUPED_PARAMS& p) {
+        return double(p.M) * double(p.N) * double(std::max(p.K, size_t(1)));
+    };
+
+    double TotalComplexity = 0.0;
+
+    for (size_t i = 0; i < GroupSize; i++) {
+        TotalComplexity += GemmComplexity(Params[i]);
+    }
+
+    if (TotalComplexity == 0.0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the whole
+    // group.
+    //
+
+    ptrdiff_t TargetThreadCount;
+
+    if (TotalComplexity < double(MLAS_SGEMM_THREAD_COMPLEXITY) * double(GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(TotalComplexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+
+        //
+        // Every thread walks the group with the same arithmetic, so each
+        // segment starts within the share of exactly one thread.
+        //
+
+        const double RangeStart = TotalComplexity * double(tid) / double(TargetThreadCount);
+        const double RangeEnd = (tid + 1 == TargetThreadCount) ? std::numeric_limits<double>::infinity() :
+            TotalComplexity * double(tid + 1) / double(TargetThreadCount);
+
+        double Offset = 0.0;
+
+        for (size_t i = 0; i < GroupSize && Offset < RangeEnd; i++) {
+
+            const MLAS_SGEMM_GROUPED_PARAMS& p = Params[i];
+            const double Complexity = GemmComplexity(p);
+
+            if (Complexity == 0.0 || Offset + Complexity <= RangeStart) {
+                Offset += Complexity;
+                continue;
+            }
+
+            ptrdiff_t ThreadCountM;
+            ptrdiff_t ThreadCountN;
+
+            MlasSgemmGroupedPartition(p, TargetThreadCount, &ThreadCountM, &ThreadCountN);
+
+            const ptrdiff_t ThreadCount = ThreadCountM * ThreadCountN;
+
+            for (ptrdiff_t ThreadIdx = 0; ThreadIdx < ThreadCount; ThreadIdx++) {
+
+                const double SegmentStart = Offset + Complexity * double(ThreadIdx) / double(ThreadCount);
+
+                if (SegmentStart >= RangeStart && SegmentStart < RangeEnd) {
+                    MlasSgemmThreaded(ThreadCountM, ThreadCountN, p.TransA, p.TransB,
+                        p.M, p.N, p.K, &p.Data, ThreadIdx, nullptr);
+                }
+            }
+
+            Offset += Complexity;
+        }
+    });
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -430,7 +430,9 @@ void
 MLASCALL
 MlasTranspose(
     const uint32_t* Input,
+    size_t ldInput,
     uint32_t* Output,
+    size_t ldOutput,
     size_t M,
     size_t N
     )
@@ -439,14 +441,19 @@ MlasTranspose(
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The matrices may be submatrices of
+    larger buffers.
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the first dimension of the input buffer.
+
     Output - Supplies the output buffer.
 
+    ldOutput - Supplies the first dimension of the output buffer.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -476,9 +483,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, ldInput, d, ldOutput);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -487,15 +494,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += ldOutput * 4;
         n -= 4;
     }
 
@@ -512,9 +519,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, ldInput, d, 1);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -523,17 +530,53 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns).
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTranspose(Input, N, Output, M, M, N);
+}
+
 void
 MLASCALL
 MlasTranspose(
@@ -555,7 +598,9 @@ void
 MLASCALL
 MlasTranspose(
     const uint16_t* Input,
+    size_t ldInput,
     uint16_t* Output,
+    size_t ldOutput,
     size_t M,
     size_t N
     )
@@ -564,14 +609,19 @@ MlasTranspose(
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The matrices may be submatrices of
+    larger buffers.
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the first dimension of the input buffer.
+
     Output - Supplies the output buffer.
 
+    ldOutput - Supplies the first dimension of the output buffer.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -601,9 +651,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, ldInput, d, ldOutput);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -612,15 +662,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += ldOutput * 4;
         n -= 4;
     }
 
@@ -637,9 +687,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, ldInput, d, 1);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -648,23 +698,61 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns).
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTranspose(Input, N, Output, M, M, N);
+}
+
 
 void
 MLASCALL
 MlasTranspose(
     const uint8_t* Input,
+    size_t ldInput,
     uint8_t* Output,
+    size_t ldOutput,
     size_t M,
     size_t N
     )
@@ -673,14 +761,19 @@ MlasTranspose(
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The matrices may be submatrices of
+    larger buffers.
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the first dimension of the input buffer.
+
     Output - Supplies the output buffer.
 
+    ldOutput - Supplies the first dimension of the output buffer.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -707,24 +800,24 @@ Return Value:
         size_t m = M;
         while (m >= 16) {
 
-            MlasTranspose16x16Block(s, N, d, M);
+            MlasTranspose16x16Block(s, ldInput, d, ldOutput);
 
-            s += N * 16;
+            s += ldInput * 16;
             d += 16;
             m -= 16;
         }
 
         while (m > 0) {
 
-            MlasTranspose16xNVector(s, 1, d, M);
+            MlasTranspose16xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 16;
-        Output += M * 16;
+        Output += ldOutput * 16;
         n -= 16;
     }
 #endif
@@ -738,9 +831,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8x8Block(s, N, d, M);
+            MlasTranspose8x8Block(s, ldInput, d, ldOutput);
 
-            s += N * 8;
+            s += ldInput * 8;
             d += 8;
             m -= 8;
         }
@@ -749,15 +842,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose8xNVector(s, 1, d, M);
+            MlasTranspose8xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 8;
-        Output += M * 8;
+        Output += ldOutput * 8;
         n -= 8;
     }
 
@@ -774,9 +867,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8xNVector(s, N, d, 1);
+            MlasTranspose8xNVector(s, ldInput, d, 1);
 
-            s += N * 8;
+            s += ldInput * 8;
             d += 8;
             m -= 8;
         }
@@ -785,17 +878,53 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns).
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTranspose(Input, N, Output, M, M, N);
+}
+
 void
 MLASCALL
 MlasTranspose(
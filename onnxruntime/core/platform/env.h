@@ -91,6 +91,9 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // If spinning is allowed, adapt the time spent spinning to the observed gaps between work items.
+  bool adaptive_spinning = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -141,6 +144,18 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// \brief Returns the logical processors of each NUMA node, in node order.
+  /// Only nodes with processors the process is allowed to run on are included.
+  /// An empty result means the topology is unknown and the system should be treated as a single node.
+  virtual std::vector<LogicalProcessors> GetNumaNodeProcessors() const {
+    return {};
+  }
+
+  /// \brief Returns the id of the logical processor the calling thread is currently running on, or -1 if unknown.
+  virtual int GetCurrentProcessorId() const {
+    return -1;
+  }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -29,6 +29,7 @@ limitations under the License.
 #include <sys/syscall.h>
 #include <unistd.h>
 
+#include <fstream>
 #include <iostream>
 #include <optional>
 #include <thread>
@@ -274,6 +275,41 @@ class PosixThread : public EnvThread {
   pthread_t hThread;
 };
 
+#if defined(__linux__) && !defined(__ANDROID__)
+// Parse a sysfs cpu list such as "0-3,8-11". Returns an empty list if the file can't be read.
+static LogicalProcessors ReadSysfsCpuList(const std::string& path) {
+  LogicalProcessors ids;
+  std::ifstream file(path);
+  std::string list;
+  if (!file || !std::getline(file, list)) {
+    return ids;
+  }
+
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    const std::string range = list.substr(pos, end - pos);
+    pos = end + 1;
+
+    const size_t dash = range.find('-');
+    ORT_TRY {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int id = first; id <= last; ++id) {
+        ids.push_back(id);
+      }
+    }
+    ORT_CATCH(const std::exception&) {
+      // skip malformed or empty entries
+    }
+  }
+  return ids;
+}
+#endif
+
 class PosixEnv : public Env {
  public:
   static PosixEnv& Instance() {
@@ -328,6 +364,38 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  std::vector<LogicalProcessors> GetNumaNodeProcessors() const override {
+    std::vector<LogicalProcessors> ret;
+#if defined(__linux__) && !defined(__ANDROID__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+      return ret;
+    }
+    for (int node : ReadSysfsCpuList("/sys/devices/system/node/online")) {
+      LogicalProcessors node_processors;
+      for (int id : ReadSysfsCpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist")) {
+        if (id < CPU_SETSIZE && CPU_ISSET(id, &allowed)) {
+          node_processors.push_back(id);
+        }
+      }
+      // memory-only nodes and nodes excluded by the process affinity have no processors to run threads on
+      if (!node_processors.empty()) {
+        ret.push_back(std::move(node_processors));
+      }
+    }
+#endif
+    return ret;
+  }
+
+  int GetCurrentProcessorId() const override {
+#if defined(__linux__) && !defined(__ANDROID__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
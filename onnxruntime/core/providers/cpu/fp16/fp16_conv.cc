@@ -7,7 +7,7 @@
 
 #include "core/mlas/inc/mlas.h"
 
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#ifdef MLAS_F16_GEMM_SUPPORTED
 
 #include "core/common/safeint.h"
 #include "core/framework/float16.h"
@@ -601,7 +601,7 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
     FusedConvFp16);
 
-#ifndef DISABLE_CONTRIB_OPS
+#if !defined(DISABLE_CONTRIB_OPS) && defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
 
 namespace contrib {
 
@@ -630,4 +630,4 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
 
 }  // namespace onnxruntime
 
-#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+#endif  // MLAS_F16_GEMM_SUPPORTED
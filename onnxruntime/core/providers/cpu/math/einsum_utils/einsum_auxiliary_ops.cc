@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace onnxruntime::common;
 
@@ -24,8 +25,9 @@ Status DataCopy(const Tensor& input, Tensor& output, void* /*einsum_cuda_assets*
 
 // CPU specific Transpose helper
 Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input,
-                 Tensor& output, const TensorShape* input_shape_override, void* /*einsum_cuda_assets*/) {
-  return TransposeBase::DoTranspose(permutation, input, output, input_shape_override);
+                 Tensor& output, const TensorShape* input_shape_override,
+                 concurrency::ThreadPool* tp, void* /*einsum_cuda_assets*/) {
+  return TransposeBase::DoTranspose(permutation, input, output, input_shape_override, tp);
 }
 
 // CPU specific MatMul helper
@@ -34,14 +36,31 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
               size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
               void* /*einsum_cuda_assets*/) {
-  for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp);
+  if constexpr (std::is_same_v<T, float>) {
+    // Partition the work of all the batches across the thread pool at once instead of one batch at a time.
+    std::vector<MLAS_SGEMM_GROUPED_PARAMS> params(num_batches);
+    for (size_t i = 0; i < num_batches; ++i) {
+      params[i].M = M;
+      params[i].N = N;
+      params[i].K = K;
+      params[i].Data.A = input_1_data + i * left_stride;
+      params[i].Data.lda = K;
+      params[i].Data.B = input_2_data + i * right_stride;
+      params[i].Data.ldb = N;
+      params[i].Data.C = output_data + i * output_stride;
+      params[i].Data.ldc = N;
+    }
+    MlasGemmGrouped(params.data(), num_batches, tp);
+  } else {
+    for (size_t i = 0; i < num_batches; ++i) {
+      math::MatMul<T>(
+          static_cast<int>(M),
+          static_cast<int>(N),
+          static_cast<int>(K),
+          input_1_data + i * left_stride,
+          input_2_data + i * right_stride,
+          output_data + i * output_stride, tp);
+    }
   }
 
   return Status::OK();
@@ -214,7 +233,7 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 
     // Permutate the input so that the dims from which we need the diagonal forms the innermost dims
     // (Pass in CPU Transpose function here as this Diagonal method will only be used for CPU based diagonal parsing)
-    auto transposed = EinsumOp::Transpose(input, input_dims, permutation, allocator, nullptr, Transpose);
+    auto transposed = EinsumOp::Transpose(input, input_dims, permutation, allocator, nullptr, nullptr, Transpose);
 
     // Parse the diagonal from the innermost dims
     output = DiagonalInnermostDims(*transposed, preserve_innermost_dim_val, allocator);
@@ -230,7 +249,7 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 
     // Permutate using the reverse permutation to get back the original axes ordering
     // (Pass in CPU Transpose function here as this Diagonal method will only be used for CPU based diagonal parsing)
-    output = EinsumOp::Transpose(*output, output->Shape().GetDims(), reverse_permutation, allocator, nullptr, Transpose);
+    output = EinsumOp::Transpose(*output, output->Shape().GetDims(), reverse_permutation, allocator, nullptr, nullptr, Transpose);
   } else {
     // No transposing required
     output = DiagonalInnermostDims(input, preserve_innermost_dim_val, allocator);
@@ -275,7 +294,8 @@ bool IsTransposeRequired(size_t input_rank, const gsl::span<const size_t>& permu
 // The following are thin wrappers over device specific helpers
 std::unique_ptr<Tensor> Transpose(const Tensor& input, const TensorShape& input_shape_override,
                                   const gsl::span<const size_t>& permutation, AllocatorPtr allocator,
-                                  void* einsum_cuda_assets, const DeviceHelpers::Transpose& device_transpose_func) {
+                                  concurrency::ThreadPool* tp, void* einsum_cuda_assets,
+                                  const DeviceHelpers::Transpose& device_transpose_func) {
   auto input_rank = input_shape_override.NumDimensions();
   ORT_ENFORCE(input_rank == permutation.size(), "Length of permutation must match the rank of the input to be permutated");
 
@@ -292,7 +312,7 @@ std::unique_ptr<Tensor> Transpose(const Tensor& input, const TensorShape& input_
 
   TensorShape overriden_shape(input_shape_override);
 
-  auto status = device_transpose_func(permutation, input, *output, &overriden_shape, einsum_cuda_assets);
+  auto status = device_transpose_func(permutation, input, *output, &overriden_shape, tp, einsum_cuda_assets);
 
   if (!status.IsOK()) {
     ORT_THROW(ONNXRUNTIME, FAIL, "Einsum op: Transpose failed: ", status.ErrorMessage());
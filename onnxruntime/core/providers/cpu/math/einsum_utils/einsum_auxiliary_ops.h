@@ -30,7 +30,7 @@ using DataCopy = std::function<Status(const Tensor& input, Tensor& output, void*
 // Transpose op - Transposes given input based on data in `permutation`
 using Transpose = std::function<Status(const gsl::span<const size_t>& permutation, const Tensor& input,
                                        Tensor& output, const TensorShape* input_shape_override,
-                                       void* einsum_cuda_assets)>;
+                                       concurrency::ThreadPool* tp, void* einsum_cuda_assets)>;
 
 // MatMul op - Multiplies two inputs of shapes [num_batches, M, K] and [num_batches, K, N]
 template <typename T>
@@ -64,7 +64,8 @@ namespace CpuDeviceHelpers {
 Status DataCopy(const Tensor& input, Tensor& output, void* einsum_cuda_assets);
 
 Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input,
-                 Tensor& output, const TensorShape* input_shape_override, void* einsum_cuda_assets);
+                 Tensor& output, const TensorShape* input_shape_override,
+                 concurrency::ThreadPool* tp, void* einsum_cuda_assets);
 
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
@@ -89,7 +90,8 @@ bool IsTransposeRequired(size_t input_rank, const gsl::span<const size_t>& permu
 
 // Thin wrapper over the Transpose op to be called from Einsum that does some checks and invokes the device specific helper
 std::unique_ptr<Tensor> Transpose(const Tensor& input, const TensorShape& input_shape_override,
-                                  const gsl::span<const size_t>& permutation, AllocatorPtr allocator, void* einsum_cuda_assets,
+                                  const gsl::span<const size_t>& permutation, AllocatorPtr allocator,
+                                  concurrency::ThreadPool* tp, void* einsum_cuda_assets,
                                   const DeviceHelpers::Transpose& device_transpose_func);
 
 // Thin wrapper over the MatMul op to be called from Einsum that does some checks and invokes the device specific helper
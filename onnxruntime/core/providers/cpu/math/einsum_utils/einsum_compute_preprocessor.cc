@@ -458,7 +458,7 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
                                       permutation)) {
       preprocessed = EinsumOp::Transpose(preprocessed ? *preprocessed : *inputs_[onnxruntime::narrow<size_t>(input_iter)],
                                          preprocessed ? preprocessed->Shape().GetDims() : inputs_[onnxruntime::narrow<size_t>(input_iter)]->Shape().GetDims(),
-                                         permutation, allocator_, einsum_ep_assets_, device_transpose_func_);
+                                         permutation, allocator_, nullptr, einsum_ep_assets_, device_transpose_func_);
     }
 
     // pre-processed may be null if the input didn't have need diagonals parsed and didn't need transposing
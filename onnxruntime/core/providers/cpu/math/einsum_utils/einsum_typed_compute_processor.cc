@@ -54,7 +54,7 @@ void EinsumTypedComputeProcessor<T>::FinalizeOutput(const Tensor& candidate_outp
   if (EinsumOp::IsTransposeRequired(candidate_output_shape_without_reduced_dims.size(), output_permutation)) {
     auto candidate_output_transposed = EinsumOp::Transpose(candidate_output, candidate_output_shape_without_reduced_dims,
                                                            output_permutation,
-                                                           allocator_, einsum_ep_assets_, device_transpose_func_);
+                                                           allocator_, tp_, einsum_ep_assets_, device_transpose_func_);
 
     // We have the result in an output "candidate". Now we have to copy the contents in its buffer
     // into the buffer of the actual output given to us by the execution frame
@@ -218,7 +218,7 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
       // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
       current_left = EinsumOp::Transpose(current_left ? *current_left : left,
                                          current_left ? current_left->Shape().GetDims() : left_dims,
-                                         left_permutation, allocator_, einsum_ep_assets_,
+                                         left_permutation, allocator_, tp_, einsum_ep_assets_,
                                          device_transpose_func_);
     }
   }
@@ -245,7 +245,7 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
       // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
       current_right = EinsumOp::Transpose(current_right ? *current_right : right,
                                           current_right ? current_right->Shape().GetDims() : right_dims,
-                                          right_permutation, allocator_, einsum_ep_assets_,
+                                          right_permutation, allocator_, tp_, einsum_ep_assets_,
                                           device_transpose_func_);
     }
   }
@@ -322,7 +322,7 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
         output->Reshape(reshaped_dims);
       } else {
         output = EinsumOp::Transpose(*output, output_dims, output_permutation, allocator_,
-                                     einsum_ep_assets_, device_transpose_func_);
+                                     tp_, einsum_ep_assets_, device_transpose_func_);
       }
     }
   } else {  // This is the final pair - Transpose directly to the output ordering required and copy the contents to the op's output
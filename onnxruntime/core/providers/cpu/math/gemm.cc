@@ -6,6 +6,7 @@
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/providers/cpu/tunable/gemm.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
@@ -80,7 +81,7 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
     Gemm<MLFloat16>);
 
-// opset 13 Adds BFloat16 support but we are not supporting it yet
+// opset 13 Adds BFloat16 support
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Gemm,
     13,
@@ -99,6 +100,12 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MLFloat16,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
     Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    Gemm<BFloat16>);
 
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
@@ -138,6 +145,41 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+bool GemmPackBBf16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   IAllocatorUniquePtr<void>& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  // Only handle the common case of a 2D weight matrix.
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasBf16GemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  auto* packed_b_data = packed_b.get();
+
+  // Zero the padding so that identical weights produce identical buffers, see GemmPackBFp32.
+  memset(packed_b_data, 0, packed_b_size);
+
+  MlasBf16GemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                    N,
+                    K,
+                    tensor_b.Data<BFloat16>(),
+                    trans_b ? K : N,
+                    packed_b_data);
+  return true;
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -263,6 +305,25 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   return Status::OK();
 }
 
+template <>
+Status Gemm<BFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                               AllocatorPtr alloc, /*out*/ bool& is_packed,
+                               /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBBf16(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
 template <typename T>
 Status Gemm<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
                                           int /*input_idx*/,
@@ -284,6 +345,55 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <>
+Status Gemm<BFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 int input_idx,
+                                                 /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::UsePersistedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                             std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                             /*out*/ bool& used_persisted_buffers) {
+  used_persisted_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                 std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 /*out*/ bool& used_persisted_buffers) {
+  used_persisted_buffers = false;
+
+  if (input_idx == 1) {
+    used_persisted_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                    std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                    /*out*/ bool& used_persisted_buffers) {
+  used_persisted_buffers = false;
+
+  if (input_idx == 1) {
+    used_persisted_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -408,7 +518,26 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
+  auto* tuning_ctx = cpu::tunable::GetCpuTuningContext(Info().GetExecutionProvider());
+
+  if (tuning_ctx != nullptr && tuning_ctx->IsTunableOpEnabled()) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+    data.B = B ? B->Data<float>() : static_cast<const float*>(packed_b_.get());
+    data.ldb = B ? static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N) : 0;
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.alpha = alpha_;
+    data.beta = c_data != nullptr ? beta_ : 0.0f;
+    data.BIsPacked = B == nullptr;
+
+    ORT_RETURN_IF_ERROR(cpu::tunable::blas::Sgemm(tuning_ctx, trans_A_, trans_B_,
+                                                  static_cast<size_t>(M), static_cast<size_t>(N),
+                                                  static_cast<size_t>(K), &data, 1, thread_pool));
+  } else if (B) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
   } else {
@@ -433,4 +562,59 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <>
+Status Gemm<BFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_A_ != CblasNoTrans, B ? B->Shape() : b_shape_, trans_B_ != CblasNoTrans,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  ptrdiff_t M = helper.M();
+  ptrdiff_t N = helper.N();
+  ptrdiff_t K = helper.K();
+
+  auto Y = context->Output(0, {M, N});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  BFloat16* y_data = Y->MutableData<BFloat16>();
+
+  const BFloat16* c_data = C != nullptr ? C->Data<BFloat16>() : nullptr;
+  const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
+
+  // Broadcast the bias as needed if bias is given. MLAS scales it by beta when it rounds the fp32 accumulators.
+  const float beta = c_data != nullptr ? beta_ : 0.0f;
+  if (beta != 0.0f) {
+    GemmBroadcastBias(M, N, Eigen::bfloat16(1.0f), reinterpret_cast<const Eigen::bfloat16*>(c_data), c_shape,
+                      reinterpret_cast<Eigen::bfloat16*>(y_data));
+  }
+
+  MLAS_BF16_GEMM_DATA_PARAMS data;
+  data.A = A->Data<BFloat16>();
+  data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+  data.B = B ? static_cast<const void*>(B->Data<BFloat16>()) : packed_b_.get();
+  data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha_;
+  data.beta = beta;
+  data.BIsPacked = B == nullptr;
+  MlasBf16GemmBatch(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                    &data, 1, thread_pool);
+
+  ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
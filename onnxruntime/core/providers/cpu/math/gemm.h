@@ -28,6 +28,10 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      /*out*/ bool& used_persisted_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                           T alpha,
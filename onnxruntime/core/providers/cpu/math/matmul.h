@@ -36,6 +36,10 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      /*out*/ bool& used_persisted_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
@@ -50,4 +54,37 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_b_;
 };
 
+template <>
+class MatMul<BFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      /*out*/ bool& used_persisted_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape b_shape_;
+  IAllocatorUniquePtr<void> packed_b_;
+};
+
+// B is consumed as is by the fp16 GEMM kernels, which have no packed layout
+// of their own, so there is nothing to pre-pack.
+template <>
+class MatMul<MLFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
 }  // namespace onnxruntime
@@ -58,6 +58,31 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Softmax<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Softmax,
+    1,
+    10,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+// Opset 11 starts to support Neg Axis.
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Softmax,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+// Opset 13 changed the semantic meaning of the axis attribute.
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Softmax,
+    13,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     LogSoftmax,
     1,
@@ -163,7 +188,7 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
     Tensor temp_input(input.DataType(), TensorShape(transposed_input_dims), alloc);
 
     // Perform the transpose
-    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, input, temp_input));
+    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, input, temp_input, nullptr, thread_pool));
     transposed_input = std::move(temp_input);
 
     // Allocate memory for the intermediate output
@@ -181,7 +206,7 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
 
   if (is_transpose_required) {
     // Perform the transpose to get the axes back to the original ordering
-    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, intermediate_output, output));
+    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, intermediate_output, output, nullptr, thread_pool));
   }
 
   return Status::OK();
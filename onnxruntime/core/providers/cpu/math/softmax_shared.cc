@@ -24,6 +24,8 @@
 #include <cmath>
 #include "core/common/gsl.h"
 
+#include "core/framework/float16.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
@@ -103,4 +105,36 @@ common::Status SoftmaxCPU<float>(size_t N,
   return Status::OK();
 }
 
+// The fp16 rows are converted to fp32 a block at a time and run through the
+// fp32 MLAS kernel.
+template <>
+common::Status SoftmaxCPU<MLFloat16>(size_t N,
+                                     size_t D,
+                                     const MLFloat16* Xdata,
+                                     MLFloat16* Ydata,
+                                     bool logarithmic,
+                                     onnxruntime::concurrency::ThreadPool* thread_pool) {
+  constexpr size_t kBlockElements = 16384;
+  const size_t rows_per_block = std::max<size_t>(1, kBlockElements / std::max<size_t>(1, D));
+  const std::ptrdiff_t block_count = static_cast<std::ptrdiff_t>((N + rows_per_block - 1) / rows_per_block);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, block_count, [&](std::ptrdiff_t block) {
+    const size_t row_start = static_cast<size_t>(block) * rows_per_block;
+    const size_t row_count = std::min(rows_per_block, N - row_start);
+    const size_t element_count = row_count * D;
+
+    std::vector<float> buffer(element_count);
+    MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Xdata + row_start * D), buffer.data(),
+                                 element_count);
+    MlasComputeSoftmax(buffer.data(), buffer.data(), row_count, D, logarithmic, nullptr);
+
+    MLFloat16* output = Ydata + row_start * D;
+    for (size_t i = 0; i < element_count; i++) {
+      output[i] = MLFloat16(buffer[i]);
+    }
+  });
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -18,6 +19,115 @@ LayerNormImpl::LayerNormImpl(const OpKernelInfo& op_kernel_info, bool simplified
 }
 
 namespace {
+template <typename T, typename U>
+void ComputeJob(
+    const T* X_data,
+    const T* scale_data,
+    const T* bias_data,
+    const ptrdiff_t task_idx,
+    const int64_t norm_size,
+    float epsilon,
+    bool simplified,
+    T* Y_data,
+    U* mean_data,
+    U* inv_std_dev_data) {
+  const T* p_input = X_data + task_idx * norm_size;
+  T* p_output = Y_data + task_idx * norm_size;
+
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    mean += p_input[h];
+    mean_square += p_input[h] * p_input[h];
+  }
+
+  mean = mean / norm_size;
+  if (simplified) {
+    mean_square = sqrt(mean_square / norm_size + epsilon);
+  } else {
+    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
+  }
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    if (simplified) {
+      p_output[h] = p_input[h] / mean_square * scale_data[h];
+    } else if (nullptr == bias_data) {
+      p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+    } else {
+      p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+    }
+  }
+
+  if (mean_data != nullptr) {
+    // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
+    mean_data[task_idx] = gsl::narrow_cast<U>(mean);
+  }
+
+  if (inv_std_dev_data != nullptr) {
+    inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
+  }
+}
+
+// float, fp16 and bfloat16 rows are normalized by MLAS in fp32. The scale and
+// bias are passed as fp32, converted once per call by ComputeImpl if needed.
+template <typename T, typename U>
+void MlasComputeJob(
+    const T* X_data,
+    const ptrdiff_t task_idx,
+    const int64_t norm_size,
+    const float* scale_float,
+    const float* bias_float,
+    float epsilon,
+    bool simplified,
+    T* Y_data,
+    U* mean_data,
+    U* inv_std_dev_data) {
+  float mean;
+  float inv_std_dev;
+
+  MLAS_LAYER_NORM_PARAMS<T> params;
+  params.Input = X_data + task_idx * norm_size;
+  params.Scale = scale_float;
+  params.Bias = bias_float;
+  params.Output = Y_data + task_idx * norm_size;
+  params.Mean = &mean;
+  params.InvStdDev = &inv_std_dev;
+  params.Epsilon = epsilon;
+  params.Simplified = simplified;
+
+  MlasLayerNormalization(params, static_cast<size_t>(norm_size));
+
+  if (mean_data != nullptr) {
+    mean_data[task_idx] = U(mean);
+  }
+
+  if (inv_std_dev_data != nullptr) {
+    inv_std_dev_data[task_idx] = U(inv_std_dev);
+  }
+}
+
+// Returns the scale or bias as fp32, converting into `buffer` if needed.
+template <typename T>
+const float* ParamsAsFloat(const T* data, int64_t size, std::vector<float>& buffer) {
+  if (data == nullptr) {
+    return nullptr;
+  }
+  if constexpr (std::is_same_v<T, float>) {
+    ORT_UNUSED_PARAMETER(size);
+    ORT_UNUSED_PARAMETER(buffer);
+    return data;
+  } else {
+    buffer.resize(static_cast<size_t>(size));
+    if constexpr (std::is_same_v<T, MLFloat16>) {
+      MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(data), buffer.data(), buffer.size());
+    } else {
+      MlasConvertBFloat16ToFloatBuffer(reinterpret_cast<const unsigned short*>(data), buffer.data(), buffer.size());
+    }
+    return buffer.data();
+  }
+}
+
 template <typename T, typename U>
 Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, bool simplified) {
   // Inputs
@@ -74,47 +184,28 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
     inv_std_dev_data = inv_std_dev->MutableData<U>();
   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
-      [&](ptrdiff_t task_idx) {
-        const T* p_input = X_data + task_idx * norm_size;
-        T* p_output = Y_data + task_idx * norm_size;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
-
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon);
-        } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-        }
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
-          } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-          }
-        }
-
-        if (mean_data != nullptr) {
-          // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-          mean_data[task_idx] = gsl::narrow_cast<U>(mean);
-        }
-
-        if (inv_std_dev_data != nullptr) {
-          inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
-        }
-      },
-      0);
+  if constexpr (std::is_same_v<T, float> || std::is_same_v<T, MLFloat16> || std::is_same_v<T, BFloat16>) {
+    std::vector<float> scale_buffer;
+    std::vector<float> bias_buffer;
+    const float* scale_float = ParamsAsFloat(scale_data, norm_size, scale_buffer);
+    const float* bias_float = ParamsAsFloat(bias_data, norm_size, bias_buffer);
+
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
+        [&](ptrdiff_t task_idx) {
+          MlasComputeJob(X_data, task_idx, norm_size, scale_float, bias_float, epsilon, simplified,
+                         Y_data, mean_data, inv_std_dev_data);
+        },
+        0);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
+        [&](ptrdiff_t task_idx) {
+          ComputeJob(X_data, scale_data, bias_data, task_idx, norm_size, epsilon, simplified,
+                     Y_data, mean_data, inv_std_dev_data);
+        },
+        0);
+  }
 
   return Status::OK();
 }
@@ -141,7 +232,7 @@ struct SrcDispatcher {
 Status LayerNormImpl::Compute(OpKernelContext* p_ctx) const {
   const auto elem_type = p_ctx->Input<Tensor>(0)->GetElementType();
 
-  using SupportedTypeList = boost::mp11::mp_list<float, double>;
+  using SupportedTypeList = boost::mp11::mp_list<float, double, MLFloat16, BFloat16>;
 
   utils::MLTypeCallDispatcherFromTypeList<SupportedTypeList> t_disp(elem_type);
   return t_disp.InvokeRet<Status, SrcDispatcher>(p_ctx, axis_, epsilon_, simplified_, contrib_op_);
@@ -13,10 +13,13 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
-#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -118,6 +121,116 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+struct BoxInfoPtr {
+  float score_{};
+  int64_t index_{};
+
+  BoxInfoPtr() = default;
+  explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
+  // Orders by descending score, and by ascending index between equal scores. NaN scores are ordered last so that
+  // this is a strict weak ordering for the sort.
+  inline bool operator<(const BoxInfoPtr& rhs) const {
+    const bool is_nan = std::isnan(score_);
+    const bool rhs_is_nan = std::isnan(rhs.score_);
+    if (is_nan != rhs_is_nan) {
+      return rhs_is_nan;
+    }
+    if (!is_nan && score_ != rhs.score_) {
+      return score_ > rhs.score_;
+    }
+    return index_ < rhs.index_;
+  }
+};
+
+// Corners and area of a box, computed the same way as SuppressByIOU does.
+struct BoxCorners {
+  float x_min, y_min, x_max, y_max, area;
+};
+
+BoxCorners GetBoxCorners(const float* box, int64_t center_point_box) {
+  BoxCorners corners;
+  if (0 == center_point_box) {
+    // boxes data format [y1, x1, y2, x2]
+    MaxMin(box[1], box[3], corners.x_min, corners.x_max);
+    MaxMin(box[0], box[2], corners.y_min, corners.y_max);
+  } else {
+    // boxes data format [x_center, y_center, width, height]
+    const float width_half = box[2] / 2;
+    const float height_half = box[3] / 2;
+    corners.x_min = box[0] - width_half;
+    corners.x_max = box[0] + width_half;
+    corners.y_min = box[1] - height_half;
+    corners.y_max = box[1] + height_half;
+  }
+  corners.area = (corners.x_max - corners.x_min) * (corners.y_max - corners.y_min);
+  return corners;
+}
+
+// The boxes selected so far for a class, stored as structure of arrays so that the IOU of a candidate with all of
+// them is computed with vectorized Eigen array expressions.
+class SelectedBoxes {
+ public:
+  void Reserve(size_t capacity) {
+    x_min_.reserve(capacity);
+    y_min_.reserve(capacity);
+    x_max_.reserve(capacity);
+    y_max_.reserve(capacity);
+    area_.reserve(capacity);
+  }
+
+  void Clear() {
+    x_min_.clear();
+    y_min_.clear();
+    x_max_.clear();
+    y_max_.clear();
+    area_.clear();
+  }
+
+  int64_t Size() const { return static_cast<int64_t>(area_.size()); }
+
+  void Add(const BoxCorners& box) {
+    x_min_.push_back(box.x_min);
+    y_min_.push_back(box.y_min);
+    x_max_.push_back(box.x_max);
+    y_max_.push_back(box.y_max);
+    area_.push_back(box.area);
+  }
+
+  // Same result as SuppressByIOU(candidate, selected) being true for any selected box.
+  bool Suppresses(const BoxCorners& candidate, float iou_threshold) const {
+    if (area_.empty() || candidate.area <= .0f) {
+      return false;
+    }
+
+    const auto size = static_cast<Eigen::Index>(area_.size());
+    const ConstEigenVectorArrayMap<float> x_min(x_min_.data(), size);
+    const ConstEigenVectorArrayMap<float> y_min(y_min_.data(), size);
+    const ConstEigenVectorArrayMap<float> x_max(x_max_.data(), size);
+    const ConstEigenVectorArrayMap<float> y_max(y_max_.data(), size);
+    const ConstEigenVectorArrayMap<float> area(area_.data(), size);
+
+    const auto intersection_x_min = x_min.max(candidate.x_min);
+    const auto intersection_x_max = x_max.min(candidate.x_max);
+    const auto intersection_y_min = y_min.max(candidate.y_min);
+    const auto intersection_y_max = y_max.min(candidate.y_max);
+    const auto intersection_area = (intersection_x_max - intersection_x_min) *
+                                   (intersection_y_max - intersection_y_min);
+    const auto union_area = candidate.area + area - intersection_area;
+
+    return ((intersection_x_max > intersection_x_min) && (intersection_y_max > intersection_y_min) &&
+            (intersection_area > .0f) && (area > .0f) && (union_area > .0f) &&
+            (intersection_area / union_area > iou_threshold))
+        .any();
+  }
+
+ private:
+  std::vector<float> x_min_, y_min_, x_max_, y_max_, area_;
+};
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -135,75 +248,85 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
-
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
+  const bool has_score_threshold = pc.score_threshold_ != nullptr;
+  const auto num_boxes = static_cast<size_t>(pc.num_boxes_);
+  const auto max_selected = static_cast<size_t>(std::min<int64_t>(max_output_boxes_per_class, pc.num_boxes_));
+
+  // Every (batch, class) pair is independent, so they are processed in parallel, each into its own list.
+  const std::ptrdiff_t num_batch_classes = narrow<std::ptrdiff_t>(pc.num_batches_ * pc.num_classes_);
+  std::vector<std::vector<SelectedIndex>> batch_class_selected_indices(num_batch_classes);
+
+  const double cost_per_batch_class = static_cast<double>(pc.num_boxes_);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_batch_classes,
+      TensorOpCost{cost_per_batch_class * sizeof(float), cost_per_batch_class * sizeof(BoxInfoPtr),
+                   cost_per_batch_class * 8},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(num_boxes);
+        SelectedBoxes selected_boxes;
+        selected_boxes.Reserve(max_selected);
+
+        for (std::ptrdiff_t batch_class = begin; batch_class < end; ++batch_class) {
+          const int64_t batch_index = batch_class / pc.num_classes_;
+          const int64_t class_index = batch_class % pc.num_classes_;
+          const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
+          const float* class_scores = scores_data + batch_class * pc.num_boxes_;
+          auto& selected_indices = batch_class_selected_indices[batch_class];
+
+          // Filter by score_threshold_
+          candidate_boxes.clear();
+          for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index) {
+            if (!has_score_threshold || class_scores[box_index] > score_threshold) {
+              candidate_boxes.emplace_back(class_scores[box_index], box_index);
+            }
           }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+
+          // Visit the candidates in descending score order, filtering by iou_threshold. Most of the candidates are
+          // usually never reached, so they are sorted a chunk at a time: the next chunk is selected with
+          // nth_element and sorted only when the sorted ones run out.
+          selected_boxes.Clear();
+          size_t sorted_end = 0;
+          for (size_t next = 0;
+               next < candidate_boxes.size() && static_cast<size_t>(selected_boxes.Size()) < max_selected;
+               ++next) {
+            if (next == sorted_end) {
+              const size_t chunk_size = std::max<size_t>(2 * (max_selected - selected_boxes.Size()), 64);
+              sorted_end = std::min(candidate_boxes.size(), next + chunk_size);
+              if (sorted_end < candidate_boxes.size()) {
+                std::nth_element(candidate_boxes.begin() + next, candidate_boxes.begin() + sorted_end,
+                                 candidate_boxes.end());
+              }
+              std::sort(candidate_boxes.begin() + next, candidate_boxes.begin() + sorted_end);
+            }
+
+            const BoxInfoPtr& next_top_score = candidate_boxes[next];
+            const BoxCorners corners = GetBoxCorners(batch_boxes + 4 * next_top_score.index_, center_point_box);
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over
+            // Union) threshold
+            if (!selected_boxes.Suppresses(corners, iou_threshold)) {
+              selected_boxes.Add(corners);
+              selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+            }
           }
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }    // for class_index
-  }      // for batch_index
+  size_t num_selected = 0;
+  for (const auto& selected_indices : batch_class_selected_indices) {
+    num_selected += selected_indices.size();
+  }
 
   constexpr auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (const auto& selected_indices : batch_class_selected_indices) {
+    output_data = std::copy(selected_indices.begin(), selected_indices.end(), output_data);
+  }
 
   return Status::OK();
 }
@@ -78,6 +78,21 @@ class MatMulIntegerBase : public OpKernel {
     return Status::OK();
   }
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      /*out*/ bool& used_persisted_buffers) override {
+    used_persisted_buffers = false;
+
+    if (input_idx == GetBIdx()) {
+      used_persisted_buffers = true;
+      b_shape_ = tensor.Shape();
+      b_is_signed_ = tensor.IsDataType<int8_t>();
+      packed_b_ = std::move(prepacked_buffers[0]);
+    }
+
+    return Status::OK();
+  }
+
  protected:
   /**
    * @return input index of Matrix B, the weight tensor
@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -688,6 +689,81 @@ FastReduceKind OptimizeShapeForFastReduce(gsl::span<const int64_t> input_shape,
   return FastReduceKind::kNone;
 }
 
+static float MlasFastReduceAll(MLAS_REDUCE_KIND kind, const float* data, int64_t size) {
+  if (size == 0) {
+    return 0;
+  }
+  float value;
+  MlasReduceRows(kind, data, &value, 1, onnxruntime::narrow<size_t>(size), onnxruntime::narrow<size_t>(size));
+  return value;
+}
+
+static void MlasFastReduceKR(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                             Tensor& output, concurrency::ThreadPool* tp) {
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  size_t N = onnxruntime::narrow<size_t>(fast_shape[1]);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, fast_shape[1], sizeof(float), 6),
+      [kind, data, out, N](std::ptrdiff_t first, std::ptrdiff_t last) {
+        MlasReduceRows(kind, data + first * N, out + first, static_cast<size_t>(last - first), N, N);
+      });
+}
+
+static void MlasFastReduceRK(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                             Tensor& output, concurrency::ThreadPool* tp) {
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  size_t n_rows = onnxruntime::narrow<size_t>(fast_shape[0]);
+  size_t N = onnxruntime::narrow<size_t>(fast_shape[1]);
+  // Each thread reduces a range of columns over all the rows, MLAS blocks the rows to stay in cache.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[1]), ParallelReduceFastCost(1, fast_shape[0], sizeof(float), 6),
+      [kind, data, out, n_rows, N](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        MlasReduceColumns(kind, data + begin, out + begin, n_rows, static_cast<size_t>(end - begin), N);
+      });
+}
+
+static void MlasFastReduceKRK(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                              Tensor& output, concurrency::ThreadPool* tp) {
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  size_t n_rows = onnxruntime::narrow<size_t>(fast_shape[1]);
+  size_t N = onnxruntime::narrow<size_t>(fast_shape[2]);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(float), 6),
+      [kind, data, out, n_rows, N](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t d = begin; d < end; ++d) {
+          MlasReduceColumns(kind, data + d * n_rows * N, out + d * N, n_rows, N, N);
+        }
+      });
+}
+
+#define REDUCE_AGGREGATOR_MLAS_SPECIALIZATION(AGG, kind)                                          \
+  template <>                                                                                     \
+  float AGG<float>::aggall(const float* from_data, int64_t size) {                                \
+    return MlasFastReduceAll(kind, from_data, size);                                              \
+  }                                                                                               \
+  template <>                                                                                     \
+  void AGG<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,  \
+                                Tensor& output, concurrency::ThreadPool* tp) {                    \
+    MlasFastReduceKR(kind, input, fast_shape, output, tp);                                        \
+  }                                                                                               \
+  template <>                                                                                     \
+  void AGG<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,  \
+                                Tensor& output, concurrency::ThreadPool* tp) {                    \
+    MlasFastReduceRK(kind, input, fast_shape, output, tp);                                        \
+  }                                                                                               \
+  template <>                                                                                     \
+  void AGG<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape, \
+                                 Tensor& output, concurrency::ThreadPool* tp) {                   \
+    MlasFastReduceKRK(kind, input, fast_shape, output, tp);                                       \
+  }
+
+REDUCE_AGGREGATOR_MLAS_SPECIALIZATION(ReduceAggregatorSum, MlasReduceSum)
+REDUCE_AGGREGATOR_MLAS_SPECIALIZATION(ReduceAggregatorMax, MlasReduceMaximum)
+REDUCE_AGGREGATOR_MLAS_SPECIALIZATION(ReduceAggregatorMin, MlasReduceMinimum)
+
 void ValidateCommonFastReduce(const Tensor* axes_tensor) {
   ORT_ENFORCE(axes_tensor != nullptr, "Axes input is null");
   ORT_ENFORCE(axes_tensor->Shape().NumDimensions() == 1,
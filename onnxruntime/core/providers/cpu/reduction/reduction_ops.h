@@ -282,6 +282,21 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
   }
 };
 
+#ifndef SHARED_PROVIDER
+// The float reductions use the vectorized MLAS kernels, see reduction_ops.cc.
+template <>
+float ReduceAggregatorSum<float>::aggall(const float* from_data, int64_t size);
+template <>
+void ReduceAggregatorSum<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorSum<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorSum<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                               Tensor& output, concurrency::ThreadPool* tp);
+#endif
+
 template <typename T, typename TVAL = T>
 class ReduceAggregatorSumSquare : public ReduceAggregator<T, TVAL> {
  public:
@@ -444,6 +459,20 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
   }
 };
 
+#ifndef SHARED_PROVIDER
+template <>
+float ReduceAggregatorMax<float>::aggall(const float* from_data, int64_t size);
+template <>
+void ReduceAggregatorMax<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMax<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMax<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                               Tensor& output, concurrency::ThreadPool* tp);
+#endif
+
 template <typename T, typename TVAL = int64_t>
 class ReduceAggregatorArgMinMax : public ReduceAggregator<T, TVAL> {
  protected:
@@ -619,6 +648,20 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
   }
 };
 
+#ifndef SHARED_PROVIDER
+template <>
+float ReduceAggregatorMin<float>::aggall(const float* from_data, int64_t size);
+template <>
+void ReduceAggregatorMin<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMin<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMin<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                               Tensor& output, concurrency::ThreadPool* tp);
+#endif
+
 template <typename T>
 class ReduceAggregatorProd : public ReduceAggregator<T, T> {
  public:
@@ -682,6 +725,34 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, T> {
   }
   inline void update(const T& v) { this->accumulator_ += reduce_exp(v - max_); }
   inline T get_value() { return reduce_log<T>(this->accumulator_) + max_; }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    int64_t stridei = fast_shape[1];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 12),
+        [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t d = first; d < last; ++d) {
+            // Same two passes as NoTransposeReduce2Loops so that infinite values are handled alike.
+            const T* p = data + d * stridei;
+            ReduceAggregatorLogSumExp<T> agg(stridei, p[0]);
+            for (int64_t i = 0; i < stridei; ++i) {
+              agg.update0(p[i]);
+            }
+            for (int64_t i = 0; i < stridei; ++i) {
+              agg.update(p[i]);
+            }
+            out[d] = agg.get_value();
+          }
+        });
+  }
 };
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
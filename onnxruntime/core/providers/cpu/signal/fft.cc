@@ -0,0 +1,339 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/signal/fft.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+
+namespace onnxruntime {
+namespace signal {
+
+namespace {
+
+// Prime factors up to this are transformed with the generic butterfly, larger ones with Bluestein's algorithm.
+constexpr size_t kMaxGenericRadix = 31;
+
+// Complex products written out, as std::complex multiplication handles infinities and NaN through a library call
+// that keeps the butterflies from being vectorized.
+template <typename T>
+inline std::complex<T> Mul(const std::complex<T>& a, const std::complex<T>& b) {
+  return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+// Multiplies by the imaginary unit.
+template <typename T>
+inline std::complex<T> MulI(const std::complex<T>& a) {
+  return {-a.imag(), a.real()};
+}
+
+template <typename T>
+std::complex<T> UnitRoot(size_t numerator, size_t denominator, bool inverse) {
+  // Computed in double so that the roots of the float plans are exact to float precision.
+  constexpr double tau = 2 * M_PI;
+  const double angle = (inverse ? tau : -tau) * static_cast<double>(numerator % denominator) / denominator;
+  return {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+}
+
+// One stage of the Stockham FFT: for every p < m and q < stride, the radix-point DFT of the input elements
+// q + stride * (p + j * m) is multiplied by the twiddle factors of p and written to the output elements
+// q + stride * (radix * p + k), in natural order.
+template <size_t Radix, typename T, typename Butterfly>
+void StockhamStage(size_t m, size_t stride, const std::complex<T>* twiddles, const std::complex<T>* input,
+                   std::complex<T>* output, const Butterfly& butterfly) {
+  for (size_t p = 0; p < m; ++p) {
+    const std::complex<T>* w = twiddles + p * (Radix - 1);
+    for (size_t q = 0; q < stride; ++q) {
+      std::array<std::complex<T>, Radix> a;
+      for (size_t j = 0; j < Radix; ++j) {
+        a[j] = input[q + stride * (p + j * m)];
+      }
+      butterfly(a);
+      std::complex<T>* y = output + q + stride * Radix * p;
+      y[0] = a[0];
+      for (size_t k = 1; k < Radix; ++k) {
+        y[stride * k] = Mul(a[k], w[k - 1]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+FFTPlan<T>::FFTPlan(size_t length, bool inverse, bool real_input)
+    : length_(length), inverse_(inverse), real_input_(real_input), scratch_size_(length) {
+  ORT_ENFORCE(length > 0, "The FFT length must be positive.");
+
+  if (real_input) {
+    ORT_ENFORCE(length % 2 == 0, "The FFT length of real input must be even.");
+    const size_t half_length = length / 2;
+    half_length_plan_ = std::make_unique<FFTPlan<T>>(half_length, inverse);
+    scratch_size_ = half_length_plan_->ScratchSize();
+    real_twiddles_.resize(half_length + 1);
+    for (size_t k = 0; k <= half_length; ++k) {
+      real_twiddles_[k] = UnitRoot<T>(k, length, inverse);
+    }
+    return;
+  }
+
+  std::vector<size_t> radices;
+  size_t remaining = length;
+  for (size_t radix : {4, 2, 3, 5}) {
+    while (remaining % radix == 0) {
+      radices.push_back(radix);
+      remaining /= radix;
+    }
+  }
+  for (size_t radix = 7; radix <= kMaxGenericRadix && remaining > 1; radix += 2) {
+    while (remaining % radix == 0) {
+      radices.push_back(radix);
+      remaining /= radix;
+    }
+  }
+
+  if (remaining != 1) {
+    // Bluestein's algorithm: with the chirp c[k] = w^(k^2 / 2) where w is the root of unity of the transform,
+    // X[k] = c[k] * sum_j (x[j] * c[j]) * conj(c[k - j]), a convolution that is computed with power of 2 FFTs.
+    size_t convolution_length = 1;
+    while (convolution_length < 2 * length - 1) {
+      convolution_length <<= 1;
+    }
+    convolution_plan_ = std::make_unique<FFTPlan<T>>(convolution_length, false);
+    scratch_size_ = convolution_length + convolution_plan_->ScratchSize();
+
+    chirp_.resize(length);
+    for (size_t k = 0; k < length; ++k) {
+      // k^2 / 2 modulo length, doubled so that it stays an integer
+      const size_t k_squared = static_cast<size_t>((static_cast<uint64_t>(k) * k) % (2 * length));
+      chirp_[k] = UnitRoot<T>(k_squared, 2 * length, inverse);
+    }
+
+    // The filter is transformed once here, scaled for the inverse transform of the convolution.
+    chirp_filter_.assign(convolution_length, std::complex<T>{});
+    chirp_filter_[0] = std::conj(chirp_[0]);
+    for (size_t k = 1; k < length; ++k) {
+      chirp_filter_[k] = chirp_filter_[convolution_length - k] = std::conj(chirp_[k]);
+    }
+    std::vector<std::complex<T>> scratch(convolution_plan_->ScratchSize());
+    convolution_plan_->Transform(chirp_filter_.data(), scratch.data());
+    for (auto& value : chirp_filter_) {
+      value /= static_cast<T>(convolution_length);
+    }
+    return;
+  }
+
+  size_t stage_length = length;
+  size_t stride = 1;
+  for (size_t radix : radices) {
+    const size_t m = stage_length / radix;
+    stages_.push_back({radix, stage_length, stride, twiddles_.size(), roots_.size()});
+
+    for (size_t p = 0; p < m; ++p) {
+      for (size_t k = 1; k < radix; ++k) {
+        twiddles_.push_back(UnitRoot<T>(p * k, stage_length, inverse));
+      }
+    }
+    if (radix > 5) {
+      for (size_t k = 0; k < radix; ++k) {
+        roots_.push_back(UnitRoot<T>(k, radix, inverse));
+      }
+    }
+
+    stage_length = m;
+    stride *= radix;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::RunStage(const Stage& stage, const std::complex<T>* input, std::complex<T>* output) const {
+  const size_t m = stage.length / stage.radix;
+  const std::complex<T>* twiddles = twiddles_.data() + stage.twiddle_offset;
+  // the sign of the exponent of the roots of unity
+  const T sign = inverse_ ? T{1} : T{-1};
+
+  switch (stage.radix) {
+    case 2:
+      StockhamStage<2>(m, stage.stride, twiddles, input, output, [](std::array<std::complex<T>, 2>& a) {
+        const std::complex<T> a0 = a[0];
+        a[0] = a0 + a[1];
+        a[1] = a0 - a[1];
+      });
+      break;
+    case 3: {
+      const T sin_1 = sign * static_cast<T>(0.86602540378443864676);  // sin(2 pi / 3)
+      StockhamStage<3>(m, stage.stride, twiddles, input, output, [sin_1](std::array<std::complex<T>, 3>& a) {
+        const std::complex<T> sum = a[1] + a[2];
+        const std::complex<T> mid = a[0] - sum * T{0.5};
+        const std::complex<T> rotated = MulI(a[1] - a[2]) * sin_1;
+        a[0] += sum;
+        a[1] = mid + rotated;
+        a[2] = mid - rotated;
+      });
+      break;
+    }
+    case 4:
+      StockhamStage<4>(m, stage.stride, twiddles, input, output, [sign](std::array<std::complex<T>, 4>& a) {
+        const std::complex<T> t0 = a[0] + a[2];
+        const std::complex<T> t1 = a[0] - a[2];
+        const std::complex<T> t2 = a[1] + a[3];
+        const std::complex<T> t3 = MulI(a[1] - a[3]) * sign;
+        a[0] = t0 + t2;
+        a[1] = t1 + t3;
+        a[2] = t0 - t2;
+        a[3] = t1 - t3;
+      });
+      break;
+    case 5: {
+      const T cos_1 = static_cast<T>(0.30901699437494742410);          // cos(2 pi / 5)
+      const T cos_2 = static_cast<T>(-0.80901699437494742410);         // cos(4 pi / 5)
+      const T sin_1 = sign * static_cast<T>(0.95105651629515357212);   // sin(2 pi / 5)
+      const T sin_2 = sign * static_cast<T>(0.58778525229247312917);   // sin(4 pi / 5)
+      StockhamStage<5>(m, stage.stride, twiddles, input, output,
+                       [cos_1, cos_2, sin_1, sin_2](std::array<std::complex<T>, 5>& a) {
+                         const std::complex<T> sum_1 = a[1] + a[4];
+                         const std::complex<T> sum_2 = a[2] + a[3];
+                         const std::complex<T> diff_1 = a[1] - a[4];
+                         const std::complex<T> diff_2 = a[2] - a[3];
+                         const std::complex<T> mid_1 = a[0] + sum_1 * cos_1 + sum_2 * cos_2;
+                         const std::complex<T> mid_2 = a[0] + sum_1 * cos_2 + sum_2 * cos_1;
+                         const std::complex<T> rotated_1 = MulI(diff_1 * sin_1 + diff_2 * sin_2);
+                         const std::complex<T> rotated_2 = MulI(diff_1 * sin_2 - diff_2 * sin_1);
+                         a[0] += sum_1 + sum_2;
+                         a[1] = mid_1 + rotated_1;
+                         a[4] = mid_1 - rotated_1;
+                         a[2] = mid_2 + rotated_2;
+                         a[3] = mid_2 - rotated_2;
+                       });
+      break;
+    }
+    default: {
+      const size_t radix = stage.radix;
+      const size_t stride = stage.stride;
+      const std::complex<T>* roots = roots_.data() + stage.roots_offset;
+      std::array<std::complex<T>, kMaxGenericRadix> a;
+      for (size_t p = 0; p < m; ++p) {
+        const std::complex<T>* w = twiddles + p * (radix - 1);
+        for (size_t q = 0; q < stride; ++q) {
+          for (size_t j = 0; j < radix; ++j) {
+            a[j] = input[q + stride * (p + j * m)];
+          }
+          std::complex<T>* y = output + q + stride * radix * p;
+          for (size_t k = 0; k < radix; ++k) {
+            std::complex<T> sum = a[0];
+            for (size_t j = 1, root = k; j < radix; ++j, root = (root + k) % radix) {
+              sum += Mul(a[j], roots[root]);
+            }
+            y[stride * k] = k == 0 ? sum : Mul(sum, w[k - 1]);
+          }
+        }
+      }
+      break;
+    }
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Transform(std::complex<T>* data, std::complex<T>* scratch) const {
+  ORT_ENFORCE(!real_input_, "Transform() of a plan for real input.");
+
+  if (convolution_plan_) {
+    TransformBluestein(data, scratch);
+    return;
+  }
+
+  // The stages alternate between data and scratch.
+  std::complex<T>* input = data;
+  std::complex<T>* output = scratch;
+  for (const auto& stage : stages_) {
+    RunStage(stage, input, output);
+    std::swap(input, output);
+  }
+  if (input != data) {
+    std::copy_n(input, length_, data);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::TransformBluestein(std::complex<T>* data, std::complex<T>* scratch) const {
+  const size_t convolution_length = convolution_plan_->Length();
+  std::complex<T>* convolution = scratch;
+  std::complex<T>* convolution_scratch = scratch + convolution_length;
+
+  for (size_t k = 0; k < length_; ++k) {
+    convolution[k] = Mul(data[k], chirp_[k]);
+  }
+  std::fill(convolution + length_, convolution + convolution_length, std::complex<T>{});
+
+  convolution_plan_->Transform(convolution, convolution_scratch);
+  // The inverse transform is computed as the conjugate of the forward transform of the conjugate.
+  for (size_t k = 0; k < convolution_length; ++k) {
+    convolution[k] = std::conj(Mul(convolution[k], chirp_filter_[k]));
+  }
+  convolution_plan_->Transform(convolution, convolution_scratch);
+
+  for (size_t k = 0; k < length_; ++k) {
+    data[k] = Mul(std::conj(convolution[k]), chirp_[k]);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::TransformReal(std::complex<T>* data, std::complex<T>* scratch) const {
+  ORT_ENFORCE(real_input_, "TransformReal() of a plan for complex input.");
+
+  // The real values are the complex values z[k] = x[2k] + i x[2k + 1], whose transform Z gives the transforms of the
+  // even and odd samples E[k] = (Z[k] + conj(Z[h - k])) / 2 and O[k] = (Z[k] - conj(Z[h - k])) / 2i, from which
+  // X[k] = E[k] + w^k O[k].
+  const size_t half_length = length_ / 2;
+  half_length_plan_->Transform(data, scratch);
+
+  const auto combine = [](const std::complex<T>& z, const std::complex<T>& z_mirror, const std::complex<T>& w) {
+    const std::complex<T> even = (z + std::conj(z_mirror)) * T{0.5};
+    const std::complex<T> odd = MulI(z - std::conj(z_mirror)) * T{-0.5};
+    return even + Mul(w, odd);
+  };
+
+  const std::complex<T> z_0 = data[0];
+  data[0] = {z_0.real() + z_0.imag(), T{0}};
+  data[half_length] = {z_0.real() - z_0.imag(), T{0}};
+  for (size_t k = 1; 2 * k <= half_length; ++k) {
+    const size_t mirror = half_length - k;
+    const std::complex<T> z = data[k];
+    const std::complex<T> z_mirror = data[mirror];
+    data[k] = combine(z, z_mirror, real_twiddles_[k]);
+    data[mirror] = combine(z_mirror, z, real_twiddles_[mirror]);
+  }
+}
+
+template class FFTPlan<float>;
+template class FFTPlan<double>;
+
+template <typename T>
+std::shared_ptr<const FFTPlan<T>> FFTPlanCache::GetPlan(size_t length, bool inverse, bool real_input) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& plans = [this]() -> auto& {
+    if constexpr (std::is_same_v<T, float>) {
+      return float_plans_;
+    } else {
+      return double_plans_;
+    }
+  }();
+
+  const Key key{length, inverse, real_input};
+  auto it = plans.find(key);
+  if (it == plans.end()) {
+    if (plans.size() >= kMaxPlans) {
+      plans.clear();
+    }
+    it = plans.emplace(key, std::make_shared<const FFTPlan<T>>(length, inverse, real_input)).first;
+  }
+  return it->second;
+}
+
+template std::shared_ptr<const FFTPlan<float>> FFTPlanCache::GetPlan<float>(size_t, bool, bool);
+template std::shared_ptr<const FFTPlan<double>> FFTPlanCache::GetPlan<double>(size_t, bool, bool);
+
+}  // namespace signal
+}  // namespace onnxruntime
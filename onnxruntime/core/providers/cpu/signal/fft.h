@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace signal {
+
+/*
+  A precomputed plan for the unnormalized discrete Fourier transform of a fixed length and direction.
+
+  Lengths whose prime factors are all small are transformed with a mixed radix Stockham FFT, which has specialized
+  butterflies for the radices 4, 2, 3 and 5 and a generic one for the other small primes. Other lengths are
+  transformed with Bluestein's algorithm, using a power of 2 FFT for the convolution.
+
+  A plan created for real input transforms a signal of even length as a complex signal of half the length, and then
+  separates the transforms of its even and odd samples.
+
+  A plan is immutable once created, so it can be used by several threads at once, each with its own scratch buffer.
+*/
+template <typename T>
+class FFTPlan {
+ public:
+  FFTPlan(size_t length, bool inverse, bool real_input = false);
+
+  size_t Length() const { return length_; }
+  bool IsRealInput() const { return real_input_; }
+
+  // Number of complex elements of the scratch buffer of Transform() and TransformReal().
+  size_t ScratchSize() const { return scratch_size_; }
+
+  // Transforms the Length() complex values of data in place.
+  // Not supported by plans for real input.
+  void Transform(std::complex<T>* data, std::complex<T>* scratch) const;
+
+  // Transforms Length() real values, stored in place of the first Length() / 2 complex values of data, into the
+  // first Length() / 2 + 1 complex values of the transform, the others being their conjugates.
+  // Only supported by plans for real input.
+  void TransformReal(std::complex<T>* data, std::complex<T>* scratch) const;
+
+ private:
+  struct Stage {
+    size_t radix;
+    // length of the sub-transforms, and stride between the elements of each of them
+    size_t length;
+    size_t stride;
+    // offset of the (radix - 1) * (length / radix) twiddle factors of the stage in twiddles_
+    size_t twiddle_offset;
+    // offset of the radix roots of unity of the stage in roots_, for the generic radices
+    size_t roots_offset;
+  };
+
+  void RunStage(const Stage& stage, const std::complex<T>* input, std::complex<T>* output) const;
+  void TransformBluestein(std::complex<T>* data, std::complex<T>* scratch) const;
+
+  size_t length_;
+  bool inverse_;
+  bool real_input_;
+  size_t scratch_size_;
+
+  std::vector<Stage> stages_;
+  std::vector<std::complex<T>> twiddles_;
+  std::vector<std::complex<T>> roots_;
+
+  // Bluestein's algorithm
+  std::unique_ptr<FFTPlan<T>> convolution_plan_;
+  std::vector<std::complex<T>> chirp_;
+  std::vector<std::complex<T>> chirp_filter_;
+
+  // real input
+  std::unique_ptr<FFTPlan<T>> half_length_plan_;
+  std::vector<std::complex<T>> real_twiddles_;
+};
+
+// Caches the FFT plans of a kernel, which usually transforms the same lengths on every run.
+class FFTPlanCache {
+ public:
+  template <typename T>
+  std::shared_ptr<const FFTPlan<T>> GetPlan(size_t length, bool inverse, bool real_input);
+
+ private:
+  // Bound on the number of plans of a type, in case the length changes from run to run.
+  static constexpr size_t kMaxPlans = 16;
+
+  using Key = std::tuple<size_t, bool, bool>;
+
+  std::mutex mutex_;
+  std::map<Key, std::shared_ptr<const FFTPlan<float>>> float_plans_;
+  std::map<Key, std::shared_ptr<const FFTPlan<double>>> double_plans_;
+};
+
+}  // namespace signal
+}  // namespace onnxruntime
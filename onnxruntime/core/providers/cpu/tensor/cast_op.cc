@@ -1,8 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <array>
 #include <cstddef>
 #include <cstdio>
+#include <functional>
 #include <string>
 #include <type_traits>
 
@@ -15,6 +17,8 @@
 #include "core/framework/data_types.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
@@ -22,10 +26,6 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-#include "core/mlas/inc/mlas.h"
-#endif
-
 namespace onnxruntime {
 
 namespace op_kernel_type_control {
@@ -61,6 +61,21 @@ template <typename T>
 using IsOrtFloat8Type = boost::mp11::mp_contains<element_type_lists::AllFloat8, T>;
 #endif
 
+// integer types with an MLAS conversion routine to and from float
+template <typename T>
+using IsMlasConvertibleIntegerType = boost::mp11::mp_contains<TypeList<int8_t, uint8_t, int32_t, int64_t>, T>;
+
+// Runs fn(first, last) over the element range of the tensor, split across the intra-op thread pool.
+// The cost is that of a memory bound element-wise op, so only large tensors are split.
+template <typename SrcType, typename DstType>
+void ParallelCast(const OpKernelContext& context, const TensorShape& shape,
+                  const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), narrow<std::ptrdiff_t>(shape.Size()),
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), 1.0},
+      fn);
+}
+
 // string cast helpers
 // Note: when C++17 is available, use <charconv> functions
 
@@ -181,19 +196,120 @@ struct EigenCastType<BFloat16> {
 // generic tensor X -> Y
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     using SrcEigenCastType = typename EigenCastType<SrcType>::type;
     using DstEigenCastType = typename EigenCastType<DstType>::type;
 
-    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+    const auto* in_data = reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>());
+    auto* out_data = reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>());
+    ParallelCast<SrcType, DstType>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      const auto in_vector = ConstEigenVectorMap<SrcEigenCastType>(in_data + first, last - first);
+      auto out_vector = EigenVectorMap<DstEigenCastType>(out_data + first, last - first);
+      out_vector = in_vector.template cast<DstEigenCastType>();
+    });
+  }
+};
+
+// specializations using the vectorized MLAS conversion routines
+
+// tensor MLFloat16 -> float
+template <>
+struct TensorCaster<MLFloat16, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const auto* in_data = in.Data<MLFloat16>();
+    auto* out_data = out.MutableData<float>();
+    ParallelCast<MLFloat16, float>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertHalfToFloatBuffer(&in_data[first].val, out_data + first, static_cast<size_t>(last - first));
+    });
   }
 };
 
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const auto* in_data = in.Data<float>();
+    auto* out_data = out.MutableData<MLFloat16>();
+    ParallelCast<float, MLFloat16>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertFloatToHalfBuffer(in_data + first, &out_data[first].val, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const auto* in_data = in.Data<BFloat16>();
+    auto* out_data = out.MutableData<float>();
+    ParallelCast<BFloat16, float>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertBFloat16ToFloatBuffer(&in_data[first].val, out_data + first, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+// tensor float -> BFloat16
+template <>
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const auto* in_data = in.Data<float>();
+    auto* out_data = out.MutableData<BFloat16>();
+    ParallelCast<float, BFloat16>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertFloatToBFloat16Buffer(in_data + first, &out_data[first].val, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+// tensor int8/uint8/int32/int64 -> float
+template <typename SrcType>
+struct TensorCaster<SrcType, float, std::enable_if_t<IsMlasConvertibleIntegerType<SrcType>::value>> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const auto* in_data = in.Data<SrcType>();
+    auto* out_data = out.MutableData<float>();
+    ParallelCast<SrcType, float>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertBuffer(in_data + first, out_data + first, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+// tensor float -> int8/uint8/int32/int64
+template <typename DstType>
+struct TensorCaster<float, DstType, std::enable_if_t<IsMlasConvertibleIntegerType<DstType>::value>> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const auto* in_data = in.Data<float>();
+    auto* out_data = out.MutableData<DstType>();
+    ParallelCast<float, DstType>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertBuffer(in_data + first, out_data + first, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+
+// tensor float 8 -> float, looked up in a table of all 256 values
+template <typename SrcType>
+struct TensorCaster<SrcType, float, std::enable_if_t<IsOrtFloat8Type<SrcType>::value>> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    static const std::array<float, 256> table = []() {
+      std::array<float, 256> values{};
+      for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = SrcType(static_cast<uint8_t>(i), SrcType::FromBits()).ToFloat();
+      }
+      return values;
+    }();
+
+    const auto* in_data = in.Data<SrcType>();
+    auto* out_data = out.MutableData<float>();
+    ParallelCast<SrcType, float>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        out_data[i] = table[in_data[i].val];
+      }
+    });
+  }
+};
+
+#endif
+
 // tensor X -> string
 template <typename SrcType>
 struct TensorCaster<SrcType, std::string> {
@@ -225,13 +341,14 @@ struct TensorCaster<std::string, DstType> {
 // tensor X -> float 8
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCasterNoSat {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const auto* in_data = in.Data<SrcType>();
     auto* out_data = out.MutableData<DstType>();
-    for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-      out_data[i] = DstType(static_cast<float>(in_data[i]), false);
-    }
+    ParallelCast<SrcType, DstType>(context, shape, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        out_data[i] = DstType(static_cast<float>(in_data[i]), false);
+      }
+    });
   }
 };
 
@@ -252,20 +369,7 @@ struct TensorCasterNoSat<std::string, DstType> {
 
 #endif
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
-
-// tensor MLFloat16 -> float
-template <>
-struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-  }
-};
+// MLFloat16 -> X goes through the vectorized MLFloat16 -> float conversion
 
 Tensor GetIntermediateMLFloat16ToFloatTensor(
     const OpKernelContext& context, const TensorShape& shape, const Tensor& in) {
@@ -299,7 +403,6 @@ struct TensorCaster<MLFloat16, std::string> {
     CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+
+#include <algorithm>
+
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/parallel_compaction.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -38,17 +42,17 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  // Figure out output shape. The positive conditions are counted per block in parallel, which also gives the output
+  // offset of the first positive condition of each block for the copies below.
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+  ParallelCompaction compaction(thread_pool, onnxruntime::narrow<std::ptrdiff_t>(valid_condition_length));
+  const int64_t positive_condition_count = compaction.Count([condition_data](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    return std::count(condition_data + begin, condition_data + end, true);
+  });
 
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
@@ -68,7 +72,6 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
   if (has_axis_) {
     int64_t axes_left_stride = 1;
@@ -81,42 +84,69 @@ Status Compress::Compute(OpKernelContext* ctx) const {
       axes_right_stride *= input_dimensions[i];
     }
     int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     ORT_ENFORCE(axes_right_stride >= 0 &&
                 static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
     size_t axes_right_stride_bytes = 0;
     if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
                                          &axes_right_stride_bytes))
       return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
+
+    // the indices along the axis that are selected, in order
+    std::vector<int64_t> selected(onnxruntime::narrow<size_t>(positive_condition_count));
+    compaction.Scatter([condition_data, &selected](std::ptrdiff_t begin, std::ptrdiff_t end, int64_t output_offset) {
+      for (std::ptrdiff_t j = begin; j < end; ++j) {
+        if (condition_data[j]) {
+          selected[onnxruntime::narrow<size_t>(output_offset++)] = j;
+        }
+      }
+    });
+
+    // each output row is the slice of a selected index along the axis, for an index of the axes to the left
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, onnxruntime::narrow<std::ptrdiff_t>(axes_left_stride * positive_condition_count),
+        TensorOpCost{static_cast<double>(axes_right_stride_bytes), static_cast<double>(axes_right_stride_bytes), 1.0},
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t row = begin; row < end; ++row) {
+            const int64_t i = row / positive_condition_count;
+            const int64_t j = selected[onnxruntime::narrow<size_t>(row % positive_condition_count)];
+            const int64_t input_offset = i * axes_included_right_stride + j * axes_right_stride;
+            const int64_t output_offset = row * axes_right_stride;
+            if (is_string_type) {
+              std::copy_n(reinterpret_cast<const std::string*>(input_data) + input_offset,
+                          onnxruntime::narrow<size_t>(axes_right_stride),
+                          reinterpret_cast<std::string*>(output_data) + output_offset);
+            } else {
+              memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                     axes_right_stride_bytes);
+            }
+          }
+        });
+  } else {
+    compaction.Scatter([&](std::ptrdiff_t begin, std::ptrdiff_t end, int64_t output_index) {
+      for (std::ptrdiff_t i = begin; i < end;) {
+        if (!condition_data[i]) {
+          ++i;
           continue;
         }
+
+        // copy the run of elements with a positive condition at once
+        std::ptrdiff_t run_end = i + 1;
+        while (run_end < end && condition_data[run_end]) {
+          ++run_end;
+        }
+
         if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
+          std::copy(reinterpret_cast<const std::string*>(input_data) + i,
+                    reinterpret_cast<const std::string*>(input_data) + run_end,
+                    reinterpret_cast<std::string*>(output_data) + output_index);
         } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
+          memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes,
+                 (run_end - i) * element_bytes);
         }
+        output_index += run_end - i;
+        i = run_end;
       }
-    }
-  } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
-    }
+    });
   }
 
   return Status::OK();
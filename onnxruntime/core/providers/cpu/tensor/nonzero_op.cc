@@ -3,10 +3,11 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
-#include <vector>
-#include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+
+#include "core/common/inlined_containers.h"
+#include "core/providers/cpu/tensor/parallel_compaction.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -59,25 +60,50 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
+  const size_t coordinate_size = X_shape.IsScalar() ? 1 : X_shape.NumDimensions();
   const T* data = X->Data<T>();
 
+  // Count the non-zero values of each block of X in parallel, which gives the output shape and the offset of each
+  // block's first non-zero value in it. Then write the coordinates of every block in parallel.
+  ParallelCompaction compaction(context->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(X_shape.Size()));
+  const int64_t num_non_zero_values = compaction.Count([data](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    return std::count_if(data + begin, data + end, [](const T& value) { return value != T{}; });
+  });
+
+  Tensor* const Y = context->Output(0, {static_cast<int64_t>(coordinate_size), num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+
+  int64_t* y_data = Y->MutableData<int64_t>();
+
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    y_data[0] = 0;
+    return Status::OK();
+  }
+
+  // Y is [coordinate_size, num_non_zero_values], i.e. the coordinates are written transposed.
+  compaction.Scatter([&X_shape, data, y_data, coordinate_size, num_non_zero_values](
+                         std::ptrdiff_t begin, std::ptrdiff_t end, int64_t output_offset) {
+    InlinedVector<int64_t> coordinate(coordinate_size);
+    for (size_t idx = coordinate_size, remaining = static_cast<size_t>(begin); idx-- > 0;) {
+      coordinate[idx] = static_cast<int64_t>(remaining % static_cast<size_t>(X_shape[idx]));
+      remaining /= static_cast<size_t>(X_shape[idx]);
     }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
 
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      if (data[i] != T{}) {
+        for (size_t idx = 0; idx < coordinate_size; ++idx) {
+          y_data[idx * num_non_zero_values + output_offset] = coordinate[idx];
+        }
+        ++output_offset;
+      }
+
+      // as we iterate the entries, increment the coordinate for the current entry
+      // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
+      for (size_t idx = coordinate_size; idx-- > 0;) {
         int64_t& cur_coord = coordinate[idx];
         if (cur_coord != X_shape[idx] - 1) {
           ++cur_coord;
@@ -85,33 +111,8 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
         }
         cur_coord = 0;
       }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
 }
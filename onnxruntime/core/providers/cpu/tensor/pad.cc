@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/pad.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -167,44 +170,41 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 using PadsVector = PadBase::PadsVector;
 
-// This is the general padding method to n-dimensionally do edge or reflection padding (based on the inputDelta values)
-template <typename T>
-static void PadAxis(T* output, T* input, ptrdiff_t input_delta, ptrdiff_t input_pitch,
-                    size_t block_size, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    for (size_t i = 0; i < block_size; i++) {
-      *output++ = *input;
-      input += input_delta;
-    }
-    input += input_pitch;
-  }
-}
-
-// These are optimizations of PadAxis. The inner loop is removed since the innermost axis has a blockSize of 1,
-// and inputPitch and inputDelta are just a single value added each iteration.
-template <typename T>
-static void PadInnermostAxis(T* output, T* input, ptrdiff_t input_delta, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    *output++ = *input;
-    input += input_delta;
-  }
-}
+// A run of an output row of the innermost axis. The run is filled with the constant if input_offset is negative,
+// else it is copied from the input row (input_stride of 1), or filled with the single input element at input_offset
+// (input_stride of 0).
+struct PadRun {
+  ptrdiff_t output_offset;
+  ptrdiff_t size;
+  ptrdiff_t input_offset;
+  ptrdiff_t input_stride;
+};
 
-// For constant padding, there is no input, just a size to write the constant to
-template <typename T>
-static void PadAxisConstant(T* output, T constant, size_t size) {
-  if (size == 1) {
-    *output = constant;
-  } else if (size == 2) {
-    *output = constant;
-    *(output + 1) = constant;
-  } else {
-    // This would be faster with SSE instructions.
-    // That would mean to have an implementation for each type (uint8, uint32, uint64).
-    T* end = output + size;
-    for (; output != end;)
-      *output++ = constant;
+// Maps each output index of an axis to the input index it reads from, or -1 if it is constant padding.
+// The padding is applied around the input_extent values starting at input_start, which is how slices are handled.
+static InlinedVector<int64_t> PadAxisIndexMap(Mode mode, int64_t pad_begin, int64_t input_start,
+                                              int64_t input_extent, int64_t output_size) {
+  InlinedVector<int64_t> index_map(onnxruntime::narrow<size_t>(std::max<int64_t>(output_size, 0)));
+  for (int64_t output_index = 0; output_index < output_size; output_index++) {
+    int64_t k = output_index - pad_begin;
+    if (k < 0 || k >= input_extent) {
+      if (mode == Mode::Constant || input_extent <= 0) {
+        k = -1;
+      } else if (mode == Mode::Edge) {
+        k = std::clamp<int64_t>(k, 0, input_extent - 1);
+      } else if (mode == Mode::Reflect) {
+        const int64_t period = 2 * (input_extent - 1);
+        k = period == 0 ? 0 : std::abs(k) % period;
+        if (k >= input_extent) {
+          k = period - k;
+        }
+      } else {
+        k = ((k % input_extent) + input_extent) % input_extent;
+      }
+    }
+    index_map[onnxruntime::narrow<size_t>(output_index)] = k < 0 ? -1 : input_start + k;
   }
+  return index_map;
 }
 
 Status PadBase::HandleDimValueZero(const Mode& mode, const TensorShape& input_shape, TensorShape& output_shape) {
@@ -294,18 +294,6 @@ static void FlattenInnerShape(const TensorShapeVector& input_dims, const PadsVec
   reshaped_dims[inner_axis] = inner_size;
 }
 
-static void ReshapePads(const PadsVector& src_pad, size_t src_dim_count, size_t new_dim_count,
-                        size_t inner_no_pad_size, PadsVector& reshaped_pad) {
-  size_t inner_axis = new_dim_count - 1;
-  std::copy(src_pad.begin(), src_pad.begin() + inner_axis, reshaped_pad.begin());
-  std::copy(src_pad.begin() + src_dim_count, src_pad.begin() + src_dim_count + inner_axis,
-            reshaped_pad.begin() + new_dim_count);
-
-  // Flatten inner axis.
-  reshaped_pad[inner_axis] = src_pad[inner_axis] * inner_no_pad_size;
-  reshaped_pad[inner_axis + new_dim_count] = src_pad[inner_axis + src_dim_count] * inner_no_pad_size;
-}
-
 template <typename T>
 static Status PadImpl(OpKernelContext* ctx,
                       const PadsVector& pads,
@@ -329,28 +317,19 @@ static Status PadImpl(OpKernelContext* ctx,
   TensorShapeVector reshaped_input_dims;
   FlattenInnerShape(output_dims, pads, slices, reshaped_input_dims);
 
-  // Reshape padding
+  // The inner axis is padded in blocks of the flattened inner axes that have no padding.
   size_t new_dims_count = reshaped_input_dims.size();
   size_t inner_axis = new_dims_count - 1;
   size_t inner_no_pad_size = onnxruntime::narrow<size_t>(output_dims[inner_axis] > 0
                                                              ? reshaped_input_dims[inner_axis] / output_dims[inner_axis]
                                                              : 0);
-  PadsVector reshaped_pad(2 * new_dims_count), reshaped_slice(2 * new_dims_count);
-  ReshapePads(pads, data_rank, new_dims_count, inner_no_pad_size, reshaped_pad);
-  ReshapePads(slices, data_rank, new_dims_count, inner_no_pad_size, reshaped_slice);
 
-  TensorShapeVector reshaped_output_dims = reshaped_input_dims;
-  TensorShapeVector input_starts;
-  TensorShapeVector input_extents;
-
-  // Calculate output dimensions, and handle any negative padding
-  input_starts.reserve(new_dims_count);
-  input_extents.reserve(new_dims_count);
+  // Map the output indices of the reshaped axes to the input, in units of inner_no_pad_size for the inner axis.
+  std::vector<InlinedVector<int64_t>> index_maps(new_dims_count);
   for (size_t i = 0; i < new_dims_count; i++) {
-    input_starts.push_back(-1 * reshaped_slice[i]);
-    input_extents.push_back(reshaped_input_dims[i] + reshaped_slice[i] + reshaped_slice[i + new_dims_count]);
-    reshaped_output_dims[i] += reshaped_pad[i] + reshaped_pad[i + new_dims_count] +
-                               reshaped_slice[i] + reshaped_slice[i + new_dims_count];
+    const int64_t input_extent = output_dims[i] + slices[i] + slices[i + data_rank];
+    index_maps[i] = PadAxisIndexMap(mode, pads[i], -slices[i], input_extent,
+                                    input_extent + pads[i] + pads[i + data_rank]);
   }
 
   for (size_t i = 0; i < data_rank; i++) {
@@ -363,194 +342,106 @@ static Status PadImpl(OpKernelContext* ctx,
     return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
   }
 
-  TensorShape input_shape(reshaped_input_dims);
-  SliceIterator<T> input(input_tensor, input_shape, input_starts, input_extents, {});
-
   // output_shape need to keep original.
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
   auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
+  const auto* input = reinterpret_cast<const T*>(input_tensor.DataRaw());
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-  TensorPitches output_pitches(reshaped_output_dims);
-  size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
-
-  // Initial skip, sum up the begin padding on each axis
-  for (size_t i = 0; i < new_dims_count; i++)
-    alignSkip += SafeInt<size_t>(reshaped_pad[i]) * output_pitches[i];
-
-  ExtentAxisCounters input_counters(input_extents);
-
-  switch (mode) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, onnxruntime::narrow<size_t>(prePad));
-          PadAxisConstant(output, value, onnxruntime::narrow<size_t>(postPad));
-          output += postPad;
-          alignSkip = onnxruntime::narrow<size_t>(prePad);
+  // Every output row of the inner axis is made of the same runs of copies and fills, so compute them once.
+  // Adjacent blocks that read adjacent input are merged into a single copy, and adjacent constant blocks into a
+  // single fill.
+  const auto block_size = static_cast<ptrdiff_t>(inner_no_pad_size);
+  InlinedVector<PadRun> runs;
+  for (int64_t input_index : index_maps[inner_axis]) {
+    const ptrdiff_t output_offset = runs.empty() ? 0 : runs.back().output_offset + runs.back().size;
+    const ptrdiff_t input_offset = input_index < 0 ? -1 : static_cast<ptrdiff_t>(input_index) * block_size;
+    if (!runs.empty()) {
+      auto& run = runs.back();
+      if (input_offset < 0 && run.input_offset < 0) {
+        run.size += block_size;
+        continue;
+      }
+      if (input_offset >= 0 && run.input_offset >= 0) {
+        if (run.input_stride == 1 && input_offset == run.input_offset + run.size) {
+          run.size += block_size;
+          continue;
         }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = onnxruntime::narrow<std::ptrdiff_t>(output_pitches[input_counters.Axis()]);
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value, SafeInt<std::ptrdiff_t>(prePad) * inner_pitch);
-          PadAxisConstant(output, value, SafeInt<ptrdiff_t>(postPad) * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * SafeInt<size_t>(prePad);
+        if (block_size == 1 && input_offset == run.input_offset && (run.input_stride == 0 || run.size == 1)) {
+          run.input_stride = 0;
+          run.size += 1;
+          continue;
         }
       }
-      break;
+    }
+    runs.push_back({output_offset, block_size, input_offset, 1});
+  }
 
-    case Mode::Edge:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadAxisConstant(axisStart - prePad, *axisStart, onnxruntime::narrow<size_t>(prePad));
-            PadAxisConstant(output, *(output - 1), onnxruntime::narrow<size_t>(postPad));
-          } else {
-            // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
-            // Also general loop below after handling first pad axis with non-pad axis works fine.
-            PadAxis(axisStart - prePad, axisStart, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis]));
-            PadAxis(output, output - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
-          }
-          output += postPad;
-          alignSkip = onnxruntime::narrow<size_t>(prePad);
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = onnxruntime::narrow<std::ptrdiff_t>(output_pitches[input_counters.Axis()]);
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart, 1, -inner_pitch, inner_pitch, onnxruntime::narrow<size_t>(prePad));
-          PadAxis(output, output - inner_pitch, 1, -inner_pitch, inner_pitch, onnxruntime::narrow<size_t>(postPad));
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * SafeInt<size_t>(prePad);
-        }
+  const ptrdiff_t output_row_size = runs.back().output_offset + runs.back().size;
+  const ptrdiff_t input_row_size = static_cast<ptrdiff_t>(reshaped_input_dims[inner_axis]);
+
+  // The outer axes index whole rows. Fold the input pitches into the outer index maps so that a row's input offset is
+  // the sum of the mapped values.
+  ptrdiff_t row_count = 1;
+  int64_t input_pitch = input_row_size;
+  for (size_t i = inner_axis; i-- > 0;) {
+    for (auto& input_index : index_maps[i]) {
+      if (input_index >= 0) {
+        input_index *= input_pitch;
       }
-      break;
+    }
+    input_pitch *= reshaped_input_dims[i];
+    row_count *= static_cast<ptrdiff_t>(index_maps[i].size());
+  }
 
-    case Mode::Reflect:
-    case Mode::Wrap:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            if (mode == Mode::Reflect) {
-              PadInnermostAxis(axisStart - prePad, axisStart + prePad, -1 /* inputDelta */, onnxruntime::narrow<size_t>(prePad));
-              PadInnermostAxis(output, output - 2, -1 /* inputDelta */, onnxruntime::narrow<size_t>(postPad));
-            } else {
-              PadInnermostAxis(axisStart - prePad, output - prePad, 1 /* inputDelta */, onnxruntime::narrow<size_t>(prePad));
-              PadInnermostAxis(output, axisStart, 1 /* inputDelta */, onnxruntime::narrow<size_t>(postPad));
-            }
+  const TensorOpCost cost{static_cast<double>(input_row_size * sizeof(T)),
+                          static_cast<double>(output_row_size * sizeof(T)),
+                          static_cast<double>(runs.size())};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), row_count, cost,
+      [&index_maps, &runs, inner_axis, output_row_size, input, output, value](ptrdiff_t first, ptrdiff_t last) {
+        // the output index of each outer axis for the first row of the partition
+        InlinedVector<size_t> outer_index(inner_axis);
+        for (size_t i = inner_axis, row = static_cast<size_t>(first); i-- > 0;) {
+          outer_index[i] = row % index_maps[i].size();
+          row /= index_maps[i].size();
+        }
+
+        T* output_row = output + first * output_row_size;
+        for (ptrdiff_t row = first; row < last; row++, output_row += output_row_size) {
+          ptrdiff_t input_row_offset = 0;
+          for (size_t i = 0; i < inner_axis && input_row_offset >= 0; i++) {
+            const int64_t input_offset = index_maps[i][outer_index[i]];
+            input_row_offset = input_offset < 0 ? -1 : input_row_offset + static_cast<ptrdiff_t>(input_offset);
+          }
+
+          if (input_row_offset < 0) {
+            std::fill_n(output_row, output_row_size, value);
           } else {
-            // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
-            if (mode == Mode::Reflect) {
-              PadAxis(
-                  axisStart - prePad,
-                  axisStart + prePad,
-                  1,
-                  -ptrdiff_t(inner_no_pad_size * 2),
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis]));
-              PadAxis(
-                  output,
-                  output - 2 * inner_no_pad_size,
-                  1,
-                  -ptrdiff_t(inner_no_pad_size * 2),
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
-            } else {
-              PadAxis(
-                  axisStart - prePad,
-                  output - pads[inner_axis] * inner_no_pad_size,
-                  1,
-                  0,
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis]));
-              PadAxis(
-                  output,
-                  axisStart,
-                  1,
-                  0,
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
+            const T* input_row = input + input_row_offset;
+            for (const auto& run : runs) {
+              if (run.input_offset < 0) {
+                std::fill_n(output_row + run.output_offset, run.size, value);
+              } else if (run.input_stride == 0) {
+                std::fill_n(output_row + run.output_offset, run.size, input_row[run.input_offset]);
+              } else {
+                memcpy(output_row + run.output_offset, input_row + run.input_offset, run.size * sizeof(T));
+              }
             }
           }
-          output += postPad;
-          alignSkip = onnxruntime::narrow<size_t>(prePad);
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = onnxruntime::narrow<std::ptrdiff_t>(output_pitches[input_counters.Axis()]);
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          if (mode == Mode::Reflect) {
-            PadAxis(
-                axisStart - prePad * inner_pitch,
-                axisStart + prePad * inner_pitch,
-                1,
-                -inner_pitch * 2,
-                inner_pitch,
-                onnxruntime::narrow<size_t>(prePad));
-            PadAxis(
-                output,
-                output - 2 * inner_pitch,
-                1,
-                -inner_pitch * 2,
-                inner_pitch,
-                onnxruntime::narrow<size_t>(postPad));
-          } else {
-            PadAxis(
-                axisStart - prePad * inner_pitch,
-                output - prePad * inner_pitch,
-                1,
-                0,
-                inner_pitch,
-                onnxruntime::narrow<size_t>(prePad));
-            PadAxis(
-                output,
-                axisStart,
-                1,
-                0,
-                inner_pitch,
-                onnxruntime::narrow<size_t>(postPad));
+
+          for (size_t i = inner_axis; i-- > 0;) {
+            if (++outer_index[i] < index_maps[i].size()) {
+              break;
+            }
+            outer_index[i] = 0;
           }
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * SafeInt<size_t>(prePad);
         }
-      }
-      break;
-  }
+      });
 
   return Status::OK();
 }
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Helper for kernels whose output is a data dependent selection of the input, such as NonZero and Compress.
+//
+// The items [0, num_items) are split into blocks, one per unit of parallelism. Count() counts the selected items of
+// every block in parallel, and takes the exclusive prefix sum of the counts as the output offset of each block.
+// Once the caller has allocated the output for the total, Scatter() writes the selected items of every block in
+// parallel. The blocks are in the input order, so the output is too.
+class ParallelCompaction {
+ public:
+  static constexpr std::ptrdiff_t kDefaultMinBlockSize = 16 * 1024;
+
+  // min_block_size is the fewest items worth a block of their own, so that small inputs run on the calling thread.
+  ParallelCompaction(concurrency::ThreadPool* thread_pool, std::ptrdiff_t num_items,
+                     std::ptrdiff_t min_block_size = kDefaultMinBlockSize)
+      : thread_pool_(thread_pool), num_items_(num_items) {
+    const std::ptrdiff_t max_blocks = std::max<std::ptrdiff_t>(num_items / std::max<std::ptrdiff_t>(min_block_size, 1),
+                                                               1);
+    num_blocks_ = std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool), max_blocks);
+    output_offsets_.resize(static_cast<size_t>(num_blocks_) + 1, 0);
+  }
+
+  std::ptrdiff_t NumBlocks() const { return num_blocks_; }
+
+  // count(begin, end) returns the number of selected items in [begin, end).
+  // Returns the total number of selected items.
+  template <typename CountFn>
+  int64_t Count(const CountFn& count) {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, num_blocks_, [this, &count](std::ptrdiff_t block) {
+          output_offsets_[static_cast<size_t>(block) + 1] = static_cast<int64_t>(count(BlockBegin(block),
+                                                                                       BlockBegin(block + 1)));
+        });
+
+    std::partial_sum(output_offsets_.begin(), output_offsets_.end(), output_offsets_.begin());
+    return output_offsets_.back();
+  }
+
+  // scatter(begin, end, output_offset) writes the selected items in [begin, end), the first of them to output_offset.
+  template <typename ScatterFn>
+  void Scatter(const ScatterFn& scatter) const {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, num_blocks_, [this, &scatter](std::ptrdiff_t block) {
+          scatter(BlockBegin(block), BlockBegin(block + 1), output_offsets_[static_cast<size_t>(block)]);
+        });
+  }
+
+ private:
+  std::ptrdiff_t BlockBegin(std::ptrdiff_t block) const {
+    return static_cast<std::ptrdiff_t>(static_cast<int64_t>(num_items_) * block / num_blocks_);
+  }
+
+  concurrency::ThreadPool* thread_pool_;
+  std::ptrdiff_t num_items_;
+  std::ptrdiff_t num_blocks_;
+  std::vector<int64_t> output_offsets_;
+};
+
+// Sorts [first, last) by sorting blocks of it in parallel and then merging pairs of sorted runs in parallel.
+// Like std::sort, the order of equivalent elements is unspecified.
+template <typename RandomIt, typename Compare>
+void ParallelSort(concurrency::ThreadPool* thread_pool, RandomIt first, RandomIt last, const Compare& comp,
+                  std::ptrdiff_t min_block_size = 4 * 1024) {
+  const std::ptrdiff_t num_items = last - first;
+  const std::ptrdiff_t num_blocks = std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool),
+                                                             num_items / std::max<std::ptrdiff_t>(min_block_size, 1));
+  if (num_blocks <= 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  auto block_begin = [first, num_items, num_blocks](std::ptrdiff_t block) {
+    block = std::min(block, num_blocks);
+    return first + static_cast<std::ptrdiff_t>(static_cast<int64_t>(num_items) * block / num_blocks);
+  };
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_blocks, [&](std::ptrdiff_t block) {
+    std::sort(block_begin(block), block_begin(block + 1), comp);
+  });
+
+  for (std::ptrdiff_t width = 1; width < num_blocks; width *= 2) {
+    const std::ptrdiff_t num_merges = (num_blocks + 2 * width - 1) / (2 * width);
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_merges, [&](std::ptrdiff_t merge) {
+      const std::ptrdiff_t begin = merge * 2 * width;
+      std::inplace_merge(block_begin(begin), block_begin(begin + width), block_begin(begin + 2 * width), comp);
+    });
+  }
+}
+
+}  // namespace onnxruntime
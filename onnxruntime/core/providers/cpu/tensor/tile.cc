@@ -1,20 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// there's no way to use a raw pointer as the copy destination with std::copy_n
-// (which gsl::copy uses with span::data() which returns a raw pointer) with the 14.11 toolset
-// without generating a 4996 warning. going through an iterator is way too much overhead so turn off the warning.
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-
 #include "core/providers/cpu/tensor/tile.h"
-#include "core/providers/cpu/tensor/utils.h"
 
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
+#include "core/framework/copy.h"
+#include "core/framework/element_type_lists.h"
 
 using namespace ::onnxruntime::common;
 
@@ -57,88 +47,6 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
-  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
-
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
-
-  while (input_counters) {
-    // Copy the input data over
-    block_size = SafeInt<size_t>(innermost_dim) * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
-    }
-
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = onnxruntime::narrow<size_t>(output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()]);
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
-    }
-  }
-  return Status::OK();
-}
-
-Status TileCoreForStringType(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = input_tensor.Data<std::string>();
-  auto* output = output_tensor.MutableData<std::string>();
-
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const std::string* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
-
-  while (input_counters) {
-    // Copy the input data over
-    block_size = SafeInt<size_t>(innermost_dim);
-    output = std::copy(input, input + block_size, output);
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      output = std::copy(copy, copy + block_size, output);
-    }
-
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      block_size = onnxruntime::narrow<size_t>(output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()]);
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        output = std::copy(copy, copy + block_size, output);
-      }
-    }
-  }
-  return Status::OK();
-}
-
 namespace TileOp {
 // Find the first non-1 repeat and check the input shape to the left of that dimension:
 // 1) If the dim values to the left are all 1s (or don't exist), then the tiling logic is essentially copying the input buffer
@@ -209,98 +117,29 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  // Repeat tensor has all 1s in it
-  if (output_shape == input_shape) {
-    if (input_tensor.IsDataType<std::string>())
-      std::copy(input_tensor.Data<std::string>(), input_tensor.Data<std::string>() + input_shape.Size(), output_tensor.MutableData<std::string>());
-    else
-      memcpy(output_tensor.MutableDataRaw(), input_tensor.DataRaw(), input_tensor.SizeInBytes());
-    return Status::OK();
+  // The output is the input broadcast to the shape [repeats[0], dims[0], repeats[1], dims[1], ...], with the
+  // repeat dimensions having an input stride of 0. The strided copy coalesces that down to memcpy or fill runs over the
+  // longest contiguous spans, e.g. a single copy of the whole input per repeat when only the outer dims are repeated.
+  TensorShapeVector copy_dims(2 * input_rank);
+  TensorShapeVector input_strides(2 * input_rank);
+  TensorShapeVector output_strides(2 * input_rank);
+  int64_t input_pitch = 1;
+  int64_t output_pitch = 1;
+  for (size_t axis = input_rank; axis-- > 0;) {
+    copy_dims[2 * axis + 1] = input_shape[axis];
+    input_strides[2 * axis + 1] = input_pitch;
+    output_strides[2 * axis + 1] = output_pitch;
+    input_pitch *= input_shape[axis];
+    output_pitch *= input_shape[axis];
+
+    copy_dims[2 * axis] = repeats[axis];
+    input_strides[2 * axis] = 0;
+    output_strides[2 * axis] = output_pitch;
+    output_pitch *= repeats[axis];
   }
 
-  bool is_batched_memcpy = false;
-  size_t num_of_elements_per_batch = 1;
-  size_t num_of_copies_per_batch = 1;
-  size_t num_of_batch_copies = 1;
-  if (TileOp::IsTileMemcpy(input_shape,
-                           repeats,
-                           input_rank,
-                           is_batched_memcpy,
-                           num_of_elements_per_batch,
-                           num_of_copies_per_batch,
-                           num_of_batch_copies) &&
-      !input_tensor.IsDataType<std::string>()) {
-    int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-    const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
-
-    if (!is_batched_memcpy) {
-      size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
-    } else {
-      size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
-      size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
-
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
-
-      // Now account for batch dim repeat
-      if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-        copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
-      }
-    }
-
-    return Status::OK();
-  }
-
-  TensorAxisCounters input_counters(input_tensor);
-  TensorPitches output_pitches(output_tensor);
-
-  static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
-  static_assert(sizeof(double) == sizeof(int64_t), "Double and Int64 are of different sizes");
-
-  if (input_tensor.IsDataType<std::string>())
-    return TileCoreForStringType(input_tensor, output_tensor, repeats, input_counters, output_pitches);
-
-  if (input_tensor.IsDataType<float>() ||
-      input_tensor.IsDataType<int32_t>() ||
-      input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
-
-  if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
-      input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
-
-  else if (input_tensor.IsDataType<int8_t>() ||
-           input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
-
-  if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
-
-  else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
-
-  // TODO: Support 'string' and 'float16' types for completeness
-  else
-    ORT_THROW("Tile doesn't have an implementation yet for the type: ", input_tensor.DataType());
+  return DispatchStridedCopy<element_type_lists::All>(ctx->GetOperatorThreadPool(),
+                                                      output_tensor, 0, output_strides, TensorShape(copy_dims),
+                                                      input_tensor, 0, input_strides);
 }
 }  // namespace onnxruntime
@@ -338,7 +338,7 @@ bool IsTransposeReshape(const gsl::span<const size_t>& perm, gsl::span<const int
 
 //`input_shape_override` overrides the shape of `input` for compute purposes.
 Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                  const TensorShape* input_shape_override) {
+                                  const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -356,11 +356,8 @@ Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, c
       return Status::OK();
     }
 
-    size_t from = 0, to = 0;
-    bool moving_single_axis = IsTransposeMovingSingleAxis(permutations, from, to);
-
-    if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to, input_shape_override);
+    if (!input.IsDataTypeString()) {
+      GeneralTranspose(permutations, input, output, input_shape_override, tp);
     } else {
       // fall back to default implementation
       status = DoUntypedTranspose(permutations, input, output, input_shape_override);
@@ -391,24 +388,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  if (IsTransposeReshape(*p_perm, input_dims)) {
-    // As long as the dims with values > 1 stay in the same order, it's a reshape.
-    // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
-    CopyCpuTensor(&X, &Y);
-    return Status::OK();
-  }
-
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsTransposeMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to, nullptr, ctx->GetOperatorThreadPool());
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
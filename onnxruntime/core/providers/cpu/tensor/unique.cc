@@ -2,11 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
-#include <map>
-#include <core/common/safeint.h>
-#include "core/common/gsl.h"
+
+#include <algorithm>
+
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/unique_items.h"
 #include "core/providers/op_kernel_type_control.h"
 
 namespace onnxruntime {
@@ -107,271 +108,109 @@ Status Unique::Compute(OpKernelContext* context) const {
   return status;
 }
 
-// class to represent a subtensor along a given axis for a single entry on that axis
 template <typename T>
-class Subtensor {
- public:
-  // Create Subtensor for entry 'idx' on axis 'axis'
-  // n_axis is the number of entries for 'axis' is the original data.
-  //   e.g. if original shape was [4, 2] and axis is 1, n_axis == 2.
-  // subtensor_shape is the shape for the subtensor. the dimension value for the 'axis' dimension in it will be 1.
-  Subtensor(const gsl::span<const T>& data, const TensorShape& subtensor_shape,
-            int64_t axis, int64_t n_axis, int64_t idx) {
-    // rows and columns for the slice along axis, flattened to 2D by merging the dimensions before and after the axis
-    int64_t columns = subtensor_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis));
-    int64_t rows = subtensor_shape.SizeToDimension(onnxruntime::narrow<size_t>(axis));
-    items_.reserve(SafeInt<size_t>(rows) * columns);
-    size_t cur_data = SafeInt<size_t>(idx) * columns;  // offset into data for first row of slice
-
-    for (int r = 0; r < rows; ++r) {
-      for (int c = 0; c < columns; ++c) {
-        // TODO: could copy blocks instead of individual items for non std::string types
-        items_.push_back(data[cur_data + c]);
-      }
-
-      cur_data += SafeInt<size_t>(columns) * n_axis;
-    }
-  }
-
-  bool operator<(const Subtensor& rhs) const {
-    return items_ < rhs.items_;
+Status Unique::ComputeImpl(OpKernelContext& context) const {
+  if (!utils::HasType<EnabledUniqueDataTypes, T>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Data type is not supported in this build.");
   }
 
-  const std::vector<T>& GetItems() const { return items_; }
-
- private:
-  // TODO: Simple copy for now. std::string would be better as std::reference_wrapper<std::string>
-  std::vector<T> items_;
-};
-
-template <typename T>
-static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
-                                  bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
-  Tensor& Y = *context.Output(0, {num_unique});
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
-
-  auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
-
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
-
-    Y_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->first;
-
-    if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
-    }
-
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
-    }
+  const Tensor& input = *context.Input<Tensor>(0);
+  const T* data = input.Data<T>();
+  concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
+
+  // The items to find the unique ones of are the elements of the flattened input, or else the slices of the input
+  // along the axis. A slice is viewed as num_rows rows of num_cols contiguous elements, with num_axis * num_cols
+  // elements between the rows, and slice i starting at element i * num_cols.
+  const auto& input_shape = input.Shape();
+  int64_t axis = 0;
+  int64_t num_rows = 1;
+  int64_t num_cols = 1;
+  int64_t num_axis = input_shape.Size();
+  if (!flatten_) {
+    axis = HandleNegativeAxis(axis_, static_cast<int64_t>(input_shape.NumDimensions()));
+    num_rows = input_shape.SizeToDimension(onnxruntime::narrow<size_t>(axis));
+    num_cols = input_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis) + 1);
+    num_axis = input_shape[onnxruntime::narrow<size_t>(axis)];
   }
 
-  if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
+  const int64_t row_pitch = num_axis * num_cols;
+  auto hash = [data, num_rows, num_cols, row_pitch](int64_t i) {
+    size_t hash_value = 0;
+    for (int64_t r = 0; r < num_rows; ++r) {
+      const T* row = data + r * row_pitch + i * num_cols;
+      for (int64_t c = 0; c < num_cols; ++c) {
+        hash_value ^= UniqueHashValue(row[c]) + 0x9e3779b9 + (hash_value << 6) + (hash_value >> 2);
       }
-
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[onnxruntime::narrow<size_t>(i)] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
+    }
+    return hash_value;
+  };
+  auto equal = [data, num_rows, num_cols, row_pitch](int64_t i, int64_t j) {
+    for (int64_t r = 0; r < num_rows; ++r) {
+      if (!std::equal(data + r * row_pitch + i * num_cols, data + r * row_pitch + (i + 1) * num_cols,
+                      data + r * row_pitch + j * num_cols)) {
+        return false;
       }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
+    }
+    return true;
+  };
+  // lexicographic order of the slices, row by row
+  auto less = [data, num_rows, num_cols, row_pitch](int64_t i, int64_t j) {
+    for (int64_t r = 0; r < num_rows; ++r) {
+      const T* lhs = data + r * row_pitch + i * num_cols;
+      const T* rhs = data + r * row_pitch + j * num_cols;
+      for (int64_t c = 0; c < num_cols; ++c) {
+        if (UniqueValueLess(lhs[c], rhs[c])) {
+          return true;
+        }
+        if (UniqueValueLess(rhs[c], lhs[c])) {
+          return false;
+        }
       }
     }
-  }
-}
+    return false;
+  };
 
-template <typename T>
-static void CreateOutput(OpKernelContext& context,
-                         const TensorShape& subtensor_shape,
-                         int64_t axis,
-                         const std::map<const Subtensor<T>, int64_t>& offsets,  // map sorted key to unsorted idx
-                         const std::vector<std::vector<int64_t>>& indices,      // unsorted
-                         const std::vector<int64_t>& inverse_index,             // unsorted
-                         bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
-
-  // rows and columns for the slice along axis, flattened to 2D by merging the dimensions before and after the axis
-  int64_t num_cols = subtensor_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis));
-  int64_t num_rows = subtensor_shape.SizeToDimension(onnxruntime::narrow<size_t>(axis));
+  const UniqueItems unique = FindUniqueItems(thread_pool, num_axis, hash, equal, less, sort_);
+  const auto num_unique = static_cast<int64_t>(unique.first_indices.size());
 
-  auto subtensor_dims = subtensor_shape.GetDims();
-  std::vector<int64_t> Y_dims;
-  Y_dims.reserve(subtensor_dims.size());
-  for (int64_t i = 0, end = subtensor_dims.size(); i < end; ++i) {
-    if (i == axis)
-      Y_dims.push_back(num_unique);
-    else
-      Y_dims.push_back(subtensor_dims[onnxruntime::narrow<size_t>(i)]);
+  TensorShape Y_shape({num_unique});
+  if (!flatten_) {
+    Y_shape = input_shape;
+    Y_shape[onnxruntime::narrow<size_t>(axis)] = num_unique;
   }
 
-  Tensor& Y = *context.Output(0, TensorShape(std::move(Y_dims)));
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
+  Tensor& Y = *context.Output(0, Y_shape);
+  Tensor* indices = context.Output(1, {num_unique});
+  Tensor* inverse_indices = context.Output(2, {num_axis});
   Tensor* counts = context.Output(3, {num_unique});
 
-  auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
-
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = (sorted ? i : unsorted_idx);
-
-    const auto& items = offsets_iter->first.GetItems();
-    auto item = items.cbegin();
-    assert(static_cast<int64_t>(items.size()) == num_rows * num_cols);
-
-    int64_t out_offset = output_idx * num_cols;
-
-    for (int64_t row = 0; row < num_rows; ++row) {
-      // copy num_cols items from entries to output
-      if (std::is_same<T, std::string>::value) {
-        std::copy(item, item + onnxruntime::narrow<size_t>(num_cols), &Y_data[onnxruntime::narrow<size_t>(out_offset)]);
-      } else {
-        std::copy_n(item, onnxruntime::narrow<size_t>(num_cols), &Y_data[onnxruntime::narrow<size_t>(out_offset)]);
-      }
-
-      item += onnxruntime::narrow<size_t>(num_cols);
-      out_offset += num_unique * num_cols;
-    }
-
-    assert(item == items.cend());
-
-    if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
-    }
-
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
-    }
+  // copy the first occurrence of each unique item to its output position
+  T* Y_data = Y.MutableData<T>();
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_unique),
+      TensorOpCost{static_cast<double>(num_rows * num_cols * sizeof(T)),
+                   static_cast<double>(num_rows * num_cols * sizeof(T)),
+                   static_cast<double>(num_rows)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i < end; ++i) {
+          const int64_t first_index = unique.first_indices[i];
+          for (int64_t r = 0; r < num_rows; ++r) {
+            std::copy_n(data + r * row_pitch + first_index * num_cols, onnxruntime::narrow<size_t>(num_cols),
+                        Y_data + (r * num_unique + i) * num_cols);
+          }
+        }
+      });
+
+  if (indices) {
+    std::copy(unique.first_indices.begin(), unique.first_indices.end(), indices->MutableData<int64_t>());
   }
 
   if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
-
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
-    }
+    std::copy(unique.inverse_indices.begin(), unique.inverse_indices.end(), inverse_indices->MutableData<int64_t>());
   }
-}
-
-template <typename T>
-Status Unique::ComputeImpl(OpKernelContext& context) const {
-  if (!utils::HasType<EnabledUniqueDataTypes, T>()) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Data type is not supported in this build.");
-  }
-
-  const Tensor& input = *context.Input<Tensor>(0);
-  auto data = input.DataAsSpan<T>();
-
-  if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[onnxruntime::narrow<size_t>(i)]);
-      if (entry == offsets.end()) {
-        offsets[data[onnxruntime::narrow<size_t>(i)]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
-
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
-  } else {
-    const auto& input_shape = input.Shape();
-    const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
-    const int64_t axis = HandleNegativeAxis(axis_, input_dims);
-
-    std::vector<int64_t> subtensor_dims;
-    subtensor_dims.reserve(onnxruntime::narrow<size_t>(input_dims));
-    for (int64_t i = 0; i < input_dims; ++i) {
-      subtensor_dims.push_back(i == axis ? 1 : input_shape[onnxruntime::narrow<size_t>(i)]);
-    }
-
-    TensorShape subtensor_shape(std::move(subtensor_dims));
-
-    std::map<const Subtensor<T>, int64_t> offsets;
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-    int64_t n_axis = input_shape[onnxruntime::narrow<size_t>(axis)];
-
-    for (int64_t i = 0; i < n_axis; ++i) {
-      Subtensor<T> s(data, subtensor_shape, axis, n_axis, i);
-
-      auto entry = offsets.find(s);
-      if (entry == offsets.end()) {
-        offsets[std::move(s)] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
 
-    CreateOutput(context, subtensor_shape, axis, offsets, indices, inverse_index, sort_);
+  if (counts) {
+    std::copy(unique.counts.begin(), unique.counts.end(), counts->MutableData<int64_t>());
   }
 
   return Status::OK();
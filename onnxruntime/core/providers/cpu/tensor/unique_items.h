@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/parallel_compaction.h"
+
+namespace onnxruntime {
+
+// Hash of a value that is consistent with operator==, i.e. 0.0 and -0.0 hash the same.
+template <typename T>
+size_t UniqueHashValue(const T& value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (value == T{}) {
+      return 0;
+    }
+  }
+  return std::hash<T>{}(value);
+}
+
+// Strict weak ordering for sorting unique values. NaN values, which are all unique, sort after everything else.
+template <typename T>
+bool UniqueValueLess(const T& lhs, const T& rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return lhs < rhs || (std::isnan(rhs) && !std::isnan(lhs));
+  } else {
+    return lhs < rhs;
+  }
+}
+
+struct UniqueItems {
+  // index of the first occurrence of each unique item, in the output order
+  std::vector<int64_t> first_indices;
+  // number of occurrences of each unique item, in the output order
+  std::vector<int64_t> counts;
+  // output position of the unique item for each item
+  std::vector<int64_t> inverse_indices;
+};
+
+// Finalizer of splitmix64, so that every bit of the result depends on every bit of the hash. std::hash is the
+// identity for integers, so the bits of the raw hash of strided keys are far from uniform.
+inline uint64_t MixUniqueHash(uint64_t hash) {
+  hash ^= hash >> 30;
+  hash *= 0xBF58476D1CE4E5B9ull;
+  hash ^= hash >> 27;
+  hash *= 0x94D049BB133111EBull;
+  hash ^= hash >> 31;
+  return hash;
+}
+
+/*
+  Finds the unique items among the items [0, num_items), which are compared through their index with hash(i) and
+  equal(i, j).
+
+  The items are partitioned into shards by hash so that the shards can be deduplicated in parallel, each with its own
+  hash table. The unique items are then put in the output order with ParallelSort: ascending by less(i, j) if sorted
+  is set, else in the order of their first occurrence.
+*/
+template <typename HashFn, typename EqualFn, typename LessFn>
+UniqueItems FindUniqueItems(concurrency::ThreadPool* thread_pool, int64_t num_items,
+                            const HashFn& hash, const EqualFn& equal, const LessFn& less, bool sorted) {
+  const auto n = static_cast<std::ptrdiff_t>(num_items);
+  const std::ptrdiff_t num_blocks = ParallelCompaction(thread_pool, n).NumBlocks();
+  const std::ptrdiff_t num_shards = std::min<std::ptrdiff_t>(num_blocks, std::numeric_limits<uint16_t>::max());
+  const auto block_begin = [n, num_blocks](std::ptrdiff_t block) {
+    return static_cast<std::ptrdiff_t>(static_cast<int64_t>(n) * block / num_blocks);
+  };
+
+  UniqueItems result;
+  result.inverse_indices.resize(static_cast<size_t>(n));
+
+  // The shard of an item comes from the low bits of its mixed hash, and its hash table slot from the high ones.
+  std::vector<uint64_t> hashes(static_cast<size_t>(n));
+  std::vector<uint16_t> shards(static_cast<size_t>(n));
+  std::vector<std::ptrdiff_t> block_shard_offsets(static_cast<size_t>(num_blocks * num_shards), 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_blocks, [&](std::ptrdiff_t block) {
+    std::ptrdiff_t* shard_counts = block_shard_offsets.data() + block * num_shards;
+    for (std::ptrdiff_t i = block_begin(block), end = block_begin(block + 1); i < end; ++i) {
+      const uint64_t mixed = MixUniqueHash(static_cast<uint64_t>(hash(i)));
+      const auto shard = static_cast<uint16_t>((mixed & 0xFFFFFFFFull) % static_cast<uint64_t>(num_shards));
+      hashes[i] = mixed;
+      shards[i] = shard;
+      ++shard_counts[shard];
+    }
+  });
+
+  // Partition the items by shard, keeping them in order within each shard so that each unique item is represented
+  // by its first occurrence.
+  std::vector<std::ptrdiff_t> shard_begin(static_cast<size_t>(num_shards) + 1, 0);
+  std::ptrdiff_t offset = 0;
+  for (std::ptrdiff_t shard = 0; shard < num_shards; ++shard) {
+    shard_begin[shard] = offset;
+    for (std::ptrdiff_t block = 0; block < num_blocks; ++block) {
+      auto& block_offset = block_shard_offsets[block * num_shards + shard];
+      const std::ptrdiff_t count = block_offset;
+      block_offset = offset;
+      offset += count;
+    }
+  }
+  shard_begin[num_shards] = offset;
+
+  std::vector<std::ptrdiff_t> shard_items(static_cast<size_t>(n));
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_blocks, [&](std::ptrdiff_t block) {
+    std::ptrdiff_t* shard_offsets = block_shard_offsets.data() + block * num_shards;
+    for (std::ptrdiff_t i = block_begin(block), end = block_begin(block + 1); i < end; ++i) {
+      shard_items[shard_offsets[shards[i]]++] = i;
+    }
+  });
+
+  // Deduplicate every shard with an open addressing table of the shard's unique items. The shard local id of each
+  // item's unique item is stored in inverse_indices for now.
+  struct Shard {
+    std::vector<int64_t> first_indices;
+    std::vector<int64_t> counts;
+  };
+  std::vector<Shard> shard_results(static_cast<size_t>(num_shards));
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_shards, [&](std::ptrdiff_t shard) {
+    auto& unique = shard_results[shard];
+    unsigned table_bits = 10;
+    std::vector<int64_t> table(size_t{1} << table_bits, -1);
+    const auto slot_of = [&table_bits](uint64_t mixed) { return static_cast<size_t>(mixed >> (64 - table_bits)); };
+
+    for (std::ptrdiff_t item = shard_begin[shard]; item < shard_begin[shard + 1]; ++item) {
+      const std::ptrdiff_t i = shard_items[item];
+      const size_t mask = table.size() - 1;
+      size_t slot = slot_of(hashes[i]);
+      int64_t id;
+      for (;;) {
+        id = table[slot];
+        if (id < 0) {
+          break;
+        }
+        const int64_t first_index = unique.first_indices[static_cast<size_t>(id)];
+        if (hashes[first_index] == hashes[i] && equal(first_index, i)) {
+          break;
+        }
+        slot = (slot + 1) & mask;
+      }
+
+      if (id >= 0) {
+        ++unique.counts[static_cast<size_t>(id)];
+      } else {
+        id = static_cast<int64_t>(unique.first_indices.size());
+        unique.first_indices.push_back(i);
+        unique.counts.push_back(1);
+        table[slot] = id;
+
+        // keep the load factor at most 1/2
+        if (2 * unique.first_indices.size() > table.size()) {
+          ++table_bits;
+          table.assign(size_t{1} << table_bits, -1);
+          const size_t rehash_mask = table.size() - 1;
+          for (int64_t rehash_id = 0; rehash_id <= id; ++rehash_id) {
+            size_t rehash_slot = slot_of(hashes[unique.first_indices[rehash_id]]);
+            while (table[rehash_slot] >= 0) {
+              rehash_slot = (rehash_slot + 1) & rehash_mask;
+            }
+            table[rehash_slot] = rehash_id;
+          }
+        }
+      }
+
+      result.inverse_indices[i] = id;
+    }
+  });
+
+  // Number the unique items of all shards consecutively, then find the output position of each.
+  std::vector<int64_t> shard_offsets(static_cast<size_t>(num_shards) + 1, 0);
+  for (std::ptrdiff_t shard = 0; shard < num_shards; ++shard) {
+    shard_offsets[shard + 1] = shard_offsets[shard] + static_cast<int64_t>(shard_results[shard].first_indices.size());
+  }
+  const int64_t num_unique = shard_offsets.back();
+
+  std::vector<int64_t> first_indices;
+  std::vector<int64_t> counts;
+  first_indices.reserve(static_cast<size_t>(num_unique));
+  counts.reserve(static_cast<size_t>(num_unique));
+  for (auto& shard : shard_results) {
+    first_indices.insert(first_indices.end(), shard.first_indices.begin(), shard.first_indices.end());
+    counts.insert(counts.end(), shard.counts.begin(), shard.counts.end());
+  }
+
+  // Ties are broken by the first occurrence so the order is deterministic.
+  std::vector<int64_t> order(static_cast<size_t>(num_unique));
+  std::iota(order.begin(), order.end(), int64_t{0});
+  if (sorted) {
+    ParallelSort(thread_pool, order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      const int64_t lhs_index = first_indices[lhs];
+      const int64_t rhs_index = first_indices[rhs];
+      if (less(lhs_index, rhs_index)) {
+        return true;
+      }
+      if (less(rhs_index, lhs_index)) {
+        return false;
+      }
+      return lhs_index < rhs_index;
+    });
+  } else {
+    ParallelSort(thread_pool, order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      return first_indices[lhs] < first_indices[rhs];
+    });
+  }
+
+  std::vector<int64_t> output_positions(static_cast<size_t>(num_unique));
+  result.first_indices.resize(static_cast<size_t>(num_unique));
+  result.counts.resize(static_cast<size_t>(num_unique));
+  for (int64_t position = 0; position < num_unique; ++position) {
+    const int64_t id = order[position];
+    output_positions[id] = position;
+    result.first_indices[position] = first_indices[id];
+    result.counts[position] = counts[id];
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, n, TensorOpCost{18.0, 8.0, 2.0}, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i < end; ++i) {
+          const int64_t id = shard_offsets[shards[i]] + result.inverse_indices[i];
+          result.inverse_indices[i] = output_positions[id];
+        }
+      });
+
+  return result;
+}
+
+}  // namespace onnxruntime
@@ -4,9 +4,9 @@
 #include "core/providers/cpu/tensor/where_op.h"
 
 #include <algorithm>
-#include <type_traits>
+#include <array>
 
-#include "core/providers/cpu/math/element_wise_ops.h"  // for broadcast utilities
+#include "core/framework/copy.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -61,219 +61,107 @@ WHERE_TYPED_KERNEL_WITH_TYPE_NAME(std::string, string)
 
 namespace {
 
-template <typename T, typename R>
-using EnableIfEigenScalar = typename std::enable_if<std::is_arithmetic<T>::value, R>::type;
-
-template <typename T, typename R>
-using EnableIfEigenNotScalar = typename std::enable_if<!std::is_arithmetic<T>::value, R>::type;
-
-template <typename T>
-ProcessBroadcastSpanFuncs CreateScalarBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        bool condition = per_iter_bh.ScalarInput0<bool>();
-        auto value = per_iter_bh.EigenInput1<T>();
-        auto output = per_iter_bh.OutputEigen<T>();
-        if (condition == target) {
-          output = value;
-        } else {
-          output = EigenVectorMap<T>::PlainObject::Constant(value.size(), T{});
-        }
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.EigenInput0<bool>();
-        const T& value = per_iter_bh.ScalarInput1<T>();
-        auto output = per_iter_bh.OutputEigen<T>();
-        output = (condition.array() == target)
-                     .select(value, EigenVectorMap<T>::PlainObject::Constant(condition.size(), T{}));
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.EigenInput0<bool>();
-        auto value = per_iter_bh.EigenInput1<T>();
-        auto output = per_iter_bh.OutputEigen<T>();
-        output = (condition.array() == target)
-                     .select(value, EigenVectorMap<T>::PlainObject::Constant(condition.size(), T{}));
-      }};
-}
-
-template <typename T>
-ProcessBroadcastSpanFuncs CreateNonScalarBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        bool condition = per_iter_bh.ScalarInput0<bool>();
-        auto value = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        if (condition == target) {
-          std::copy(value.begin(), value.end(), output.begin());
-        } else {
-          std::fill(output.begin(), output.end(), T{});
-        }
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.SpanInput0<bool>();
-        const T& value = per_iter_bh.ScalarInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        std::transform(condition.begin(), condition.end(), output.begin(),
-                       [target, &value](bool condition_element) {
-                         return condition_element == target ? value : T{};
-                       });
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.SpanInput0<bool>();
-        auto value = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        std::transform(condition.begin(), condition.end(), value.begin(), output.begin(),
-                       [target](bool condition_element, const T& value_element) {
-                         return condition_element == target ? value_element : T{};
-                       });
-      }};
-}
-
-template <typename T>
-EnableIfEigenScalar<T, ProcessBroadcastSpanFuncs> SelectBroadcastFuncs() {
-  // NOTE: Workaround a VS2017 bug by calling a separate function to create the broadcast funcs.
-  // If we create them directly here it doesn't bring in the definitions of the Eigen classes leading to
-  // a 'class has no constructors' error
-  return CreateScalarBroadcastFuncs<T>();
-}
+// Computes the output shape of broadcasting the inputs together, and the strides of the output and of each input over
+// that shape. Inputs have a stride of 0 along the dimensions they are broadcast over.
+template <size_t N>
+Status ComputeBroadcastStrides(const std::array<const Tensor*, N>& inputs,
+                               TensorShapeVector& output_dims,
+                               std::array<TensorShapeVector, N + 1>& strides) {
+  size_t rank = 0;
+  for (const auto* input : inputs) {
+    rank = std::max(rank, input->Shape().NumDimensions());
+  }
 
-template <typename T>
-EnableIfEigenNotScalar<T, ProcessBroadcastSpanFuncs> SelectBroadcastFuncs() {
-  return CreateNonScalarBroadcastFuncs<T>();
-}
+  output_dims.assign(rank, 1);
+  for (const auto* input : inputs) {
+    const auto dims = input->Shape().GetDims();
+    const size_t offset = rank - dims.size();
+    for (size_t i = 0; i < dims.size(); ++i) {
+      auto& output_dim = output_dims[offset + i];
+      if (dims[i] != 1) {
+        ORT_RETURN_IF_NOT(output_dim == 1 || output_dim == dims[i],
+                          "Where: cannot broadcast input of shape ", input->Shape(), " to dimension ", output_dim,
+                          " of the output.");
+        output_dim = dims[i];
+      }
+    }
+  }
 
-template <typename T>
-void MergeScalarAndVector(EigenVectorMap<T> output, const T& scalar_value, ConstEigenVectorMap<T> vector_value) {
-  if (scalar_value != T{}) {
-    output = EigenVectorMap<T>::PlainObject::Constant(vector_value.size(), scalar_value);
-  } else {
-    output = vector_value;
+  for (size_t i = 0; i <= N; ++i) {
+    strides[i].assign(rank, 0);
+    const auto dims = i == 0 ? gsl::span<const int64_t>(output_dims) : inputs[i - 1]->Shape().GetDims();
+    const size_t offset = rank - dims.size();
+    int64_t pitch = 1;
+    for (size_t axis = dims.size(); axis-- > 0;) {
+      strides[i][offset + axis] = dims[axis] == 1 ? 0 : pitch;
+      pitch *= dims[axis];
+    }
   }
-};
 
-template <typename T>
-EnableIfEigenScalar<T, ProcessBroadcastSpanFuncs> MergeBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputEigen<T>(),
-                             per_iter_bh.ScalarInput0<T>(),  // X selection
-                             per_iter_bh.EigenInput1<T>());  // Y selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputEigen<T>(),
-                             per_iter_bh.ScalarInput1<T>(),  // Y selection
-                             per_iter_bh.EigenInput0<T>());  // X selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        auto X_selection = per_iter_bh.EigenInput0<T>();
-        auto Y_selection = per_iter_bh.EigenInput1<T>();
-        per_iter_bh.OutputEigen<T>() = X_selection.binaryExpr(Y_selection,
-                                                              [](T x, T y) -> T {
-                                                                return x != T{} ? x : y;
-                                                              });
-      }};
+  return Status::OK();
 }
 
+// Selects a span of count elements. strides holds the strides of the output, condition, X and Y in that order.
 template <typename T>
-void MergeScalarAndVector(gsl::span<T> output, const T& scalar_value, gsl::span<const T> vector_value) {
-  if (!scalar_value.empty()) {
-    std::fill(output.begin(), output.end(), scalar_value);
+void SelectSpan(T* output, const bool* condition, const T* X, const T* Y,
+                const std::array<std::ptrdiff_t, 4>& strides, std::ptrdiff_t count) {
+  if (strides[1] == 0) {
+    // the condition is the same for the whole span so it is a copy, or fill, from one of the inputs
+    if (*condition) {
+      strided_copy_detail::Copy1D<T>(output, strides[0], X, strides[2], count);
+    } else {
+      strided_copy_detail::Copy1D<T>(output, strides[0], Y, strides[3], count);
+    }
+  } else if (strides[0] == 1 && strides[1] == 1 && strides[2] == 1 && strides[3] == 1) {
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      output[i] = condition[i] ? X[i] : Y[i];
+    }
   } else {
-    std::copy(vector_value.begin(), vector_value.end(), output.begin());
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      *output = *condition ? *X : *Y;
+      output += strides[0];
+      condition += strides[1];
+      X += strides[2];
+      Y += strides[3];
+    }
   }
-};
-
-template <typename T>
-EnableIfEigenNotScalar<T, ProcessBroadcastSpanFuncs> MergeBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputSpan<T>(),
-                             per_iter_bh.ScalarInput0<T>(),  // X selection
-                             per_iter_bh.SpanInput1<T>());   // Y selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputSpan<T>(),
-                             per_iter_bh.ScalarInput1<T>(),  // Y selection
-                             per_iter_bh.SpanInput0<T>());   // X selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        auto X_selection = per_iter_bh.SpanInput0<T>();
-        auto Y_selection = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        std::transform(X_selection.begin(), X_selection.end(), Y_selection.begin(), output.begin(),
-                       [](const T& x, const T& y) { return !x.empty() ? x : y; });
-      }};
 }
 
-// function pointer to create typed tensor from type agnostic code whilst avoiding the overhead of std::function
-using AllocTensorFunc = std::unique_ptr<Tensor> (*)(const TensorAllocator& allocator, const TensorShape& shape);
-
-static std::unique_ptr<Tensor> UntypedSelect(OpKernelContext& context, bool target,
-                                             const TensorAllocator& allocator, AllocTensorFunc allocate_tensor,
-                                             const ProcessBroadcastSpanFuncs& functors) {
-  const auto& condition = *context.Input<Tensor>(0);
-  // select the X input (input 1) for 'true', and Y input (input 2) for 'false'
-  const auto& values = *context.Input<Tensor>(target ? 1 : 2);
-
-  InputBroadcaster input_broadcaster(condition, values);
-
-  std::unique_ptr<Tensor> selection_tensor = allocate_tensor(allocator, input_broadcaster.GetOutputShape());
-  OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *selection_tensor);
-
-  // store value of 'target' directly in void* for user_data so it's accessible in the state-less functors
-  BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, reinterpret_cast<void*>(target));
-
-  BroadcastLooper(broadcast_helper, functors);
-
-  return selection_tensor;
-}
-
-static void UntypedMerge(OpKernelContext& context,
-                         const Tensor& X_selection_tensor, const Tensor& Y_selection_tensor,
-                         const ProcessBroadcastSpanFuncs& functors) {
-  InputBroadcaster merge_broadcaster{X_selection_tensor, Y_selection_tensor};
-  Tensor& output = *context.Output(0, merge_broadcaster.GetOutputShape());
-
-  OutputBroadcaster output_broadcaster{merge_broadcaster.GetSpanSize(), output};
-  BroadcastHelper broadcast_helper(merge_broadcaster, output_broadcaster);
-
-  BroadcastLooper(broadcast_helper, functors);
-}
 }  // namespace
 
 template <typename T>
 Status Where<T>::Compute(OpKernelContext* context) const {
-  // we use a func pointer to save the overhead of std::function, so we can't capture tensor_allocator here
-  const auto typed_tensor_allocation = [](const TensorAllocator& allocator,
-                                          const TensorShape& shape) {
-    return allocator.Allocate<T>(shape);
-  };
-
-  TensorAllocator tensor_allocator{*context};
-  ProcessBroadcastSpanFuncs funcs = SelectBroadcastFuncs<T>();
-
-  // The current implementation is limited to broadcasting over two tensors at once.
-  // So, we first broadcast over condition and X to select the values from X:
-  //   X_selection = condition ? X : default value
-  // Similarly, we broadcast over condition and Y to select the values from Y:
-  //   Y_selection = !condition ? Y : default value
-  //
-  // These selections are handled within UntypedSelect.
-  //
-  // Finally, we broadcast over and merge X_selection and Y_selection:
-  //   output = (X_selection != default value) ? X_selection : Y_selection
-  //
-  // The merging is handled within UntypedMerge.
-  auto X_selection_tensor = UntypedSelect(*context, true, tensor_allocator, typed_tensor_allocation, funcs);
-  auto Y_selection_tensor = UntypedSelect(*context, false, tensor_allocator, typed_tensor_allocation, funcs);
+  const auto& condition = *context->Input<Tensor>(0);
+  const auto& X = *context->Input<Tensor>(1);
+  const auto& Y = *context->Input<Tensor>(2);
+
+  // Broadcast the three inputs together and select in a single pass over the output. The broadcasting is expressed as
+  // strides, so that dimensions are coalesced into long spans, and a span with a broadcast condition becomes a plain
+  // copy, or fill, from X or Y.
+  TensorShapeVector output_dims;
+  std::array<TensorShapeVector, 4> strides;
+  ORT_RETURN_IF_ERROR(ComputeBroadcastStrides<3>({&condition, &X, &Y}, output_dims, strides));
+
+  const TensorShape output_shape(output_dims);
+  Tensor& output = *context->Output(0, output_shape);
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-  UntypedMerge(*context, *X_selection_tensor, *Y_selection_tensor, MergeBroadcastFuncs<T>());
+  T* output_data = output.MutableData<T>();
+  const bool* condition_data = condition.Data<bool>();
+  const T* X_data = X.Data<T>();
+  const T* Y_data = Y.Data<T>();
+
+  StridedForEachSpan<4>(
+      context->GetOperatorThreadPool(), output_shape, strides,
+      {static_cast<float>(sizeof(bool) + sizeof(T)), static_cast<float>(sizeof(T)), 1.0F},
+      [output_data, condition_data, X_data, Y_data](const std::array<std::ptrdiff_t, 4>& offsets,
+                                                    const std::array<std::ptrdiff_t, 4>& inner_strides,
+                                                    std::ptrdiff_t count) {
+        SelectSpan<T>(output_data + offsets[0], condition_data + offsets[1], X_data + offsets[2],
+                      Y_data + offsets[3], inner_strides, count);
+      });
 
   return Status::OK();
 }
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/tunable.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
+#include "core/providers/cpu/tunable/util.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+// CPU kernels have no native stream, the stream handle is always nullptr.
+using OpParams = OpParams<CpuTuningContext, void*>;
+
+template <typename ParamsT>
+using Op = Op<ParamsT>;
+
+template <typename ParamsT>
+using TunableOp = TunableOp<ParamsT, Timer>;
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
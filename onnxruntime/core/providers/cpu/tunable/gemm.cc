@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/gemm.h"
+
+#include <memory>
+#include <utility>
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+namespace blas {
+
+static const char* TransposeToString(CBLAS_TRANSPOSE trans) {
+  return trans == CblasNoTrans ? "N" : "T";
+}
+
+std::string SgemmParams::Signature() const {
+  // A pre-packed B does not support the same candidates, so it is tuned separately.
+  return MakeString(TransposeToString(trans_a), TransposeToString(trans_b), "_", m, "_", n, "_", k,
+                    "_B", batch, "_T", concurrency::ThreadPool::DegreeOfParallelism(thread_pool),
+                    data[0].BIsPacked ? "_P" : "");
+}
+
+namespace {
+
+bool HasNonZeroBeta(const SgemmParams* params) {
+  for (size_t i = 0; i < params->batch; i++) {
+    if (params->data[i].beta != 0.0f) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Status SgemmDefaultOp(const SgemmParams* params) {
+  MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                params->data, params->batch, params->thread_pool);
+  return Status::OK();
+}
+
+class SgemmTunableOp : public TunableOp<SgemmParams> {
+ public:
+  SgemmTunableOp() {
+    // The kernel id is the index of the registration, and is what tuning results store. Only append candidates, so
+    // that tuning results saved by earlier builds keep referring to the same parameters.
+    this->RegisterOp(SgemmDefaultOp);
+
+    constexpr std::pair<size_t, size_t> strides[] = {{0, 0}, {256, 64}, {64, 256}, {512, 32}};
+    constexpr size_t thread_complexities[] = {0, size_t{16} * 1024, size_t{256} * 1024};
+
+    for (const auto& [stride_n, stride_k] : strides) {
+      for (size_t thread_complexity : thread_complexities) {
+        if (stride_n == 0 && thread_complexity == 0) {
+          continue;  // same as the default op
+        }
+
+        MLAS_SGEMM_TUNING_PARAMS tuning;
+        tuning.StrideN = stride_n;
+        tuning.StrideK = stride_k;
+        tuning.ThreadComplexity = thread_complexity;
+
+        this->RegisterOp([tuning](const SgemmParams* params) -> Status {
+          // The strides do not apply to a pre-packed B, so only the thread complexity is worth tuning then.
+          TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+              tuning.StrideN != 0 && params->data[0].BIsPacked, "strides are not used with a pre-packed B");
+          MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                        params->data, params->batch, params->thread_pool, &tuning);
+          return Status::OK();
+        });
+      }
+    }
+  }
+
+  const SgemmParams* PreTuning(const SgemmParams* params) override {
+    if (HasNonZeroBeta(params)) {
+      // When beta != 0, C is an input as well as the output, so running the candidates repeatedly during tuning
+      // would accumulate into it. Tune over scratch output buffers instead.
+      auto* proxy = new SgemmParams(*params);
+      auto* data = new MLAS_SGEMM_DATA_PARAMS[params->batch];
+      for (size_t i = 0; i < params->batch; i++) {
+        data[i] = params->data[i];
+        data[i].C = new float[params->m * params->data[i].ldc]();
+      }
+      proxy->data = data;
+      return proxy;
+    }
+
+    return params;
+  }
+
+  void PostTuning(const SgemmParams* params) override {
+    if (HasNonZeroBeta(params)) {
+      for (size_t i = 0; i < params->batch; i++) {
+        delete[] params->data[i].C;
+      }
+      delete[] params->data;
+      delete params;
+    }
+  }
+};
+
+}  // namespace
+
+Status Sgemm(CpuTuningContext* tuning_ctx,
+             CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+             size_t m, size_t n, size_t k,
+             const MLAS_SGEMM_DATA_PARAMS* data, size_t batch,
+             concurrency::ThreadPool* thread_pool) {
+  if (tuning_ctx == nullptr || !tuning_ctx->IsTunableOpEnabled() || batch == 0) {
+    MlasGemmBatch(trans_a, trans_b, m, n, k, data, batch, thread_pool);
+    return Status::OK();
+  }
+
+  SgemmParams params;
+  params.tuning_ctx = tuning_ctx;
+  params.trans_a = trans_a;
+  params.trans_b = trans_b;
+  params.m = m;
+  params.n = n;
+  params.k = k;
+  params.data = data;
+  params.batch = batch;
+  params.thread_pool = thread_pool;
+
+  static SgemmTunableOp op;
+  return op(&params);
+}
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+namespace blas {
+
+struct SgemmParams : OpParams {
+  std::string Signature() const override;
+
+  CBLAS_TRANSPOSE trans_a;
+  CBLAS_TRANSPOSE trans_b;
+  size_t m;
+  size_t n;
+  size_t k;
+  const MLAS_SGEMM_DATA_PARAMS* data;
+  size_t batch;
+  concurrency::ThreadPool* thread_pool;
+};
+
+// Batched SGEMM. If TunableOp is enabled for the tuning context, the MLAS blocking and threading parameters are
+// looked up, or tuned, per (transposes, shape, batch, thread count). Otherwise, or if tuning_ctx is nullptr, this is
+// MlasGemmBatch with the built-in heuristics.
+Status Sgemm(CpuTuningContext* tuning_ctx,
+             CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+             size_t m, size_t n, size_t k,
+             const MLAS_SGEMM_DATA_PARAMS* data, size_t batch,
+             concurrency::ThreadPool* thread_pool);
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
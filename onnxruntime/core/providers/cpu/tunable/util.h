@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+
+#include "core/framework/tunable.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+// CPU kernels run synchronously on the calling thread, so wall clock time between Start() and End() is the duration.
+class Timer : public ITimer<void*> {
+ public:
+  using TimerBase = ITimer<void*>;
+
+  explicit Timer(void* stream);
+
+  void Start() override;
+  void End() override;
+  float Duration() override;
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point end_;
+};
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -33,7 +33,8 @@ Status DataCopy(const Tensor& input, Tensor& output, void* einsum_cuda_assets) {
 
 // CUDA EP specific Transpose helper
 Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input,
-                 Tensor& output, const TensorShape* input_shape_override, void* einsum_cuda_assets) {
+                 Tensor& output, const TensorShape* input_shape_override,
+                 concurrency::ThreadPool* /*tp*/, void* einsum_cuda_assets) {
   return cuda::Transpose::DoTranspose(static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetDeviceProp(),
                                       static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->GetCudaStream(),
                                       static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cublas_handle_,
@@ -43,7 +43,8 @@ namespace DeviceHelpers {
 namespace CudaDeviceHelpers {
 
 Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input,
-                 Tensor& output, const TensorShape* input_shape_override, void* einsum_cuda_assets);
+                 Tensor& output, const TensorShape* input_shape_override,
+                 concurrency::ThreadPool* /*tp*/, void* einsum_cuda_assets);
 
 Status DataCopy(const Tensor& input, Tensor& output, void* einsum_cuda_assets);
 
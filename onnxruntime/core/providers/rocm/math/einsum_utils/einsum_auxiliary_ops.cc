@@ -34,7 +34,8 @@ Status DataCopy(const Tensor& input, Tensor& output, void* einsum_rocm_assets) {
 
 // ROCM EP specific Transpose helper
 Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input,
-                 Tensor& output, const TensorShape* input_shape_override, void* einsum_rocm_assets) {
+                 Tensor& output, const TensorShape* input_shape_override,
+                 concurrency::ThreadPool* /*tp*/, void* einsum_rocm_assets) {
   return rocm::Transpose::DoTranspose(static_cast<EinsumRocmAssets*>(einsum_rocm_assets)->rocm_ep_->GetDeviceProp(),
                                       static_cast<EinsumRocmAssets*>(einsum_rocm_assets)->GetRocmStream(),
                                       static_cast<EinsumRocmAssets*>(einsum_rocm_assets)->rocblas_handle_,
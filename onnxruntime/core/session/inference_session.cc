@@ -384,6 +384,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -402,8 +404,22 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
           ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set for intra op thread pool");
         }
 
-        thread_pool_ =
-            concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+        if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1") {
+          numa_thread_pools_ = concurrency::CreateNumaThreadPools(&Env::Default(), to);
+          if (numa_thread_pools_.pools.empty()) {
+            LOGS(*session_logger_, INFO) << "NUMA topology is unknown or has a single node. "
+                                         << "Using a single intra-op thread pool.";
+          } else {
+            LOGS(*session_logger_, INFO) << "Using an intra-op thread pool for each of "
+                                         << numa_thread_pools_.pools.size() << " NUMA nodes.";
+            thread_pool_ = std::move(numa_thread_pools_.pools[0]);
+          }
+        }
+
+        if (numa_thread_pools_.pools.empty()) {
+          thread_pool_ =
+              concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+        }
       }
     }
     if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
@@ -421,6 +437,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.name = inter_thread_pool_name_.c_str();
         to.set_denormal_as_zero = set_denormal_as_zero;
         to.allow_spinning = allow_inter_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigInterOpAdaptiveSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
 
         // Set custom threading functions
@@ -1537,6 +1555,15 @@ common::Status InferenceSession::Initialize() {
         session_options_,
         prepacked_weights_container_);
 
+    if (!numa_thread_pools_.pools.empty()) {
+      InlinedVector<concurrency::ThreadPool*> numa_pools;
+      numa_pools.push_back(thread_pool_.get());
+      for (size_t node = 1; node < numa_thread_pools_.pools.size(); ++node) {
+        numa_pools.push_back(numa_thread_pools_.pools[node].get());
+      }
+      session_state_->SetNumaThreadPools(numa_thread_pools_.node_processors, numa_pools);
+    }
+
     bool use_env_allocators =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
     if (use_env_allocators) {
@@ -1822,6 +1849,26 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    // The CPU EP may be added implicitly, so its TunableOp is configured with session options rather than
+    // provider options.
+    if (auto* cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider); cpu_ep != nullptr) {
+      auto* tuning_ctx = cpu_ep->GetTuningContext();
+      if (tuning_ctx != nullptr) {
+        const auto& config_options = session_options_.config_options;
+        if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpEnable, "0") == "1") {
+          tuning_ctx->EnableTunableOp();
+        }
+        if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpTuningEnable, "0") == "1") {
+          tuning_ctx->EnableTuning();
+        }
+        std::string max_tuning_duration_ms;
+        if (config_options.TryGetConfigEntry(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs,
+                                             max_tuning_duration_ms)) {
+          tuning_ctx->SetMaxTuningDurationMs(ParseStringWithClassicLocale<int>(max_tuning_duration_ms));
+        }
+      }
+    }
+
     std::vector<TuningResults> tuning_results;
     bool found_tuning_results = false;
     ORT_RETURN_IF_ERROR_SESSIONID_(inference_session_utils::ParseTuningResultsFromModelMetadata(
@@ -1829,11 +1876,33 @@ common::Status InferenceSession::Initialize() {
     if (found_tuning_results) {
       ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ true));
     }
+
+    const std::string tuning_results_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsTuningResultsFile, "");
+    if (!tuning_results_file.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(
+          inference_session_utils::ParseTuningResultsFromFile(tuning_results_file, tuning_results));
+      ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ true));
+    }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    if (!numa_thread_pools_.pools.empty()) {
+      const size_t replicate_min_bytes = ParseStringWithClassicLocale<size_t>(
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigNumaReplicateInitializersMinBytes,
+                                                             "1048576"));
+      ORT_RETURN_IF_ERROR_SESSIONID_(session_state_->ReplicateInitializedTensorsPerNumaNode(replicate_min_bytes));
+    }
+
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAggregateProfiling, "0") == "1") {
+      const bool hardware_counters = session_options_.config_options.GetConfigOrDefault(
+                                         kOrtSessionOptionsConfigAggregateProfilingHardwareCounters, "0") == "1";
+      aggregate_profiler_ = std::make_unique<profiling::AggregateProfiler>(hardware_counters);
+      session_state_->SetAggregateProfiler(aggregate_profiler_.get());
+    }
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
@@ -1886,6 +1955,21 @@ common::Status InferenceSession::Initialize() {
     }
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // this runs the model so needs to happen once initialization is complete and the session_mutex_ is released
+  if (status.IsOK()) {
+    const std::string prewarm_shapes_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternPrewarmShapes, "");
+    if (!prewarm_shapes_str.empty()) {
+      std::vector<InlinedHashMap<std::string, TensorShape>> shape_sets;
+      status = inference_session_utils::ParseMemoryPatternPrewarmShapes(prewarm_shapes_str, shape_sets);
+      if (status.IsOK()) {
+        status = PrewarmMemoryPatterns(shape_sets);
+      }
+    }
+  }
+#endif
+
   return status;
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1896,6 +1980,96 @@ int InferenceSession::GetCurrentNumRuns() const {
   return current_num_runs_.load();
 }
 
+common::Status InferenceSession::PrewarmMemoryPatterns(
+    const std::vector<InlinedHashMap<std::string, TensorShape>>& shape_sets) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  if (!session_state_->GetEnableMemoryPattern()) {
+    LOGS(*session_logger_, WARNING) << "Memory pattern is disabled for this session. Skipping memory pattern prewarm.";
+    return Status::OK();
+  }
+
+  const auto inputs = GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs.first);
+  const auto outputs = GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs.first);
+
+  std::vector<std::string> output_names;
+  output_names.reserve(outputs.second->size());
+  for (const auto* output : *outputs.second) {
+    output_names.push_back(output->Name());
+  }
+
+  // feeds are copied to the device of the consuming nodes by Run() so they can always be created on CPU
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  RunOptions run_options;
+  run_options.run_tag = "memory_pattern_prewarm";
+
+  for (const auto& shape_set : shape_sets) {
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    feed_names.reserve(inputs.second->size());
+    feeds.reserve(inputs.second->size());
+    size_t num_shapes_used = 0;
+
+    for (const auto* input : *inputs.second) {
+      TensorShape shape;
+      auto it = shape_set.find(input->Name());
+      if (it != shape_set.end()) {
+        shape = it->second;
+        ++num_shapes_used;
+      } else {
+        const auto* shape_proto = input->Shape();
+        ORT_RETURN_IF(shape_proto == nullptr, "Shape of input '", input->Name(),
+                      "' must be specified for memory pattern prewarm as it is unknown in the model.");
+        for (const auto& dim : shape_proto->dim()) {
+          ORT_RETURN_IF_NOT(utils::HasDimValue(dim), "Shape of input '", input->Name(),
+                            "' must be specified for memory pattern prewarm as it is not fixed in the model.");
+        }
+        shape = utils::GetTensorShapeFromTensorShapeProto(*shape_proto);
+      }
+
+      const auto* type_proto = input->TypeAsProto();
+      ORT_RETURN_IF(type_proto == nullptr || !utils::HasTensorType(*type_proto),
+                    "Memory pattern prewarm only supports tensor inputs. Input '", input->Name(), "' is not a tensor.");
+      const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(
+                                     type_proto->tensor_type().elem_type())
+                                     ->GetElementType();
+
+      OrtValue feed;
+      Tensor::InitOrtValue(element_type, shape, cpu_allocator, feed);
+      auto* tensor = feed.GetMutable<Tensor>();
+      // string tensors are initialized to empty strings by the Tensor ctor
+      if (!tensor->IsDataTypeString()) {
+        memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+      }
+
+      feed_names.push_back(input->Name());
+      feeds.push_back(std::move(feed));
+    }
+
+    ORT_RETURN_IF(num_shapes_used != shape_set.size(),
+                  "Memory pattern prewarm shapes contain names that are not inputs of the model.");
+
+    std::vector<OrtValue> fetches;
+    auto status = Run(run_options, feed_names, feeds, output_names, &fetches, nullptr);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Memory pattern prewarm run failed and was skipped. Error: "
+                                      << status.ErrorMessage();
+    }
+  }
+
+  const auto stats = session_state_->GetMemoryPatternCacheStats();
+  LOGS(*session_logger_, INFO) << "Memory pattern cache has " << stats.num_entries << " entries after prewarm.";
+  return Status::OK();
+}
+
 const std::vector<std::string>& InferenceSession::GetRegisteredProviderTypes() const {
   return execution_providers_.GetIds();
 }
@@ -2200,21 +2374,30 @@ namespace {
 struct ThreadPoolSpinningSwitch {
   concurrency::ThreadPool* intra_tp_{nullptr};
   concurrency::ThreadPool* inter_tp_{nullptr};
+  // intra-op thread pools of the other NUMA nodes
+  gsl::span<const std::unique_ptr<concurrency::ThreadPool>> numa_tps_;
   std::atomic<int>& concurrent_num_runs_;
   // __Ctor Refcounting and spinning control
   ThreadPoolSpinningSwitch(concurrency::ThreadPool* intra_tp,
                            concurrency::ThreadPool* inter_tp,
+                           gsl::span<const std::unique_ptr<concurrency::ThreadPool>> numa_tps,
                            std::atomic<int>& ref) noexcept
-      : intra_tp_(intra_tp), inter_tp_(inter_tp), concurrent_num_runs_(ref) {
+      : intra_tp_(intra_tp), inter_tp_(inter_tp), numa_tps_(numa_tps), concurrent_num_runs_(ref) {
     if (concurrent_num_runs_.fetch_add(1, std::memory_order_relaxed) == 0) {
       if (intra_tp_) intra_tp_->EnableSpinning();
       if (inter_tp_) inter_tp_->EnableSpinning();
+      for (const auto& numa_tp : numa_tps_) {
+        if (numa_tp) numa_tp->EnableSpinning();
+      }
     }
   }
   ~ThreadPoolSpinningSwitch() {
     if (1 == concurrent_num_runs_.fetch_sub(1, std::memory_order_acq_rel)) {
       if (intra_tp_) intra_tp_->DisableSpinning();
       if (inter_tp_) inter_tp_->DisableSpinning();
+      for (const auto& numa_tp : numa_tps_) {
+        if (numa_tp) numa_tp->DisableSpinning();
+      }
     }
   }
 };
@@ -2244,7 +2427,9 @@ Status InferenceSession::Run(const RunOptions& run_options,
                                 !cached_execution_provider_for_graph_replay_.IsGraphCaptured();
   auto* intra_tp = (control_spinning) ? thread_pool_.get() : nullptr;
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
-  ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
+  gsl::span<const std::unique_ptr<concurrency::ThreadPool>> numa_tps;
+  if (control_spinning) numa_tps = numa_thread_pools_.pools;
+  ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, numa_tps, current_num_runs_);
 
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
@@ -2660,6 +2845,40 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+Status InferenceSession::GetAggregateProfile(std::string& profile) const {
+  if (!aggregate_profiler_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Aggregate profiling is not enabled. Set the session.profiling.aggregate config option.");
+  }
+  profile = aggregate_profiler_->SnapshotJson();
+  return Status::OK();
+}
+
+Status InferenceSession::ResetAggregateProfile() {
+  if (!aggregate_profiler_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Aggregate profiling is not enabled. Set the session.profiling.aggregate config option.");
+  }
+  aggregate_profiler_->Reset();
+  return Status::OK();
+}
+
+void InferenceSession::HintThreadPoolBurst(std::chrono::microseconds duration) {
+  if (auto* intra_tp = GetIntraOpThreadPoolToUse()) intra_tp->HintBurst(duration);
+  if (auto* inter_tp = GetInterOpThreadPoolToUse()) inter_tp->HintBurst(duration);
+  for (auto& numa_tp : numa_thread_pools_.pools) {
+    if (numa_tp) numa_tp->HintBurst(duration);
+  }
+}
+
+void InferenceSession::HintThreadPoolIdle() {
+  if (auto* intra_tp = GetIntraOpThreadPoolToUse()) intra_tp->HintIdle();
+  if (auto* inter_tp = GetInterOpThreadPoolToUse()) inter_tp->HintIdle();
+  for (auto& numa_tp : numa_thread_pools_.pools) {
+    if (numa_tp) numa_tp->HintIdle();
+  }
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
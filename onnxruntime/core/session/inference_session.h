@@ -9,6 +9,7 @@
 
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
+#include "core/common/aggregate_profiler.h"
 #include "core/common/logging/logging.h"
 #include "core/common/path_string.h"
 #include "core/common/profiler.h"
@@ -426,6 +427,17 @@ class InferenceSession {
    */
   int GetCurrentNumRuns() const;
 
+  /**
+   * Generate and cache the memory patterns for the given input shapes by running the model once per shape set
+   * with zero filled inputs, so that later requests with those shapes do not pay for the pattern generation.
+   * Inputs missing from a shape set are fed with their shape from the model, which must be fully specified.
+   * Runs that fail, e.g. because the model does not accept zero filled inputs, are logged and skipped.
+   * Must be called after Initialize(). Does nothing if memory pattern is disabled.
+   * @param shape_sets input name to shape for each set of input shapes to generate memory patterns for.
+   * @return OK if success.
+   */
+  common::Status PrewarmMemoryPatterns(const std::vector<InlinedHashMap<std::string, TensorShape>>& shape_sets);
+
   /**
    * Get the names of registered Execution Providers. The returned vector is ordered by Execution Provider
    * priority. The first provider in the vector has the highest priority.
@@ -474,6 +486,29 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+   * Get the per op type statistics aggregated since the session was initialized or the last reset, as JSON.
+   * Requires the session.profiling.aggregate config option.
+   */
+  Status GetAggregateProfile(std::string& profile) const;
+
+  /**
+   * Clear the statistics of the aggregating profiler.
+   */
+  Status ResetAggregateProfile();
+
+  /**
+   * Hint that a burst of requests is about to arrive. The workers of the session's thread pools are woken up and
+   * spin for up to the given duration, so that the first requests do not pay for waking them up.
+   */
+  void HintThreadPoolBurst(std::chrono::microseconds duration);
+
+  /**
+   * Hint that no requests are expected for a while. Spinning workers of the session's thread pools block
+   * immediately instead of spinning until their spin time runs out.
+   */
+  void HintThreadPoolIdle();
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -710,6 +745,9 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Aggregating profiler for this session. nullptr unless session.profiling.aggregate is set.
+  std::unique_ptr<profiling::AggregateProfiler> aggregate_profiler_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler memory_profiler_;
 #endif
@@ -729,6 +767,10 @@ class InferenceSession {
   // Spinning is restarted on the next Run()
   bool force_spinning_stop_between_runs_ = false;
 
+  // Intra-op thread pools of the NUMA nodes other than the first when session.intra_op.numa_aware is set.
+  // The pool of the first node is moved to thread_pool_. Declared first as the pools refer to its names.
+  onnxruntime::concurrency::NumaThreadPools numa_thread_pools_;
+
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
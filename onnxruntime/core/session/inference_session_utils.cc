@@ -5,6 +5,12 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <fstream>
+
+#include "core/common/parse_string.h"
+#include "core/common/path_string.h"
+#include "core/common/string_utils.h"
+
 namespace onnxruntime {
 
 //---------------------
@@ -264,6 +270,61 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+Status ParseTuningResultsFromFile(const std::string& file_path,
+                                  std::vector<TuningResults>& results) {
+  results.clear();
+
+  std::ifstream file_stream(ToPathString(file_path));
+  ORT_RETURN_IF(!file_stream.good(), "Failed to open tuning results file: ", file_path);
+
+  Status status;
+  ORT_TRY {
+    auto parsed_tuning_results_json = json::parse(file_stream);
+    results = parsed_tuning_results_json.get<std::vector<TuningResults>>();
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Tuning results file ", file_path, " cannot be parsed. Error message: ", e.what());
+    });
+  }
+
+  return status;
+}
+
+Status ParseMemoryPatternPrewarmShapes(const std::string& shapes_str,
+                                       std::vector<InlinedHashMap<std::string, TensorShape>>& shape_sets) {
+  shape_sets.clear();
+  for (const auto& shape_set_str : utils::SplitString(shapes_str, ";")) {
+    InlinedHashMap<std::string, TensorShape> shape_set;
+    for (const auto& input_str : utils::SplitString(shape_set_str, ",")) {
+      // input names may contain ':' so split on the last one
+      const auto separator = input_str.rfind(':');
+      ORT_RETURN_IF(separator == std::string_view::npos || separator == 0,
+                    "Invalid memory pattern prewarm input '", input_str, "'. Expected <name>:<dims separated by 'x'>");
+
+      TensorShapeVector dims;
+      // an empty list of dims is a scalar
+      for (const auto& dim_str : utils::SplitString(input_str.substr(separator + 1), "x")) {
+        int64_t dim = 0;
+        ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(dim_str, dim));
+        ORT_RETURN_IF(dim < 0, "Invalid dim in memory pattern prewarm input '", input_str, "'");
+        dims.push_back(dim);
+      }
+
+      const std::string name{input_str.substr(0, separator)};
+      ORT_RETURN_IF_NOT(shape_set.emplace(name, TensorShape(dims)).second,
+                        "Input '", name, "' is specified more than once in a memory pattern prewarm shape set");
+    }
+
+    if (!shape_set.empty()) {
+      shape_sets.push_back(std::move(shape_set));
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -62,6 +62,15 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ std::vector<TuningResults>& results,
                                            /*out*/ bool& key_found);
 
+// Parses the tuning results in the file given by the kOrtSessionOptionsTuningResultsFile config option.
+Status ParseTuningResultsFromFile(const std::string& file_path,
+                                  /*out*/ std::vector<TuningResults>& results);
+
+// Parses the value of the kOrtSessionOptionsMemoryPatternPrewarmShapes config option.
+// Returns one map of input name to shape per shape set.
+Status ParseMemoryPatternPrewarmShapes(const std::string& shapes_str,
+                                       /*out*/ std::vector<InlinedHashMap<std::string, TensorShape>>& shape_sets);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -5,6 +5,7 @@
 #include "core/session/allocator_adapters.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/IOBinding.h"
+#include "core/session/request_batcher.h"
 #include "core/framework/allocator.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_provider.h"
@@ -18,6 +19,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
+#include "core/common/parse_string.h"
 #include "core/common/status.h"
 #include "core/common/safeint.h"
 #include "core/graph/constants.h"
@@ -38,6 +40,7 @@
 #include "core/framework/TensorSeq.h"
 #include "core/platform/ort_mutex.h"
 #include "core/common/string_helper.h"
+#include "core/common/string_utils.h"
 
 #ifdef USE_CUDA
 #include "core/providers/cuda/cuda_provider_factory.h"
@@ -870,6 +873,109 @@ ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateRequestBatcher, _In_ OrtSession* sess, _In_reads_(num_keys) const char* const* keys,
+                    _In_reads_(num_keys) const char* const* values, _In_ size_t num_keys,
+                    _Outptr_ OrtRequestBatcher** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  RequestBatcherOptions options;
+
+  for (size_t i = 0; i < num_keys; ++i) {
+    if (strcmp(keys[i], "batch_dim") == 0) {
+      options.batch_dim_param = values[i];
+    } else if (strcmp(keys[i], "padded_dims") == 0) {
+      for (const auto& dim_param : utils::SplitString(values[i], ",")) {
+        options.padded_dim_params.emplace_back(dim_param);
+      }
+    } else if (strcmp(keys[i], "max_batch_size") == 0) {
+      ORT_API_RETURN_IF_STATUS_NOT_OK(ParseStringWithClassicLocale(values[i], options.max_batch_size));
+    } else if (strcmp(keys[i], "max_delay_us") == 0) {
+      int64_t max_delay_us = 0;
+      ORT_API_RETURN_IF_STATUS_NOT_OK(ParseStringWithClassicLocale(values[i], max_delay_us));
+      options.max_delay = std::chrono::microseconds(max_delay_us);
+    } else {
+      std::ostringstream oss;
+      oss << "Invalid key found: " << keys[i];
+
+      return CreateStatus(ORT_INVALID_ARGUMENT, oss.str().c_str());
+    }
+  }
+
+  std::unique_ptr<RequestBatcher> batcher;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(RequestBatcher::Create(*session, options, batcher));
+  *out = reinterpret_cast<OrtRequestBatcher*>(batcher.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RequestBatcherRun, _Inout_ OrtRequestBatcher* batcher_ptr,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+  auto batcher = reinterpret_cast<RequestBatcher*>(batcher_ptr);
+
+  InlinedVector<std::string> feed_names;
+  feed_names.reserve(input_len);
+  InlinedVector<OrtValue> feeds;
+  feeds.reserve(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name and value cannot be nullptr");
+    }
+
+    feed_names.emplace_back(input_names[i]);
+    feeds.emplace_back(*input[i]);
+  }
+
+  InlinedVector<std::string> fetch_names;
+  fetch_names.reserve(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names[i] == nullptr || output[i] != nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                   "output name cannot be nullptr and outputs must be allocated by the batcher");
+    }
+
+    fetch_names.emplace_back(output_names[i]);
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(batcher->Run(feed_names, feeds, fetch_names, fetches));
+
+  for (size_t i = 0; i != output_names_len; ++i) {
+    output[i] = std::make_unique<OrtValue>(std::move(fetches[i])).release();
+  }
+
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseRequestBatcher, _Frees_ptr_opt_ OrtRequestBatcher* batcher) {
+  delete reinterpret_cast<RequestBatcher*>(batcher);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionHintThreadPoolActivity, _In_ OrtSession* sess, _In_ OrtThreadPoolActivityHint hint,
+                    _In_ int64_t burst_duration_us) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  switch (hint) {
+    case ORT_THREAD_POOL_ACTIVITY_BURST:
+      if (burst_duration_us < 0) {
+        return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "burst_duration_us must not be negative");
+      }
+      session->HintThreadPoolBurst(std::chrono::microseconds(burst_duration_us));
+      break;
+    case ORT_THREAD_POOL_ACTIVITY_IDLE:
+      session->HintThreadPoolIdle();
+      break;
+    default:
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Invalid thread pool activity hint");
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -1364,6 +1470,25 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetAggregateProfile, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string profile;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetAggregateProfile(profile));
+  *out = StrDup(profile, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionResetAggregateProfile, _In_ OrtSession* sess) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->ResetAggregateProfile());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2230,6 +2355,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "thread_cache_max_bytes") == 0) {
+      cfg->thread_cache_max_bytes = static_cast<int64_t>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2721,6 +2848,12 @@ static constexpr OrtApi ort_api_1_to_17 = {
     &OrtApis::ShapeInferContext_SetOutputTypeShape,
     &OrtApis::SetSymbolicDimensions,
     &OrtApis::ReadOpAttr,
+    &OrtApis::CreateRequestBatcher,
+    &OrtApis::RequestBatcherRun,
+    &OrtApis::ReleaseRequestBatcher,
+    &OrtApis::SessionHintThreadPoolActivity,
+    &OrtApis::SessionGetAggregateProfile,
+    &OrtApis::SessionResetAggregateProfile,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
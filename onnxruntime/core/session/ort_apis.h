@@ -500,5 +500,19 @@ ORT_API_STATUS_IMPL(ShapeInferContext_GetAttribute, _In_ const OrtShapeInferCont
 ORT_API_STATUS_IMPL(ShapeInferContext_SetOutputTypeShape, _In_ const OrtShapeInferContext* context, _In_ size_t index, _In_ const OrtTensorTypeAndShapeInfo* info);
 ORT_API_STATUS_IMPL(SetSymbolicDimensions, _In_ OrtTensorTypeAndShapeInfo* info, _In_ const char* dim_params[], _In_ size_t dim_params_length);
 ORT_API_STATUS_IMPL(ReadOpAttr, _In_ const OrtOpAttr* op_attr, _In_ OrtOpAttrType type, _Inout_ void* data, _In_ size_t len, _Out_ size_t* out);
+ORT_API_STATUS_IMPL(CreateRequestBatcher, _In_ OrtSession* session, _In_reads_(num_keys) const char* const* keys,
+                    _In_reads_(num_keys) const char* const* values, _In_ size_t num_keys,
+                    _Outptr_ OrtRequestBatcher** out);
+ORT_API_STATUS_IMPL(RequestBatcherRun, _Inout_ OrtRequestBatcher* batcher,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** outputs);
+ORT_API(void, ReleaseRequestBatcher, _Frees_ptr_opt_ OrtRequestBatcher*);
+ORT_API_STATUS_IMPL(SessionHintThreadPoolActivity, _In_ OrtSession* session, _In_ OrtThreadPoolActivityHint hint,
+                    _In_ int64_t burst_duration_us);
+ORT_API_STATUS_IMPL(SessionGetAggregateProfile, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(SessionResetAggregateProfile, _In_ OrtSession* session);
 
 }  // namespace OrtApis
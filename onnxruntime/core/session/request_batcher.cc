@@ -0,0 +1,430 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/node_arg.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Copy a box with dims box_dims from src, starting at src_start, to dst, starting at dst_start.
+void CopyBox(const uint8_t* src, gsl::span<const int64_t> src_dims, gsl::span<const int64_t> src_start,
+             uint8_t* dst, gsl::span<const int64_t> dst_dims, gsl::span<const int64_t> dst_start,
+             gsl::span<const int64_t> box_dims, size_t element_size) {
+  const size_t rank = box_dims.size();
+  if (std::any_of(box_dims.begin(), box_dims.end(), [](int64_t dim) { return dim == 0; })) {
+    return;
+  }
+
+  if (rank == 0) {
+    memcpy(dst, src, element_size);
+    return;
+  }
+
+  InlinedVector<int64_t> src_strides(rank, 1);
+  InlinedVector<int64_t> dst_strides(rank, 1);
+  for (size_t axis = rank - 1; axis > 0; --axis) {
+    src_strides[axis - 1] = src_strides[axis] * src_dims[axis];
+    dst_strides[axis - 1] = dst_strides[axis] * dst_dims[axis];
+  }
+
+  // trailing axes that the box fully covers in both tensors are contiguous, so copy them with one memcpy.
+  // inner_axis is the outermost axis that is part of the contiguous row.
+  size_t inner_axis = rank - 1;
+  int64_t row_size = box_dims[inner_axis];
+  while (inner_axis > 0 && box_dims[inner_axis] == src_dims[inner_axis] && box_dims[inner_axis] == dst_dims[inner_axis]) {
+    --inner_axis;
+    row_size *= box_dims[inner_axis];
+  }
+
+  const size_t row_bytes = static_cast<size_t>(row_size) * element_size;
+  InlinedVector<int64_t> index(inner_axis, 0);
+  while (true) {
+    int64_t src_offset = 0;
+    int64_t dst_offset = 0;
+    for (size_t axis = 0; axis < rank; ++axis) {
+      const int64_t i = axis < inner_axis ? index[axis] : 0;
+      src_offset += (src_start[axis] + i) * src_strides[axis];
+      dst_offset += (dst_start[axis] + i) * dst_strides[axis];
+    }
+
+    memcpy(dst + dst_offset * element_size, src + src_offset * element_size, row_bytes);
+
+    // move to the next row
+    size_t axis = inner_axis;
+    while (axis > 0) {
+      --axis;
+      if (++index[axis] < box_dims[axis]) {
+        break;
+      }
+
+      index[axis] = 0;
+      if (axis == 0) {
+        return;
+      }
+    }
+
+    if (inner_axis == 0) {
+      return;
+    }
+  }
+}
+
+Status GetValueAxes(const NodeArg& node_arg, const RequestBatcherOptions& options,
+                    size_t& rank, size_t& batch_axis, InlinedVector<std::pair<size_t, size_t>>& padded_axes) {
+  const auto* shape = node_arg.Shape();
+  ORT_RETURN_IF(shape == nullptr, "Shape of ", node_arg.Name(), " is unknown so it can't be batched.");
+
+  rank = static_cast<size_t>(shape->dim_size());
+  bool has_batch_axis = false;
+  for (size_t axis = 0; axis < rank; ++axis) {
+    const auto& dim = shape->dim(static_cast<int>(axis));
+    if (!utils::HasDimParam(dim)) {
+      continue;
+    }
+
+    if (dim.dim_param() == options.batch_dim_param) {
+      ORT_RETURN_IF(has_batch_axis, node_arg.Name(), " has more than one batch dim.");
+      has_batch_axis = true;
+      batch_axis = axis;
+      continue;
+    }
+
+    const auto& padded = options.padded_dim_params;
+    auto it = std::find(padded.begin(), padded.end(), dim.dim_param());
+    if (it != padded.end()) {
+      padded_axes.emplace_back(axis, static_cast<size_t>(it - padded.begin()));
+    }
+  }
+
+  ORT_RETURN_IF_NOT(has_batch_axis, node_arg.Name(), " does not have the batch dim '", options.batch_dim_param, "'.");
+  return Status::OK();
+}
+
+}  // namespace
+
+RequestBatcher::RequestBatcher(InferenceSession& session, const RequestBatcherOptions& options)
+    : session_(session), options_(options) {
+  run_options_.run_tag = "RequestBatcher";
+}
+
+Status RequestBatcher::Create(InferenceSession& session, const RequestBatcherOptions& options,
+                              std::unique_ptr<RequestBatcher>& batcher) {
+  ORT_RETURN_IF(options.batch_dim_param.empty(), "The name of the batch dim must be specified.");
+  ORT_RETURN_IF(options.max_batch_size < 1, "max_batch_size must be positive.");
+  ORT_RETURN_IF(options.max_delay.count() < 0, "max_delay must not be negative.");
+
+  batcher.reset(new RequestBatcher(session, options));
+  ORT_RETURN_IF_ERROR(batcher->Initialize());
+  batcher->worker_ = std::thread(&RequestBatcher::WorkerLoop, batcher.get());
+  return Status::OK();
+}
+
+Status RequestBatcher::Initialize() {
+  auto add_axes = [this](const std::vector<const NodeArg*>& defs,
+                         InlinedHashMap<std::string, ValueAxes>& axes_map) -> Status {
+    for (const auto* def : defs) {
+      ValueAxes axes;
+      ORT_RETURN_IF_ERROR(GetValueAxes(*def, options_, axes.rank, axes.batch_axis, axes.padded_axes));
+      axes_map.emplace(def->Name(), std::move(axes));
+    }
+
+    return Status::OK();
+  };
+
+  auto inputs = session_.GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs.first);
+  ORT_RETURN_IF_ERROR(add_axes(*inputs.second, input_axes_));
+
+  auto outputs = session_.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs.first);
+  ORT_RETURN_IF_ERROR(add_axes(*outputs.second, output_axes_));
+
+  allocator_ = session_.GetAllocator(OrtMemoryInfo(CPU, OrtDeviceAllocator));
+  ORT_RETURN_IF(allocator_ == nullptr, "Session does not have a CPU allocator.");
+  return Status::OK();
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    shutdown_ = true;
+  }
+
+  queue_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+Status RequestBatcher::PrepareRequest(Request& request) const {
+  ORT_RETURN_IF(request.feed_names.size() != request.feeds.size(), "Number of feed names and feeds must match.");
+  ORT_RETURN_IF(request.feeds.empty(), "At least one feed is required to determine the batch size.");
+
+  request.batch_size = -1;
+  request.padded_dim_values.assign(options_.padded_dim_params.size(), -1);
+
+  auto& key = request.key;
+  for (size_t i = 0, end = request.feeds.size(); i < end; ++i) {
+    const auto& name = request.feed_names[i];
+    const auto& feed = request.feeds[i];
+
+    auto axes_it = input_axes_.find(name);
+    ORT_RETURN_IF(axes_it == input_axes_.end(), "Invalid input name: ", name);
+    const auto& axes = axes_it->second;
+
+    ORT_RETURN_IF_NOT(feed.IsTensor(), "Input ", name, " is not a tensor.");
+    const auto& tensor = feed.Get<Tensor>();
+    ORT_RETURN_IF(tensor.IsDataTypeString(), "Input ", name, " is a string tensor, which can't be batched.");
+    ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU, "Input ", name, " is not in CPU memory.");
+
+    const auto dims = tensor.Shape().GetDims();
+    ORT_RETURN_IF(dims.size() != axes.rank, "Input ", name, " has rank ", dims.size(), " but the model expects ",
+                  axes.rank);
+
+    const int64_t batch_size = dims[axes.batch_axis];
+    ORT_RETURN_IF(request.batch_size != -1 && request.batch_size != batch_size,
+                  "Inputs have different batch sizes: ", request.batch_size, " and ", batch_size);
+    request.batch_size = batch_size;
+
+    InlinedVector<bool> is_variable_axis(dims.size(), false);
+    is_variable_axis[axes.batch_axis] = true;
+    for (const auto& padded_axis : axes.padded_axes) {
+      is_variable_axis[padded_axis.first] = true;
+      auto& value = request.padded_dim_values[padded_axis.second];
+      const int64_t dim = dims[padded_axis.first];
+      ORT_RETURN_IF(value != -1 && value != dim, "Inputs have different values for dim '",
+                    options_.padded_dim_params[padded_axis.second], "': ", value, " and ", dim);
+      value = dim;
+    }
+
+    // the key contains everything that has to match for requests to be batched together
+    key += name;
+    key += ':';
+    key += std::to_string(tensor.GetElementType());
+    for (size_t axis = 0; axis < dims.size(); ++axis) {
+      key += is_variable_axis[axis] ? std::string(",?") : "," + std::to_string(dims[axis]);
+    }
+
+    key += ';';
+  }
+
+  key += '|';
+  for (const auto& output_name : request.output_names) {
+    ORT_RETURN_IF(output_axes_.find(output_name) == output_axes_.end(), "Invalid output name: ", output_name);
+    key += output_name;
+    key += ';';
+  }
+
+  return Status::OK();
+}
+
+Status RequestBatcher::Run(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                           gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches) {
+  Request request;
+  request.feed_names = feed_names;
+  request.feeds = feeds;
+  request.output_names = output_names;
+  request.fetches = &fetches;
+  ORT_RETURN_IF_ERROR(PrepareRequest(request));
+
+  auto result = request.result.get_future();
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ORT_RETURN_IF(shutdown_, "RequestBatcher is shutting down.");
+    request.enqueue_time = std::chrono::steady_clock::now();
+    queue_.push_back(&request);
+  }
+
+  queue_cv_.notify_one();
+  return result.get();
+}
+
+int64_t RequestBatcher::QueuedBatchSize() const {
+  const auto& key = queue_.front()->key;
+  int64_t batch_size = 0;
+  for (const auto* request : queue_) {
+    if (request->key == key) {
+      batch_size += request->batch_size;
+    }
+  }
+
+  return batch_size;
+}
+
+std::vector<RequestBatcher::Request*> RequestBatcher::TakeBatch() {
+  std::vector<Request*> batch;
+  batch.push_back(queue_.front());
+  queue_.pop_front();
+
+  int64_t batch_size = batch.front()->batch_size;
+  for (auto it = queue_.begin(); it != queue_.end() && batch_size < options_.max_batch_size;) {
+    if ((*it)->key == batch.front()->key && batch_size + (*it)->batch_size <= options_.max_batch_size) {
+      batch_size += (*it)->batch_size;
+      batch.push_back(*it);
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return batch;
+}
+
+void RequestBatcher::WorkerLoop() {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  while (true) {
+    queue_cv_.wait(lock, [this]() { return shutdown_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+
+    // wait for more requests until the batch is full or the oldest request has waited long enough
+    const auto deadline = queue_.front()->enqueue_time + options_.max_delay;
+    for (auto now = std::chrono::steady_clock::now();
+         !shutdown_ && QueuedBatchSize() < options_.max_batch_size && now < deadline;
+         now = std::chrono::steady_clock::now()) {
+      queue_cv_.wait_for(lock, deadline - now);
+    }
+
+    auto batch = TakeBatch();
+    lock.unlock();
+
+    Status status;
+    ORT_TRY {
+      status = ExecuteBatch(batch);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+
+    // updated before the requests complete so that they are visible to the callers
+    num_runs_.fetch_add(1, std::memory_order_relaxed);
+    num_requests_.fetch_add(batch.size(), std::memory_order_relaxed);
+
+    for (auto* request : batch) {
+      if (!status.IsOK()) {
+        request->fetches->clear();
+      }
+
+      request->result.set_value(status);
+    }
+
+    lock.lock();
+  }
+}
+
+Status RequestBatcher::ExecuteBatch(gsl::span<Request* const> batch) {
+  const Request& first = *batch.front();
+  if (batch.size() == 1) {
+    return session_.Run(run_options_, first.feed_names, first.feeds, first.output_names, first.fetches);
+  }
+
+  // combined batch size and the largest value of each padded dim
+  int64_t batch_size = 0;
+  InlinedVector<int64_t> padded_dim_values(options_.padded_dim_params.size(), -1);
+  for (const auto* request : batch) {
+    batch_size += request->batch_size;
+    for (size_t i = 0; i < padded_dim_values.size(); ++i) {
+      padded_dim_values[i] = std::max(padded_dim_values[i], request->padded_dim_values[i]);
+    }
+  }
+
+  std::vector<OrtValue> feeds(first.feeds.size());
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto& axes = input_axes_.at(first.feed_names[i]);
+    const auto& first_tensor = first.feeds[i].Get<Tensor>();
+
+    TensorShapeVector dims = first_tensor.Shape().AsShapeVector();
+    dims[axes.batch_axis] = batch_size;
+    for (const auto& padded_axis : axes.padded_axes) {
+      dims[padded_axis.first] = padded_dim_values[padded_axis.second];
+    }
+
+    Tensor::InitOrtValue(first_tensor.DataType(), TensorShape(dims), allocator_, feeds[i]);
+    auto& batched = *feeds[i].GetMutable<Tensor>();
+
+    const bool needs_padding = std::any_of(batch.begin(), batch.end(), [&](const Request* request) {
+      const auto request_dims = request->feeds[i].Get<Tensor>().Shape().GetDims();
+      return std::any_of(axes.padded_axes.begin(), axes.padded_axes.end(), [&](const auto& padded_axis) {
+        return request_dims[padded_axis.first] != dims[padded_axis.first];
+      });
+    });
+
+    if (needs_padding) {
+      memset(batched.MutableDataRaw(), 0, batched.SizeInBytes());
+    }
+
+    InlinedVector<int64_t> src_start(dims.size(), 0);
+    InlinedVector<int64_t> dst_start(dims.size(), 0);
+    for (const auto* request : batch) {
+      const auto& tensor = request->feeds[i].Get<Tensor>();
+      const auto request_dims = tensor.Shape().GetDims();
+      CopyBox(static_cast<const uint8_t*>(tensor.DataRaw()), request_dims, src_start,
+              static_cast<uint8_t*>(batched.MutableDataRaw()), dims, dst_start,
+              request_dims, tensor.DataType()->Size());
+      dst_start[axes.batch_axis] += request->batch_size;
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(session_.Run(run_options_, first.feed_names, feeds, first.output_names, &fetches));
+  feeds.clear();
+
+  // split the outputs, removing any padding
+  for (auto* request : batch) {
+    request->fetches->clear();
+    request->fetches->resize(fetches.size());
+  }
+
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    const auto& output_name = first.output_names[i];
+    const auto& axes = output_axes_.at(output_name);
+
+    ORT_RETURN_IF_NOT(fetches[i].IsTensor(), "Output ", output_name, " is not a tensor.");
+    const auto& batched = fetches[i].Get<Tensor>();
+    ORT_RETURN_IF(batched.IsDataTypeString(), "Output ", output_name, " is a string tensor, which can't be split.");
+    ORT_RETURN_IF_NOT(batched.Location().device.Type() == OrtDevice::CPU, "Output ", output_name,
+                      " is not in CPU memory.");
+
+    const auto dims = batched.Shape().GetDims();
+    ORT_RETURN_IF(dims.size() != axes.rank || dims[axes.batch_axis] != batch_size, "Output ", output_name,
+                  " has shape ", batched.Shape(), ", which does not have the combined batch size of ", batch_size,
+                  " in the batch dim.");
+
+    InlinedVector<int64_t> src_start(dims.size(), 0);
+    InlinedVector<int64_t> dst_start(dims.size(), 0);
+    for (auto* request : batch) {
+      TensorShapeVector request_dims(dims.begin(), dims.end());
+      request_dims[axes.batch_axis] = request->batch_size;
+      for (const auto& padded_axis : axes.padded_axes) {
+        const int64_t value = request->padded_dim_values[padded_axis.second];
+        if (value != -1 && value < dims[padded_axis.first]) {
+          request_dims[padded_axis.first] = value;
+        }
+      }
+
+      auto& fetch = (*request->fetches)[i];
+      Tensor::InitOrtValue(batched.DataType(), TensorShape(request_dims), allocator_, fetch);
+      auto& tensor = *fetch.GetMutable<Tensor>();
+      CopyBox(static_cast<const uint8_t*>(batched.DataRaw()), dims, src_start,
+              static_cast<uint8_t*>(tensor.MutableDataRaw()), request_dims, dst_start,
+              request_dims, batched.DataType()->Size());
+      src_start[axes.batch_axis] += request->batch_size;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+class InferenceSession;
+
+struct RequestBatcherOptions {
+  // Maximum combined batch size of the requests that are executed together.
+  int64_t max_batch_size = 8;
+
+  // Maximum time the oldest queued request waits for other requests before it is executed.
+  std::chrono::microseconds max_delay{1000};
+
+  // Name of the symbolic dim (dim_param) that is the batch dim. Every input and output of the model must have it.
+  std::string batch_dim_param;
+
+  // Names of symbolic dims that may differ between requests that are batched together, e.g. a sequence length.
+  // Inputs are padded with zeros to the largest value in the batch, and output dims with the same name are sliced
+  // back to the value of each request.
+  InlinedVector<std::string> padded_dim_params;
+};
+
+/**
+ * Combines concurrent Run requests against a session into batched runs.
+ *
+ * Usage is as follows:
+ *
+ * RequestBatcherOptions options;
+ * options.batch_dim_param = "batch_size";
+ * options.padded_dim_params = {"sequence_length"};
+ * std::unique_ptr<RequestBatcher> batcher;
+ * ORT_RETURN_IF_ERROR(RequestBatcher::Create(session, options, batcher));
+ *
+ * // from any number of threads
+ * std::vector<OrtValue> fetches;
+ * ORT_RETURN_IF_ERROR(batcher->Run(feed_names, feeds, output_names, fetches));
+ *
+ * Requests are queued, and a worker thread executes the oldest request together with the queued requests that can be
+ * batched with it once their combined batch size reaches max_batch_size or the oldest request has waited for
+ * max_delay. The feeds are concatenated along the batch dim, and the outputs are split back to each request.
+ * While a batch is running new requests are queued, so the next batch is formed as soon as the current one completes.
+ *
+ * Requests can be batched together if they have the same feed names, output names and element types, and their feed
+ * shapes only differ in the batch dim and the padded dims. Feeds must be non-string tensors in CPU memory.
+ * Outputs are allocated by the batcher.
+ */
+class RequestBatcher {
+ public:
+  static Status Create(InferenceSession& session, const RequestBatcherOptions& options,
+                       std::unique_ptr<RequestBatcher>& batcher);
+
+  // Requests that are still queued are executed before the worker thread exits.
+  ~RequestBatcher();
+
+  // Blocks until the request has been executed. Thread-safe.
+  Status Run(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+  struct Stats {
+    // number of session runs the requests were executed in
+    uint64_t runs = 0;
+    // number of requests executed
+    uint64_t requests = 0;
+  };
+
+  // Statistics of the requests that completed. Thread-safe.
+  Stats GetStats() const {
+    return {num_runs_.load(std::memory_order_relaxed), num_requests_.load(std::memory_order_relaxed)};
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RequestBatcher);
+
+ private:
+  // the axes of an input or output that are the batch dim and the padded dims
+  struct ValueAxes {
+    size_t rank;
+    size_t batch_axis;
+    // pairs of axis and index in padded_dim_params
+    InlinedVector<std::pair<size_t, size_t>> padded_axes;
+  };
+
+  struct Request {
+    gsl::span<const std::string> feed_names;
+    gsl::span<const OrtValue> feeds;
+    gsl::span<const std::string> output_names;
+    std::vector<OrtValue>* fetches;
+
+    int64_t batch_size;
+    // value of each of the padded dims. -1 if the request has no value for the dim
+    InlinedVector<int64_t> padded_dim_values;
+    // requests with the same key can be batched together
+    std::string key;
+
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::promise<Status> result;
+  };
+
+  RequestBatcher(InferenceSession& session, const RequestBatcherOptions& options);
+
+  Status Initialize();
+  Status PrepareRequest(Request& request) const;
+
+  void WorkerLoop();
+  // the combined batch size of the queued requests that can be batched with the oldest one. requires mutex_.
+  int64_t QueuedBatchSize() const;
+  // remove the oldest request and the requests that can be batched with it from the queue. requires mutex_.
+  std::vector<Request*> TakeBatch();
+  Status ExecuteBatch(gsl::span<Request* const> batch);
+
+  InferenceSession& session_;
+  const RequestBatcherOptions options_;
+  RunOptions run_options_;
+  AllocatorPtr allocator_;
+
+  InlinedHashMap<std::string, ValueAxes> input_axes_;
+  InlinedHashMap<std::string, ValueAxes> output_axes_;
+
+  OrtMutex mutex_;
+  OrtCondVar queue_cv_;
+  std::deque<Request*> queue_;
+  bool shutdown_{false};
+  std::thread worker_;
+
+  std::atomic<uint64_t> num_runs_{0};
+  std::atomic<uint64_t> num_requests_{0};
+};
+
+}  // namespace onnxruntime
@@ -10,6 +10,7 @@
 #endif
 #include <thread>
 #include "core/session/ort_apis.h"
+#include "core/common/path_string.h"
 #include "core/common/string_utils.h"
 #include "core/common/logging/logging.h"
 
@@ -71,6 +72,19 @@ static std::vector<LogicalProcessors> ReadThreadAffinityConfig(const std::string
 }
 #endif
 
+static void SetCommonThreadOptions(const OrtThreadPoolParams& options, ThreadOptions& to) {
+  to.set_denormal_as_zero = options.set_denormal_as_zero;
+  // set custom thread management members
+  to.custom_create_thread_fn = options.custom_create_thread_fn;
+  to.custom_thread_creation_options = options.custom_thread_creation_options;
+  to.custom_join_thread_fn = options.custom_join_thread_fn;
+  to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.adaptive_spinning = options.adaptive_spinning;
+  if (to.custom_create_thread_fn) {
+    ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
+  }
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
@@ -109,15 +123,7 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
 #endif
   }
 
-  to.set_denormal_as_zero = options.set_denormal_as_zero;
-  // set custom thread management members
-  to.custom_create_thread_fn = options.custom_create_thread_fn;
-  to.custom_thread_creation_options = options.custom_thread_creation_options;
-  to.custom_join_thread_fn = options.custom_join_thread_fn;
-  to.dynamic_block_base_ = options.dynamic_block_base_;
-  if (to.custom_create_thread_fn) {
-    ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
-  }
+  SetCommonThreadOptions(options, to);
 
   return std::make_unique<ThreadPool>(env, to, options.name, options.thread_pool_size,
                                       options.allow_spinning);
@@ -132,6 +138,97 @@ CreateThreadPool(Env* env, OrtThreadPoolParams options, ThreadPoolType tpool_typ
   return CreateThreadPoolHelper(env, options);
 }
 
+// index of the node in node_processors that contains the processor, or -1
+static int FindNumaNode(gsl::span<const LogicalProcessors> node_processors, int processor_id) {
+  for (size_t node = 0; node < node_processors.size(); ++node) {
+    const auto& processors = node_processors[node];
+    if (std::find(processors.begin(), processors.end(), processor_id) != processors.end()) {
+      return static_cast<int>(node);
+    }
+  }
+  return -1;
+}
+
+NumaThreadPools CreateNumaThreadPools(Env* env, OrtThreadPoolParams options) {
+  NumaThreadPools result;
+  auto node_processors = env->GetNumaNodeProcessors();
+  if (node_processors.size() <= 1) {
+    return result;
+  }
+
+  // affinities of the threads of each node. the first entry of each is the placeholder for the calling thread.
+  std::vector<std::vector<LogicalProcessors>> node_affinities(node_processors.size());
+  if (!options.affinity_str.empty()) {
+#if defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+    ORT_THROW("Setting thread affinity is not implemented in this build.");
+#else
+    // each thread goes to the pool of the node that contains the first processor in its affinity
+    for (auto& affinity : ReadThreadAffinityConfig(options.affinity_str)) {
+      const int node = FindNumaNode(node_processors, affinity.front());
+      ORT_ENFORCE(node >= 0, "Processor ", affinity.front() + 1, " in the affinity string is not available.");
+      auto& affinities = node_affinities[node];
+      if (affinities.empty()) {
+        affinities.emplace_back();
+      }
+      affinities.push_back(std::move(affinity));
+    }
+    if (options.thread_pool_size > 0) {
+      for (const auto& affinities : node_affinities) {
+        ORT_ENFORCE(affinities.empty() || affinities.size() == static_cast<size_t>(options.thread_pool_size),
+                    "Number of affinities on each NUMA node must equal thread_pool_size minus one, affinities: ",
+                    affinities.size() - 1, ", thread_pool_size: ", options.thread_pool_size);
+      }
+    }
+#endif
+  } else if (options.thread_pool_size <= 0) {
+    // one thread per physical core of each node
+    for (auto& core : env->GetDefaultThreadAffinities()) {
+      const int node = core.empty() ? -1 : FindNumaNode(node_processors, core.front());
+      if (node < 0) {
+        continue;
+      }
+      auto& affinities = node_affinities[node];
+      if (options.auto_set_affinity) {
+        affinities.push_back(std::move(core));
+      } else {
+        affinities.push_back(node_processors[node]);
+      }
+    }
+  } else {
+    for (size_t node = 0; node < node_processors.size(); ++node) {
+      node_affinities[node].assign(options.thread_pool_size, node_processors[node]);
+    }
+  }
+
+  // the pools keep pointers to their names
+  result.pool_names.reserve(node_processors.size());
+  for (size_t node = 0; node < node_processors.size(); ++node) {
+    // nodes without threads are left out, and runs from them use the first node
+    if (node_affinities[node].empty()) {
+      continue;
+    }
+
+    ThreadOptions to;
+    to.affinities = std::move(node_affinities[node]);
+    SetCommonThreadOptions(options, to);
+    const int num_threads = static_cast<int>(to.affinities.size());
+    PathString name = options.name ? PathString(options.name) + ORT_TSTR("-") : PathString();
+    name += ORT_TSTR("numa-") + ToPathString(std::to_string(node));
+    const auto& pool_name = result.pool_names.emplace_back(std::move(name));
+
+    result.node_processors.push_back(std::move(node_processors[node]));
+    result.pools.push_back(num_threads > 1
+                               ? std::make_unique<ThreadPool>(env, to, pool_name.c_str(), num_threads,
+                                                              options.allow_spinning)
+                               : nullptr);
+  }
+
+  if (result.pools.size() <= 1) {
+    return NumaThreadPools{};
+  }
+  return result;
+}
+
 }  // namespace concurrency
 }  // namespace onnxruntime
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -2,10 +2,12 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include "core/common/path_string.h"
 #include "core/platform/threadpool.h"
 #include "core/session/onnxruntime_c_api.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 struct OrtThreadPoolParams {
   // 0: Use default setting. (All the physical cores or half of the logical cores)
@@ -21,6 +23,10 @@ struct OrtThreadPoolParams {
   // If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  // If it is true and allow_spinning is true, the time spent spinning adapts to the observed gaps between
+  // work items instead of using a fixed spin count.
+  bool adaptive_spinning = false;
+
   // It it is non-negative, thread pool will split a task by a decreasing block size
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
@@ -65,5 +71,22 @@ enum class ThreadPoolType : uint8_t {
 };
 std::unique_ptr<ThreadPool> CreateThreadPool(Env* env, OrtThreadPoolParams options,
                                              ThreadPoolType tpool_type);
+
+// Intra-op thread pools with one pool per NUMA node.
+struct NumaThreadPools {
+  // logical processors of each node
+  std::vector<LogicalProcessors> node_processors;
+  std::vector<PathString> pool_names;
+  // thread pool of each node. nullptr if the calling thread is the only thread for the node.
+  std::vector<std::unique_ptr<ThreadPool>> pools;
+};
+
+// Create a thread pool for each NUMA node with its threads restricted to the processors of the node.
+// thread_pool_size is the size of each pool, and defaults to the number of physical cores of the node.
+// Each thread is allowed to run on all the processors of its node unless auto_set_affinity is set, in which case it
+// is bound to a physical core. If affinity_str is set, each thread goes to the pool of the node that contains the
+// first processor in its affinity.
+// Returns no pools if the NUMA topology is unknown or there's only one node.
+NumaThreadPools CreateNumaThreadPools(Env* env, OrtThreadPoolParams options);
 }  // namespace concurrency
 }  // namespace onnxruntime
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/aggregate_profiler.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime::test {
+
+using profiling::AggregateProfiler;
+using profiling::OpTypeStats;
+
+namespace {
+const OpTypeStats* FindStats(const std::vector<OpTypeStats>& stats, const std::string& op_type) {
+  auto it = std::find_if(stats.begin(), stats.end(),
+                         [&op_type](const OpTypeStats& op_stats) { return op_stats.op_type == op_type; });
+  return it == stats.end() ? nullptr : &*it;
+}
+}  // namespace
+
+TEST(AggregateProfilerTest, AggregatesPerOpType) {
+  AggregateProfiler profiler(false);
+  const size_t conv = profiler.RegisterOpType("Conv", "CPUExecutionProvider");
+  const size_t relu = profiler.RegisterOpType("Relu", "CPUExecutionProvider");
+  ASSERT_NE(conv, relu);
+  ASSERT_EQ(profiler.RegisterOpType("Conv", "CPUExecutionProvider"), conv);
+
+  for (int i = 0; i < 3; ++i) {
+    auto sample = profiler.Begin();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    profiler.End(sample, conv, 16, 5);
+  }
+
+  auto stats = profiler.Snapshot();
+  ASSERT_EQ(stats.size(), 1u);  // Relu was never run
+  const auto* conv_stats = FindStats(stats, "Conv");
+  ASSERT_NE(conv_stats, nullptr);
+  EXPECT_EQ(conv_stats->provider, "CPUExecutionProvider");
+  EXPECT_EQ(conv_stats->calls, 3u);
+  EXPECT_EQ(conv_stats->output_bytes, 48u);
+  EXPECT_EQ(conv_stats->threadpool_dispatch_ns, 15u);
+  EXPECT_GE(conv_stats->min_ns, 100000u);
+  EXPECT_LE(conv_stats->min_ns, conv_stats->max_ns);
+  EXPECT_GE(conv_stats->total_ns, conv_stats->min_ns + conv_stats->max_ns);
+  EXPECT_EQ(conv_stats->cycles, 0u);
+
+  EXPECT_FALSE(profiler.HardwareCountersAvailable());
+  const auto json = profiler.SnapshotJson();
+  EXPECT_NE(json.find("\"hardware_counters\": false"), std::string::npos);
+  EXPECT_NE(json.find("\"op_type\": \"Conv\""), std::string::npos);
+  EXPECT_EQ(json.find("Relu"), std::string::npos);
+}
+
+TEST(AggregateProfilerTest, MultipleThreadsAndReset) {
+  AggregateProfiler profiler(false);
+  const size_t add = profiler.RegisterOpType("Add", "CPUExecutionProvider");
+
+  constexpr int kThreads = 4;
+  constexpr int kCallsPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&profiler, add]() {
+      for (int i = 0; i < kCallsPerThread; ++i) {
+        profiler.End(profiler.Begin(), add, 4, 0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto stats = profiler.Snapshot();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats[0].calls, static_cast<uint64_t>(kThreads * kCallsPerThread));
+  EXPECT_EQ(stats[0].output_bytes, static_cast<uint64_t>(4 * kThreads * kCallsPerThread));
+
+  profiler.Reset();
+  EXPECT_TRUE(profiler.Snapshot().empty());
+
+  profiler.End(profiler.Begin(), add, 8, 0);
+  stats = profiler.Snapshot();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats[0].calls, 1u);
+  EXPECT_EQ(stats[0].output_bytes, 8u);
+}
+
+TEST(AggregateProfilerTest, HardwareCountersAreOptional) {
+  // the counters may not be available, e.g. in containers, in which case they are reported as 0
+  AggregateProfiler profiler(true);
+  const size_t op = profiler.RegisterOpType("MatMul", "CPUExecutionProvider");
+
+  // each thread opens its own counters and closes them when it exits. the samples of exited threads are kept.
+  constexpr int kThreads = 3;
+  for (int t = 0; t < kThreads; ++t) {
+    std::thread([&profiler, op]() {
+      auto sample = profiler.Begin();
+      volatile uint64_t sum = 0;
+      for (uint64_t i = 0; i < 100000; ++i) {
+        sum = sum + i;
+      }
+      profiler.End(sample, op, 0, 0);
+    }).join();
+  }
+
+  auto stats = profiler.Snapshot();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats[0].calls, static_cast<uint64_t>(kThreads));
+  if (profiler.HardwareCountersAvailable()) {
+    EXPECT_GT(stats[0].cycles, 0u);
+    EXPECT_NE(profiler.SnapshotJson().find("\"hardware_counters\": true"), std::string::npos);
+  } else {
+    EXPECT_EQ(stats[0].cycles, 0u);
+    EXPECT_NE(profiler.SnapshotJson().find("\"hardware_counters\": false"), std::string::npos);
+  }
+}
+
+}  // namespace onnxruntime::test
@@ -370,6 +370,16 @@ TEST(AttentionTest, AttentionBatch1WithQKVAttr1) {
                    batch_size, sequence_length, hidden_size, number_of_heads,
                    false, false, false, 0, nullptr, nullptr, AttentionMaskType::MASK_1D_KEY_SEQ_LEN, 0,
                    0, false, false, disable_rocm, false, qkv_sizes);
+
+  // Tiled attention in the CPU kernel, with a V head size different from the Q/K one
+  {
+    ScopedEnvironmentVariables scoped_env_vars{
+        EnvVarMap{{onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "0"}}};
+    RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                     batch_size, sequence_length, hidden_size, number_of_heads,
+                     false, false, false, 0, nullptr, nullptr, AttentionMaskType::MASK_1D_KEY_SEQ_LEN, 0,
+                     0, false, false, disable_rocm, false, qkv_sizes);
+  }
 }
 
 TEST(AttentionTest, AttentionBatch1WithQKVAttr2) {
@@ -408,6 +418,58 @@ TEST(AttentionTest, AttentionBatch1WithQKVAttr2) {
                    batch_size, sequence_length, hidden_size, number_of_heads,
                    false, false, false, 0, nullptr, nullptr, AttentionMaskType::MASK_1D_KEY_SEQ_LEN, 0,
                    0, false, false, disable_rocm, false, qkv_sizes);
+
+  // Tiled attention in the CPU kernel, with a V head size different from the Q/K one
+  {
+    ScopedEnvironmentVariables scoped_env_vars{
+        EnvVarMap{{onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "0"}}};
+    RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                     batch_size, sequence_length, hidden_size, number_of_heads,
+                     false, false, false, 0, nullptr, nullptr, AttentionMaskType::MASK_1D_KEY_SEQ_LEN, 0,
+                     0, false, false, disable_rocm, false, qkv_sizes);
+  }
+}
+
+TEST(AttentionTest, AttentionQ4Weights) {
+  int batch_size = 2;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  // Every row has the largest magnitude 1.27 and a multiple of 0.01, so int8 block quantization is exact.
+  std::vector<float> input_data = {
+      1.27f, -0.5f, 0.3f, 0.8f,
+      0.25f, 1.27f, -0.6f, -0.04f,
+      -0.35f, 0.7f, -1.27f, 0.1f,
+      0.9f, -0.2f, 0.05f, -1.27f};
+
+  // Every column has the largest magnitude -1 and multiples of 1/8, so 4-bit block quantization is exact.
+  std::vector<float> weight_data = {
+      -1.0f, 0.25f, 0.5f, -1.0f, 0.125f, -0.5f, 0.75f, -1.0f, 0.375f, -0.25f, 0.5f, -1.0f,
+      0.5f, -1.0f, -0.25f, 0.375f, -1.0f, 0.25f, -0.125f, 0.5f, -1.0f, 0.625f, -0.75f, 0.25f,
+      0.25f, 0.75f, -1.0f, -0.5f, 0.375f, -1.0f, 0.25f, -0.375f, 0.125f, -1.0f, 0.875f, 0.5f,
+      -0.75f, 0.125f, 0.625f, 0.25f, -0.5f, 0.875f, -1.0f, 0.75f, -0.5f, 0.25f, -1.0f, -0.625f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  std::vector<int32_t> mask_index_data = {2L, 2L};
+
+  std::vector<float> output_data = {
+      -0.71365712f, 1.7016904f, -0.21891223f, 0.30894751f,
+      0.43357675f, 0.42620888f, -0.88531891f, 0.88295326f,
+      1.4910366f, -0.10281935f, -1.4925035f, 1.0287806f,
+      -0.43465051f, 2.0995158f, 0.18851525f, 1.0469092f};
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads);
+
+  for (const char* q4_weights : {"1", "2"}) {
+    ScopedEnvironmentVariables scoped_env_vars{
+        EnvVarMap{{onnxruntime::contrib::attention::kCpuAttentionQ4Weights, q4_weights}}};
+    RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                     batch_size, sequence_length, hidden_size, number_of_heads);
+  }
 }
 
 TEST(AttentionTest, AttentionBatch1RelativePositionBias) {
@@ -1294,6 +1356,16 @@ TEST(AttentionTest, AttentionPastStateBatch2WithPadding_SharedPastPresent) {
   RawAttentionPastStateBatch2WithPadding(true);
 }
 
+TEST(AttentionTest, AttentionPastState_CpuFlashAttention) {
+  // Tiled attention in the CPU kernel, which concatenates the past and present state first.
+  ScopedEnvironmentVariables scoped_env_vars{
+      EnvVarMap{{onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "0"}}};
+  RawAttentionEmptyPastState(false);
+  RawAttentionPastStateBatch1(false);
+  RawAttentionPastStateBatch2(false);
+  RawAttentionPastStateBatch2WithPadding(false);
+}
+
 TEST(AttentionTest, AttentionBatch2MaskIndex2) {
   int batch_size = 2;
   int sequence_length = 2;
@@ -1627,6 +1699,16 @@ TEST(AttentionTest, AttentionUnidirectionalAttentionMask) {
                    batch_size, sequence_length, hidden_size, number_of_heads,
                    use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data,
                    AttentionMaskType::MASK_2D_KEY_PADDING);
+
+  // Tiled attention in the CPU kernel
+  {
+    ScopedEnvironmentVariables scoped_env_vars{
+        EnvVarMap{{onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "0"}}};
+    RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                     batch_size, sequence_length, hidden_size, number_of_heads,
+                     use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data,
+                     AttentionMaskType::MASK_2D_KEY_PADDING);
+  }
 }
 
 TEST(AttentionTest, AttentionWithNormFactor) {
@@ -2199,6 +2281,19 @@ TEST(AttentionTest, Attention_Mask2D_Fp32_B2_S32) {
       mask_index_data,
       onnx_model,
       false);
+
+  // Tiled attention in the CPU kernel
+  {
+    ScopedEnvironmentVariables scoped_env_vars{
+        EnvVarMap{{onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "0"}}};
+    RunModelWithRandomInput(
+        batch_size,
+        sequence_length,
+        mask_index_dims,
+        mask_index_data,
+        onnx_model,
+        false);
+  }
 }
 
 TEST(AttentionTest, Attention_Mask1D_Fp32_B2_S64) {
@@ -2219,6 +2314,19 @@ TEST(AttentionTest, Attention_Mask1D_Fp32_B2_S64) {
       mask_index_data,
       onnx_model,
       false);
+
+  // Tiled attention in the CPU kernel
+  {
+    ScopedEnvironmentVariables scoped_env_vars{
+        EnvVarMap{{onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "0"}}};
+    RunModelWithRandomInput(
+        batch_size,
+        sequence_length,
+        mask_index_dims,
+        mask_index_data,
+        onnx_model,
+        false);
+  }
 }
 
 // This case can be used to test flash attention using Ampere GPU
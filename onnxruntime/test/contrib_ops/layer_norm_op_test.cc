@@ -209,6 +209,37 @@ TEST(LayerNormTest, LayerNorm17_double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDnnlExecutionProvider});
 }
 
+TEST(LayerNormTest, LayerNorm17_Scale_Bias_bfloat16_Cpu) {
+  OpTester test("LayerNormalization", 17);
+  test.AddAttribute<float>("epsilon", 1e-05f);
+
+  // Each row alternates between two values so it normalizes to -1, 1, -1, 1, ... and the outputs are exact in
+  // bfloat16. The hidden size covers a full AVX512 vector.
+  constexpr int64_t hidden_size = 16;
+  std::vector<int64_t> dims{2, hidden_size};
+  std::vector<float> x, gamma, bias, output;
+  for (int64_t i = 0; i < hidden_size; ++i) {
+    gamma.push_back(0.5f * static_cast<float>(i % 5 + 1));
+    bias.push_back(0.25f * static_cast<float>(i % 3) - 0.25f);
+  }
+  for (const auto& [mean, std_dev] : {std::pair{2.0f, 1.0f}, std::pair{-4.0f, 8.0f}}) {
+    for (int64_t i = 0; i < hidden_size; ++i) {
+      const float normalized = i % 2 == 0 ? -1.0f : 1.0f;
+      x.push_back(mean + normalized * std_dev);
+      output.push_back(normalized * gamma[i] + bias[i]);
+    }
+  }
+
+  test.AddInput<BFloat16>("x", dims, FloatsToBFloat16s(x));
+  test.AddInput<BFloat16>("gamma", {hidden_size}, FloatsToBFloat16s(gamma));
+  test.AddInput<BFloat16>("bias", {hidden_size}, FloatsToBFloat16s(bias));
+  test.AddOutput<BFloat16>("output", dims, FloatsToBFloat16s(output));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(LayerNormTest, LayerNorm_InvalidScaleBias) {
   OpTester test("LayerNormalization");
   test.AddAttribute<float>("epsilon", 1e-05f);
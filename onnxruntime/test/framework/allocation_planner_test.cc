@@ -1344,8 +1344,7 @@ TEST_F(PlannerTest, MultiStreamMultiOutput) {
 //    \     /
 //      node3
 // node1 and node2 are in the same stream, both has an output which will be consumed by node3 in a different stream
-// TODO(leca): the ideal case is there is only 1 wait step before launching node3,
-// as there is a specific order between node1 and node2 if they are in the same stream, thus node3 will only need to wait the latter one
+// there is a specific order between node1 and node2 as they are in the same stream, thus node3 only needs a barrier for the latter one
 TEST_F(PlannerTest, MultiStream2NodesSameStreamConsumedBy1NodeInDifferentStream) {
   std::unique_ptr<::onnxruntime::KernelDef> cudaKernel = KernelDefBuilder().SetName("Transpose").Provider(kCudaExecutionProvider).SinceVersion(1, 10).Build();
   std::string Graph_input1("Graph_input1"), Graph_input2("Graph_input2"), Graph_input3("Graph_input3"), Arg1("Arg1"), Arg2("Arg2"), Arg3("Arg3"), node1("node1"), node2("node2"), node3("node3");
@@ -1365,20 +1364,18 @@ TEST_F(PlannerTest, MultiStream2NodesSameStreamConsumedBy1NodeInDifferentStream)
   CreatePlan({}, false);
 
   EXPECT_EQ(GetState().GetExecutionPlan()->execution_plan.size(), 2) << "2 logic streams";
-  EXPECT_EQ(GetState().GetExecutionPlan()->execution_plan[0]->steps_.size(), 6) << "stream 0 has 6 steps";
+  EXPECT_EQ(GetState().GetExecutionPlan()->execution_plan[0]->steps_.size(), 5) << "stream 0 has 5 steps";
   EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[0]).name(), "LaunchKernelStep"), nullptr) << "0th step: LaunchKernelStep for node 1";
   EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[1]).name(), "ActivateNotificationStep"), nullptr) << "1st step: ActivateNofiticationStep by node 1";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[2]).name(), "TriggerDownstreamStep"), nullptr) << "2nd step: TriggerDownstreamStep for node 3";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[3]).name(), "LaunchKernelStep"), nullptr) << "3rd step: LaunchKernelStep for node 2";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[4]).name(), "ActivateNotificationStep"), nullptr) << "4th step: ActivateNofiticationStep by node 2";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[5]).name(), "TriggerDownstreamStep"), nullptr) << "5th step: TriggerDownstreamStep for node 3";
-
-  EXPECT_EQ(GetState().GetExecutionPlan()->execution_plan[1]->steps_.size(), 5) << "stream 1 has 5 steps";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[0]).name(), "BarrierStep"), nullptr) << "0th step: BarrierStep for node 1, for TriggerDownstreamStep in stream 0";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[1]).name(), "BarrierStep"), nullptr) << "1st step: BarrierStep for node 2, for TriggerDownstreamStep in stream 0";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[2]).name(), "WaitOnEPStep"), nullptr) << "2nd step: WaitOnEPStep for node 1, for ActivateNotificationStep in stream 0";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[3]).name(), "WaitOnEPStep"), nullptr) << "3rd step: WaitOnEPStep for node 2, for ActivateNotificationStep in stream 0";
-  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[4]).name(), "LaunchKernelStep"), nullptr) << "4th step: LaunchKernelStep for node 3";
+  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[2]).name(), "LaunchKernelStep"), nullptr) << "2nd step: LaunchKernelStep for node 2, no TriggerDownstreamStep for node 1";
+  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[3]).name(), "ActivateNotificationStep"), nullptr) << "3rd step: ActivateNofiticationStep by node 2";
+  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[0]->steps_[4]).name(), "TriggerDownstreamStep"), nullptr) << "4th step: TriggerDownstreamStep for node 3";
+
+  EXPECT_EQ(GetState().GetExecutionPlan()->execution_plan[1]->steps_.size(), 4) << "stream 1 has 4 steps";
+  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[0]).name(), "BarrierStep"), nullptr) << "0th step: BarrierStep for node 2, for TriggerDownstreamStep in stream 0";
+  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[1]).name(), "WaitOnEPStep"), nullptr) << "1st step: WaitOnEPStep for node 1, for ActivateNotificationStep in stream 0";
+  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[2]).name(), "WaitOnEPStep"), nullptr) << "2nd step: WaitOnEPStep for node 2, for ActivateNotificationStep in stream 0";
+  EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[3]).name(), "LaunchKernelStep"), nullptr) << "3rd step: LaunchKernelStep for node 3";
 }
 #endif
 
@@ -1845,6 +1842,49 @@ TEST_F(PlannerTest, TestMultiStreamConfig) {
               graph_partitioner_cpu_gpu->Streams() == 2);
 }
 
+// Two independent chains of CPU nodes are partitioned into one stream each when multiple CPU streams are allowed:
+// Graph_input -> node_a1 -> node_a2 -> node_a3
+//             -> node_b1 -> node_b2 -> node_b3
+TEST_F(PlannerTest, TestCriticalPathPartitioner) {
+  std::string Graph_input("Graph_input"), A1("A1"), A2("A2"), A3("A3"), B1("B1"), B2("B2"), B3("B3");
+  std::string node_a1("node_a1"), node_a2("node_a2"), node_a3("node_a3");
+  std::string node_b1("node_b1"), node_b2("node_b2"), node_b3("node_b3");
+  std::vector<onnxruntime::NodeArg*> input{Arg(Graph_input)}, a1{Arg(A1)}, a2{Arg(A2)}, a3{Arg(A3)},
+      b1{Arg(B1)}, b2{Arg(B2)}, b3{Arg(B3)};
+  AddNode(*GetStdKernel(), node_a1, input, a1);
+  AddNode(*GetStdKernel(), node_b1, input, b1);
+  AddNode(*GetStdKernel(), node_a2, a1, a2);
+  AddNode(*GetStdKernel(), node_b2, b1, b2);
+  AddNode(*GetStdKernel(), node_a3, a2, a3);
+  AddNode(*GetStdKernel(), node_b3, b2, b3);
+  ASSERT_STATUS_OK(GetGraph().Resolve());
+
+  GraphViewer graph_viewer(GetGraph());
+  auto partitioner = IGraphPartitioner::CreateGraphPartitioner(DefaultLoggingManager().DefaultLogger(),
+                                                               ORT_TSTR(""), 4);
+  ASSERT_STREQ(partitioner->Type(), "CriticalPathPartitioner");
+
+  std::vector<InlinedVector<NodeIndex>> stream_nodes;
+  ASSERT_STATUS_OK(partitioner->PartitionGraph(graph_viewer, GetExecutionProviders(), stream_nodes,
+                                               ExecutionOrder::DEFAULT));
+  ASSERT_EQ(stream_nodes.size(), 2u) << "one stream per chain";
+  for (const auto& nodes : stream_nodes) {
+    ASSERT_EQ(nodes.size(), 3u);
+    // all nodes of a stream belong to the same chain, in order
+    const char chain = graph_viewer.GetNode(nodes[0])->Name()[5];
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      const auto& name = graph_viewer.GetNode(nodes[i])->Name();
+      EXPECT_EQ(name[5], chain);
+      EXPECT_EQ(name.back(), static_cast<char>('1' + i));
+    }
+  }
+
+  // a single CPU stream uses the device based partitioner
+  auto single_stream_partitioner = IGraphPartitioner::CreateGraphPartitioner(DefaultLoggingManager().DefaultLogger(),
+                                                                             ORT_TSTR(""), 1);
+  ASSERT_STREQ(single_stream_partitioner->Type(), "DeviceBasedPartitioner");
+}
+
 // Save partition config to a file and check its completeness
 TEST_F(PlannerTest, TestMultiStreamSaveConfig) {
   const char* config_file_path = "./testdata/multi_stream_models/conv_add_relu_single_stream.json";
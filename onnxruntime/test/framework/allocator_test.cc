@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/allocator.h"
+#include "core/framework/bump_allocator.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -109,5 +110,63 @@ TEST(AllocatorTest, TestOverflowChecks) {
   EXPECT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size - (kAllocAlignment / num_elements), &size));
   EXPECT_FALSE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size, &size));
 }
+
+TEST(AllocatorTest, BumpAllocatorPool) {
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  BumpAllocatorPool pool(cpu_allocator, 4096);
+
+  BumpAllocator* first_allocator = nullptr;
+  {
+    // the first use of an allocator has no region so everything falls back
+    auto allocator = pool.Acquire();
+    first_allocator = allocator.get();
+    EXPECT_EQ(allocator->Info(), cpu_allocator->Info());
+    EXPECT_EQ(allocator->Alloc(100), nullptr);
+    EXPECT_EQ(allocator->Alloc(1000), nullptr);
+    // larger than the maximum region size so not counted
+    EXPECT_EQ(allocator->Alloc(8192), nullptr);
+  }
+
+  {
+    // the region grows to fit the previous demand
+    auto allocator = pool.Acquire();
+    EXPECT_EQ(allocator.get(), first_allocator);
+    EXPECT_EQ(allocator->RegionSize(), kAllocAlignment + 1024);
+
+    auto* p1 = static_cast<char*>(allocator->Alloc(100));
+    auto* p2 = static_cast<char*>(allocator->Alloc(1000));
+    ASSERT_NE(p1, nullptr);
+    ASSERT_NE(p2, nullptr);
+    EXPECT_EQ(p2 - p1, static_cast<ptrdiff_t>(kAllocAlignment));
+    memset(p1, 1, 100);
+    memset(p2, 2, 1000);
+    allocator->Free(p1);
+
+    // exhausted. Free doesn't make the space available again
+    EXPECT_EQ(allocator->Alloc(100), nullptr);
+
+    AllocatorStats stats;
+    allocator->GetStats(&stats);
+    EXPECT_EQ(stats.num_allocs, 2);
+    EXPECT_EQ(stats.bytes_in_use, static_cast<int64_t>(allocator->RegionSize()));
+
+    // a concurrent user gets a different allocator
+    auto other_allocator = pool.Acquire();
+    EXPECT_NE(other_allocator.get(), first_allocator);
+  }
+
+  {
+    // the region is limited to the maximum size
+    auto allocator = pool.Acquire();
+    EXPECT_EQ(allocator.get(), first_allocator);
+    EXPECT_EQ(allocator->RegionSize(), kAllocAlignment + 1024 + kAllocAlignment);
+    for (int i = 0; i < 20; ++i) {
+      allocator->Alloc(kAllocAlignment);
+    }
+  }
+
+  auto allocator = pool.Acquire();
+  EXPECT_EQ(allocator->RegionSize(), size_t{4096});
+}
 }  // namespace test
 }  // namespace onnxruntime
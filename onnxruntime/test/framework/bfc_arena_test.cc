@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -475,5 +476,88 @@ TEST(BFCArenaTest, TestExtendStrategy) {
   ASSERT_EQ(extend_delta_bytes, extend_limit);
 }
 
+TEST(BFCArenaTest, ThreadCache) {
+  constexpr int64_t thread_cache_max_bytes = 16 * 1024;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             thread_cache_max_bytes);
+
+  // the first allocation misses and refills the cache with a few more chunks of the same size
+  void* p1 = a.Alloc(1000);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 0);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_GT(stats.thread_cache_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_use, stats.num_allocs * 1024);
+
+  void* p2 = a.Alloc(1000);
+  EXPECT_NE(p1, p2);
+  a.Free(p1);
+  void* p3 = a.Alloc(1024);
+  EXPECT_EQ(p1, p3);  // served from the free list
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 2);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+
+  // large allocations bypass the cache
+  void* large = a.Alloc(1 << 20);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 2);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  a.Free(large);
+
+  // the cache is flushed back to the arena when it exceeds its budget
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 64; ++i) {
+    ptrs.push_back(a.Alloc(512));
+  }
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+  a.GetStats(&stats);
+  EXPECT_LE(stats.thread_cache_bytes, thread_cache_max_bytes);
+
+  a.Free(p2);
+  a.Free(p3);
+}
+
+TEST(BFCArenaTest, ThreadCacheCrossThreadFree) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             64 * 1024);
+
+  void* p = a.Alloc(256);
+
+  // freed by another thread. the chunk goes back to the allocating thread's cache.
+  std::thread t([&a, p]() { a.Free(p); });
+  t.join();
+
+  void* allocated_on_other_thread = nullptr;
+  std::thread t2([&a, &allocated_on_other_thread]() { allocated_on_other_thread = a.Alloc(256); });
+  t2.join();
+
+  // the chunk freed by the other thread is picked up by this thread's cache on its next miss
+  std::vector<void*> ptrs;
+  bool found = false;
+  for (int i = 0; i < 8 && !found; ++i) {
+    ptrs.push_back(a.Alloc(256));
+    found = ptrs.back() == p;
+  }
+  EXPECT_TRUE(found);
+
+  // the thread that exited returned its cache to the arena, so freeing its allocation goes directly to the arena
+  a.Free(allocated_on_other_thread);
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, stats.thread_cache_bytes);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
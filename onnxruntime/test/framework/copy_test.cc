@@ -3,6 +3,10 @@
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+
+#include <array>
+#include <numeric>
+
 #include "core/framework/copy.h"
 #include "core/platform/threadpool.h"
 #include "core/util/thread_utils.h"
@@ -109,6 +113,51 @@ TEST_F(CopyTest, Concat2D) {
   }
 }
 
+TEST_F(CopyTest, Broadcast3D) {
+  // test broadcasting a [4, 1] src to [3, 4, 5] using strides of 0
+  int src[4] = {1, 2, 3, 4};
+  int dst[3 * 4 * 5];
+
+  StridedCopy<int>(tp.get(), dst, {20, 5, 1}, {3, 4, 5}, src, {0, 1, 0});
+
+  for (int i0 = 0; i0 < 3; i0++) {
+    for (int i1 = 0; i1 < 4; i1++) {
+      for (int i2 = 0; i2 < 5; i2++) {
+        EXPECT_EQ(src[i1], dst[i0 * 20 + i1 * 5 + i2]);
+      }
+    }
+  }
+}
+
+TEST_F(CopyTest, StridedForEachSpan) {
+  // sum a [2, 1, 3] tensor and a [1, 4, 3] tensor into a [2, 4, 3] output
+  constexpr int64_t numel = 2 * 4 * 3;
+  std::vector<int64_t> a(2 * 3), b(4 * 3), out(numel, -1);
+  std::iota(a.begin(), a.end(), int64_t{100});
+  std::iota(b.begin(), b.end(), int64_t{0});
+
+  std::array<TensorShapeVector, 3> strides{TensorShapeVector{12, 3, 1},
+                                           TensorShapeVector{3, 0, 1},
+                                           TensorShapeVector{0, 3, 1}};
+  StridedForEachSpan<3>(
+      tp.get(), TensorShape({2, 4, 3}), strides, {8.0, 8.0, 1.0},
+      [&](const std::array<std::ptrdiff_t, 3>& offsets, const std::array<std::ptrdiff_t, 3>& inner_strides,
+          std::ptrdiff_t count) {
+        for (std::ptrdiff_t i = 0; i < count; i++) {
+          out[offsets[0] + i * inner_strides[0]] = a[offsets[1] + i * inner_strides[1]] +
+                                                   b[offsets[2] + i * inner_strides[2]];
+        }
+      });
+
+  for (int i0 = 0; i0 < 2; i0++) {
+    for (int i1 = 0; i1 < 4; i1++) {
+      for (int i2 = 0; i2 < 3; i2++) {
+        EXPECT_EQ(a[i0 * 3 + i2] + b[i1 * 3 + i2], out[i0 * 12 + i1 * 3 + i2]);
+      }
+    }
+  }
+}
+
 TEST_F(CopyTest, CoalesceTensorsTest) {
   {
     TensorShapeVector strides_a{3, 1};
@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -330,6 +331,128 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+#ifndef ENABLE_TRAINING
+TEST_F(ExecutionFrameTest, BucketedMemPatternGrowsTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def1("X1", &tensor_float),
+      input_def2("X2", &tensor_float),
+      input_def3("X3", &tensor_float),
+      gemm1_out_def("T1", &tensor_float),
+      gemm2_out_def("T2", &tensor_float),
+      clip_out_def("T3", &tensor_float);
+
+  graph.AddNode("node1", "MatMul", "gemm1", ArgMap{&input_def1, &input_def2}, ArgMap{&gemm1_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "MatMul", "gemm2", ArgMap{&gemm1_out_def, &input_def3}, ArgMap{&gemm2_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "Clip", "clip1", ArgMap{&gemm2_out_def}, ArgMap{&clip_out_def})
+      .SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsMemoryPatternDimBuckets, "16"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  ASSERT_TRUE(state.IsMemoryPatternBucketed());
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+
+  int x1_idx = -1, x2_idx = -1, x3_idx = -1;
+  int t1_idx = -1, t2_idx = -1, t3_idx = -1;
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X1", x1_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X2", x2_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X3", x3_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T1", t1_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T2", t2_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T3", t3_idx).IsOK());
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->CreatePreferredAllocators()[0];
+  const auto& location = cpu_allocator->Info().device;
+
+  // X1 has `rows` rows, which are in the same bucket for both runs, and so are T1 and T2
+  auto create_feeds = [&cpu_allocator](int64_t rows) {
+    std::vector<OrtValue> feeds(3);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{rows, 8},
+                         std::vector<float>(static_cast<size_t>(rows) * 8, 1.0f), &feeds[0]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{8, 8}, std::vector<float>(64, 1.0f), &feeds[1]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{8, 8}, std::vector<float>(64, 1.0f), &feeds[2]);
+    return feeds;
+  };
+
+  // allocates T1 and T2 as a run does, and updates the cached patterns as the executor does
+  auto run = [&](const std::vector<OrtValue>& feeds, int64_t rows, bool expect_update) {
+    std::vector<OrtValue> outputs;
+    ExecutionFrame frame(AsSpan({x1_idx, x2_idx, x3_idx}), feeds, AsSpan({t3_idx}), outputs, {}, {}, state);
+
+    for (int idx : {t1_idx, t2_idx}) {
+      OrtValue& value = *frame.GetMutableNodeInputOrOutputMLValue(idx);
+      ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(value, idx, DataTypeImpl::GetType<float>(), location,
+                                                                TensorShape({rows, 8})));
+    }
+
+    ASSERT_EQ(frame.ShouldUpdateMemoryPatterns(), expect_update);
+    if (expect_update) {
+      MemoryPatternGroup patterns;
+      ASSERT_STATUS_OK(frame.GeneratePatterns(patterns));
+      ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(feeds, std::move(patterns)));
+    }
+  };
+
+  const size_t small_size = 2 * 8 * sizeof(float);
+  const size_t large_size = 4 * 8 * sizeof(float);
+  const std::vector<OrtValue> small_feeds = create_feeds(2);
+  const std::vector<OrtValue> large_feeds = create_feeds(4);
+  const std::vector<int> feed_idxs{x1_idx, x2_idx, x3_idx};
+
+  // the first run generates the patterns of the bucket
+  run(small_feeds, 2, true);
+  auto entry = state.GetMemoryPatternGroup(small_feeds, feed_idxs);
+  ASSERT_NE(entry, nullptr);
+  ASSERT_EQ(entry->mem_patterns.GetPatterns(location)->GetBlock(t1_idx)->size_, small_size);
+
+  // the blocks are too small for the second run, which grows the patterns of the bucket
+  run(large_feeds, 4, true);
+  auto grown_entry = state.GetMemoryPatternGroup(small_feeds, feed_idxs);
+  ASSERT_EQ(grown_entry, state.GetMemoryPatternGroup(large_feeds, feed_idxs));
+  ASSERT_NE(grown_entry, entry);
+  const auto* pattern = grown_entry->mem_patterns.GetPatterns(location);
+  EXPECT_EQ(pattern->GetBlock(t1_idx)->size_, large_size);
+  EXPECT_EQ(pattern->GetBlock(t2_idx)->size_, large_size);
+  EXPECT_EQ(pattern->PeakSize(), 2 * large_size);
+
+  // both shapes fit in the grown patterns, so they are left as they are
+  run(small_feeds, 2, false);
+  run(large_feeds, 4, false);
+  EXPECT_EQ(state.GetMemoryPatternGroup(large_feeds, feed_idxs), grown_entry);
+  EXPECT_EQ(state.GetMemoryPatternCacheStats().num_entries, 1u);
+}
+#endif
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
@@ -47,6 +47,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/request_batcher.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -797,6 +798,35 @@ TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
   ASSERT_TRUE(before_start_time <= profiling_start_time && profiling_start_time <= after_start_time);
 }
 
+TEST(InferenceSessionTests, CheckRunAggregateProfiler) {
+  SessionOptions so;
+  so.session_logid = "CheckRunAggregateProfiler";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigAggregateProfiling, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  std::string profile;
+  ASSERT_STATUS_OK(session_object.GetAggregateProfile(profile));
+  EXPECT_NE(profile.find("\"op_type\": \"Mul\""), std::string::npos);
+  EXPECT_NE(profile.find("\"calls\": 2"), std::string::npos);
+
+  ASSERT_STATUS_OK(session_object.ResetAggregateProfile());
+  ASSERT_STATUS_OK(session_object.GetAggregateProfile(profile));
+  EXPECT_EQ(profile.find("Mul"), std::string::npos);
+
+  // not available unless enabled
+  InferenceSession session_without_profiler(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(session_without_profiler.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_profiler.Initialize());
+  ASSERT_FALSE(session_without_profiler.GetAggregateProfile(profile).IsOK());
+}
+
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   SessionOptions session_options;
 
@@ -2996,5 +3026,178 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
   VerifyThreadPoolWithDenormalAsZero(session2.GetInterOpThreadPoolToUse(), false);
 }
 
+TEST(InferenceSessionTests, RunBumpAllocator) {
+  // Z = Neg(Relu(X)). The output of Relu is an intermediate tensor.
+  onnxruntime::Model model("run_bump_allocator", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  constexpr int64_t num_elements = 1024;
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(num_elements);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& t = graph.GetOrCreateNodeArg("T", &float_tensor);
+  auto& z = graph.GetOrCreateNodeArg("Z", &float_tensor);
+  graph.AddNode("relu", "Relu", "", {&x}, {&t});
+  graph.AddNode("neg", "Neg", "", {&t}, {&z});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_str;
+  model.ToProto().SerializeToString(&model_str);
+  std::stringstream sstr(model_str);
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  // tensors covered by a memory pattern are not allocated from the bump allocator
+  so.enable_mem_pattern = false;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsRunBumpAllocatorMaxBytes, "1048576"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<float> x_values(num_elements);
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    x_values[i] = static_cast<float>(i) - num_elements / 2;
+  }
+
+  auto run = [&]() {
+    OrtValue feed;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {num_elements}, x_values,
+                         &feed);
+    NameMLValMap feeds{{"X", feed}};
+    std::vector<std::string> output_names{"Z"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto z_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      ASSERT_EQ(z_values[i], -std::max(x_values[i], 0.f));
+    }
+  };
+
+  // a run that doesn't overlap with another gets the allocator of the previous run back from the pool
+  const auto& session_state = session_object.GetSessionState();
+  auto get_stats = [&session_state](size_t& region_size) {
+    auto allocator = session_state.AcquireRunBumpAllocator();
+    region_size = allocator->RegionSize();
+    AllocatorStats stats;
+    allocator->GetStats(&stats);
+    return stats;
+  };
+
+  constexpr int64_t intermediate_bytes = num_elements * sizeof(float);
+  size_t region_size = 0;
+
+  // the allocator has no region on its first run so T falls back to the CPU allocator. the region is sized to fit
+  // the demand of that run afterwards.
+  run();
+  auto stats = get_stats(region_size);
+  EXPECT_EQ(stats.num_allocs, 0);
+  EXPECT_EQ(region_size, static_cast<size_t>(intermediate_bytes));
+
+  // T is allocated from the region, which is released when the run completes
+  run();
+  stats = get_stats(region_size);
+  EXPECT_EQ(stats.num_allocs, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, intermediate_bytes);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  // the region is reused by the next run
+  run();
+  stats = get_stats(region_size);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 2 * intermediate_bytes);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_reserves, 1);
+  EXPECT_EQ(region_size, static_cast<size_t>(intermediate_bytes));
+}
+
+TEST(InferenceSessionTests, RequestBatcher) {
+  // Z = X + Y with shape {batch, seq}
+  onnxruntime::Model model("request_batcher", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  auto& z = graph.GetOrCreateNodeArg("Z", &float_tensor);
+  graph.AddNode("add", "Add", "", {&x, &y}, {&z});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_str;
+  model.ToProto().SerializeToString(&model_str);
+  std::stringstream sstr(model_str);
+
+  SessionOptions so;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RequestBatcherOptions options;
+  options.batch_dim_param = "batch";
+  options.padded_dim_params = {"seq"};
+  options.max_batch_size = 4;
+  // long enough for all the requests to be batched together
+  options.max_delay = std::chrono::seconds(10);
+  std::unique_ptr<RequestBatcher> batcher;
+  ASSERT_STATUS_OK(RequestBatcher::Create(session_object, options, batcher));
+
+  // the first request has a batch size of 2
+  constexpr int num_requests = 3;
+  auto run_request = [&](int request_index) {
+    const int64_t batch = request_index == 0 ? 2 : 1;
+    const int64_t seq = request_index + 1;
+    std::vector<int64_t> dims{batch, seq};
+    std::vector<float> x_values(batch * seq);
+    std::vector<float> y_values(batch * seq);
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      x_values[i] = static_cast<float>(request_index * 100 + i);
+      y_values[i] = 0.5f;
+    }
+
+    std::vector<OrtValue> feeds(2);
+    auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+    CreateMLValue<float>(allocator, dims, x_values, &feeds[0]);
+    CreateMLValue<float>(allocator, dims, y_values, &feeds[1]);
+    std::vector<std::string> feed_names{"X", "Y"};
+    std::vector<std::string> output_names{"Z"};
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(batcher->Run(feed_names, feeds, output_names, fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    const auto& output = fetches[0].Get<Tensor>();
+    ASSERT_EQ(output.Shape(), TensorShape(dims));
+    auto output_values = output.DataAsSpan<float>();
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      EXPECT_EQ(output_values[i], x_values[i] + 0.5f);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back(run_request, i);
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // the combined batch size of the requests is max_batch_size, so they were executed in a single run
+  const auto stats = batcher->GetStats();
+  EXPECT_EQ(stats.requests, static_cast<uint64_t>(num_requests));
+  EXPECT_EQ(stats.runs, 1u);
+
+  // requests with names the model doesn't have are rejected
+  std::vector<OrtValue> fetches;
+  std::vector<std::string> feed_names{"W"};
+  std::vector<OrtValue> feeds(1);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1}, {1.f}, &feeds[0]);
+  EXPECT_FALSE(batcher->Run(feed_names, feeds, {}, fetches).IsOK());
+}
+
 }  // namespace test
 }  // namespace onnxruntime
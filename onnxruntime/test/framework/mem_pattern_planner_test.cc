@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/memory_pattern_cache.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
 #include "gtest/gtest.h"
 
 namespace onnxruntime {
@@ -35,5 +38,101 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+static OrtValue CreateInput(const TensorShape& shape) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, std::make_shared<CPUAllocator>(), value);
+  return value;
+}
+
+TEST(MemoryPatternCacheTest, BucketedKeys) {
+  MemoryPatternCache cache;
+  cache.Configure({16, 32, 64}, 0);
+  ASSERT_TRUE(cache.IsBucketed());
+
+  std::vector<OrtValue> inputs_a{CreateInput({1, 17}), CreateInput({1, 17})};
+  std::vector<OrtValue> inputs_b{CreateInput({1, 32}), CreateInput({1, 30})};
+  std::vector<OrtValue> inputs_c{CreateInput({1, 33}), CreateInput({1, 17})};
+  std::vector<OrtValue> inputs_d{CreateInput({1, 100}), CreateInput({1, 17})};
+  std::vector<OrtValue> inputs_e{CreateInput({1, 101}), CreateInput({1, 17})};
+
+  EXPECT_EQ(cache.CalculateKey(inputs_a), cache.CalculateKey(inputs_b));
+  EXPECT_NE(cache.CalculateKey(inputs_a), cache.CalculateKey(inputs_c));
+  // dims beyond the last bucket are used as is
+  EXPECT_NE(cache.CalculateKey(inputs_d), cache.CalculateKey(inputs_e));
+
+  // rank is part of the key
+  std::vector<OrtValue> inputs_f{CreateInput({2, 3})};
+  std::vector<OrtValue> inputs_g{CreateInput({2}), CreateInput({3})};
+  EXPECT_NE(cache.CalculateKey(inputs_f), cache.CalculateKey(inputs_g));
+}
+
+TEST(MemoryPatternCacheTest, LruEviction) {
+  MemoryPatternCache cache;
+  cache.Configure({}, 2);
+  ASSERT_FALSE(cache.IsBucketed());
+
+  cache.Insert(1, {});
+  cache.Insert(2, {});
+  auto entry_1 = cache.Find(1);
+  ASSERT_NE(entry_1, nullptr);
+
+  // 2 is the least recently used entry
+  cache.Insert(3, {});
+  EXPECT_EQ(cache.Find(2), nullptr);
+  EXPECT_NE(cache.Find(1), nullptr);
+  EXPECT_NE(cache.Find(3), nullptr);
+
+  // evicted entries stay valid while in use
+  cache.Insert(4, {});
+  cache.Insert(5, {});
+  EXPECT_EQ(cache.Find(1), nullptr);
+  EXPECT_TRUE(entry_1->mem_patterns.locations.empty());
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.num_entries, 2u);
+  EXPECT_EQ(stats.capacity, 2u);
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.evictions, 3u);
+}
+
+static MemoryPatternCache::Entry CreateEntry(const OrtDevice& location, std::initializer_list<size_t> block_sizes) {
+  MemPatternPlanner planner{/*using_counters*/ false};
+  int ort_value_idx = 0;
+  for (size_t block_size : block_sizes) {
+    planner.TraceAllocation(ort_value_idx++, block_size);
+  }
+
+  MemoryPatternCache::Entry entry;
+  entry.mem_patterns.locations.push_back(location);
+  entry.mem_patterns.patterns.push_back(planner.GenerateMemPattern());
+  return entry;
+}
+
+TEST(MemoryPatternCacheTest, InsertOrGrow) {
+  MemoryPatternCache cache;
+  cache.Configure({16, 32, 64}, 0);
+  const OrtDevice location;
+
+  auto entry = cache.InsertOrGrow(1, CreateEntry(location, {256, 512}));
+  EXPECT_EQ(entry->mem_patterns.GetPatterns(location)->PeakSize(), 256u + 512u);
+
+  // a pattern for larger tensors in the same bucket replaces the existing one
+  entry = cache.InsertOrGrow(1, CreateEntry(location, {256, 1024}));
+  EXPECT_EQ(entry->mem_patterns.GetPatterns(location)->PeakSize(), 256u + 1024u);
+
+  // patterns that are smaller, the same, or smaller for some tensors don't
+  entry = cache.InsertOrGrow(1, CreateEntry(location, {128, 1024}));
+  EXPECT_EQ(entry->mem_patterns.GetPatterns(location)->GetBlock(0)->size_, 256u);
+  entry = cache.InsertOrGrow(1, CreateEntry(location, {256, 1024}));
+  EXPECT_EQ(entry->mem_patterns.GetPatterns(location)->PeakSize(), 256u + 1024u);
+  entry = cache.InsertOrGrow(1, CreateEntry(location, {512, 512}));
+  EXPECT_EQ(entry->mem_patterns.GetPatterns(location)->GetBlock(0)->size_, 256u);
+
+  EXPECT_EQ(cache.Find(1), entry);
+  EXPECT_EQ(cache.GetStats().num_entries, 1u);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
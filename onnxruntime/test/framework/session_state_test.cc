@@ -337,6 +337,59 @@ TEST(SessionStateTest, TestInitializerMemoryAllocatedUsingNonArenaMemory) {
 
 #endif
 
+// Test that initializers with external data consumed on CPU are served from the external data file without planned
+// initializer memory only if the session opts in
+TEST(SessionStateTest, TestMappedExternalInitializers) {
+  for (const bool use_mapped_external_initializers : {false, true}) {
+    SCOPED_TRACE(MakeString("use_mapped_external_initializers: ", use_mapped_external_initializers));
+    const std::basic_string<ORTCHAR_T> model_path = ORT_TSTR("testdata/model_with_external_initializers.onnx");
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(model_path, model, nullptr, DefaultLoggingManager().DefaultLogger()));
+    Graph& graph = model->MainGraph();
+
+    ExecutionProviders execution_providers;
+    CPUExecutionProviderInfo epi{false};
+    ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::make_unique<CPUExecutionProvider>(epi)));
+
+    KernelRegistryManager krm;
+    ASSERT_STATUS_OK(krm.RegisterKernels(execution_providers));
+
+    DataTransferManager dtm;
+    profiling::Profiler profiler;
+
+    SessionOptions sess_options;
+    sess_options.enable_mem_pattern = true;
+    sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+    // plan the initializers into a single buffer, which is only done without pre-packing
+    ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigDisablePrepacking, "1"));
+    ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsUseMappedExternalInitializers,
+                                                                use_mapped_external_initializers ? "1" : "0"));
+
+    SessionState session_state(graph, execution_providers, nullptr, nullptr, dtm,
+                               DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+    AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+    GraphPartitioner partitioner(krm, execution_providers);
+    ASSERT_STATUS_OK(partitioner.Partition(
+        graph, session_state.GetMutableFuncMgr(),
+        [&cpu_allocator](Graph& graph, bool& modified, const IExecutionProvider& execution_provider,
+                         const layout_transformation::DebugGraphFn& debug_graph_fn) -> Status {
+          return layout_transformation::TransformLayoutForEP(graph, modified, execution_provider,
+                                                             cpu_allocator, debug_graph_fn);
+        }));
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(model_path, krm));
+
+    // the external 'Pads' is the only initializer, so no buffer is allocated for initializers if it is mapped
+    EXPECT_EQ(session_state.GetMutableWeightsBuffers().size(), use_mapped_external_initializers ? 0u : 1u);
+
+    const auto& initialized_tensors = session_state.GetInitializedTensors();
+    ASSERT_EQ(initialized_tensors.size(), 1u);
+    auto pads = initialized_tensors.begin()->second.Get<Tensor>().DataAsSpan<int64_t>();
+    EXPECT_EQ(std::vector<int64_t>(pads.begin(), pads.end()), (std::vector<int64_t>{0, 0, 1, 1}));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateTestP, testing::ValuesIn(param_list));
 
 #ifndef ENABLE_TRAINING_CORE
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/framework/allocator.h"
 #include "core/framework/transpose_helper.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace test {
@@ -34,5 +37,79 @@ TEST(TransposeIsMovingSingleAxis, test4) {
   size_t from = 0, to = 0;
   ASSERT_FALSE(IsTransposeMovingSingleAxis(perm, from, to));
 }
+
+// Transposes an input filled with the element indices, with and without a thread pool, and checks every element.
+template <typename T>
+static void TestGeneralTranspose(const std::vector<int64_t>& input_dims, const std::vector<size_t>& perm) {
+  const size_t rank = input_dims.size();
+  const TensorShape input_shape(input_dims);
+  const auto size = static_cast<size_t>(input_shape.Size());
+
+  std::vector<int64_t> output_dims(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    output_dims[i] = input_dims[perm[i]];
+  }
+
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  Tensor input(DataTypeImpl::GetType<T>(), input_shape, allocator);
+  T* input_data = input.MutableData<T>();
+  for (size_t i = 0; i < size; ++i) {
+    input_data[i] = static_cast<T>(i);
+  }
+
+  std::vector<T> expected(size);
+  for (size_t i = 0; i < size; ++i) {
+    size_t rest = i;
+    size_t input_offset = 0;
+    for (size_t axis = rank; axis-- > 0;) {
+      const auto dim = static_cast<size_t>(output_dims[axis]);
+      input_offset += (rest % dim) * static_cast<size_t>(input_shape.SizeFromDimension(perm[axis] + 1));
+      rest /= dim;
+    }
+    expected[i] = input_data[input_offset];
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 4;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+
+  for (auto* tp : {static_cast<concurrency::ThreadPool*>(nullptr), thread_pool.get()}) {
+    Tensor output(DataTypeImpl::GetType<T>(), TensorShape(output_dims), allocator);
+    GeneralTranspose(perm, input, output, nullptr, tp);
+    const T* output_data = output.Data<T>();
+    ASSERT_EQ(std::vector<T>(output_data, output_data + size), expected)
+        << "shape " << input_shape << " with " << (tp ? "" : "no ") << "thread pool";
+  }
+}
+
+TEST(GeneralTranspose, BlockCopy) {
+  // {B, S, N, H} to {B, N, S, H} as in attention
+  TestGeneralTranspose<float>({2, 67, 12, 33}, {0, 2, 1, 3});
+  TestGeneralTranspose<uint8_t>({3, 5, 7, 3}, {2, 0, 1, 3});
+  TestGeneralTranspose<uint16_t>({4, 1, 6, 5, 11}, {3, 1, 2, 0, 4});
+}
+
+TEST(GeneralTranspose, SmallBlocksAsElements) {
+  TestGeneralTranspose<float>({2, 67, 12, 2}, {0, 2, 1, 3});
+  TestGeneralTranspose<uint8_t>({9, 130, 2}, {1, 0, 2});
+  TestGeneralTranspose<uint8_t>({9, 130, 4}, {1, 0, 2});
+  TestGeneralTranspose<uint8_t>({9, 130, 8}, {1, 0, 2});
+}
+
+TEST(GeneralTranspose, Tiled) {
+  TestGeneralTranspose<uint8_t>({3, 130, 270}, {0, 2, 1});
+  TestGeneralTranspose<uint16_t>({3, 130, 70}, {0, 2, 1});
+  TestGeneralTranspose<float>({3, 130, 70}, {2, 0, 1});
+  TestGeneralTranspose<double>({3, 130, 70}, {0, 2, 1});
+  TestGeneralTranspose<float>({5, 1, 7, 9, 4}, {3, 1, 0, 4, 2});
+  TestGeneralTranspose<float>({2, 3, 4, 5}, {3, 2, 1, 0});
+  TestGeneralTranspose<int64_t>({1, 2, 3, 1, 4, 5}, {5, 4, 0, 1, 2, 3});
+}
+
+TEST(GeneralTranspose, Reshape) {
+  TestGeneralTranspose<float>({1, 8, 1, 5}, {2, 1, 0, 3});
+  TestGeneralTranspose<float>({6, 1, 1}, {2, 0, 1});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
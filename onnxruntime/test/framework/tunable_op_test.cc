@@ -6,10 +6,8 @@
 #include <chrono>
 
 #include "core/common/common.h"
+// The TuningContext implementation is provided by the CPU EP, which is linked into the tests.
 #include "core/framework/tunable.h"
-#define TUNING_CONTEXT_IMPL
-#include "core/framework/tuning_context_impl.h"
-#undef TUNING_CONTEXT_IMPL
 
 using namespace std::chrono_literals;
 
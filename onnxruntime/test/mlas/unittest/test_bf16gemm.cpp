@@ -0,0 +1,136 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_bf16gemm.cpp
+
+Abstract:
+
+    Tests for MLAS bfloat16 GEMM.
+
+--*/
+
+#include "test_util.h"
+
+#include <cstring>
+
+inline float Bf16ToFloat(uint16_t v) {
+  const uint32_t bits = uint32_t(v) << 16;
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+inline uint16_t FloatToBf16(float v) {
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  return uint16_t(bits >> 16);
+}
+
+template <bool Packed, bool Threaded>
+class MlasBf16GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint16_t> BufferA;
+  MatrixGuardBuffer<uint16_t> BufferB;
+  MatrixGuardBuffer<uint16_t> BufferC;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void FillBf16(uint16_t* start, size_t size) {
+    std::default_random_engine generator(static_cast<unsigned>(size));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < size; i++) {
+      start[i] = FloatToBf16(distribution(generator));
+    }
+  }
+
+ public:
+  MlasBf16GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(bool TransA, bool TransB, size_t M, size_t N, size_t K, float alpha, float beta) {
+    const size_t lda = TransA ? M : K;
+    const size_t ldb = TransB ? K : N;
+
+    const uint16_t* A = BufferA.GetFilledBuffer(M * K, FillBf16);
+    const uint16_t* B = BufferB.GetFilledBuffer(K * N, FillBf16);
+    uint16_t* C = BufferC.GetFilledBuffer(M * N, FillBf16);
+    std::vector<uint16_t> COriginal(C, C + M * N);
+
+    MLAS_BF16_GEMM_DATA_PARAMS params;
+    params.A = reinterpret_cast<const MLAS_BF16*>(A);
+    params.lda = lda;
+    params.B = B;
+    params.ldb = ldb;
+    params.C = reinterpret_cast<MLAS_BF16*>(C);
+    params.ldc = N;
+    params.alpha = alpha;
+    params.beta = beta;
+
+    if (Packed) {
+      size_t PackedBSize = MlasBf16GemmPackBSize(N, K);
+      void* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+      MlasBf16GemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, reinterpret_cast<const MLAS_BF16*>(B), ldb,
+                        PackedB);
+      params.B = PackedB;
+      params.BIsPacked = true;
+    }
+
+    MlasBf16GemmBatch(TransA ? CblasTrans : CblasNoTrans, TransB ? CblasTrans : CblasNoTrans,
+                      M, N, K, &params, 1, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0;
+        for (size_t k = 0; k < K; k++) {
+          const float a = Bf16ToFloat(TransA ? A[k * lda + m] : A[m * lda + k]);
+          const float b = Bf16ToFloat(TransB ? B[n * ldb + k] : B[k * ldb + n]);
+          sum += double(a) * double(b);
+        }
+        const double expected = alpha * sum + beta * Bf16ToFloat(COriginal[m * N + n]);
+        const double actual = Bf16ToFloat(C[m * N + n]);
+        // the result is rounded to bfloat16 (8 bits of mantissa) and the products are summed in fp32
+        const double tolerance = std::abs(expected) / 128 + 1e-5 * K;
+        ASSERT_NEAR(actual, expected, tolerance)
+            << "@[" << m << "x" << n << "], M=" << M << ", N=" << N << ", K=" << K
+            << ", TransA=" << TransA << ", TransB=" << TransB;
+      }
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Bf16Gemm") +
+                                          (Packed ? "_Packed" : "_NoPack") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t sizes[] = {1, 2, 3, 15, 16, 17, 31, 32, 33, 63, 129};
+    for (size_t M : sizes) {
+      for (size_t N : sizes) {
+        Test(false, false, M, N, M + N, 1.0f, 0.0f);
+        Test(true, false, M, N, 2 * N + 1, 0.5f, 1.0f);
+        Test(false, true, M, N, 300, 1.0f, 0.5f);
+        Test(true, true, M, N, 33, 2.0f, 0.0f);
+      }
+    }
+    Test(false, false, 70, 300, 600, 1.0f, 0.0f);
+    Test(false, true, 1, 1000, 257, 1.0f, 0.0f);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<false, true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<true, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<true, true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasConvSymTest : public MlasTestBase {
+ private:
+  // NHWC convolution of a single image with a square kernel, stride 1 and
+  // "same" padding, so that every output has KernelSize input pixels.
+  void Test(size_t Height, size_t Width, size_t KernelDim, size_t InputChannels, size_t OutputChannels,
+            bool PerChannelScale) {
+    const size_t KernelSize = KernelDim * KernelDim;
+    const size_t OutputCount = Height * Width;
+
+    const size_t PackedSize = MlasConvSymPackWSize(1, InputChannels, OutputChannels, KernelSize, false);
+    if (PackedSize == 0) {
+      return;
+    }
+
+    std::default_random_engine generator(static_cast<unsigned>(OutputCount * 7 + InputChannels * 3 + OutputChannels));
+    std::uniform_int_distribution<int> input_distribution(0, 255);
+    std::uniform_int_distribution<int> filter_distribution(-127, 127);
+    std::uniform_int_distribution<int> bias_distribution(-5000, 5000);
+
+    const int32_t InputZeroPoint = 117;
+    const int32_t OutputZeroPoint = 131;
+
+    std::vector<uint8_t> Input(OutputCount * InputChannels);
+    std::vector<int8_t> Filter(OutputChannels * InputChannels * KernelSize);
+    std::vector<int32_t> Bias(OutputChannels);
+    std::vector<float> Scale(PerChannelScale ? OutputChannels : 1);
+    for (auto& v : Input) v = static_cast<uint8_t>(input_distribution(generator));
+    for (auto& v : Filter) v = static_cast<int8_t>(filter_distribution(generator));
+    for (auto& v : Bias) v = bias_distribution(generator);
+    for (size_t i = 0; i < Scale.size(); i++) Scale[i] = 0.0005f + 0.0001f * static_cast<float>(i % 7);
+
+    // The kernels expect the input zero point folded into the bias.
+    std::vector<int32_t> KernelBias(OutputChannels);
+    for (size_t oc = 0; oc < OutputChannels; oc++) {
+      int32_t sum = 0;
+      for (size_t i = 0; i < InputChannels * KernelSize; i++) {
+        sum += Filter[oc * InputChannels * KernelSize + i];
+      }
+      KernelBias[oc] = Bias[oc] - InputZeroPoint * sum;
+    }
+
+    std::vector<int8_t> PackedFilter(PackedSize);
+    MlasConvSymPackW(1, InputChannels, OutputChannels, KernelSize, Filter.data(), PackedFilter.data(), PackedSize,
+                     false);
+
+    std::vector<uint8_t> Padding(InputChannels, static_cast<uint8_t>(InputZeroPoint));
+    std::vector<const void*> Indirection(OutputCount * KernelSize);
+    const ptrdiff_t Pad = static_cast<ptrdiff_t>(KernelDim / 2);
+    for (size_t h = 0; h < Height; h++) {
+      for (size_t w = 0; w < Width; w++) {
+        for (size_t kh = 0; kh < KernelDim; kh++) {
+          for (size_t kw = 0; kw < KernelDim; kw++) {
+            const ptrdiff_t ih = static_cast<ptrdiff_t>(h + kh) - Pad;
+            const ptrdiff_t iw = static_cast<ptrdiff_t>(w + kw) - Pad;
+            const bool inside = ih >= 0 && ih < static_cast<ptrdiff_t>(Height) &&
+                                iw >= 0 && iw < static_cast<ptrdiff_t>(Width);
+            Indirection[((h * Width + w) * KernelDim + kh) * KernelDim + kw] =
+                inside ? Input.data() + (ih * Width + iw) * InputChannels : Padding.data();
+          }
+        }
+      }
+    }
+
+    std::vector<uint8_t> Output(OutputCount * OutputChannels);
+
+    MLAS_CONV_SYM_PARAMS Params = {};
+    if (KernelSize == 1) {
+      Params.InputDirect = Input.data();
+    } else {
+      Params.InputIndirection = Indirection.data();
+    }
+    Params.Filter = PackedFilter.data();
+    Params.Output = Output.data();
+    Params.InputChannels = InputChannels;
+    Params.OutputChannels = OutputChannels;
+    Params.OutputCount = OutputCount;
+    Params.KernelSize = KernelSize;
+    Params.Bias = KernelBias.data();
+    Params.Scale = Scale.data();
+    Params.PerChannelScale = PerChannelScale;
+    Params.OutputZeroPoint = OutputZeroPoint;
+    Params.InputIsSigned = false;
+
+    MlasConvSym(Params);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      for (size_t oc = 0; oc < OutputChannels; oc++) {
+        int32_t acc = Bias[oc];
+        for (size_t k = 0; k < KernelSize; k++) {
+          const uint8_t* row = static_cast<const uint8_t*>(Indirection[o * KernelSize + k]);
+          for (size_t ic = 0; ic < InputChannels; ic++) {
+            acc += (int32_t(row[ic]) - InputZeroPoint) * Filter[(oc * InputChannels + ic) * KernelSize + k];
+          }
+        }
+        const float scaled = static_cast<float>(acc) * Scale[PerChannelScale ? oc : 0];
+        const int32_t expected = std::clamp(static_cast<int32_t>(std::nearbyint(scaled)) + OutputZeroPoint, 0, 255);
+        ASSERT_EQ(Output[o * OutputChannels + oc], expected)
+            << " H " << Height << " W " << Width << " K " << KernelDim << " IC " << InputChannels
+            << " OC " << OutputChannels << " @" << o << "," << oc;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("ConvSymU8S8");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // Pointwise convolutions read the input image directly.
+    for (size_t ic : {8, 32, 64, 100, 192}) {
+      for (size_t oc : {16, 20, 64, 100, 132}) {
+        Test(1, 1, 1, ic, oc, false);
+        Test(5, 7, 1, ic, oc, true);
+        Test(6, 8, 1, ic, oc, false);
+      }
+    }
+    for (size_t ic : {12, 36, 64, 80}) {
+      for (size_t oc : {16, 36, 64, 68}) {
+        Test(4, 5, 3, ic, oc, true);
+        Test(7, 9, 3, ic, oc, false);
+      }
+    }
+    Test(3, 3, 5, 48, 24, true);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConvSymTest>::RegisterShortExecute();
+  }
+  return count;
+});
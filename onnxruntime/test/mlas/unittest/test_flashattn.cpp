@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "core/framework/float16.h"
+
+template <typename T, bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  static float ToFloat(float v) { return v; }
+  static float ToFloat(MLAS_FP16 v) { return v.ToFloat(); }
+  static float ToFloat(MLAS_BF16 v) { return v.ToFloat(); }
+
+  void Test(size_t B, size_t N, size_t S, size_t T_, size_t H, size_t Hv, bool Causal, bool WithMask) {
+    std::default_random_engine generator(static_cast<unsigned>(B * 131 + S * 17 + T_ * 7 + H + Causal));
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+    std::vector<float> Query(B * N * S * H);
+    std::vector<T> Key(B * N * T_ * H);
+    std::vector<T> Value(B * N * T_ * Hv);
+    std::vector<float> KeyMask(B * T_);
+    std::vector<float> Output(B * S * N * Hv);
+
+    for (auto& v : Query) v = distribution(generator);
+    for (auto& v : Key) v = T(distribution(generator));
+    for (auto& v : Value) v = T(distribution(generator));
+    for (size_t b = 0; b < B; b++) {
+      // Mask out a tail of keys that differs per batch, as right padding does.
+      const size_t valid = T_ - (b * 5) % (T_ / 2 + 1);
+      for (size_t t = 0; t < T_; t++) {
+        KeyMask[b * T_ + t] = (t < valid) ? 0.0f : -10000.0f;
+      }
+    }
+
+    const float Scale = 1.0f / std::sqrt(static_cast<float>(H));
+
+    MLAS_FLASH_ATTENTION_PARAMS<T> params;
+    params.Query = Query.data();
+    params.Key = Key.data();
+    params.Value = Value.data();
+    params.KeyMask = WithMask ? KeyMask.data() : nullptr;
+    params.Output = Output.data();
+    params.BatchSize = B;
+    params.NumHeads = N;
+    params.SequenceLength = S;
+    params.TotalSequenceLength = T_;
+    params.QkHeadSize = H;
+    params.VHeadSize = Hv;
+    params.Scale = Scale;
+    params.Causal = Causal;
+
+    MlasFlashAttention(params, threadpool_);
+
+    std::vector<double> scores(T_);
+    for (size_t b = 0; b < B; b++) {
+      for (size_t n = 0; n < N; n++) {
+        const size_t bn = b * N + n;
+        for (size_t s = 0; s < S; s++) {
+          const size_t visible = Causal ? T_ - S + s + 1 : T_;
+          double maximum = -std::numeric_limits<double>::infinity();
+          for (size_t t = 0; t < visible; t++) {
+            double dot = 0;
+            for (size_t h = 0; h < H; h++) {
+              dot += double(Query[(bn * S + s) * H + h]) * ToFloat(Key[(bn * T_ + t) * H + h]);
+            }
+            scores[t] = dot * Scale + (WithMask ? KeyMask[b * T_ + t] : 0.0f);
+            maximum = std::max(maximum, scores[t]);
+          }
+          double sum = 0;
+          for (size_t t = 0; t < visible; t++) {
+            scores[t] = std::exp(scores[t] - maximum);
+            sum += scores[t];
+          }
+          for (size_t h = 0; h < Hv; h++) {
+            double expected = 0;
+            for (size_t t = 0; t < visible; t++) {
+              expected += scores[t] * ToFloat(Value[(bn * T_ + t) * Hv + h]);
+            }
+            expected /= sum;
+            const float actual = Output[((b * S + s) * N + n) * Hv + h];
+            ASSERT_NEAR(actual, expected, 1e-4 * (1 + std::fabs(expected)))
+                << " B " << B << " N " << N << " S " << S << " T " << T_ << " H " << H << " Hv " << Hv
+                << (Causal ? " causal" : "") << (WithMask ? " mask" : "") << " @" << b << "," << n << "," << s << "," << h;
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::string("FlashAttention") +
+                                        (std::is_same_v<T, float>       ? "Fp32"
+                                         : std::is_same_v<T, MLAS_FP16> ? "Fp16"
+                                                                        : "Bf16") +
+                                        (Threaded ? "_Threaded" : "_SingleThread"));
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool causal : {false, true}) {
+      for (bool mask : {false, true}) {
+        Test(1, 1, 1, 1, 8, 8, causal, mask);
+        Test(2, 3, 5, 5, 16, 8, causal, mask);
+        Test(1, 2, 1, 300, 64, 64, causal, mask);
+        Test(2, 2, 70, 70, 32, 48, causal, mask);
+        Test(1, 1, 100, 600, 64, 64, causal, mask);
+        Test(1, 2, 130, 257, 40, 24, causal, mask);
+      }
+    }
+    Test(1, 1, 300, 300, 8, 8, false, false);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<float, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<float, true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<MLAS_FP16, true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<MLAS_BF16, true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -167,6 +167,37 @@ class MlasHalfGemmTest : public MlasTestBase {
     }
   }
 
+  // The x64 F16C kernel converts the fp16 inputs to fp32 and accumulates in
+  // fp32, rounding to fp16 only once per K stride. It is tested against this
+  // reference instead of ReferenceQgemm, see MlasHalfGemmAccumulatesInFloat().
+  void ReferenceQgemmFloatAccumulation(size_t M,
+                                       size_t N,
+                                       size_t K,
+                                       size_t BatchSize,
+                                       const AType* A,
+                                       const BType* B,
+                                       const MLFp16* Bias,
+                                       float* C) {
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          const AType* a = A + M * K * batch + m * K;
+          const BType* b = B + K * N * batch + n;
+          float sum = (Bias != nullptr) ? float(Bias[n]) : 0.0f;
+          for (size_t k = 0; k < K; k++) {
+            sum += float(MLFp16(float(*a))) * float(MLFp16(float(*b)));
+            b += N;
+            a += 1;
+          }
+          C[(M * N * batch) + (m * N) + n] = float(MLFp16(sum));
+        }
+      }
+      if (Bias) {
+        Bias += N;
+      }
+    }
+  }
+
  public:
   MlasHalfGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
 
@@ -195,7 +226,11 @@ class MlasHalfGemmTest : public MlasTestBase {
         });
 
     this->CallGemm(M, N, K, BatchSize, A, K, B, N, Bias, C, N, Cfloat);
-    ReferenceQgemm(M, N, K, BatchSize, A, B, Bias, CReference);
+    if (MlasHalfGemmAccumulatesInFloat()) {
+      ReferenceQgemmFloatAccumulation(M, N, K, BatchSize, A, B, Bias, CReference);
+    } else {
+      ReferenceQgemm(M, N, K, BatchSize, A, B, Bias, CReference);
+    }
 
     for (size_t batch = 0, f = 0; batch < BatchSize; batch++) {
       for (size_t m = 0; m < M; m++) {
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "core/framework/float16.h"
+
+template <typename T>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferParams;
+
+  static float ToFloat(float v) { return v; }
+  static float ToFloat(MLAS_FP16 v) { return v.ToFloat(); }
+  static float ToFloat(MLAS_BF16 v) { return v.ToFloat(); }
+
+  void Test(size_t N, bool Simplified, bool WithSkip, bool WithSkipBias, bool WithBias, float Offset) {
+    // MatrixGuardBuffer fills from int, which MLAS_FP16 and MLAS_BF16 do not
+    // convert from unambiguously.
+    std::vector<T> Input(N);
+    std::vector<T> Skip(N);
+    std::vector<T> Output(N);
+    std::vector<T> SkipOutput(N);
+    float* Params = BufferParams.GetBuffer(N * 3);
+    float* Scale = Params;
+    float* Bias = Params + N;
+    float* SkipBias = Params + 2 * N;
+
+    std::default_random_engine generator(static_cast<unsigned>(N * 17 + Simplified));
+    std::uniform_real_distribution<float> distribution(-2.f, 2.f);
+
+    for (size_t i = 0; i < N; i++) {
+      Input[i] = T(Offset + distribution(generator));
+      Skip[i] = T(distribution(generator));
+      Scale[i] = distribution(generator);
+      Bias[i] = distribution(generator);
+      SkipBias[i] = distribution(generator);
+    }
+
+    MLAS_LAYER_NORM_PARAMS<T> p;
+    p.Input = Input.data();
+    p.Skip = WithSkip ? Skip.data() : nullptr;
+    p.SkipBias = WithSkipBias ? SkipBias : nullptr;
+    p.Scale = Scale;
+    p.Bias = WithBias ? Bias : nullptr;
+    p.Output = Output.data();
+    p.SkipOutput = SkipOutput.data();
+    float Mean = 0.f;
+    float InvStdDev = 0.f;
+    p.Mean = &Mean;
+    p.InvStdDev = &InvStdDev;
+    p.Epsilon = 1e-5f;
+    p.Simplified = Simplified;
+
+    MlasLayerNormalization(p, N);
+
+    std::vector<double> x(N);
+    double sum = 0, sum_squares = 0;
+    for (size_t i = 0; i < N; i++) {
+      x[i] = ToFloat(Input[i]);
+      if (WithSkip) x[i] += ToFloat(Skip[i]);
+      if (WithSkipBias) x[i] += SkipBias[i];
+      sum += x[i];
+    }
+    const double ref_mean = Simplified ? 0.0 : sum / N;
+    for (size_t i = 0; i < N; i++) {
+      sum_squares += (x[i] - ref_mean) * (x[i] - ref_mean);
+    }
+    const double ref_inv_std_dev = 1.0 / std::sqrt(sum_squares / N + 1e-5);
+
+    // fp16 and bfloat16 round the sum of the input and skip, then the output.
+    const float epsilon = std::is_same_v<T, float> ? 1e-4f : (std::is_same_v<T, MLAS_FP16> ? 2e-2f : 1e-1f);
+
+    if (!Simplified) {
+      ASSERT_NEAR(Mean, ref_mean, 1e-4 * (1 + std::fabs(ref_mean))) << " N " << N;
+    }
+    ASSERT_NEAR(InvStdDev, ref_inv_std_dev, 1e-3 * ref_inv_std_dev) << " N " << N;
+
+    for (size_t i = 0; i < N; i++) {
+      double y = (x[i] - ref_mean) * ref_inv_std_dev * Scale[i];
+      if (WithBias && !Simplified) y += Bias[i];
+      ASSERT_NEAR(ToFloat(Output[i]), y, epsilon * (1 + std::fabs(y)))
+          << " N " << N << " @" << i << (Simplified ? " simplified" : "")
+          << (WithSkip ? " skip" : "") << (WithSkipBias ? " skip_bias" : "") << (WithBias ? " bias" : "");
+      ASSERT_NEAR(ToFloat(SkipOutput[i]), x[i], epsilon * (1 + std::fabs(x[i]))) << " N " << N << " @" << i;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_same_v<T, float>       ? "LayerNormFp32"
+                                        : std::is_same_v<T, MLAS_FP16> ? "LayerNormFp16"
+                                                                       : "LayerNormBf16");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n : {1, 3, 8, 15, 16, 33, 64, 255, 256, 257, 768, 1000}) {
+      for (bool simplified : {false, true}) {
+        Test(n, simplified, false, false, false, 0.f);
+        Test(n, simplified, true, false, true, 0.f);
+        Test(n, simplified, true, true, true, 0.f);
+        Test(n, simplified, false, true, false, 0.f);
+      }
+    }
+    // A large offset relative to the spread of the values.
+    if (std::is_same_v<T, float>) {
+      Test(1024, false, false, false, true, 1000.f);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<float>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<MLAS_FP16>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<MLAS_BF16>>::RegisterShortExecute();
+  }
+  return count;
+});
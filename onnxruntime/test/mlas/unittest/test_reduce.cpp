@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  static float ReferenceReduce(MLAS_REDUCE_KIND Kind, float a, float b) {
+    switch (Kind) {
+      case MlasReduceSum:
+        return a + b;
+      case MlasReduceMaximum:
+        return std::max(a, b);
+      case MlasReduceMinimum:
+        return std::min(a, b);
+    }
+    return a;
+  }
+
+  void Test(MLAS_REDUCE_KIND Kind, size_t M, size_t N, size_t ld, bool Columns) {
+    float* Input = BufferInput.GetBuffer(M * ld);
+    const size_t OutputCount = Columns ? N : M;
+    float* Output = BufferOutput.GetBuffer(OutputCount);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputCount);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 1021 + N));
+    std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+
+    for (size_t i = 0; i < M * ld; i++) {
+      Input[i] = distribution(generator);
+    }
+
+    if (Columns) {
+      MlasReduceColumns(Kind, Input, Output, M, N, ld);
+      for (size_t n = 0; n < N; n++) {
+        float Value = Input[n];
+        for (size_t m = 1; m < M; m++) {
+          Value = ReferenceReduce(Kind, Value, Input[m * ld + n]);
+        }
+        OutputReference[n] = Value;
+      }
+    } else {
+      MlasReduceRows(Kind, Input, Output, M, N, ld);
+      for (size_t m = 0; m < M; m++) {
+        float Value = Input[m * ld];
+        for (size_t n = 1; n < N; n++) {
+          Value = ReferenceReduce(Kind, Value, Input[m * ld + n]);
+        }
+        OutputReference[m] = Value;
+      }
+    }
+
+    // The sum is accumulated in a different order than the reference.
+    const float epsilon = (Kind == MlasReduceSum) ? 1e-5f * float(Columns ? M : N) * 10.f : 0.f;
+
+    for (size_t i = 0; i < OutputCount; i++) {
+      ASSERT_LE(std::fabs(Output[i] - OutputReference[i]), epsilon)
+          << " kind " << int(Kind) << (Columns ? " columns" : " rows")
+          << " [" << M << "," << N << "," << ld << "] @" << i;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Reduce");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_REDUCE_KIND Kind : {MlasReduceSum, MlasReduceMaximum, MlasReduceMinimum}) {
+      for (bool Columns : {false, true}) {
+        for (size_t n = 1; n <= 80; n++) {
+          Test(Kind, 3, n, n, Columns);
+          Test(Kind, 7, n, n + 5, Columns);
+        }
+        for (size_t m = 1; m <= 20; m++) {
+          Test(Kind, m, 67, 67, Columns);
+        }
+        Test(Kind, 600, 257, 257, Columns);
+        Test(Kind, 513, 1000, 1024, Columns);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasReduceTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSgemmGroupedTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  struct Shape {
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    float beta;
+  };
+
+  void Test(const std::vector<Shape>& shapes) {
+    std::default_random_engine generator(static_cast<unsigned>(shapes.size() * 31 + shapes[0].M));
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+    const size_t count = shapes.size();
+    std::vector<std::vector<float>> A(count), B(count), C(count), CReference(count);
+    std::vector<MLAS_SGEMM_GROUPED_PARAMS> params(count);
+
+    for (size_t i = 0; i < count; i++) {
+      const Shape& s = shapes[i];
+      // Pad the leading dimensions to catch stride mistakes.
+      const size_t lda = ((s.TransA == CblasNoTrans) ? s.K : s.M) + 3;
+      const size_t ldb = ((s.TransB == CblasNoTrans) ? s.N : s.K) + 1;
+      const size_t ldc = s.N + 2;
+
+      A[i].resize(((s.TransA == CblasNoTrans) ? s.M : s.K) * lda);
+      B[i].resize(((s.TransB == CblasNoTrans) ? s.K : s.N) * ldb);
+      C[i].resize(s.M * ldc);
+      for (auto& v : A[i]) v = distribution(generator);
+      for (auto& v : B[i]) v = distribution(generator);
+      for (auto& v : C[i]) v = distribution(generator);
+      CReference[i] = C[i];
+
+      for (size_t m = 0; m < s.M; m++) {
+        for (size_t n = 0; n < s.N; n++) {
+          double sum = 0;
+          for (size_t k = 0; k < s.K; k++) {
+            const float a = (s.TransA == CblasNoTrans) ? A[i][m * lda + k] : A[i][k * lda + m];
+            const float b = (s.TransB == CblasNoTrans) ? B[i][k * ldb + n] : B[i][n * ldb + k];
+            sum += double(a) * b;
+          }
+          float& c = CReference[i][m * ldc + n];
+          c = static_cast<float>(0.5 * sum + s.beta * c);
+        }
+      }
+
+      params[i].TransA = s.TransA;
+      params[i].TransB = s.TransB;
+      params[i].M = s.M;
+      params[i].N = s.N;
+      params[i].K = s.K;
+      params[i].Data.A = A[i].data();
+      params[i].Data.lda = lda;
+      params[i].Data.B = B[i].data();
+      params[i].Data.ldb = ldb;
+      params[i].Data.C = C[i].data();
+      params[i].Data.ldc = ldc;
+      params[i].Data.alpha = 0.5f;
+      params[i].Data.beta = s.beta;
+    }
+
+    MlasGemmGrouped(params.data(), count, threadpool_);
+
+    for (size_t i = 0; i < count; i++) {
+      for (size_t j = 0; j < C[i].size(); j++) {
+        ASSERT_NEAR(C[i][j], CReference[i][j], 1e-4f * (1 + std::fabs(CReference[i][j])))
+            << " gemm " << i << " M " << shapes[i].M << " N " << shapes[i].N << " K " << shapes[i].K << " @" << j;
+      }
+    }
+  }
+
+ public:
+  MlasSgemmGroupedTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SGemmGrouped_Threaded" : "SGemmGrouped_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // Many small multiplications of the same shape, as per-head attention issues.
+    Test(std::vector<Shape>(48, Shape{CblasNoTrans, CblasTrans, 7, 9, 16, 0.0f}));
+
+    // Mixed shapes, including empty multiplications and K == 0.
+    Test({{CblasNoTrans, CblasNoTrans, 1, 1, 1, 0.0f},
+          {CblasNoTrans, CblasNoTrans, 0, 5, 3, 1.0f},
+          {CblasTrans, CblasNoTrans, 33, 17, 5, 1.0f},
+          {CblasNoTrans, CblasTrans, 4, 200, 64, 0.5f},
+          {CblasNoTrans, CblasNoTrans, 3, 3, 0, 0.5f},
+          {CblasTrans, CblasTrans, 65, 2, 31, 0.0f},
+          {CblasNoTrans, CblasNoTrans, 1, 300, 1, 1.0f}});
+
+    // One large multiplication among small ones is split across threads.
+    Test({{CblasNoTrans, CblasNoTrans, 2, 3, 4, 0.0f},
+          {CblasNoTrans, CblasNoTrans, 256, 320, 128, 0.0f},
+          {CblasNoTrans, CblasTrans, 5, 6, 7, 1.0f},
+          {CblasNoTrans, CblasNoTrans, 300, 40, 96, 1.0f}});
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
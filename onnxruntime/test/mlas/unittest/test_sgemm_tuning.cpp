@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSgemmTuningTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, size_t M, size_t N, size_t K, float beta,
+            const MLAS_SGEMM_TUNING_PARAMS& Tuning) {
+    std::default_random_engine generator(static_cast<unsigned>(M * 131 + N * 17 + K));
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+    const size_t lda = ((TransA == CblasNoTrans) ? K : M) + 1;
+    const size_t ldb = ((TransB == CblasNoTrans) ? N : K) + 3;
+    const size_t ldc = N + 2;
+
+    std::vector<float> A(((TransA == CblasNoTrans) ? M : K) * lda);
+    std::vector<float> B(((TransB == CblasNoTrans) ? K : N) * ldb);
+    std::vector<float> C(M * ldc);
+    for (auto& v : A) v = distribution(generator);
+    for (auto& v : B) v = distribution(generator);
+    for (auto& v : C) v = distribution(generator);
+    std::vector<float> CReference(C);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0;
+        for (size_t k = 0; k < K; k++) {
+          const float a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+          const float b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+          sum += double(a) * b;
+        }
+        float& c = CReference[m * ldc + n];
+        c = static_cast<float>(sum + beta * c);
+      }
+    }
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A.data();
+    Data.lda = lda;
+    Data.B = B.data();
+    Data.ldb = ldb;
+    Data.C = C.data();
+    Data.ldc = ldc;
+    Data.beta = beta;
+
+    MlasGemmBatch(TransA, TransB, M, N, K, &Data, 1, threadpool_, &Tuning);
+
+    for (size_t i = 0; i < C.size(); i++) {
+      ASSERT_NEAR(C[i], CReference[i], 1e-4f * (1 + std::fabs(CReference[i])))
+          << " M " << M << " N " << N << " K " << K << " StrideN " << Tuning.StrideN << " StrideK "
+          << Tuning.StrideK << " ThreadComplexity " << Tuning.ThreadComplexity << " @" << i;
+    }
+  }
+
+ public:
+  MlasSgemmTuningTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SGemmTuning_Threaded" : "SGemmTuning_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // Valid tuned strides, plus strides that do not fit the panels and must
+    // fall back to the built-in heuristics.
+    const std::vector<std::pair<size_t, size_t>> strides = {
+        {0, 0}, {128, 128}, {256, 64}, {64, 256}, {16, 1024}, {512, 32}, {48, 300}, {24, 64}, {256, 256}};
+
+    for (const auto& [StrideN, StrideK] : strides) {
+      for (size_t ThreadComplexity : {size_t(0), size_t(4096), size_t(256) * 1024}) {
+        MLAS_SGEMM_TUNING_PARAMS Tuning;
+        Tuning.StrideN = StrideN;
+        Tuning.StrideK = StrideK;
+        Tuning.ThreadComplexity = ThreadComplexity;
+
+        for (auto TransA : {CblasNoTrans, CblasTrans}) {
+          for (auto TransB : {CblasNoTrans, CblasTrans}) {
+            Test(TransA, TransB, 37, 300, 281, 0.0f, Tuning);
+            Test(TransA, TransB, 130, 45, 520, 1.0f, Tuning);
+            Test(TransA, TransB, 3, 1100, 7, 0.5f, Tuning);
+          }
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmTuningTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSgemmTuningTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
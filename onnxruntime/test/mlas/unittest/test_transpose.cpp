@@ -9,6 +9,8 @@ class MlasTransposeTest : public MlasTestBase {
   MatrixGuardBuffer<ElementType> BufferInput;
   MatrixGuardBuffer<ElementType> BufferOutput;
   MatrixGuardBuffer<ElementType> BufferOutputReference;
+  MatrixGuardBuffer<ElementType> BufferInputStrided;
+  MatrixGuardBuffer<ElementType> BufferOutputStrided;
 
   void
   Test(size_t M, size_t N) {
@@ -22,6 +24,29 @@ class MlasTransposeTest : public MlasTestBase {
     ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
   }
 
+  // Transposes the matrices as submatrices of larger buffers, which must leave the rest of the output buffer as is.
+  void
+  TestStrided(size_t M, size_t N) {
+    const size_t ldInput = N + 3;
+    const size_t ldOutput = M + 5;
+    ElementType* Input = BufferInputStrided.GetBuffer(M * ldInput);
+    ElementType* Output = BufferOutputStrided.GetBuffer(N * ldOutput);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(N * ldOutput);
+
+    std::fill_n(Output, N * ldOutput, ElementType(0x5a));
+    std::fill_n(OutputReference, N * ldOutput, ElementType(0x5a));
+
+    MlasTranspose(Input, ldInput, Output, ldOutput, M, N);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        OutputReference[n * ldOutput + m] = Input[m * ldInput + n];
+      }
+    }
+
+    ASSERT_EQ(memcmp(Output, OutputReference, N * ldOutput * sizeof(ElementType)), 0)
+        << " [" << M << "," << N << "] strided";
+  }
+
   void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
       for (size_t n = 0; n < N; n++) {
@@ -40,6 +65,7 @@ class MlasTransposeTest : public MlasTestBase {
     for (size_t m = 1; m <= 32; m++) {
       for (size_t n = 1; n <= 32; n++) {
         Test(m, n);
+        TestStrided(m, n);
       }
     }
   }
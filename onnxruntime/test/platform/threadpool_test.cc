@@ -12,8 +12,10 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -510,6 +512,91 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.adaptive_spinning = true;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 4, true);
+  constexpr int num_tasks = 64;
+
+  // alternate back-to-back parallel sections with gaps that are longer than the maximum spin time, and with hints
+  for (int rep = 0; rep < 20; rep++) {
+    if (rep % 5 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    if (rep % 4 == 1) {
+      tp->HintBurst(std::chrono::microseconds(500));
+    } else if (rep % 4 == 3) {
+      tp->HintIdle();
+    }
+
+    auto test_data = CreateTestData(num_tasks);
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    ValidateTestData(*test_data);
+  }
+
+  // workers that were woken up by a hint without any work being submitted still pick up later work
+  tp->HintBurst(std::chrono::microseconds(100));
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  auto test_data = CreateTestData(num_tasks);
+  ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestBurstKeepsWorkersSpinning) {
+  constexpr unsigned num_threads = 2;
+  const auto wait_for_blocked_threads = [](const ThreadPoolTempl<onnxruntime::Env>& tp, unsigned expected) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (tp.NumBlockedThreads() != expected && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return tp.NumBlockedThreads() == expected;
+  };
+  // a worker that is woken up at any point is noticed as it takes a while to block again
+  const auto stays_blocked = [](const ThreadPoolTempl<onnxruntime::Env>& tp, unsigned expected) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    while (std::chrono::steady_clock::now() < end) {
+      if (tp.NumBlockedThreads() != expected) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (bool adaptive_spinning : {false, true}) {
+    onnxruntime::ThreadOptions thread_options;
+    thread_options.adaptive_spinning = adaptive_spinning;
+    ThreadPoolTempl<onnxruntime::Env> tp(ORT_TSTR("test"), num_threads, true, onnxruntime::Env::Default(),
+                                         thread_options);
+    ASSERT_TRUE(wait_for_blocked_threads(tp, num_threads));
+
+    // the burst wakes the workers up, and they keep spinning well past both the spin count and the maximum
+    // adaptive spin time
+    tp.HintBurst(std::chrono::seconds(10));
+    ASSERT_TRUE(wait_for_blocked_threads(tp, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_EQ(tp.NumBlockedThreads(), 0u);
+
+    tp.HintIdle();
+    ASSERT_TRUE(wait_for_blocked_threads(tp, num_threads));
+
+    // the burst is ignored while spinning is disabled, so the workers stay blocked, and it does not apply once
+    // spinning is enabled again either: a worker that runs a task blocks again well before the burst would end
+    tp.DisableSpinning();
+    tp.HintBurst(std::chrono::seconds(60));
+    EXPECT_TRUE(stays_blocked(tp, num_threads));
+    tp.EnableSpinning();
+    tp.Schedule([]() {});
+    ASSERT_TRUE(wait_for_blocked_threads(tp, num_threads));
+  }
+
+  // and when spinning is not allowed at all
+  ThreadPoolTempl<onnxruntime::Env> tp(ORT_TSTR("test"), num_threads, false, onnxruntime::Env::Default(),
+                                       onnxruntime::ThreadOptions());
+  ASSERT_TRUE(wait_for_blocked_threads(tp, num_threads));
+  tp.HintBurst(std::chrono::seconds(10));
+  EXPECT_TRUE(stays_blocked(tp, num_threads));
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -613,6 +700,63 @@ TEST(ThreadPoolTest, TestAffinityStringWellShaped) {
   }
 }
 
+TEST(ThreadPoolTest, TestNumaThreadPools) {
+  auto& env = onnxruntime::Env::Default();
+  const auto node_processors = env.GetNumaNodeProcessors();
+
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 2;
+  auto numa_pools = concurrency::CreateNumaThreadPools(&env, tp_params);
+  if (node_processors.size() <= 1) {
+    ASSERT_TRUE(numa_pools.pools.empty());
+    return;
+  }
+
+  ASSERT_EQ(numa_pools.pools.size(), node_processors.size());
+  ASSERT_EQ(numa_pools.node_processors.size(), node_processors.size());
+  for (size_t node = 0; node < numa_pools.pools.size(); ++node) {
+    auto* tp = numa_pools.pools[node].get();
+    ASSERT_NE(tp, nullptr);
+    ASSERT_EQ(concurrency::ThreadPool::DegreeOfParallelism(tp), 2);
+
+    // the worker thread runs on a processor of the node
+    const auto& processors = numa_pools.node_processors[node];
+    std::atomic<int> processor_id{-2};
+    Barrier barrier(1);
+    concurrency::ThreadPool::Schedule(tp, [&]() {
+      processor_id = env.GetCurrentProcessorId();
+      barrier.Notify();
+    });
+    barrier.Wait();
+    if (processor_id >= 0) {
+      ASSERT_NE(std::find(processors.begin(), processors.end(), processor_id.load()), processors.end());
+    }
+  }
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(ThreadPoolTest, TestDispatchTiming) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 4;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+
+  const uint64_t baseline = concurrency::ThreadPool::StartDispatchTiming();
+  std::atomic<int> counter{0};
+  concurrency::ThreadPool::TrySimpleParallelFor(tp.get(), 64, [&](std::ptrdiff_t) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    ++counter;
+  });
+  const uint64_t dispatch_ns = concurrency::ThreadPool::StopDispatchTiming(baseline);
+  ASSERT_EQ(counter, 64);
+  ASSERT_GT(dispatch_ns, 0u);
+
+  // nothing is recorded once timing stops
+  const uint64_t next_baseline = concurrency::ThreadPool::StartDispatchTiming();
+  ASSERT_EQ(concurrency::ThreadPool::StopDispatchTiming(next_baseline), 0u);
+}
+#endif
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestDefaultAffinity) {
   test::CpuGroup cpu_group = {{0, 1},
@@ -558,7 +558,8 @@ void BaseTester::Run(SessionOptions so,
 }
 
 void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
-                               size_t* number_of_shared_pre_packed_weights_counter) {
+                               size_t* number_of_shared_pre_packed_weights_counter,
+                               size_t* number_of_persisted_pre_packed_weights_counter) {
   std::string cur_provider = "not set";
   ORT_TRY {
     testing_function_called_ = true;
@@ -611,7 +612,8 @@ void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
                          /*assign_ep_for_nodes=*/false,
                          allow_released_onnx_opset_only,
                          number_of_pre_packed_weights_counter,
-                         number_of_shared_pre_packed_weights_counter);
+                         number_of_shared_pre_packed_weights_counter,
+                         number_of_persisted_pre_packed_weights_counter);
     } else {
 #ifdef USE_TENSORRT
       // only run trt ep to reduce test time
@@ -694,7 +696,8 @@ void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
             /*try_assign_ep_for_nodes=*/true,
             allow_released_onnx_opset_only,
             number_of_pre_packed_weights_counter,
-            number_of_shared_pre_packed_weights_counter);
+            number_of_shared_pre_packed_weights_counter,
+            number_of_persisted_pre_packed_weights_counter);
 
         // Run Models with subscribed run_options->config_options
         if (ctx_.run_options != nullptr &&
@@ -713,7 +716,8 @@ void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
                 /*assign_ep_for_nodes=*/true,
                 allow_released_onnx_opset_only,
                 number_of_pre_packed_weights_counter,
-                number_of_shared_pre_packed_weights_counter);
+                number_of_shared_pre_packed_weights_counter,
+                number_of_persisted_pre_packed_weights_counter);
           }
         }
 
@@ -752,7 +756,8 @@ void BaseTester::ExecuteModelForEps(
     bool try_assign_ep_for_nodes,
     bool allow_released_onnx_opset_only,
     size_t* number_of_pre_packed_weights_counter,
-    size_t* number_of_shared_pre_packed_weights_counter) {
+    size_t* number_of_shared_pre_packed_weights_counter,
+    size_t* number_of_persisted_pre_packed_weights_counter) {
   for (auto& entry : execution_providers) {
     // Be noted, entry in execution providers passed in OpTester will be std::moved in the first BaseTester::Run(),
     // To make the error more obvious to debug (instead of a segment fault), we do check explicitly here.
@@ -807,7 +812,7 @@ void BaseTester::ExecuteModelForEps(
   // After the model has initialized (happens in ExecuteModel),
   // we should be able to tell how many constant initializers were pre-packed
   // and out of these pre-packed ones how many of them used a "cached" version
-  // from the shared container.
+  // from the shared container or from the persisted pre-packed weights file.
   // Populate these value if the user has requested this information.
   if (number_of_pre_packed_weights_counter != nullptr) {
     *number_of_pre_packed_weights_counter = session_object.GetSessionState().GetNumberOfPrepacksCounter();
@@ -817,6 +822,11 @@ void BaseTester::ExecuteModelForEps(
     *number_of_shared_pre_packed_weights_counter =
         session_object.GetSessionState().GetUsedSharedPrePackedWeightCounter();
   }
+
+  if (number_of_persisted_pre_packed_weights_counter != nullptr) {
+    *number_of_persisted_pre_packed_weights_counter =
+        session_object.GetSessionState().GetUsedPersistedPrePackedWeightCounter();
+  }
 };
 
 void BaseTester::AddReferenceOutputs(const std::string& model_path, float abs_error,
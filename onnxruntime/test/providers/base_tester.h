@@ -555,7 +555,8 @@ class BaseTester {
   BaseTester& Config(const Graph::ResolveOptions& resolve_options);
 
   void RunWithConfig(size_t* number_of_pre_packed_weights_counter = nullptr,
-                     size_t* number_of_shared_pre_packed_weights_counter = nullptr);
+                     size_t* number_of_shared_pre_packed_weights_counter = nullptr,
+                     size_t* number_of_persisted_pre_packed_weights_counter = nullptr);
 
   // [[deprecated("Use builder pattern Config* and RunWithConfig")]]
   void Run(ExpectResult expect_result = ExpectResult::kExpectSuccess, const std::string& expected_failure_string = "",
@@ -909,7 +910,8 @@ class BaseTester {
                           bool try_assign_ep_for_nodes,
                           bool allow_released_onnx_opset_only,
                           size_t* number_of_pre_packed_weights_counter,
-                          size_t* number_of_shared_pre_packed_weights_counter);
+                          size_t* number_of_shared_pre_packed_weights_counter,
+                          size_t* number_of_persisted_pre_packed_weights_counter);
 
   const std::string test_name_;
   const std::string domain_;
@@ -109,6 +109,41 @@ TEST(GemmOpTest, GemmNoTrans_bfloat16) {
 }
 #endif  // USE_CUDA USE_RCOM USE_DNNL
 
+TEST(GemmOpTest, GemmTransB_bfloat16_Cpu) {
+  // The values are small integers and halves, which bfloat16 represents exactly.
+  constexpr int64_t M = 5, K = 13, N = 21;
+  std::vector<float> a(M * K), b(N * K), c(N), y(M * N);
+  for (size_t i = 0; i < a.size(); i++) a[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  for (size_t i = 0; i < b.size(); i++) b[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  for (size_t i = 0; i < c.size(); i++) c[i] = static_cast<float>(i % 3);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * b[n * K + k];
+      }
+      y[m * N + n] = 0.5f * sum + 2.0f * c[n];
+    }
+  }
+
+  // B is pre-packed when it is an initializer
+  for (bool b_is_initializer : {false, true}) {
+    OpTester test("Gemm", 13);
+    test.AddAttribute("transA", (int64_t)0);
+    test.AddAttribute("transB", (int64_t)1);
+    test.AddAttribute("alpha", 0.5f);
+    test.AddAttribute("beta", 2.0f);
+    test.AddInput<BFloat16>("A", {M, K}, FloatsToBFloat16s(a));
+    test.AddInput<BFloat16>("B", {N, K}, FloatsToBFloat16s(b), b_is_initializer);
+    test.AddInput<BFloat16>("C", {N}, FloatsToBFloat16s(c));
+    test.AddOutput<BFloat16>("Y", {M, N}, FloatsToBFloat16s(y));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
 #if defined(USE_DNNL)
 TEST(GemmOpTest, GemmNaN_bfloat16) {
 #ifdef USE_DNNL
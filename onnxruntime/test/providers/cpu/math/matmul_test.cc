@@ -1,13 +1,19 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
+#include <iterator>
+#include <utility>
+
 #include "gtest/gtest.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "default_providers.h"
+#include "test/util/include/temp_dir.h"
 
 namespace onnxruntime {
 namespace test {
@@ -292,6 +298,53 @@ TEST(MathOpTest, MatMul_bfloat16) {
 }
 #endif
 
+TEST(MathOpTest, MatMul_bfloat16_Cpu) {
+  // A is batched and B is 2D, so that B can be pre-packed when it is an initializer.
+  // The values are small integers, which bfloat16 represents exactly.
+  constexpr int64_t batch = 2, M = 3, K = 37, N = 19;
+  std::vector<float> a(batch * M * K), b(K * N), y(batch * M * N, 0.0f);
+  for (size_t i = 0; i < a.size(); i++) a[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  for (size_t i = 0; i < b.size(); i++) b[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  for (int64_t m = 0; m < batch * M; m++)
+    for (int64_t n = 0; n < N; n++)
+      for (int64_t k = 0; k < K; k++)
+        y[m * N + n] += a[m * K + k] * b[k * N + n];
+
+  for (bool b_is_initializer : {false, true}) {
+    OpTester test("MatMul", 13);
+    test.AddInput<BFloat16>("A", {batch, M, K}, FloatsToBFloat16s(a));
+    test.AddInput<BFloat16>("B", {K, N}, FloatsToBFloat16s(b), b_is_initializer);
+    test.AddOutput<BFloat16>("Y", {batch, M, N}, FloatsToBFloat16s(y));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
+TEST(MathOpTest, MatMul_Float16_Cpu) {
+  // The values are small integers, which fp16 represents exactly, and the sums stay below 2048.
+  constexpr int64_t batch = 2, M = 7, K = 37, N = 19;
+  std::vector<float> a(batch * M * K), b(K * N), y(batch * M * N, 0.0f);
+  for (size_t i = 0; i < a.size(); i++) a[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  for (size_t i = 0; i < b.size(); i++) b[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  for (int64_t m = 0; m < batch * M; m++)
+    for (int64_t n = 0; n < N; n++)
+      for (int64_t k = 0; k < K; k++)
+        y[m * N + n] += a[m * K + k] * b[k * N + n];
+
+  for (bool b_is_initializer : {false, true}) {
+    OpTester test("MatMul", 13);
+    test.AddInput<MLFloat16>("A", {batch, M, K}, FloatsToMLFloat16s(a));
+    test.AddInput<MLFloat16>("B", {K, N}, FloatsToMLFloat16s(b), b_is_initializer);
+    test.AddOutput<MLFloat16>("Y", {batch, M, N}, FloatsToMLFloat16s(y));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
@@ -370,6 +423,67 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   }
 }
 
+TEST(MathOpTest, MatMulPersistedPrepackedWeights) {
+  TemporaryDirectory temp_dir(ORT_TSTR("matmul_persisted_prepacked_weights_test"));
+  const std::string cache_file = ToUTF8String(temp_dir.Path()) + "/prepacked_weights.bin";
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsPrepackedWeightsCacheFile, cache_file.c_str()));
+
+  auto run_session = [&so]() {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+
+    OpTester test("MatMul");
+    test.AddInput<float>("A", {2, 4},
+                         {1.0f, 2.0f, 3.0f, 4.0f,
+                          -1.0f, -2.0f, -3.0f, -4.0f});
+    test.AddInput<float>("B", {4, 3}, std::vector<float>(12, 1.0f), true);
+    test.AddOutput<float>("Y", {2, 3},
+                          {10.0f, 10.0f, 10.0f,
+                           -10.0f, -10.0f, -10.0f});
+
+    size_t number_of_pre_packed_weights_counter = 0;
+    size_t number_of_persisted_pre_packed_weights_counter = 0;
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig(&number_of_pre_packed_weights_counter, nullptr, &number_of_persisted_pre_packed_weights_counter);
+    return std::make_pair(number_of_pre_packed_weights_counter, number_of_persisted_pre_packed_weights_counter);
+  };
+
+  auto read_cache_file = [&cache_file]() {
+    std::ifstream file(cache_file, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  };
+
+  // The first session pre-packs B and writes it to the cache file
+  const auto [number_of_pre_packed_weights_counter, number_of_persisted_pre_packed_weights_counter] = run_session();
+  const std::string cache_file_contents = read_cache_file();
+  ASSERT_EQ(number_of_persisted_pre_packed_weights_counter, static_cast<size_t>(0));
+
+  // On some platforms/architectures MLAS may choose to not do any pre-packing in which case nothing is persisted
+  ASSERT_EQ(!cache_file_contents.empty(), number_of_pre_packed_weights_counter > 0);
+  if (number_of_pre_packed_weights_counter == 0) {
+    return;
+  }
+
+  // The second session uses the persisted version of every weight instead of calling PrePack() again.
+  // Using a persisted pre-packed weight counts as pre-packing it.
+  ASSERT_EQ(run_session(), std::make_pair(number_of_pre_packed_weights_counter, number_of_pre_packed_weights_counter));
+  ASSERT_EQ(read_cache_file(), cache_file_contents);
+
+  // Corrupt the pre-packed buffer of B, which is the last thing in the file. The third session must reject the
+  // entry, pre-pack B again and rewrite the file as the first session did.
+  {
+    std::string corrupted_contents = cache_file_contents;
+    corrupted_contents.back() ^= 0x5A;
+    std::ofstream file(cache_file, std::ios::binary | std::ios::trunc);
+    file.write(corrupted_contents.data(), static_cast<std::streamsize>(corrupted_contents.size()));
+  }
+  ASSERT_EQ(run_session(), std::make_pair(number_of_pre_packed_weights_counter, static_cast<size_t>(0)));
+  ASSERT_EQ(read_cache_file(), cache_file_contents);
+}
+
 #endif
 
 }  // namespace test
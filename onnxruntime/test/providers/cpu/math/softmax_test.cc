@@ -9,6 +9,7 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/dnnl_op_test_utils.h"
+#include "default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -49,6 +50,29 @@ TEST(SoftmaxOperator, Simple) {
   RunTest(x_vals, expected_vals, dimensions);
 }
 
+TEST(SoftmaxOperator, Simple_fp16_Cpu) {
+  // opset 13 on a non-innermost axis, so the rows are transposed around the fp16 kernel
+  std::vector<float> X = {-1.0f, 0.0f, 1.0f, 2.0f, 2.0f, 2.0f};
+  std::vector<float> Y = {0.04742587f, 0.11920292f, 0.26894142f, 0.95257413f, 0.88079708f, 0.73105858f};
+  std::vector<int64_t> dimensions = {2, 3};
+
+  for (int opset : {11, 13}) {
+    OpTester test("Softmax", opset);
+    test.AddAttribute("axis", static_cast<int64_t>(opset < 13 ? 1 : 0));
+    std::vector<float> expected = Y;
+    if (opset < 13) {
+      // opset 11 flattens the input to {2, 3} and normalizes each row
+      expected = {0.09003058f, 0.24472848f, 0.66524094f, 0.33333333f, 0.33333333f, 0.33333333f};
+    }
+    test.AddInput<MLFloat16>("X", dimensions, FloatsToMLFloat16s(X));
+    test.AddOutput<MLFloat16>("Y", dimensions, FloatsToMLFloat16s(expected));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(SoftmaxOperator, Simple_fp16) {
 #ifdef USE_CUDA
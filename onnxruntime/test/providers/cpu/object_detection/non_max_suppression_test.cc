@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -383,5 +387,62 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  // Box 2k + 1 is a copy of box 2k, and the other boxes don't overlap, so a box is suppressed exactly when its copy
+  // was selected before it.
+  constexpr int64_t num_batches = 2, num_classes = 40, num_boxes = 200, max_output_boxes_per_class = 30;
+  constexpr float score_threshold = 0.1f;
+
+  std::vector<float> boxes;
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      const float y = static_cast<float>(box_index / 2) * 2.0f;
+      boxes.insert(boxes.end(), {y, 0.0f, y + 1.0f, 1.0f});
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> selected_indices;
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    for (int64_t class_index = 0; class_index < num_classes; ++class_index) {
+      std::vector<std::pair<float, int64_t>> candidates;
+      for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+        // all the scores of a class are different
+        const float score = static_cast<float>((box_index * 7 + class_index * 13 + batch_index) % num_boxes) /
+                            num_boxes;
+        scores.push_back(score);
+        if (score > score_threshold) {
+          candidates.emplace_back(-score, box_index);
+        }
+      }
+
+      std::sort(candidates.begin(), candidates.end());
+      std::vector<bool> selected(num_boxes, false);
+      int64_t num_selected = 0;
+      for (const auto& candidate : candidates) {
+        if (num_selected == max_output_boxes_per_class) {
+          break;
+        }
+        const int64_t box_index = candidate.second;
+        if (!selected[box_index ^ 1]) {
+          selected[box_index] = true;
+          selected_indices.insert(selected_indices.end(), {batch_index, class_index, box_index});
+          ++num_selected;
+        }
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output_boxes_per_class});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {score_threshold});
+  test.AddOutput<int64_t>("selected_indices", {static_cast<int64_t>(selected_indices.size() / 3), 3},
+                          selected_indices);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -4454,6 +4454,70 @@ TEST(ReductionOpTest, ReduceMax_RK_parallel) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ReduceMin_RK_parallel_wide) {
+  // More rows than one MLAS row block and a column count that is not a multiple of the vector width.
+  OpTester test("ReduceMin");
+  test.AddAttribute("axes", std::vector<int64_t>{0});
+  test.AddAttribute("keepdims", (int64_t)0);
+  const int64_t n_rows = 600, n_cols = 261;
+  std::vector<float> in_data(n_rows * n_cols);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)((i * 7919) % 1013) - 500.f;
+  test.AddInput<float>("data", {n_rows, n_cols}, in_data);
+  std::vector<float> expected(n_cols);
+  for (int64_t j = 0; j < n_cols; ++j) {
+    expected[j] = in_data[j];
+    for (int64_t i = 1; i < n_rows; ++i) {
+      expected[j] = std::min(expected[j], in_data[i * n_cols + j]);
+    }
+  }
+  test.AddOutput<float>("reduced", {n_cols}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceSum_KRK_parallel) {
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  const int64_t d0 = 8, d1 = 300, d2 = 37;
+  std::vector<float> in_data(d0 * d1 * d2);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)(i % 13) / 13.f;
+  test.AddInput<float>("data", {d0, d1, d2}, in_data);
+  std::vector<float> expected(d0 * d2, 0.f);
+  for (int64_t i = 0; i < d0; ++i) {
+    for (int64_t j = 0; j < d1; ++j) {
+      for (int64_t k = 0; k < d2; ++k) {
+        expected[i * d2 + k] += in_data[(i * d1 + j) * d2 + k];
+      }
+    }
+  }
+  test.AddOutput<float>("reduced", {d0, d2}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_KR_parallel) {
+  OpTester test("ReduceLogSumExp");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  const int64_t n_rows = 64, n_cols = 100;
+  std::vector<float> in_data(n_rows * n_cols);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)(i % 23) / 4.f;
+  in_data[5] = FLOAT_NINF;
+  test.AddInput<float>("data", {n_rows, n_cols}, in_data);
+  std::vector<float> expected(n_rows);
+  for (int64_t i = 0; i < n_rows; ++i) {
+    double sum = 0;
+    for (int64_t j = 0; j < n_cols; ++j) {
+      sum += std::exp((double)in_data[i * n_cols + j]);
+    }
+    expected[i] = (float)std::log(sum);
+  }
+  test.AddOutput<float>("reduced", {n_rows}, expected);
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceMax_KRK) {
   OpTester test("ReduceMax");
   test.AddAttribute("axes", std::vector<int64_t>{1});
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -17,6 +18,22 @@ namespace test {
 
 static constexpr int kMinOpsetVersion = 17;
 
+// Computes the DFT of the real signal x, returning the first output_size (real, imaginary) pairs.
+static vector<float> NaiveRealDFT(const float* x, int64_t length, int64_t output_size) {
+  vector<float> output;
+  for (int64_t k = 0; k < output_size; k++) {
+    double real = 0, imaginary = 0;
+    for (int64_t n = 0; n < length; n++) {
+      const double angle = -2 * M_PI * static_cast<double>((n * k) % length) / length;
+      real += x[n] * std::cos(angle);
+      imaginary += x[n] * std::sin(angle);
+    }
+    output.push_back(static_cast<float>(real));
+    output.push_back(static_cast<float>(imaginary));
+  }
+  return output;
+}
+
 static void TestNaiveDFTFloat(bool onesided) {
   OpTester test("DFT", kMinOpsetVersion);
 
@@ -83,6 +100,33 @@ TEST(SignalOpsTest, DFTFloat_inverse) {
   test.Run();
 }
 
+// Tests lengths with radix 2, 3, 4 and 5 factors, with other small prime factors, and with large prime factors.
+TEST(SignalOpsTest, DFTFloat_mixed_radix) {
+  RandomValueGenerator random(GetTestRandomSeed());
+  constexpr int64_t num_batches = 2;
+  for (int64_t length : {6, 12, 30, 49, 60, 97, 202}) {
+    for (bool onesided : {false, true}) {
+      OpTester test("DFT", kMinOpsetVersion);
+
+      vector<int64_t> shape{num_batches, length, 1};
+      vector<float> input = random.Uniform<float>(shape, -1.f, 1.f);
+      const int64_t output_size = onesided ? (length >> 1) + 1 : length;
+
+      vector<float> expected_output;
+      for (int64_t batch = 0; batch < num_batches; batch++) {
+        auto batch_output = NaiveRealDFT(input.data() + batch * length, length, output_size);
+        expected_output.insert(expected_output.end(), batch_output.begin(), batch_output.end());
+      }
+
+      test.AddInput<float>("input", shape, input);
+      test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+      test.AddOutput<float>("output", {num_batches, output_size, 2}, expected_output);
+      test.SetOutputAbsErr("output", 0.0002f);
+      test.Run();
+    }
+  }
+}
+
 // Tests that FFT(FFT(x), inverse=true) == x
 static void TestDFTInvertible(bool complex) {
   // TODO: test dft_length
@@ -176,6 +220,40 @@ TEST(SignalOpsTest, STFTFloat) {
   test.Run();
 }
 
+TEST(SignalOpsTest, STFTFloat_windowed) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  constexpr int64_t batch_size = 2, signal_length = 100, frame_length = 20, frame_step = 7;
+  constexpr int64_t n_dfts = (signal_length - frame_length) / frame_step + 1;
+  constexpr int64_t dft_output_size = frame_length / 2 + 1;
+
+  vector<int64_t> signal_shape{batch_size, signal_length, 1};
+  vector<int64_t> window_shape{frame_length};
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> signal = random.Uniform<float>(signal_shape, -1.f, 1.f);
+  vector<float> window = random.Uniform<float>(window_shape, 0.f, 1.f);
+
+  vector<float> expected_output;
+  for (int64_t batch = 0; batch < batch_size; batch++) {
+    for (int64_t i = 0; i < n_dfts; i++) {
+      vector<float> frame(frame_length);
+      for (int64_t n = 0; n < frame_length; n++) {
+        frame[n] = signal[batch * signal_length + i * frame_step + n] * window[n];
+      }
+      auto frame_output = NaiveRealDFT(frame.data(), frame_length, dft_output_size);
+      expected_output.insert(expected_output.end(), frame_output.begin(), frame_output.end());
+    }
+  }
+
+  test.AddInput<float>("signal", signal_shape, signal);
+  test.AddInput<int64_t>("frame_step", {}, {frame_step});
+  test.AddInput<float>("window", window_shape, window);
+  test.AddInput<int64_t>("frame_length", {}, {frame_length});
+  test.AddOutput<float>("output", {batch_size, n_dfts, dft_output_size, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.0002f);
+  test.Run();
+}
+
 TEST(SignalOpsTest, HannWindowFloat) {
   OpTester test("HannWindow", kMinOpsetVersion);
 
@@ -158,6 +158,47 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+struct CastLargeTensorTester {
+  template <typename SrcType, typename DstType>
+  void operator()(const std::pair<SrcType, DstType>&) {
+    SCOPED_TRACE(
+        onnxruntime::MakeString(
+            "Cast from type ", utils::ToTensorProtoElementType<SrcType>(),
+            " to type ", utils::ToTensorProtoElementType<DstType>()));
+
+    // large enough to be split across the thread pool, and not a multiple of the vector width
+    const TensorShape shape{3, 7, 4099};
+    const size_t size = gsl::narrow<size_t>(shape.Size());
+
+    std::vector<int> input_int_values(size);
+    for (size_t i = 0; i < size; ++i) {
+      input_int_values[i] = static_cast<int>(i % 100);
+    }
+
+    std::vector<SrcType> input(size);
+    CastSpan<int, SrcType>(gsl::make_span(input_int_values), gsl::make_span(input));
+
+    std::vector<DstType> output(size);
+    CastSpan<SrcType, DstType>(gsl::make_span(input), gsl::make_span(output));
+
+    TestCastOp<SrcType, DstType>(gsl::make_span(input), gsl::make_span(output), shape.AsShapeVector());
+  }
+};
+
+using CastLargeTensorTypePairs =
+    boost::mp11::mp_list<
+        std::pair<float, MLFloat16>, std::pair<MLFloat16, float>,
+        std::pair<float, BFloat16>, std::pair<BFloat16, float>,
+        std::pair<float, int8_t>, std::pair<int8_t, float>,
+        std::pair<float, uint8_t>, std::pair<uint8_t, float>,
+        std::pair<float, int32_t>, std::pair<int32_t, float>,
+        std::pair<float, int64_t>, std::pair<int64_t, float>,
+        std::pair<MLFloat16, int64_t>, std::pair<double, int32_t>>;
+
+TEST(CastOpTest, LargeTensor) {
+  boost::mp11::mp_for_each<CastLargeTensorTypePairs>(CastLargeTensorTester{});
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
@@ -234,6 +275,13 @@ void CastOpTestFloat8(Saturate saturate) {
       CastedValues<float, MLFloat16>(gsl::make_span(float_input));
 
   TestCastOp<MLFloat16, F8>(gsl::make_span(float16_input), gsl::make_span(output), shape, OpTester::ExpectResult::kExpectSuccess, "", 19, saturate);
+
+  std::vector<float> float_output;
+  float_output.reserve(output.size());
+  for (const F8& value : output) {
+    float_output.push_back(value.ToFloat());
+  }
+  TestCastOp<F8, float>(gsl::make_span(output), gsl::make_span(float_output), shape, OpTester::ExpectResult::kExpectSuccess, "", 19);
 }
 
 TEST(CastOpTest, ToFloat8E4M3FN) {
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "core/util/math.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -187,6 +189,77 @@ TEST(ExpandOpTest, Expand_scalar_int32) {
   test.Run();
 }
 
+// Expands an input holding 0, 1, 2, ... to shape, and checks the result against a broadcast computed element by
+// element.
+template <typename T>
+void RunExpandTest(const std::vector<int64_t>& input_dims, const std::vector<int64_t>& shape) {
+  const size_t rank = std::max(input_dims.size(), shape.size());
+  std::vector<int64_t> aligned_input_dims(rank, 1);
+  std::vector<int64_t> output_dims(rank, 1);
+  std::copy(input_dims.begin(), input_dims.end(), aligned_input_dims.end() - static_cast<ptrdiff_t>(input_dims.size()));
+  std::copy(shape.begin(), shape.end(), output_dims.end() - static_cast<ptrdiff_t>(shape.size()));
+  int64_t input_size = 1;
+  int64_t output_size = 1;
+  for (size_t i = 0; i < rank; ++i) {
+    if (aligned_input_dims[i] != 1) {
+      output_dims[i] = aligned_input_dims[i];
+    }
+    input_size *= aligned_input_dims[i];
+    output_size *= output_dims[i];
+  }
+
+  std::vector<T> input_data(static_cast<size_t>(input_size));
+  for (int64_t i = 0; i < input_size; ++i) {
+    input_data[static_cast<size_t>(i)] = static_cast<T>(i);
+  }
+  std::vector<T> output_data(static_cast<size_t>(output_size));
+  for (int64_t i = 0; i < output_size; ++i) {
+    int64_t remain = i;
+    int64_t input_index = 0;
+    int64_t input_stride = 1;
+    for (size_t j = rank; j-- > 0;) {
+      if (aligned_input_dims[j] != 1) {
+        input_index += (remain % output_dims[j]) * input_stride;
+      }
+      remain /= output_dims[j];
+      input_stride *= aligned_input_dims[j];
+    }
+    output_data[static_cast<size_t>(i)] = input_data[static_cast<size_t>(input_index)];
+  }
+
+  OpTester test("Expand", 8);
+  test.AddInput<T>("data_0", input_dims, input_data);
+  test.AddInput<int64_t>("data_1", {static_cast<int64_t>(shape.size())}, shape);
+  test.AddOutput<T>("result", output_dims, output_data);
+  test.Run();
+}
+
+TEST(ExpandOpTest, Expand_inner_and_outer_dims) {
+  // broadcast the outer dims only
+  RunExpandTest<float>({1, 4}, {3, 4});
+  RunExpandTest<float>({4}, {2, 3, 4});
+  // broadcast the inner dims only
+  RunExpandTest<float>({3, 1}, {3, 5});
+  RunExpandTest<int64_t>({2, 3, 1}, {1, 1, 7});
+  // broadcast inner and outer dims around dims that are not broadcast
+  RunExpandTest<float>({1, 3, 1}, {2, 3, 4});
+  RunExpandTest<int32_t>({2, 1, 3, 1}, {2, 4, 3, 5});
+}
+
+TEST(ExpandOpTest, Expand_zero_size_dims) {
+  RunExpandTest<float>({0, 1}, {0, 4});
+  RunExpandTest<float>({2, 1}, {2, 0});
+  RunExpandTest<float>({1, 3}, {0, 3});
+  RunExpandTest<int32_t>({3}, {2, 0, 1});
+}
+
+TEST(ExpandOpTest, Expand_multithreaded) {
+  // large enough for the copy to be split across the intra-op thread pool
+  RunExpandTest<float>({1, 512}, {1024, 512});
+  RunExpandTest<float>({512, 1}, {512, 1024});
+  RunExpandTest<int32_t>({16, 1, 128, 1}, {16, 64, 128, 4});
+}
+
 #if defined(ENABLE_STRIDED_TENSORS) && (defined(USE_CUDA) || defined(USE_ROCM))
 TEST(ExpandOpTest, Strided) {
 #ifdef USE_CUDA
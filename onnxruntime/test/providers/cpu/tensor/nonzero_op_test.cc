@@ -99,5 +99,30 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+// large enough for the input to be split into several blocks
+TEST(NonZeroOpTest, LargeInput) {
+  constexpr int64_t rows = 300, cols = 257;
+  std::vector<int32_t> X(rows * cols);
+  std::vector<int64_t> row_indices, col_indices;
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      const bool nonzero = (r * 31 + c * 17) % 5 == 0;
+      X[r * cols + c] = nonzero ? static_cast<int32_t>(r + c + 1) : 0;
+      if (nonzero) {
+        row_indices.push_back(r);
+        col_indices.push_back(c);
+      }
+    }
+  }
+
+  std::vector<int64_t> Y(row_indices);
+  Y.insert(Y.end(), col_indices.begin(), col_indices.end());
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<int32_t>("X", {rows, cols}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(row_indices.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
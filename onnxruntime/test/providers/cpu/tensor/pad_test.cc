@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -915,6 +917,102 @@ TYPED_TEST(PadOpTest, Pad_Reflect_DimWithZeroInput) {
                                   "Cannot use 'reflect' mode to pad dimension with a value of 0. Input shape:{0,2,1}", {kTensorrtExecutionProvider});
 }
 
+// Pads an input holding 0, 1, 2, ... (modulo 100 to fit in every tested type), and checks the result against padding
+// computed element by element. The pads must not be negative.
+template <typename T>
+static void RunPadReferenceTest(const std::vector<int64_t>& input_dims, const std::vector<int64_t>& pads,
+                                const std::string& mode) {
+  SCOPED_TRACE(MakeString("mode: ", mode, ", input_dims: ", TensorShape(input_dims)));
+  const size_t rank = input_dims.size();
+  const T value = T(123);
+  std::vector<int64_t> output_dims(rank);
+  int64_t input_size = 1;
+  int64_t output_size = 1;
+  for (size_t i = 0; i < rank; ++i) {
+    output_dims[i] = input_dims[i] + pads[i] + pads[i + rank];
+    input_size *= input_dims[i];
+    output_size *= output_dims[i];
+  }
+
+  std::vector<T> input(static_cast<size_t>(input_size));
+  for (int64_t i = 0; i < input_size; ++i) {
+    input[static_cast<size_t>(i)] = T(i % 100);
+  }
+  std::vector<T> output(static_cast<size_t>(output_size));
+  for (int64_t i = 0; i < output_size; ++i) {
+    int64_t remain = i;
+    int64_t input_index = 0;
+    int64_t input_stride = 1;
+    bool is_padding = false;
+    for (size_t j = rank; j-- > 0;) {
+      const int64_t dim = input_dims[j];
+      int64_t index = remain % output_dims[j] - pads[j];
+      remain /= output_dims[j];
+      if (index < 0 || index >= dim) {
+        if (mode == "constant") {
+          is_padding = true;
+          break;
+        } else if (mode == "edge") {
+          index = std::clamp<int64_t>(index, 0, dim - 1);
+        } else if (mode == "reflect") {
+          const int64_t period = 2 * (dim - 1);
+          index = (index % period + period) % period;
+          if (index >= dim) {
+            index = period - index;
+          }
+        } else {  // wrap
+          index = (index % dim + dim) % dim;
+        }
+      }
+      input_index += index * input_stride;
+      input_stride *= dim;
+    }
+    output[static_cast<size_t>(i)] = is_padding ? value : input[static_cast<size_t>(input_index)];
+  }
+
+  if (mode == "wrap") {
+    RunOnnxOpsetTypedTest<T, 19>(input_dims, input, pads, false, value, false, output_dims, output, mode);
+  } else {
+    RunAllOpsetAllDomainPadTests<T>(input_dims, input, pads, value, output_dims, output, mode);
+  }
+}
+
+TYPED_TEST(PadOpTest, Pad_AllModes_Inner_And_Outer_Axes) {
+  using T = TypeParam;
+  for (const std::string mode : {"constant", "edge", "reflect", "wrap"}) {
+    // pad the inner axis only
+    RunPadReferenceTest<T>({3, 4, 5}, {0, 0, 2, 0, 0, 3}, mode);
+    // pad the outer axes only
+    RunPadReferenceTest<T>({3, 4, 5}, {2, 1, 0, 1, 2, 0}, mode);
+    // pad every axis
+    RunPadReferenceTest<T>({3, 4, 5}, {1, 2, 3, 2, 1, 4}, mode);
+  }
+}
+
+TYPED_TEST(PadOpTest, Pad_AllModes_DimWithZeroInput) {
+  // TODO: Unskip when fixed #41968513
+  if (DefaultDmlExecutionProvider().get() != nullptr) {
+    GTEST_SKIP() << "Skipping because of the following error: MLOperatorAuthorImpl.cpp(2100): The parameter is incorrect.";
+  }
+
+  using T = TypeParam;
+  // only the constant mode can pad the empty axis
+  RunPadReferenceTest<T>({2, 0, 3}, {0, 1, 1, 1, 1, 0}, "constant");
+  // the other modes can pad the axes that are not empty. 'wrap' does not support inputs with an empty axis.
+  for (const std::string mode : {"constant", "edge", "reflect"}) {
+    RunPadReferenceTest<T>({2, 0, 3}, {1, 0, 2, 1, 0, 1}, mode);
+  }
+}
+
+TEST(PadOpTest, Pad_AllModes_Multithreaded) {
+  // large enough for the output rows to be split across the intra-op thread pool
+  for (const std::string mode : {"constant", "edge", "reflect", "wrap"}) {
+    RunPadReferenceTest<float>({64, 96, 48}, {1, 2, 3, 2, 1, 4}, mode);
+    // few rows, each of them long
+    RunPadReferenceTest<float>({4, 65536}, {1, 3, 2, 5}, mode);
+  }
+}
+
 TEST(PadOpTest, BoolType) {
   OpTester test("Pad", 13);
   test.AddAttribute("mode", "constant");
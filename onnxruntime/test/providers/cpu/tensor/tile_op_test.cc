@@ -248,6 +248,31 @@ TEST(TensorOpTest, TileStringType) { RunTestWrapper<std::string>(); }
 
 TEST(TensorOpTest, TileBoolType) { RunTestWrapperForBool(); }
 
+TEST(TensorOpTest, TileInnerAndOuterDims) {
+  // repeat the inner dims only
+  RunTest<float>({2, 3}, {1, 4});
+  RunTest<float>({3, 1, 4}, {1, 5, 1});
+  // repeat the outer dims only
+  RunTest<float>({2, 3}, {4, 1});
+  RunTest<float>({1, 3, 1}, {2, 1, 1});
+  // repeat inner and outer dims around a dim that is not repeated
+  RunTest<float>({1, 3, 1}, {2, 1, 5});
+  RunTest<std::string>({2, 3, 2}, {3, 1, 2});
+}
+
+TEST(TensorOpTest, TileZeroSizeDims) {
+  RunTest<float>({0, 3}, {2, 2});
+  RunTest<float>({2, 0, 3}, {1, 3, 2});
+  RunTest<std::string>({3, 0}, {2, 4});
+}
+
+TEST(TensorOpTest, TileMultithreaded) {
+  // large enough for the copy to be split across the intra-op thread pool
+  RunTest<float>({64, 1, 128}, {2, 16, 2});
+  RunTest<int32_t>({3, 257, 5}, {20, 1, 16});
+  RunTest<std::string>({64, 64}, {4, 4});
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(TensorOpTest, TileMLFloat16Type) { RunTestWrapper<MLFloat16>(); }
 #endif
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -394,5 +396,55 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+// NaN compares unequal to everything, so every NaN is a unique value of its own. Sorted, they come last.
+TEST(Unique, Flatten_NaN) {
+  constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<float> X{1.f, nan, 2.f, nan, 1.f};
+
+  RunUniqueTest<float>({5}, X, nullptr, false, {4}, {1.f, nan, 2.f, nan}, {4}, {0, 1, 2, 3},
+                       {5}, {0, 1, 2, 3, 0}, {4}, {2, 1, 1, 1});
+  RunUniqueTest<float>({5}, X, nullptr, true, {4}, {1.f, 2.f, nan, nan}, {4}, {0, 2, 1, 3},
+                       {5}, {0, 2, 1, 3, 0}, {4}, {2, 1, 1, 1});
+}
+
+// large enough for the items to be split into several shards and blocks
+TEST(Unique, Flatten_LargeInput) {
+  constexpr int64_t num_items = 100000;
+  constexpr int64_t num_unique = 997;
+  std::vector<int64_t> X(num_items);
+  for (int64_t i = 0; i < num_items; ++i) {
+    X[i] = (num_unique - 1) - (i * 7919) % num_unique;
+  }
+
+  // the first num_unique items are all different, so they are the unsorted output
+  const std::vector<int64_t> Y_unsorted(X.begin(), X.begin() + num_unique);
+  std::vector<int64_t> indices_unsorted(num_unique);
+  std::vector<int64_t> inverse_indices_unsorted(num_items);
+  std::vector<int64_t> counts(num_unique, num_items / num_unique);
+  for (int64_t i = 0; i < num_unique; ++i) {
+    indices_unsorted[i] = i;
+    counts[i] += i < num_items % num_unique ? 1 : 0;
+  }
+  for (int64_t i = 0; i < num_items; ++i) {
+    inverse_indices_unsorted[i] = i % num_unique;
+  }
+
+  RunUniqueTest<int64_t>({num_items}, X, nullptr, false, {num_unique}, Y_unsorted, {num_unique}, indices_unsorted,
+                         {num_items}, inverse_indices_unsorted, {num_unique}, counts);
+
+  // sorted, the output value v is at position v
+  std::vector<int64_t> Y_sorted(num_unique);
+  std::vector<int64_t> indices_sorted(num_unique);
+  std::vector<int64_t> counts_sorted(num_unique);
+  for (int64_t i = 0; i < num_unique; ++i) {
+    Y_sorted[X[i]] = X[i];
+    indices_sorted[X[i]] = i;
+    counts_sorted[X[i]] = counts[i];
+  }
+
+  RunUniqueTest<int64_t>({num_items}, X, nullptr, true, {num_unique}, Y_sorted, {num_unique}, indices_sorted,
+                         {num_items}, X, {num_unique}, counts_sorted);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 
 #include "core/common/gsl.h"
@@ -146,5 +148,33 @@ TEST(WhereOpTest, BroadcastWithScalar) {
   test.Run();
 }
 
+TEST(WhereOpTest, BroadcastAllInputs) {
+  // each input is broadcast along a different set of dims, including a condition broadcast along the innermost dim
+  OpTester test{kOpName, kOpVersion};
+
+  const std::vector<bool> condition{true, false, false, true, true, true, false, false};
+  std::vector<float> X(3 * 5), Y(2 * 1 * 5);
+  std::iota(X.begin(), X.end(), 1.0f);
+  std::iota(Y.begin(), Y.end(), -10.0f);
+
+  std::vector<float> result;
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        for (int l = 0; l < 5; ++l) {
+          result.push_back(condition[i * 4 + j] ? X[k * 5 + l] : Y[i * 5 + l]);
+        }
+      }
+    }
+  }
+
+  test.AddInput<bool>("condition", {2, 4, 1, 1}, {true, false, false, true, true, true, false, false});
+  test.AddInput<float>("X", {3, 5}, X);
+  test.AddInput<float>("Y", {2, 1, 1, 5}, Y);
+  test.AddOutput<float>("output", {2, 4, 3, 5}, result);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <fstream>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/providers/cpu/tunable/gemm.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/framework/test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+CPUExecutionProviderInfo TunableCpuExecutionProviderInfo(bool tuning_enable) {
+  CPUExecutionProviderInfo info;
+  info.tunable_op.enable = true;
+  info.tunable_op.tuning_enable = tuning_enable;
+  info.tunable_op.max_tuning_duration_ms = 1;
+  return info;
+}
+
+// Runs a batch of two multiplications with beta != 0 through the tunable SGEMM and checks the result, so that
+// tuning must not accumulate into C while timing the candidates.
+void RunTunableSgemm(cpu::tunable::CpuTuningContext* tuning_ctx) {
+  constexpr size_t batch = 2, M = 37, N = 70, K = 50;
+  std::default_random_engine generator(3);
+  std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+  std::vector<float> A(batch * M * K), B(batch * N * K), C(batch * M * N);
+  for (auto& v : A) v = distribution(generator);
+  for (auto& v : B) v = distribution(generator);
+  for (auto& v : C) v = distribution(generator);
+
+  std::vector<float> expected(C);
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(batch);
+  for (size_t b = 0; b < batch; b++) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += A[(b * M + m) * K + k] * B[(b * N + n) * K + k];
+        }
+        expected[(b * M + m) * N + n] = 2.0f * sum + 0.5f * expected[(b * M + m) * N + n];
+      }
+    }
+
+    data[b].A = A.data() + b * M * K;
+    data[b].lda = K;
+    data[b].B = B.data() + b * N * K;
+    data[b].ldb = K;
+    data[b].C = C.data() + b * M * N;
+    data[b].ldc = N;
+    data[b].alpha = 2.0f;
+    data[b].beta = 0.5f;
+  }
+
+  ASSERT_STATUS_OK(cpu::tunable::blas::Sgemm(tuning_ctx, CblasNoTrans, CblasTrans, M, N, K,
+                                             data.data(), batch, nullptr));
+
+  for (size_t i = 0; i < C.size(); i++) {
+    ASSERT_NEAR(C[i], expected[i], 1e-4f * (1 + std::fabs(expected[i]))) << "@" << i;
+  }
+}
+
+}  // namespace
+
+TEST(CpuTunableOpTest, SgemmTuningAndResults) {
+#ifdef ORT_NO_RTTI
+  GTEST_SKIP() << "TunableOp needs RTTI to work correctly";
+#else
+  CPUExecutionProvider ep(TunableCpuExecutionProviderInfo(/*tuning_enable*/ true));
+  auto* tuning_ctx = cpu::tunable::GetCpuTuningContext(&ep);
+  ASSERT_NE(tuning_ctx, nullptr);
+
+  RunTunableSgemm(tuning_ctx);
+
+  // The shape is tuned once and the result is used by later runs.
+  auto trs = tuning_ctx->GetTuningResults();
+  ASSERT_EQ(trs.ep, kCpuExecutionProvider);
+  ASSERT_EQ(trs.results.size(), 1u);
+  ASSERT_EQ(trs.results.begin()->second.size(), 1u);
+  ASSERT_EQ(trs.validators.count("CPU_ISA"), 1u);
+
+  RunTunableSgemm(tuning_ctx);
+  ASSERT_EQ(tuning_ctx->GetTuningResults().results.begin()->second.size(), 1u);
+
+  // Results load into another session's EP, but not if they were tuned for another instruction set.
+  CPUExecutionProvider other_ep(TunableCpuExecutionProviderInfo(/*tuning_enable*/ false));
+  auto* other_tuning_ctx = cpu::tunable::GetCpuTuningContext(&other_ep);
+  ASSERT_STATUS_OK(other_tuning_ctx->LoadTuningResults(trs));
+  ASSERT_EQ(other_tuning_ctx->GetTuningResults().results, trs.results);
+  RunTunableSgemm(other_tuning_ctx);
+
+  auto mismatched = trs;
+  mismatched.validators["CPU_ISA"] = "unknown";
+  ASSERT_FALSE(other_tuning_ctx->GetTuningResultsValidator().ValidateAll(mismatched.validators).IsOK());
+#endif
+}
+
+TEST(CpuTunableOpTest, MatMulWithTuningResultsFile) {
+#ifdef ORT_NO_RTTI
+  GTEST_SKIP() << "TunableOp needs RTTI to work correctly";
+#else
+  // Tune the SGEMM of the MatMul in testdata/matmul_1.onnx, X{3, 2} * W{2, 1}, without a thread pool like the
+  // single threaded session below, so that the session looks up the same signature.
+  CPUExecutionProvider ep(TunableCpuExecutionProviderInfo(/*tuning_enable*/ true));
+  {
+    const std::vector<float> A{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    const std::vector<float> B{1.0f, 2.0f};
+    std::vector<float> C(3);
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = A.data();
+    data.lda = 2;
+    data.B = B.data();
+    data.ldb = 1;
+    data.C = C.data();
+    data.ldc = 1;
+    ASSERT_STATUS_OK(cpu::tunable::blas::Sgemm(cpu::tunable::GetCpuTuningContext(&ep), CblasNoTrans, CblasNoTrans,
+                                               3, 1, 2, &data, 1, nullptr));
+  }
+  auto trs = ep.GetTuningContext()->GetTuningResults();
+  ASSERT_EQ(trs.results.size(), 1u);
+  ASSERT_EQ(trs.results.begin()->second.size(), 1u);
+
+  TemporaryDirectory temp_dir(ORT_TSTR("cpu_tunable_op_test"));
+  const std::string tuning_results_file = ToUTF8String(temp_dir.Path()) + "/tuning_results.json";
+  {
+    nlohmann::json j = nlohmann::json::array();
+    j.push_back({{"ep", trs.ep}, {"validators", trs.validators}, {"results", trs.results}});
+    std::ofstream(tuning_results_file) << j.dump();
+  }
+
+  auto make_session_options = [](const std::string& file) {
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = 1;
+    // W was not pre-packed when tuning.
+    ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDisablePrepacking, "1"));
+    ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsTuningResultsFile, file.c_str()));
+    return so;
+  };
+
+  // Loading the file enables TunableOp for the CPU EP, which has not been enabled otherwise.
+  InferenceSessionWrapper session{make_session_options(tuning_results_file), GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  auto* session_tuning_ctx =
+      session.GetSessionState().GetExecutionProviders().Get(kCpuExecutionProvider)->GetTuningContext();
+  ASSERT_NE(session_tuning_ctx, nullptr);
+  ASSERT_TRUE(session_tuning_ctx->IsTunableOpEnabled());
+  ASSERT_FALSE(session_tuning_ctx->IsTuningEnabled());
+  ASSERT_EQ(session_tuning_ctx->GetTuningResults().results, trs.results);
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+  NameMLValMap feeds{{"X", x}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+  ASSERT_EQ(fetches.size(), 1u);
+  auto y = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(std::vector<float>(y.begin(), y.end()), (std::vector<float>{5.0f, 11.0f, 17.0f}));
+
+  // The run used the loaded result instead of tuning the shape again.
+  ASSERT_EQ(session_tuning_ctx->GetTuningResults().results, trs.results);
+
+  InferenceSessionWrapper missing_file_session{
+      make_session_options(ToUTF8String(temp_dir.Path()) + "/missing.json"), GetEnvironment()};
+  ASSERT_STATUS_OK(missing_file_session.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+  auto status = missing_file_session.Initialize();
+  ASSERT_FALSE(status.IsOK());
+  ASSERT_NE(status.ErrorMessage().find("Failed to open tuning results file"), std::string::npos);
+#endif
+}
+
+}  // namespace test
+}  // namespace onnxruntime